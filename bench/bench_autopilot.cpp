@@ -0,0 +1,183 @@
+// --------------------------------------------------------------------------------------
+// Autopilot vs seekPolicy: runs many headless episodes of each on the thread pool and
+// reports win rate, time to win, planning latency percentiles and throughput. Latency is
+// the whole replan as the car sees it (goal field build + search), split into found,
+// partial (expansion budget spent, path to the pose nearest the goal) and failed plans,
+// and checked against the 1 ms per replan target. Latency is wall clock, so on a loaded
+// machine single replans can go over from preemption alone; the cpu row is the same
+// replans in thread CPU time, which preemption doesn't add to. Build with optimisation
+// (CMAKE_BUILD_TYPE=Release), an unoptimised build is several times slower.
+// Usage: autopilot_bench [episodes] [seconds]
+// --------------------------------------------------------------------------------------
+
+#include "sim/Autopilot.h"
+#include "sim/EpisodeRunner.h"
+#include "sim/SeekPolicy.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#ifndef _WIN32
+#include <time.h>
+#endif
+
+namespace {
+
+constexpr float dt = 1.f / 60.f;
+
+struct EpisodeTrack {
+    Autopilot pilot;
+    int steps = 0;
+    int wonAt = -1;
+    std::vector<double> found, partial, failed, field; // us: replan inkl. felt, og bare feltet
+    std::vector<double> cpu;                           // us: drive() med replan, trådens CPU-tid
+    std::uint64_t noRoute = 0;
+};
+
+struct Summary {
+    int wins = 0;
+    double meanWinSeconds = 0.0;
+};
+
+Summary summarize(const EpisodeRunner& runner, const std::vector<EpisodeTrack>& tracks) {
+    Summary s;
+    for (std::size_t i = 0; i < runner.size(); ++i) {
+        if (runner.episode(i).state() != GameState::Won) continue;
+        ++s.wins;
+        s.meanWinSeconds += tracks[i].wonAt * dt;
+    }
+    if (s.wins > 0) s.meanWinSeconds /= s.wins;
+    return s;
+}
+
+constexpr double targetMicros = 1000.0;
+
+// trådens CPU-tid i us; 0 der den ikke finnes (cpu-raden blir da tom)
+double threadCpuMicros() {
+#ifndef _WIN32
+    timespec ts{};
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) return ts.tv_sec * 1e6 + ts.tv_nsec * 1e-3;
+#endif
+    return 0.0;
+}
+
+double percentile(std::vector<double>& v, double p) {
+    if (v.empty()) return 0.0;
+    if (p >= 1.0) return *std::max_element(v.begin(), v.end());
+    std::size_t k = std::min(v.size() - 1, static_cast<std::size_t>(p * static_cast<double>(v.size())));
+    std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+    return v[k];
+}
+
+}
+
+int main(int argc, char** argv) {
+    const std::size_t episodes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256;
+    const float seconds = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 180.f;
+    const int steps = static_cast<int>(seconds / dt);
+
+    ThreadPool pool;
+    std::printf("%zu episodes x %.0f s simulated, %u threads\n\n", episodes, seconds, pool.size());
+#if !defined(__OPTIMIZE__)
+    std::printf("warning: unoptimized build, latencies are not comparable to the target\n\n");
+#endif
+
+    // tabellene bygges én gang per (layout, bil) og deles
+    EpisodeRunner runner(episodes, 777);
+    auto tables = plannerTablesFor(runner.episode(0).lot().layout, CarPhysicsParams{});
+    std::printf("planner tables: %zu primitives, %dx%d reach table, built in %.2f ms\n\n",
+                tables->primitives.size(), 2 * tables->window + 1, 2 * tables->window + 1, tables->buildMs);
+
+    std::vector<EpisodeTrack> autoTracks(episodes);
+    EpisodeRunStats autoStats = runner.run(pool, steps, dt, [&](std::size_t i, const Simulation& sim) {
+        // én planlegger (kladdeminne) per tråd, én autopilot per episode
+        thread_local std::unique_ptr<ParkingPlanner> planner;
+        if (!planner || &planner->tables() != tables.get()) planner = std::make_unique<ParkingPlanner>(tables);
+
+        EpisodeTrack& t = autoTracks[i];
+        if (sim.state() == GameState::Won) {
+            if (t.wonAt < 0) t.wonAt = t.steps;
+            return CarInput{};
+        }
+        ++t.steps;
+        std::uint64_t before = t.pilot.plans();
+        const double cpu0 = threadCpuMicros();
+        CarInput in = t.pilot.drive(sim, *planner, dt);
+        if (t.pilot.plans() != before) {
+            if (cpu0 > 0.0) t.cpu.push_back(threadCpuMicros() - cpu0);
+            const PlanStats& p = t.pilot.lastPlan();
+            (p.found ? t.found : p.partial ? t.partial : t.failed).push_back(p.micros + p.fieldMicros);
+            if (p.fieldMicros > 0.0) t.field.push_back(p.fieldMicros);
+            if (!p.found && !p.partial) ++t.noRoute;
+        }
+        return in;
+    });
+
+    EpisodeRunner seekRunner(episodes, 777);
+    std::vector<EpisodeTrack> seekTracks(episodes);
+    EpisodeRunStats seekStats = seekRunner.run(pool, steps, dt, [&](std::size_t i, const Simulation& sim) {
+        EpisodeTrack& t = seekTracks[i];
+        if (sim.state() == GameState::Won) {
+            if (t.wonAt < 0) t.wonAt = t.steps;
+            return CarInput{};
+        }
+        ++t.steps;
+        return seekPolicy(sim);
+    });
+
+    std::vector<double> all, searched, found, partial, failed, field, cpu;
+    std::uint64_t noRoute = 0;
+    for (const auto& t : autoTracks) {
+        found.insert(found.end(), t.found.begin(), t.found.end());
+        partial.insert(partial.end(), t.partial.begin(), t.partial.end());
+        failed.insert(failed.end(), t.failed.begin(), t.failed.end());
+        field.insert(field.end(), t.field.begin(), t.field.end());
+        cpu.insert(cpu.end(), t.cpu.begin(), t.cpu.end());
+        noRoute += t.noRoute;
+    }
+    searched = found;
+    searched.insert(searched.end(), partial.begin(), partial.end());
+    all = searched;
+    all.insert(all.end(), failed.begin(), failed.end());
+    const auto over = std::count_if(all.begin(), all.end(), [](double us) { return us > targetMicros; });
+
+    Summary a = summarize(runner, autoTracks);
+    Summary s = summarize(seekRunner, seekTracks);
+
+    std::printf("%-12s %8s %10s %16s\n", "policy", "win %", "win time", "steps/sec");
+    std::printf("%-12s %7.1f%% %9.1fs %16.3e\n", "autopilot", 100.0 * a.wins / episodes, a.meanWinSeconds, autoStats.stepsPerSec);
+    std::printf("%-12s %7.1f%% %9.1fs %16.3e\n", "seekPolicy", 100.0 * s.wins / episodes, s.meanWinSeconds, seekStats.stepsPerSec);
+
+    // partial: budsjettet brukt opp, bilen kjører mot posen nærmest målet og planlegger
+    // videre derfra. failed: ingen vei i det hele tatt, autopiloten vrir seg løs i stedet
+    std::printf("\nplans: %zu, found %zu, partial %zu, failed %llu (no route)\n", all.size(), found.size(),
+                partial.size(), static_cast<unsigned long long>(noRoute));
+    std::printf("replan latency us, goal field build included:\n");
+    std::printf("%-8s %7s %7s %7s %7s %7s\n", "", "count", "p50", "p90", "p99", "max");
+    auto row = [](const char* name, std::vector<double>& v) {
+        std::printf("%-8s %7zu %7.0f %7.0f %7.0f %7.0f\n", name, v.size(), percentile(v, 0.50),
+                    percentile(v, 0.90), percentile(v, 0.99), percentile(v, 1.0));
+    };
+    row("all", all);
+    row("found", found);
+    row("partial", partial);
+    row("failed", failed);
+    row("field", field);
+    if (!cpu.empty()) row("cpu", cpu);
+    // målet gjelder planene som søker (funnet og delvis); de mislykkede stopper tidlig
+    // og ville trukket persentilene ned
+    const double p99 = percentile(searched, 0.99), worst = percentile(all, 1.0);
+    std::printf("target %.0f us per replan: search p99 %.0f us %s, max %.0f us %s; %lld of %zu replans over (%.1f%%)\n",
+                targetMicros, p99, p99 <= targetMicros ? "met" : "MISSED", worst,
+                worst <= targetMicros ? "met" : "MISSED", static_cast<long long>(over), all.size(),
+                all.empty() ? 0.0 : 100.0 * static_cast<double>(over) / static_cast<double>(all.size()));
+    // veggklokka over, CPU-tid under: er bare veggklokka over, var tråden satt av
+    if (!cpu.empty()) {
+        const double cpuWorst = percentile(cpu, 1.0);
+        std::printf("cpu max %.0f us %s\n", cpuWorst, cpuWorst <= targetMicros ? "met" : "MISSED");
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+// --------------------------------------------------------------------------------------
+// Cone collision accuracy vs throughput: steps headless cruising episodes on a
+// cone-heavy lot at 1..10x the normal 120 Hz step, with the discrete end-of-step
+// test and with the swept car box, and counts steps whose path passed through a cone.
+// The car cruises at full throttle with slowly sweeping steering, so it keeps
+// running into cones and turning away again.
+// Usage: ccd_bench [episodes] [simulated seconds] [cones]
+// --------------------------------------------------------------------------------------
+
+#include "logic/Simulation.h"
+#include "sim/Scenario.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// bilboksen gjennom strekningen a-b (i 16 delsteg) overlapper kjeglen (minus slakk)
+bool pathHitsCone(const Simulation& sim, Vec2 a, Vec2 b, Vec2 c) {
+    for (int k = 0; k <= 16; ++k) {
+        Obb box = makeCarObb(a + (b - a) * (k / 16.f), sim.car().heading(), sim.carHalfW(), sim.carHalfD());
+        if (overlapsCircle(box, c, Simulation::coneRadius - 0.01f)) return true;
+    }
+    return false;
+}
+
+// full gass og sakte svingende ratt; time = simulert tid
+CarInput cruise(std::size_t episode, float time) {
+    CarInput in;
+    in.throttle = 1.f;
+    in.steer = std::sin(0.6f * time + static_cast<float>(episode));
+    return in;
+}
+
+struct Result {
+    double stepsPerSec = 0.0;
+    double penetrationsPerMin = 0.0;
+    double contactsPerMin = 0.0;
+};
+
+Result run(const Scenario& scenario, std::size_t episodes, float seconds, int multiplier, bool swept) {
+    const float dt = static_cast<float>(multiplier) / 120.f;
+    const int steps = static_cast<int>(seconds / dt);
+
+    std::vector<Simulation> sims;
+    sims.reserve(episodes);
+    for (std::size_t e = 0; e < episodes; ++e) {
+        sims.emplace_back(1000 + e, scenario);
+        sims.back().setContinuousCollision(swept);
+    }
+
+    // tidsmåling uten kontrollen
+    auto t0 = clock_type::now();
+    for (auto& sim : sims) {
+        const std::size_t e = static_cast<std::size_t>(&sim - sims.data());
+        for (int s = 0; s < steps; ++s) sim.step(dt, cruise(e, static_cast<float>(s) * dt));
+        sim.clearEvents();
+    }
+    double secs = std::chrono::duration<double>(clock_type::now() - t0).count();
+
+    // samme episoder igjen med kontroll mot alle kjegler etter hvert steg
+    Result r;
+    std::uint64_t penetrations = 0, contacts = 0;
+    for (std::size_t e = 0; e < episodes; ++e) {
+        Simulation sim(1000 + e, scenario);
+        sim.setContinuousCollision(swept);
+        for (int s = 0; s < steps; ++s) {
+            Vec2 a = sim.car().position();
+            float speed = sim.car().speed();
+            sim.step(dt, cruise(e, static_cast<float>(s) * dt));
+            Vec2 b = sim.car().position();
+            for (const auto& c : sim.cones()) {
+                // maks 2 m per steg + boksens halve diagonal + kjegle < 4 m
+                if (lengthSq(c - a) < 16.f && pathHitsCone(sim, a, b, c)) {
+                    ++penetrations;
+                    break;
+                }
+            }
+            // stoppet i fart (kjegle eller kant)
+            if (speed > 1.f && sim.car().speed() == 0.f) ++contacts;
+        }
+        sim.clearEvents();
+    }
+
+    const double minutes = static_cast<double>(episodes) * seconds / 60.0;
+    r.stepsPerSec = static_cast<double>(episodes) * steps / secs;
+    r.penetrationsPerMin = static_cast<double>(penetrations) / minutes;
+    r.contactsPerMin = static_cast<double>(contacts) / minutes;
+    return r;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const std::size_t episodes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+    const float seconds = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 60.f;
+
+    // mange kjegler, så bilen kjører inn i en del
+    Scenario scenario;
+    scenario.coneCount = argc > 3 ? std::atoi(argv[3]) : 300;
+
+    std::printf("%zu episodes x %.0f simulated s, %d cones\n", episodes, seconds, scenario.coneCount);
+    std::printf("%-9s %5s %8s %14s %14s %16s %9s\n",
+                "mode", "step", "dt ms", "steps/sec", "sim s/sec", "penetr./min", "stops/min");
+
+    for (int k : {1, 2, 4, 8, 10}) {
+        for (bool swept : {false, true}) {
+            Result r = run(scenario, episodes, seconds, k, swept);
+            double dt = k / 120.0;
+            std::printf("%-9s %4dx %8.2f %14.3e %14.3e %16.2f %9.2f\n",
+                        swept ? "swept" : "discrete", k, dt * 1000.0, r.stepsPerSec,
+                        r.stepsPerSec * dt, r.penetrationsPerMin, r.contactsPerMin);
+        }
+    }
+    return 0;
+}
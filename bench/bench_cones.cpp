@@ -0,0 +1,77 @@
+// --------------------------------------------------------------------------------------
+// Cone collision cost: linear scan over all cones vs the ConeGrid broadphase.
+// The lot grows with the cone count (constant density), which is how large
+// scenario lots behave; grid cost per query should stay flat.
+// --------------------------------------------------------------------------------------
+
+#include "world/ConeGrid.h"
+#include "world/TrafficCones.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double secondsSince(clock_type::time_point t0) {
+    return std::chrono::duration<double>(clock_type::now() - t0).count();
+}
+
+}
+
+int main() {
+    const float minDist = 0.9f + 0.35f;   // bil + kjegle
+    const float areaPerCone = 50.f;       // m^2
+
+    std::printf("%10s %12s %14s %14s %12s\n", "cones", "lot side m", "linear ns/q", "grid ns/q", "rebuild ms");
+
+    for (int n : {30, 1000, 10000, 100000}) {
+        const float side = std::sqrt(areaPerCone * static_cast<float>(n));
+
+        std::vector<Vec2> cones;
+        scatterTrafficCones({0.f, 0.f}, side, side, n, cones);
+
+        ConeGrid grid;
+        grid.configure({-side * 0.5f, -side * 0.5f}, side, side, 2.f * minDist);
+
+        auto t0 = clock_type::now();
+        grid.rebuild(cones);
+        double rebuildMs = secondsSince(t0) * 1e3;
+
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<float> dist(-side * 0.5f, side * 0.5f);
+        std::vector<Vec2> queries(20000);
+        for (auto& q : queries) q = {dist(gen), dist(gen)};
+
+        // lineært søk: samme test som den gamle løkka i Game::update
+        const std::size_t linearQueries = n > 10000 ? 500 : queries.size();
+        int hitsLinear = 0;
+        t0 = clock_type::now();
+        for (std::size_t i = 0; i < linearQueries; ++i) {
+            for (const auto& c : cones) {
+                float dx = queries[i].x - c.x, dz = queries[i].z - c.z;
+                if (dx * dx + dz * dz < minDist * minDist) { ++hitsLinear; break; }
+            }
+        }
+        double linearNs = secondsSince(t0) * 1e9 / static_cast<double>(linearQueries);
+
+        int hitsGrid = 0;
+        t0 = clock_type::now();
+        for (const auto& q : queries) {
+            hitsGrid += grid.firstWithin(q, minDist) >= 0;
+        }
+        double gridNs = secondsSince(t0) * 1e9 / static_cast<double>(queries.size());
+
+        std::printf("%10d %12.0f %14.1f %14.1f %12.3f\n",
+                    n, side, linearNs, gridNs, rebuildMs);
+
+        // hold resultatene i live så løkkene ikke optimaliseres bort
+        if (hitsGrid < 0 || hitsLinear < 0) return 1;
+    }
+
+    return 0;
+}
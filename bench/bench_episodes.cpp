@@ -0,0 +1,54 @@
+// --------------------------------------------------------------------------------------
+// Multi-episode throughput: steps many headless episodes with seekPolicy on 1..N
+// threads and reports episode-steps/sec, scaling and a determinism checksum.
+// Usage: episode_bench [episodes] [steps]
+// --------------------------------------------------------------------------------------
+
+#include "sim/EpisodeRunner.h"
+#include "sim/SeekPolicy.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+std::uint64_t checksum(const EpisodeRunner& runner) {
+    std::uint64_t h = 1469598103934665603ull;
+    for (std::size_t i = 0; i < runner.size(); ++i) {
+        const auto& sim = runner.episode(i);
+        float v[2] = {sim.car().position().x, sim.car().position().z};
+        unsigned char bytes[sizeof(v)];
+        std::memcpy(bytes, v, sizeof(v));
+        for (unsigned char b : bytes) h = (h ^ b) * 1099511628211ull;
+        h = (h ^ static_cast<std::uint64_t>(sim.completedTargets())) * 1099511628211ull;
+    }
+    return h;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const std::size_t episodes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2048;
+    const int steps = argc > 2 ? std::atoi(argv[2]) : 1200;
+    const unsigned maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    EpisodePolicy policy = [](std::size_t, const Simulation& sim) { return seekPolicy(sim); };
+
+    std::printf("%zu episodes x %d steps\n", episodes, steps);
+    std::printf("%8s %16s %10s %20s\n", "threads", "steps/sec", "speedup", "checksum");
+
+    double base = 0.0;
+    for (unsigned threads = 1; threads <= maxThreads; threads = threads < maxThreads ? std::min(maxThreads, threads * 2) : threads + 1) {
+        ThreadPool pool(threads);
+        EpisodeRunner runner(episodes, 12345);
+        EpisodeRunStats stats = runner.run(pool, steps, 1.f / 120.f, policy);
+
+        if (threads == 1) base = stats.stepsPerSec;
+        std::printf("%8u %16.3e %9.2fx %20llu\n", threads, stats.stepsPerSec, stats.stepsPerSec / base,
+                    static_cast<unsigned long long>(checksum(runner)));
+    }
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+// --------------------------------------------------------------------------------------
+// Throughput of the batch physics: per-object Car::update loop vs CarFleet
+// (scalar fallback and the compiled-in SIMD path). Prints cars/sec per fleet size.
+// --------------------------------------------------------------------------------------
+
+#include "sim/CarFleet.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+std::vector<CarInput> makeInputs(std::size_t n) {
+    std::vector<CarInput> inputs(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        inputs[i].throttle  = (i % 3 == 0) ? -1.f : 1.f;
+        inputs[i].steer     = static_cast<float>(static_cast<int>(i % 3) - 1);
+        inputs[i].handbrake = (i % 7 == 0);
+    }
+    return inputs;
+}
+
+template <class F>
+double carsPerSec(std::size_t cars, int ticks, F&& tick) {
+    tick(); // varm opp
+    auto t0 = clock_type::now();
+    for (int t = 0; t < ticks; ++t) tick();
+    double sec = std::chrono::duration<double>(clock_type::now() - t0).count();
+    return static_cast<double>(cars) * ticks / sec;
+}
+
+}
+
+int main() {
+    const float dt = 1.f / 120.f;
+
+    std::printf("CarFleet SIMD path: %s\n", CarFleet::simdPath());
+    std::printf("%10s %16s %16s %16s %8s\n", "cars", "Car::update/s", "fleet scalar/s", "fleet simd/s", "speedup");
+
+    for (std::size_t n : {1000u, 10000u, 100000u}) {
+        const int ticks = static_cast<int>(20000000 / n);
+        auto inputs = makeInputs(n);
+
+        std::vector<Car> cars(n);
+        double perObject = carsPerSec(n, ticks, [&] {
+            for (std::size_t i = 0; i < n; ++i) cars[i].update(dt, inputs[i]);
+        });
+
+        CarFleet scalar, simd;
+        scalar.reserve(n);
+        simd.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            scalar.add();
+            simd.add();
+        }
+
+        double fleetScalar = carsPerSec(n, ticks, [&] { scalar.updateScalar(dt, inputs); });
+        double fleetSimd   = carsPerSec(n, ticks, [&] { simd.update(dt, inputs); });
+
+        std::printf("%10zu %16.3e %16.3e %16.3e %7.2fx\n",
+                    n, perObject, fleetScalar, fleetSimd, fleetSimd / perObject);
+    }
+
+    return 0;
+}
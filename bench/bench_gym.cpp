@@ -0,0 +1,105 @@
+// --------------------------------------------------------------------------------------
+// Batched gym step throughput: env-steps/sec through the car_gym C ABI for growing
+// batch sizes on one thread and on all threads, against stepping a single Simulation
+// directly with the same kind of actions. Observations, rewards and dones go into
+// preallocated buffers; allocations per step are measured by car_bench (gym group).
+// Usage: gym_bench [steps per size]
+// --------------------------------------------------------------------------------------
+
+#include "logic/Simulation.h"
+#include "sim/car_gym.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// kjører fram og svinger sakte, forskjellig per episode
+void fillActions(std::vector<float>& a, std::size_t n, int step) {
+    for (std::size_t i = 0; i < n; ++i) {
+        a[i * CAR_GYM_ACTION_SIZE + 0] = 1.f;
+        a[i * CAR_GYM_ACTION_SIZE + 1] = std::sin(0.02f * static_cast<float>(step) + static_cast<float>(i));
+        a[i * CAR_GYM_ACTION_SIZE + 2] = 0.f;
+    }
+}
+
+double runGym(std::uint32_t episodes, std::uint32_t threads, int steps) {
+    car_gym_config cfg;
+    car_gym_default_config(&cfg);
+    cfg.episodes = episodes;
+    cfg.threads = threads;
+    car_gym* gym = car_gym_create(&cfg);
+
+    std::vector<float> obs(episodes * CAR_GYM_OBS_SIZE), actions(episodes * CAR_GYM_ACTION_SIZE), rewards(episodes);
+    std::vector<std::uint8_t> dones(episodes);
+    car_gym_reset(gym, obs.data());
+
+    // handlingene regnes ut på forhånd, så bare steget måles
+    const int distinct = 64;
+    std::vector<std::vector<float>> plan(distinct, actions);
+    for (int s = 0; s < distinct; ++s) fillActions(plan[s], episodes, s);
+
+    // varm opp (første resets fyller kapasiteten i Simulation sine buffere)
+    for (int s = 0; s < 200; ++s) {
+        car_gym_step(gym, plan[s % distinct].data(), obs.data(), rewards.data(), dones.data(), nullptr);
+    }
+
+    auto t0 = clock_type::now();
+    for (int s = 0; s < steps; ++s) {
+        car_gym_step(gym, plan[s % distinct].data(), obs.data(), rewards.data(), dones.data(), nullptr);
+    }
+    const double secs = std::chrono::duration<double>(clock_type::now() - t0).count();
+    car_gym_destroy(gym);
+
+    return static_cast<double>(episodes) * steps / secs;
+}
+
+// én Simulation, stegget direkte med samme handlinger og tidsgrense
+double runSingle(int steps) {
+    car_gym_config cfg;
+    car_gym_default_config(&cfg);
+    Simulation sim(1);
+    std::vector<float> a(CAR_GYM_ACTION_SIZE);
+    int episodeSteps = 0;
+
+    auto t0 = clock_type::now();
+    for (int s = 0; s < steps; ++s) {
+        fillActions(a, 1, s % 64);
+        sim.step(cfg.dt, {a[0], a[1], a[2] > 0.5f});
+        sim.clearEvents();
+        if (sim.state() == GameState::Won || ++episodeSteps >= static_cast<int>(cfg.max_steps)) {
+            sim.reset();
+            episodeSteps = 0;
+        }
+    }
+    const double secs = std::chrono::duration<double>(clock_type::now() - t0).count();
+    return steps / secs;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const long long budget = argc > 1 ? std::atoll(argv[1]) : 2000000; // env-steg per måling
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+
+    const double single = runSingle(static_cast<int>(budget));
+    std::printf("single Simulation::step: %.3e steps/sec\n", single);
+    std::printf("%8s %8s %16s %10s\n", "envs", "threads", "env-steps/sec", "vs single");
+
+    for (std::uint32_t n : {1u, 16u, 256u, 1024u, 4096u}) {
+        for (std::uint32_t threads : {1u, hw}) {
+            const int steps = static_cast<int>(std::max<long long>(20, budget / n));
+            const double rate = runGym(n, threads, steps);
+            std::printf("%8u %8u %16.3e %9.2fx\n", n, threads, rate, rate / single);
+            if (hw == 1) break; // bare én kolonne på én kjerne
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,220 @@
+// --------------------------------------------------------------------------------------
+// Input timing: replays synthetic key streams (short taps and longer holds on throttle
+// and steering) through two paths and compares them with a reference that splits
+// each physics step exactly at the event times:
+//   frame    - controls sampled once per 60 Hz render frame (the old Game::Controls)
+//   queue    - timestamped events through InputQueue, time-weighted inside each step
+// The second part injects the same kind of stream into a running SimThread from a
+// script thread and reports the measured input-to-physics latency.
+// Usage: input_bench [runs] [simulated seconds] [threaded seconds]
+// --------------------------------------------------------------------------------------
+
+#include "logic/Simulation.h"
+#include "sim/InputQueue.h"
+#include "sim/SimThread.h"
+#include "util/Profiler.h"
+#include "util/Rng.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::uint64_t ms = 1000000;
+
+struct Press {
+    std::uint64_t beginNs, endNs;
+};
+
+// av/på-strøm for én kontroll: halvparten korte trykk (2-30 ms), resten hold (50-500 ms)
+void addStream(Rng& rng, InputControl control, std::uint64_t endNs,
+               std::vector<InputEvent>& events, std::vector<Press>& presses) {
+    std::uint64_t t = 0;
+    for (;;) {
+        t += static_cast<std::uint64_t>(rng.uniform(20.f, 300.f) * ms);
+        const bool tap = rng.uniform01() < 0.5f;
+        const auto len = static_cast<std::uint64_t>((tap ? rng.uniform(2.f, 30.f) : rng.uniform(50.f, 500.f)) * ms);
+        if (t + len >= endNs) break;
+        const float value = rng.uniform01() < 0.5f ? -1.f : 1.f;
+        events.push_back({t, control, value});
+        events.push_back({t + len, control, 0.f});
+        presses.push_back({t, t + len});
+        t += len;
+    }
+}
+
+void apply(CarInput& in, const InputEvent& e) {
+    switch (e.control) {
+        case InputControl::Throttle: in.throttle = e.value; break;
+        case InputControl::Steer: in.steer = e.value; break;
+        case InputControl::Handbrake: in.handbrake = e.value != 0.f; break;
+    }
+}
+
+double distance(const Car& a, const Car& b) {
+    return static_cast<double>(length(a.position() - b.position()));
+}
+
+struct Accuracy {
+    std::uint64_t presses = 0;
+    std::uint64_t frameLost = 0;   // trykk som ingen frame så
+    double frameErr = 0.0;         // snitt over steg av avstand til referansen (m)
+    double queueErr = 0.0;
+    double frameMaxErr = 0.0;
+    double queueMaxErr = 0.0;
+    double nsPerEvent = 0.0;       // push + integrate, delt på hendelsene
+    float sink = 0.f;
+};
+
+Accuracy accuracy(std::size_t runs, float seconds) {
+    constexpr std::uint64_t stepNs = 1000000000ull / 120;
+    constexpr std::uint64_t frameNs = 1000000000ull / 60;
+    const float dt = 1.f / 120.f;
+    const auto endNs = static_cast<std::uint64_t>(static_cast<double>(seconds) * 1e9);
+    const std::uint64_t steps = endNs / stepNs;
+
+    Accuracy r;
+    double frameSum = 0.0, queueSum = 0.0, queueSecs = 0.0;
+    std::uint64_t samples = 0, eventCount = 0;
+
+    for (std::size_t run = 0; run < runs; ++run) {
+        Rng rng(7000 + run);
+        std::vector<InputEvent> events;
+        std::vector<Press> presses;
+        addStream(rng, InputControl::Throttle, endNs, events, presses);
+        addStream(rng, InputControl::Steer, endNs, events, presses);
+        std::stable_sort(events.begin(), events.end(),
+                         [](const InputEvent& a, const InputEvent& b) { return a.timeNs < b.timeNs; });
+        eventCount += events.size();
+
+        // trykk mellom to frames blir aldri sett av frame-samplingen
+        r.presses += presses.size();
+        for (const Press& p : presses) {
+            const std::uint64_t firstFrame = (p.beginNs + frameNs - 1) / frameNs * frameNs;
+            if (firstFrame >= p.endNs) ++r.frameLost;
+        }
+
+        Car ref, frame, queued;
+        CarInput refIn, frameIn, sampled;
+        InputQueue queue(events.size() + 1);
+        std::size_t refNext = 0, frameNext = 0;
+        for (const InputEvent& e : events) queue.push(e);
+
+        // kø-veien alene, for kostnaden per hendelse
+        {
+            InputQueue timed(events.size() + 1);
+            float sink = 0.f;
+            auto t0 = clock_type::now();
+            for (const InputEvent& e : events) timed.push(e);
+            for (std::uint64_t s = 0; s < steps; ++s) sink += timed.integrate(s * stepNs, (s + 1) * stepNs, 0).throttle;
+            queueSecs += std::chrono::duration<double>(clock_type::now() - t0).count();
+            r.sink += sink;
+        }
+
+        for (std::uint64_t s = 0; s < steps; ++s) {
+            const std::uint64_t begin = s * stepNs, end = begin + stepNs;
+
+            // referanse: steget delt ved hver hendelse
+            std::uint64_t t = begin;
+            while (refNext < events.size() && events[refNext].timeNs < end) {
+                const InputEvent& e = events[refNext++];
+                if (e.timeNs > t) {
+                    ref.update(static_cast<float>(static_cast<double>(e.timeNs - t) * 1e-9), refIn);
+                    t = e.timeNs;
+                }
+                apply(refIn, e);
+            }
+            ref.update(static_cast<float>(static_cast<double>(end - t) * 1e-9), refIn);
+
+            // frame-sampling: tilstanden ved framens start gjelder for begge stegene i den
+            if (begin % frameNs < stepNs) {
+                const std::uint64_t frameAt = begin / frameNs * frameNs;
+                while (frameNext < events.size() && events[frameNext].timeNs <= frameAt) apply(frameIn, events[frameNext++]);
+                sampled = frameIn;
+            }
+            frame.update(dt, sampled);
+
+            queued.update(dt, queue.integrate(begin, end, end));
+
+            const double fe = distance(frame, ref), qe = distance(queued, ref);
+            frameSum += fe;
+            queueSum += qe;
+            r.frameMaxErr = std::max(r.frameMaxErr, fe);
+            r.queueMaxErr = std::max(r.queueMaxErr, qe);
+            ++samples;
+        }
+    }
+
+    r.frameErr = frameSum / static_cast<double>(samples);
+    r.queueErr = queueSum / static_cast<double>(samples);
+    r.nsPerEvent = queueSecs * 1e9 / static_cast<double>(eventCount);
+    return r;
+}
+
+// skripttråd som skyter inn hendelser i en kjørende SimThread
+struct Threaded {
+    std::uint64_t events = 0;
+    std::uint64_t steps = 0;
+    LatencySummary inputToPhysics;
+    std::uint64_t dropped = 0;
+};
+
+Threaded threaded(float seconds) {
+    Simulation sim(4242);
+    SimThread simThread(sim);
+    simThread.start();
+
+    Threaded r;
+    Rng rng(99);
+    const std::uint64_t stop = Profiler::nowNs() + static_cast<std::uint64_t>(static_cast<double>(seconds) * 1e9);
+    while (Profiler::nowNs() < stop) {
+        // ujevn takt rundt 200 hendelser i sekundet
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int>(rng.uniform(500.f, 9500.f))));
+        const auto control = rng.uniform01() < 0.5f ? InputControl::Throttle : InputControl::Steer;
+        simThread.push({Profiler::nowNs(), control, rng.uniform(-1.f, 1.f)});
+        ++r.events;
+    }
+    // siste hendelser må rekke et steg før målingen leses
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    simThread.stop();
+
+    simThread.poll();
+    const SimFrame& f = simThread.frame();
+    r.steps = f.step;
+    r.inputToPhysics = f.inputToPhysics;
+    r.dropped = f.droppedInputs;
+    return r;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const std::size_t runs = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100;
+    const float seconds = argc > 2 ? static_cast<float>(std::atof(argv[2])) : 30.f;
+    const float threadSeconds = argc > 3 ? static_cast<float>(std::atof(argv[3])) : 3.f;
+
+    std::printf("synthetic streams: %zu runs x %.0f simulated s, 120 Hz physics, 60 Hz frames\n", runs, seconds);
+    Accuracy a = accuracy(runs, seconds);
+    std::printf("%llu presses, %llu (%.1f%%) never seen by frame sampling\n",
+                static_cast<unsigned long long>(a.presses), static_cast<unsigned long long>(a.frameLost),
+                100.0 * static_cast<double>(a.frameLost) / static_cast<double>(a.presses));
+    std::printf("%-8s %16s %16s\n", "path", "mean err m", "max err m");
+    std::printf("%-8s %16.4f %16.4f\n", "frame", a.frameErr, a.frameMaxErr);
+    std::printf("%-8s %16.4f %16.4f\n", "queue", a.queueErr, a.queueMaxErr);
+    std::printf("queue cost: %.1f ns per event (push + integrate of all steps)\n", a.nsPerEvent);
+
+    std::printf("\nthreaded: script thread -> SimThread for %.1f s\n", threadSeconds);
+    Threaded t = threaded(threadSeconds);
+    std::printf("%llu events, %llu steps, %llu dropped\n", static_cast<unsigned long long>(t.events),
+                static_cast<unsigned long long>(t.steps), static_cast<unsigned long long>(t.dropped));
+    std::printf("input-to-physics: p50 %.2f ms  p99 %.2f ms  max %.2f ms  (last %zu samples)\n",
+                t.inputToPhysics.p50Ms, t.inputToPhysics.p99Ms, t.inputToPhysics.maxMs, t.inputToPhysics.samples);
+    return 0;
+}
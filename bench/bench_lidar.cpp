@@ -0,0 +1,133 @@
+// --------------------------------------------------------------------------------------
+// CPU lidar throughput: rays/sec for a 3D scan (beams x elevation channels) from random
+// poses on lots with 30, 1k and 10k cones, BVH packets against testing every primitive,
+// then many cars scanning each other through the per-step dynamic BVH, on one thread
+// and on all of them. Ranges from the BVH are checked against the linear scan.
+// Usage: lidar_bench [scans per case]
+// --------------------------------------------------------------------------------------
+
+#include "logic/Simulation.h"
+#include "sim/Lidar.h"
+#include "util/Rng.h"
+#include "util/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double secondsSince(clock_type::time_point t0) {
+    return std::chrono::duration<double>(clock_type::now() - t0).count();
+}
+
+LidarPose randomPose(const Simulation& sim, Rng& rng) {
+    const ParkingLot& lot = sim.lot();
+    LidarPose pose;
+    pose.pos = lot.center + Vec2{rng.uniform(-0.45f, 0.45f) * lot.width, rng.uniform(-0.45f, 0.45f) * lot.depth};
+    pose.heading = rng.uniform(-3.14159f, 3.14159f);
+    return pose;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const int scans = argc > 1 ? std::atoi(argv[1]) : 200;
+    const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+
+    LidarConfig cfg;
+    cfg.beams = 1024;
+    cfg.channels = 16;
+    Lidar lidar(cfg);
+    const int rays = lidar.raysPerScan();
+    std::vector<float> ranges(rays), reference(rays);
+
+    std::printf("simd: %s, %d beams x %d channels = %d rays per scan\n", RayBvh::simdPath(), cfg.beams,
+                cfg.channels, rays);
+    std::printf("%8s %14s %14s %10s %12s\n", "cones", "bvh rays/s", "linear rays/s", "speedup", "mismatches");
+
+    for (int cones : {30, 1000, 10000}) {
+        Scenario sc;
+        sc.coneCount = cones;
+        Simulation sim(3, sc);
+        lidar.buildStatic(sim);
+        lidar.updateDynamic(sim);
+
+        Rng rng(11);
+        std::vector<LidarPose> poses(scans);
+        for (auto& p : poses) p = randomPose(sim, rng);
+
+        auto t0 = clock_type::now();
+        float sink = 0.f;
+        for (const auto& p : poses) {
+            lidar.scan(p, ranges.data());
+            sink += ranges[0];
+        }
+        const double bvhSecs = secondsSince(t0);
+
+        // lineær referanse på færre skanninger (10k kjegler per stråle tar tid)
+        const int linearScans = std::max(1, cones >= 10000 ? scans / 50 : scans / 5);
+        std::uint64_t mismatches = 0;
+        t0 = clock_type::now();
+        for (int s = 0; s < linearScans; ++s) lidar.scanLinear(poses[s], reference.data());
+        const double linearSecs = secondsSince(t0);
+        for (int s = 0; s < linearScans; ++s) {
+            lidar.scan(poses[s], ranges.data());
+            lidar.scanLinear(poses[s], reference.data());
+            for (int r = 0; r < rays; ++r) mismatches += std::abs(ranges[r] - reference[r]) > 1e-3f ? 1 : 0;
+        }
+
+        const double bvhRate = static_cast<double>(scans) * rays / bvhSecs;
+        const double linearRate = static_cast<double>(linearScans) * rays / linearSecs;
+        std::printf("%8d %14.3e %14.3e %9.1fx %12llu%s\n", cones, bvhRate, linearRate, bvhRate / linearRate,
+                    static_cast<unsigned long long>(mismatches), sink == 12345.f ? " " : "");
+    }
+
+    // mange biler som ser hverandre: dynamisk BVH per steg, parallelt over biler og stråler
+    LidarConfig carCfg;
+    carCfg.beams = 256;
+    carCfg.channels = 4;
+    Lidar carLidar(carCfg);
+    Scenario sc;
+    sc.coneCount = 1000;
+    Simulation sim(3, sc);
+    carLidar.buildStatic(sim);
+
+    std::printf("\n%8s %8s %12s %14s %16s\n", "cars", "threads", "build ms", "rays/s", "rays/s/thread");
+    for (int n : {100, 1000}) {
+        Rng rng(21);
+        std::vector<LidarPose> poses(n);
+        std::vector<Obb> boxes(n);
+        for (int i = 0; i < n; ++i) {
+            poses[i] = randomPose(sim, rng);
+            poses[i].self = Lidar::carTag(static_cast<std::uint32_t>(i));
+            boxes[i] = makeCarObb(poses[i].pos, poses[i].heading, sim.carHalfW(), sim.carHalfD());
+        }
+        std::vector<float> out(static_cast<std::size_t>(n) * carLidar.raysPerScan());
+        std::vector<LidarHit> hits(out.size());
+
+        for (unsigned threads : {1u, hw}) {
+            ThreadPool pool(threads);
+            const int steps = std::max(1, 20000 / n);
+            double buildSecs = 0.0, scanSecs = 0.0;
+            for (int s = 0; s < steps; ++s) {
+                auto t0 = clock_type::now();
+                carLidar.updateDynamic(sim, boxes);
+                auto t1 = clock_type::now();
+                carLidar.scan(poses, out.data(), hits.data(), pool);
+                scanSecs += secondsSince(t1);
+                buildSecs += std::chrono::duration<double>(t1 - t0).count();
+            }
+            const double rate = static_cast<double>(steps) * n * carLidar.raysPerScan() / scanSecs;
+            std::printf("%8d %8u %12.3f %14.3e %16.3e\n", n, threads, buildSecs * 1e3 / steps, rate, rate / threads);
+            if (hw == 1) break;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+// --------------------------------------------------------------------------------------
+// Before/after measurement for the parking lot markings: the old per-spot
+// Group + 3 Mesh visuals vs the single InstancedMesh from addParkingLot.
+// Reports scene-graph size, draw calls and updateMatrixWorld (traversal) cost for a
+// 12x24 and a 100x100 lot. With --gl it also opens a window and times real frames.
+//
+// No results recorded yet: the before/after frame time and traversal numbers have not
+// been measured, since the environment the change was made in had no threepp or
+// display. Only the structural counts are known (from the code): the old path adds
+// 3 line meshes in a group per spot (864 meshes at 12x24), the instanced path one.
+// Run `lot_render_bench` and `lot_render_bench --gl` from a Release build to fill in.
+// --------------------------------------------------------------------------------------
+
+#include <threepp/threepp.hpp>
+
+#include "world/Parking.h"
+#include "world/ParkingVisual.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+using namespace threepp;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// den gamle makeParkingSpotVisual: ny geometri, materiale og 3 meshes per plass
+void addParkingLotPerSpot(Scene& scene, const ParkingLot& lot) {
+    auto asphaltMat = MeshPhongMaterial::create();
+    asphaltMat->color = Color(0x303030);
+    auto asphaltGeo = PlaneGeometry::create(lot.width, lot.depth);
+    asphaltGeo->rotateX(-math::PI / 2);
+    auto asphalt = Mesh::create(asphaltGeo, asphaltMat);
+    asphalt->position.set(lot.center.x, 0.0f, lot.center.z);
+    scene.add(asphalt);
+
+    for (const auto& s : lot.spots) {
+        auto lineMat = MeshBasicMaterial::create();
+        lineMat->color = Color(0xffffff);
+
+        const float h = 0.01f;
+        const float t = 0.05f;
+        const float width = s.halfW * 2.f;
+        const float depth = s.halfD * 2.f;
+
+        auto sideGeo  = BoxGeometry::create(t, h, depth);
+        auto frontGeo = BoxGeometry::create(width, h, t);
+
+        auto group = Group::create();
+
+        auto left = Mesh::create(sideGeo, lineMat);
+        left->position.set(s.center.x - width * 0.5f, h * 0.5f, s.center.z);
+        group->add(left);
+
+        auto right = Mesh::create(sideGeo, lineMat);
+        right->position.set(s.center.x + width * 0.5f, h * 0.5f, s.center.z);
+        group->add(right);
+
+        auto front = Mesh::create(frontGeo, lineMat);
+        front->position.set(s.center.x, h * 0.5f, s.center.z + depth * 0.5f);
+        group->add(front);
+
+        scene.add(group);
+    }
+}
+
+struct SceneStats {
+    int objects = 0;
+    int drawCalls = 0;
+    double buildMs = 0.0;
+    double traverseUs = 0.0;
+};
+
+template <class Build>
+SceneStats measure(const ParkingLot& lot, Build&& build, std::shared_ptr<Scene>& sceneOut) {
+    SceneStats stats;
+
+    auto t0 = clock_type::now();
+    auto scene = Scene::create();
+    build(*scene, lot);
+    stats.buildMs = std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+
+    scene->traverse([&](Object3D& o) {
+        ++stats.objects;
+        if (o.visible && dynamic_cast<Mesh*>(&o)) ++stats.drawCalls;
+    });
+
+    // samme traversering som renderer gjør hver frame
+    const int iterations = 200;
+    t0 = clock_type::now();
+    for (int i = 0; i < iterations; ++i) {
+        scene->updateMatrixWorld(true);
+    }
+    stats.traverseUs = std::chrono::duration<double, std::micro>(clock_type::now() - t0).count() / iterations;
+
+    sceneOut = scene;
+    return stats;
+}
+
+double measureFrameMs(Canvas& canvas, GLRenderer& renderer, Scene& scene, const ParkingLot& lot, int& callsOut) {
+    auto camera = PerspectiveCamera::create(70, canvas.aspect(), 0.1f, 5000);
+    camera->position.set(lot.center.x, lot.width * 0.5f, lot.center.z + lot.depth * 0.6f);
+    camera->lookAt({lot.center.x, 0.f, lot.center.z});
+
+    const int warmup = 30, frames = 300;
+    int frame = 0;
+    clock_type::time_point t0;
+
+    canvas.animate([&] {
+        if (frame == warmup) t0 = clock_type::now();
+        renderer.render(scene, *camera);
+        if (++frame == warmup + frames) canvas.close();
+    });
+
+    callsOut = renderer.info().render.calls;
+    return std::chrono::duration<double, std::milli>(clock_type::now() - t0).count() / frames;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const bool withGl = argc > 1 && std::strcmp(argv[1], "--gl") == 0;
+
+    std::printf("%10s %10s %10s %10s %12s %14s %12s\n",
+                "lot", "variant", "objects", "draws", "build ms", "traverse us", "frame ms");
+
+    for (auto [rows, cols] : {std::pair{12, 24}, std::pair{100, 100}}) {
+        ParkingLot lot;
+        LotLayout layout;
+        layout.rows = rows;
+        layout.cols = cols;
+        generateParkingLot(lot, layout);
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "%dx%d", rows, cols);
+
+        for (int instanced = 0; instanced < 2; ++instanced) {
+            std::shared_ptr<Scene> scene;
+            SceneStats stats = instanced
+                ? measure(lot, [](Scene& s, const ParkingLot& l) { addParkingLot(s, l); }, scene)
+                : measure(lot, [](Scene& s, const ParkingLot& l) { addParkingLotPerSpot(s, l); }, scene);
+
+            double frameMs = 0.0;
+            if (withGl) {
+                Canvas canvas("lot_render_bench");
+                GLRenderer renderer(canvas.size());
+                int calls = 0;
+                frameMs = measureFrameMs(canvas, renderer, *scene, lot, calls);
+                stats.drawCalls = calls;
+            }
+
+            std::printf("%10s %10s %10d %10d %12.2f %14.1f %12.3f\n",
+                        name, instanced ? "instanced" : "per-spot",
+                        stats.objects, stats.drawCalls, stats.buildMs, stats.traverseUs, frameMs);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+// --------------------------------------------------------------------------------------
+// Scenario scripting at scale: many independent parking -> key -> door runs on the
+// default lot, each a kinematic body driven straight to its current objective. The
+// game rules run twice per tick on the same trigger contacts: as per-instance flag
+// polling (how Simulation used to run them) and as parkingScript coroutines in a
+// ScriptRuntime (what Simulation runs now). Reports the cost per instance and tick
+// and checks they agree.
+// Usage: script_bench [instances] [ticks]
+// --------------------------------------------------------------------------------------
+
+#include "logic/Simulation.h"
+#include "sim/ScriptRuntime.h"
+#include "util/Rng.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr int targetCount = 3;
+
+// de samme reglene (verdiene fra ParkingCourse) som flagg som polles hvert steg
+struct Polled {
+    int   completed = 0;
+    float parkedTimer = 0.f;
+    float doorHeight = 0.f;
+    bool  keyAvailable = false;
+    bool  keyCollected = false;
+    bool  doorOpened = false;
+    bool  won = false;
+};
+
+void poll(Polled& p, const TriggerContacts& c, float speed, const std::array<int, targetCount>& targets,
+          const ParkingCourse& rules, float dt) {
+    if (p.won) return;
+    if (p.completed < targetCount) {
+        if (c.contains(static_cast<std::uint32_t>(targets[p.completed])) && std::abs(speed) < rules.maxSpeed) {
+            p.parkedTimer += dt;
+            if (p.parkedTimer >= rules.parkTime) {
+                ++p.completed;
+                p.parkedTimer = 0.f;
+            }
+        } else {
+            p.parkedTimer = 0.f;
+        }
+    }
+    if (!p.keyAvailable && p.completed >= targetCount) p.keyAvailable = true;
+    if (p.keyAvailable && !p.keyCollected && c.contains(rules.keyTrigger)) {
+        p.keyCollected = true;
+        p.doorHeight = rules.doorFrom;
+    }
+    if (p.keyCollected && !p.doorOpened) {
+        p.doorHeight += rules.doorRate * dt;
+        if (p.doorHeight >= rules.doorTo) p.doorOpened = true;
+    }
+    if (p.doorOpened && c.contains(rules.doorTrigger)) p.won = true;
+}
+
+}
+
+int main(int argc, char** argv) {
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    const int ticks = argc > 2 ? std::atoi(argv[2]) : 120 * 90;
+    const float dt = 1.f / 120.f;
+    const float driveSpeed = 6.f;
+
+    Simulation sim(1);
+    const TriggerRegistry& reg = sim.triggers();
+    const ParkingLot& lot = sim.lot();
+    const Vec2 doorZone = sim.doorPos() + Vec2{0.f, 2.5f};
+
+    Rng rng(5);
+    std::vector<std::array<int, targetCount>> targets(n);
+    std::vector<Vec2> pos(n);
+    std::vector<float> speeds(n, 0.f);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (int& t : targets[i]) t = static_cast<int>(rng.below(static_cast<std::uint32_t>(lot.spots.size())));
+        pos[i] = lot.center + Vec2{rng.uniform(-0.45f, 0.45f) * lot.width, rng.uniform(-0.45f, 0.45f) * lot.depth};
+    }
+
+    std::vector<Polled> polled(n);
+    std::vector<ParkingProgress> progress(n);
+    std::vector<ParkingCourse> courses(n);
+    ScriptRuntime rt;
+    rt.reserveBodies(n);
+    const ParkingCourse& rules = sim.course();
+    for (std::size_t i = 0; i < n; ++i) {
+        courses[i] = rules;
+        courses[i].targets = targets[i];
+        rt.spawn(parkingScript(rt, static_cast<std::uint32_t>(i), courses[i], progress[i]));
+    }
+
+    std::vector<Obb> boxes(n);
+    std::vector<TriggerContacts> contacts(n);
+    std::vector<TriggerEvent> events;
+    events.reserve(n * 2);
+
+    double triggerSecs = 0.0, pollSecs = 0.0, scriptSecs = 0.0;
+    std::uint64_t mismatches = 0, eventCount = 0;
+    const std::uint64_t spawnResumes = rt.resumes();
+    int allWonAt = -1;
+
+    for (int t = 0; t < ticks && allWonAt < 0; ++t) {
+        // kjør rett mot neste mål og stå stille der
+        for (std::size_t i = 0; i < n; ++i) {
+            const Polled& p = polled[i];
+            Vec2 goal = p.completed < targetCount ? lot.spots[targets[i][p.completed]].center
+                      : !p.keyCollected ? sim.keyPos() : doorZone;
+            const Vec2 d = goal - pos[i];
+            const float len = length(d);
+            if (len <= driveSpeed * dt) {
+                pos[i] = goal;
+                speeds[i] = 0.f;
+            } else {
+                pos[i] = pos[i] + d * (driveSpeed * dt / len);
+                speeds[i] = driveSpeed;
+            }
+            boxes[i] = makeCarObb(pos[i], 0.f, sim.carHalfW(), sim.carHalfD());
+        }
+
+        events.clear();
+        auto t0 = clock_type::now();
+        reg.update(0, boxes, contacts, events);
+        auto t1 = clock_type::now();
+        for (std::size_t i = 0; i < n; ++i) poll(polled[i], contacts[i], speeds[i], targets[i], rules, dt);
+        auto t2 = clock_type::now();
+        rt.step(dt, events, speeds.data());
+        auto t3 = clock_type::now();
+
+        triggerSecs += std::chrono::duration<double>(t1 - t0).count();
+        pollSecs += std::chrono::duration<double>(t2 - t1).count();
+        scriptSecs += std::chrono::duration<double>(t3 - t2).count();
+        eventCount += events.size();
+
+        std::size_t won = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const Polled& p = polled[i];
+            const ParkingProgress& s = progress[i];
+            if (p.completed != s.completedTargets(courses[i]) || p.keyCollected != s.keyCollected(courses[i])) {
+                ++mismatches;
+            }
+            if (s.won(courses[i])) ++won;
+        }
+        if (won == n) allWonAt = t;
+    }
+
+    const int ran = allWonAt >= 0 ? allWonAt + 1 : ticks;
+    const double updates = static_cast<double>(n) * ran;
+    std::size_t polledWon = 0;
+    for (const auto& p : polled) polledWon += p.won ? 1 : 0;
+
+    std::printf("%zu instances, %d ticks (%.1f s), all won: %s\n", n, ran, ran * dt, allWonAt >= 0 ? "yes" : "no");
+    std::printf("%-20s %12s %12s\n", "stage", "ns/instance", "ms/tick");
+    std::printf("%-20s %12.2f %12.4f\n", "trigger update", triggerSecs * 1e9 / updates, triggerSecs * 1e3 / ran);
+    std::printf("%-20s %12.2f %12.4f\n", "flag polling", pollSecs * 1e9 / updates, pollSecs * 1e3 / ran);
+    std::printf("%-20s %12.2f %12.4f\n", "coroutine scripts", scriptSecs * 1e9 / updates, scriptSecs * 1e3 / ran);
+    std::printf("resumes per tick %.2f, trigger events per tick %.1f\n",
+                static_cast<double>(rt.resumes() - spawnResumes) / ran, static_cast<double>(eventCount) / ran);
+    std::printf("won: polling %zu, scripts %zu; progress mismatches: %llu\n", polledWon, n - rt.live(),
+                static_cast<unsigned long long>(mismatches));
+    return 0;
+}
@@ -0,0 +1,148 @@
+// --------------------------------------------------------------------------------------
+// Trigger volumes at fleet scale: a CarFleet drives around the default lot with every
+// spot, the key, the door and the four walls registered as triggers, and each tick
+// updates every car's contacts. Compares testing every volume per car against the
+// grid lookup (one thread and all threads) and checks that they agree.
+// Usage: trigger_bench [cars] [ticks]
+// --------------------------------------------------------------------------------------
+
+#include "logic/Simulation.h"
+#include "sim/CarFleet.h"
+#include "util/Rng.h"
+#include "util/ThreadPool.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t grain = 1024;
+
+struct Timing {
+    double secs = 0.0;
+    std::uint64_t contacts = 0;
+    std::uint64_t events[3] = {}; // enter, stay, exit
+};
+
+}
+
+int main(int argc, char** argv) {
+    const std::size_t cars = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    const int ticks = argc > 2 ? std::atoi(argv[2]) : 600;
+    const float dt = 1.f / 120.f;
+
+    // standardplassen: 12 x 24 plasser
+    Simulation sim(1);
+    const TriggerRegistry& reg = sim.triggers();
+    const ParkingLot& lot = sim.lot();
+    const float halfW = sim.carHalfW(), halfD = sim.carHalfD();
+
+    // halvparten står parkert på en plass, resten kjører rundt i sakte fart
+    Rng rng(77);
+    CarFleet fleet;
+    fleet.reserve(cars);
+    std::vector<CarInput> inputs(cars);
+    for (std::size_t i = 0; i < cars; ++i) {
+        const auto& spot = lot.spots[rng.below(static_cast<std::uint32_t>(lot.spots.size()))];
+        const bool parked = i % 2 == 0;
+        fleet.add({}, spot.center + Vec2{rng.uniform(-0.3f, 0.3f), rng.uniform(-0.6f, 0.6f)},
+                  parked ? 0.f : rng.uniform(-3.14f, 3.14f));
+        if (!parked) {
+            inputs[i].throttle = rng.uniform(0.3f, 0.6f);
+            inputs[i].steer = rng.uniform(-1.f, 1.f);
+        }
+    }
+
+    ThreadPool pool;
+    std::vector<Obb> boxes(cars);
+    std::vector<TriggerContacts> brute(cars), single(cars), parallel(cars);
+    std::vector<TriggerEvent> events;
+    events.reserve(cars * 4);
+    std::vector<std::vector<TriggerEvent>> chunkEvents((cars + grain - 1) / grain);
+    for (auto& e : chunkEvents) e.reserve(grain * 4);
+
+    Timing bt, st, pt;
+    std::uint64_t mismatches = 0, candidates = 0;
+
+    const Vec2 lo = lot.center - Vec2{lot.width * 0.5f, lot.depth * 0.5f};
+    const Vec2 hi = lot.center + Vec2{lot.width * 0.5f, lot.depth * 0.5f};
+
+    for (int t = 0; t < ticks; ++t) {
+        fleet.update(dt, inputs);
+        for (std::size_t i = 0; i < cars; ++i) {
+            // biler som kjører ut av plassen settes inn igjen et tilfeldig sted
+            const Vec2 p = fleet.position(i);
+            if (p.x < lo.x || p.x > hi.x || p.z < lo.z || p.z > hi.z) {
+                fleet.hardReset(i, {rng.uniform(lo.x, hi.x), rng.uniform(lo.z, hi.z)}, rng.uniform(-3.14f, 3.14f));
+            }
+            boxes[i] = makeCarObb(fleet.position(i), fleet.heading(i), halfW, halfD);
+        }
+
+        // alle volumer for hver bil
+        auto t0 = clock_type::now();
+        for (std::size_t i = 0; i < cars; ++i) {
+            TriggerContacts& c = brute[i];
+            c.clear();
+            for (std::uint32_t id = 0; id < reg.size(); ++id) {
+                if (c.count < TriggerContacts::capacity && reg.touches(id, boxes[i])) c.ids[c.count++] = id;
+            }
+        }
+        bt.secs += std::chrono::duration<double>(clock_type::now() - t0).count();
+
+        // rutenettet, én tråd
+        events.clear();
+        t0 = clock_type::now();
+        reg.update(0, boxes, single, events);
+        st.secs += std::chrono::duration<double>(clock_type::now() - t0).count();
+        for (const auto& e : events) ++st.events[static_cast<int>(e.phase)];
+
+        // rutenettet, alle tråder: hver bit har sine biler og sin hendelsesliste
+        t0 = clock_type::now();
+        pool.parallelFor(cars, grain, [&](std::size_t begin, std::size_t end) {
+            auto& out = chunkEvents[begin / grain];
+            out.clear();
+            reg.update(static_cast<std::uint32_t>(begin), std::span(boxes).subspan(begin, end - begin),
+                       std::span(parallel).subspan(begin, end - begin), out);
+        });
+        pt.secs += std::chrono::duration<double>(clock_type::now() - t0).count();
+        for (const auto& out : chunkEvents)
+            for (const auto& e : out) ++pt.events[static_cast<int>(e.phase)];
+
+        for (std::size_t i = 0; i < cars; ++i) {
+            bt.contacts += brute[i].count;
+            st.contacts += single[i].count;
+            pt.contacts += parallel[i].count;
+            candidates += reg.candidates(boxes[i].center).size();
+            bool same = brute[i].count == single[i].count && single[i].count == parallel[i].count;
+            for (int k = 0; same && k < single[i].count; ++k) {
+                same = brute[i].ids[k] == single[i].ids[k] && single[i].ids[k] == parallel[i].ids[k];
+            }
+            if (!same) ++mismatches;
+        }
+    }
+
+    const double updates = static_cast<double>(cars) * ticks;
+    std::printf("%zu cars x %d ticks, %zu triggers (%zu spots), grid %dx%d, %.1f candidates per car\n",
+                cars, ticks, reg.size(), lot.spots.size(), reg.cols(), reg.rows(),
+                static_cast<double>(candidates) / updates);
+    std::printf("%-16s %12s %14s %12s\n", "path", "ns/car", "ms/tick", "contacts");
+    auto row = [&](const char* name, const Timing& r) {
+        std::printf("%-16s %12.1f %14.3f %12.2f\n", name, r.secs * 1e9 / updates, r.secs * 1e3 / ticks,
+                    static_cast<double>(r.contacts) / ticks);
+    };
+    row("all volumes", bt);
+    row("grid", st);
+    char name[32];
+    std::snprintf(name, sizeof(name), "grid, %u thr", pool.size());
+    row(name, pt);
+    std::printf("events per tick: enter %.1f  stay %.1f  exit %.1f\n", static_cast<double>(st.events[0]) / ticks,
+                static_cast<double>(st.events[1]) / ticks, static_cast<double>(st.events[2]) / ticks);
+    std::printf("speedup grid vs all volumes: %.1fx; contact mismatches: %llu\n", bt.secs / st.secs,
+                static_cast<unsigned long long>(mismatches));
+    return 0;
+}
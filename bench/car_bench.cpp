@@ -0,0 +1,333 @@
+// --------------------------------------------------------------------------------------
+// car_bench: microbenchmarks for the headless core (car physics, parking checks,
+// target sequences, lot generation, cone scattering and a full Simulation::step).
+// Output is JSON with ns/op, allocations/op and percentiles; see bench/harness.
+// --------------------------------------------------------------------------------------
+
+#include "BenchHarness.h"
+
+#include "logic/Simulation.h"
+#include "models/Car.h"
+#include "sim/Scenario.h"
+#include "sim/car_gym.h"
+#include "sim/Lidar.h"
+#include "sim/SeekPolicy.h"
+#include "util/EventLog.h"
+#include "util/Profiler.h"
+#include "world/LotChunks.h"
+#include "world/Parking.h"
+#include "world/TrafficCones.h"
+#include "world/WorldCache.h"
+
+#include <cstdio>
+#include <string>
+#include <tuple>
+#include <vector>
+
+BENCH_CASE("car") {
+    const float dt = 1.f / 120.f;
+
+    Car car;
+    CarInput in{1.f, 0.5f, false};
+    int tick = 0;
+    bench.measure("car/update", [&] {
+        // snu gass og styring av og til så bilen ikke bare står i maks fart
+        if ((++tick & 255) == 0) {
+            in.throttle = -in.throttle;
+            in.steer = -in.steer;
+        }
+        car.update(dt, in);
+        doNotOptimize(car.position());
+    });
+}
+
+BENCH_CASE("parking") {
+    ParkingLot lot;
+    generateParkingLot(lot);
+
+    std::vector<Vec2> probes;
+    Rng rng(7);
+    for (int i = 0; i < 1024; ++i) {
+        probes.push_back({lot.center.x + rng.uniform(-lot.width * 0.5f, lot.width * 0.5f),
+                          lot.center.z + rng.uniform(-lot.depth * 0.5f, lot.depth * 0.5f)});
+    }
+
+    std::size_t i = 0;
+    bench.measure("parking/isCarInsideSpot", [&] {
+        const auto& spot = lot.spots[i % lot.spots.size()];
+        bool inside = isCarInsideSpot(spot, probes[i & 1023], 0.9f, 1.9f);
+        doNotOptimize(inside);
+        ++i;
+    });
+
+    for (int total : {288, 10000, 1000000}) {
+        Rng seqRng(11);
+        bench.measure("parking/makeRandomTargetSequence/" + std::to_string(total), [&] {
+            auto seq = makeRandomTargetSequence(total, 3, seqRng);
+            doNotOptimize(seq.data());
+        });
+
+        std::vector<int> seq;
+        bench.measure("parking/makeRandomTargetSequence_into/" + std::to_string(total), [&] {
+            makeRandomTargetSequence(total, 3, seqRng, seq);
+            doNotOptimize(seq.data());
+        });
+    }
+}
+
+BENCH_CASE("world") {
+    struct Size { const char* name; LotLayout layout; };
+    const Size sizes[] = {
+        {"small",  {4, 8}},
+        {"default", {}},
+        {"large",  {48, 96}},
+        {"huge",   {200, 200}},
+    };
+
+    for (const auto& s : sizes) {
+        ParkingLot lot;
+        bench.measure(std::string("world/generateParkingLot/") + s.name, [&] {
+            generateParkingLot(lot, s.layout);
+            doNotOptimize(lot.spots.data());
+        });
+    }
+
+    ParkingLot lot;
+    generateParkingLot(lot);
+    for (int count : {30, 1000, 100000}) {
+        Rng rng(3);
+        std::vector<Vec2> cones;
+        bench.measure("world/scatterTrafficCones/" + std::to_string(count), [&] {
+            scatterTrafficCones(lot.center, lot.width, lot.depth, count, cones, rng);
+            doNotOptimize(cones.data());
+        });
+    }
+}
+
+BENCH_CASE("streaming") {
+    // strømmebeslutningen per frame mens bilen kjører over en stor plass
+    for (auto [name, rows, cols] : {std::tuple{"default", 12, 24}, std::tuple{"city", 300, 400}}) {
+        ParkingLot lot;
+        LotLayout layout;
+        layout.rows = rows;
+        layout.cols = cols;
+        generateParkingLot(lot, layout);
+
+        LotChunks chunks;
+        chunks.configure(lot, 32.f);
+        ChunkStreamer streamer;
+        streamer.reset(chunks);
+
+        Vec2 a{lot.center.x - lot.width * 0.5f, lot.center.z - lot.depth * 0.5f};
+        Vec2 dir = Vec2{lot.width, lot.depth} * (1.f / 20000.f);
+        int frame = 0;
+        bench.measure(std::string("streaming/chunk_streamer_update/") + name, [&] {
+            streamer.update(chunks, a + dir * static_cast<float>(frame));
+            frame = (frame + 1) % 20000;
+            doNotOptimize(streamer.resident().size());
+        });
+
+        bench.measure(std::string("streaming/lot_chunks_configure/") + name, [&] {
+            chunks.configure(lot, 32.f);
+            doNotOptimize(chunks.count());
+        });
+    }
+}
+
+BENCH_CASE("startup") {
+    // oppstart av verdenen: generert vs mappet fra bakt cache (samme innhold); på en
+    // stor plass dominerer triggerrutenettet og kopieringen av plassene
+    const std::uint64_t seed = 42;
+    const float chunkSize = 32.f;
+
+    for (auto [name, rows, cols] : {std::tuple{"default", 12, 24}, std::tuple{"300x300", 300, 300}}) {
+        Scenario scenario;
+        scenario.layout.rows = rows;
+        scenario.layout.cols = cols;
+
+        bench.measure(std::string("startup/world_generate/") + name, [&] {
+            Simulation sim(seed, scenario);
+            LotChunks chunks;
+            chunks.configure(sim.lot(), chunkSize);
+            doNotOptimize(chunks.count());
+        });
+
+        const std::string path = "car_bench_world.bswc";
+        Simulation baked(seed, scenario);
+        if (!bakeWorld(path, baked, chunkSize)) return;
+
+        WorldKey key;
+        key.layout = baked.lot().layout;
+        key.seed = seed;
+        key.coneCount = baked.coneCount();
+        key.requiredTargets = baked.requiredTargets();
+        key.chunkSize = chunkSize;
+
+        bench.measure(std::string("startup/world_from_cache/") + name, [&] {
+            WorldCache cache;
+            if (!cache.open(path, key)) return;
+            Simulation sim(cache.world(), scenario);
+            LotChunks chunks;
+            chunks.configure(sim.lot(), chunkSize, cache.world().chunkStart, cache.world().chunkSpots);
+            doNotOptimize(chunks.count());
+        });
+        std::remove(path.c_str());
+    }
+}
+
+BENCH_CASE("scenario") {
+    // parsing av en full scenariofil mot verdensgenereringen den styrer
+    const char* text =
+        "# sweep-scenario\n"
+        "name = sweep_a\n"
+        "lot.rows = 12\nlot.cols = 24\nlot.slotW = 2.6\nlot.slotD = 5.2\n"
+        "lot.laneWidth = 3.0\nlot.margin = 1.0\n"
+        "rules.requiredTargets = 3\nrules.parkTime = 1.5\ncones.count = 30\n"
+        "car.maxSpeed = 20\ncar.accel = 10\ncar.brake = 20\ncar.steerRate = 1.3\ncar.friction = 3.0\n";
+
+    Scenario scenario;
+    bench.measure("scenario/parse", [&] {
+        doNotOptimize(parseScenario(text, scenario));
+    });
+
+    bench.measure("scenario/simulation_from_scenario", [&] {
+        Simulation sim(42, scenario);
+        doNotOptimize(sim.lot().spots.size());
+    });
+}
+
+BENCH_CASE("simulation") {
+    const float dt = 1.f / 120.f;
+
+    // det Game::update gjør per fast steg, uten visning: policy + Simulation::step
+    Simulation sim(42);
+    int steps = 0;
+    bench.measure("simulation/step", [&] {
+        sim.step(dt, seekPolicy(sim));
+        sim.clearEvents();
+        if (++steps == 120 * 60) { // ett minutt per episode
+            sim.reset();
+            steps = 0;
+        }
+    });
+
+    Simulation resetSim(42);
+    bench.measure("simulation/reset", [&] {
+        resetSim.reset();
+        doNotOptimize(resetSim.car().position());
+    });
+}
+
+BENCH_CASE("lidar") {
+    // én plan skanning og en 3D-skanning fra midten av standardplassen
+    Simulation sim(42);
+    for (int channels : {1, 16}) {
+        LidarConfig cfg;
+        cfg.beams = 360;
+        cfg.channels = channels;
+        Lidar lidar(cfg);
+        lidar.buildStatic(sim);
+        lidar.updateDynamic(sim);
+        std::vector<float> ranges(lidar.raysPerScan());
+        LidarPose pose{sim.lot().center, 0.3f};
+        bench.measure("lidar/scan/360x" + std::to_string(channels), [&] {
+            lidar.scan(pose, ranges.data());
+            doNotOptimize(ranges[0]);
+        });
+    }
+
+    // dynamisk BVH for døra og 1000 biler, bygget på nytt
+    Lidar lidar;
+    std::vector<Obb> cars(1000);
+    for (std::size_t i = 0; i < cars.size(); ++i) {
+        const Vec2 p = sim.lot().center +
+                       Vec2{static_cast<float>(i % 40) * 1.5f - 30.f, static_cast<float>(i / 40) * 3.f - 37.f};
+        cars[i] = makeCarObb(p, 0.1f * static_cast<float>(i), sim.carHalfW(), sim.carHalfD());
+    }
+    lidar.updateDynamic(sim, cars);
+    bench.measure("lidar/dynamic/1000", [&] {
+        lidar.updateDynamic(sim, cars);
+        doNotOptimize(lidar.dynamicBvh().size());
+    });
+}
+
+BENCH_CASE("gym") {
+    // ett batch-steg gjennom C-API-et; allocs/op skal være 0, også med trådpoolen
+    struct GymCase { uint32_t n, threads; };
+    for (GymCase gc : {GymCase{1, 1}, GymCase{64, 1}, GymCase{64, 2}}) {
+        const uint32_t n = gc.n;
+        car_gym_config cfg;
+        car_gym_default_config(&cfg);
+        cfg.episodes = n;
+        cfg.threads = gc.threads;
+        car_gym* gym = car_gym_create(&cfg);
+        std::vector<float> obs(n * CAR_GYM_OBS_SIZE), actions(n * CAR_GYM_ACTION_SIZE, 0.f), rewards(n);
+        std::vector<uint8_t> dones(n);
+        for (uint32_t i = 0; i < n; ++i) actions[i * CAR_GYM_ACTION_SIZE] = 1.f;
+        car_gym_reset(gym, obs.data());
+        bench.measure("gym/step/" + std::to_string(n) + "/" + std::to_string(gc.threads) + "t", [&] {
+            car_gym_step(gym, actions.data(), obs.data(), rewards.data(), dones.data(), nullptr);
+            doNotOptimize(obs[0]);
+        });
+        car_gym_destroy(gym);
+    }
+}
+
+BENCH_CASE("savestate") {
+    const float dt = 1.f / 120.f;
+    Simulation sim(42);
+    for (int i = 0; i < 3000; ++i) sim.step(dt, seekPolicy(sim));
+
+    SimSnapshot snap;
+    sim.snapshot(snap);
+    bench.measure("savestate/snapshot", [&] {
+        sim.snapshot(snap);
+        doNotOptimize(snap.episode);
+    });
+
+    bench.measure("savestate/restore", [&] {
+        sim.restore(snap);
+        doNotOptimize(sim.car().position());
+    });
+
+    // det en planlegger gjør per gren: tilbake til roten og ett steg
+    bench.measure("savestate/clone_and_step", [&] {
+        sim.restore(snap);
+        sim.step(dt, seekPolicy(sim));
+        doNotOptimize(sim.car().position());
+    });
+
+    // gammel vei til en ny gren: reset bygger kjegler og målsekvens på nytt
+    bench.measure("savestate/reset_baseline", [&] {
+        sim.reset();
+        doNotOptimize(sim.car().position());
+    });
+}
+
+BENCH_CASE("profiler") {
+    // kostnaden til ett PROFILE_SCOPE, av og på
+    Profiler::setEnabled(false);
+    bench.measure("profiler/scope_disabled", [] { PROFILE_SCOPE(Cones); });
+
+    Profiler::setEnabled(true);
+    bench.measure("profiler/scope_enabled", [] { PROFILE_SCOPE(Cones); });
+    Profiler::setEnabled(false);
+    Profiler::clear();
+}
+
+BENCH_CASE("log") {
+    // det update() betaler per HUD-post; formatering og skriving skjer på drain-tråden
+    std::FILE* sink = std::tmpfile();
+    if (!sink) return;
+    {
+        EventLog log(sink, 1u << 16);
+        bench.measure("log/write_hud", [&] {
+            log.write(LogKind::Hud, 12.5, 1, 3, -1.0, 1.5);
+        });
+    }
+    std::fclose(sink);
+}
+
+int main(int argc, char** argv) {
+    return runBenchMain(argc, argv, "car_bench");
+}
@@ -0,0 +1,75 @@
+// --------------------------------------------------------------------------------------
+// car_bench scene cases: building the threepp scene for a lot and its cones.
+// Only compiled when CAR_BENCH_SCENE is on; no GL context is needed.
+// --------------------------------------------------------------------------------------
+
+#include "BenchHarness.h"
+
+#include "world/ChunkedLotVisual.h"
+#include "world/ParkingVisual.h"
+#include "world/TrafficCones.h"
+#include "world/TrafficConesVisual.h"
+
+#include <threepp/threepp.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace threepp;
+
+BENCH_CASE("scene") {
+    struct Size { const char* name; LotLayout layout; };
+    const Size sizes[] = {
+        {"small",  {4, 8}},
+        {"default", {}},
+        {"large",  {48, 96}},
+    };
+
+    for (const auto& s : sizes) {
+        ParkingLot lot;
+        generateParkingLot(lot, s.layout);
+        bench.measure(std::string("scene/addParkingLot/") + s.name, [&] {
+            Scene scene;
+            addParkingLot(scene, lot);
+            doNotOptimize(scene.children.size());
+        });
+    }
+
+    // strømmet plass: én frame = update med flyttet fokus (inkluderer chunk-bygging)
+    for (const auto& s : {sizes[1], Size{"city", {300, 400}}}) {
+        ParkingLot lot;
+        generateParkingLot(lot, s.layout);
+        Rng rng(5);
+        std::vector<Vec2> cones;
+        scatterTrafficCones(lot.center, lot.width, lot.depth, static_cast<int>(lot.spots.size() / 10), cones, rng);
+
+        Scene scene;
+        ChunkedLotVisual visual(scene, lot);
+        visual.setCones(std::make_shared<const std::vector<Vec2>>(cones));
+        Vec2 a{lot.center.x - lot.width * 0.5f, lot.center.z - lot.depth * 0.5f};
+        visual.prime(a);
+
+        Vec2 dir = Vec2{lot.width, lot.depth} * (1.f / 20000.f);
+        Frustum frustum;
+        int frame = 0;
+        bench.measure(std::string("scene/chunked_lot_frame/") + s.name, [&] {
+            visual.update(a + dir * static_cast<float>(frame), frustum);
+            frame = (frame + 1) % 20000;
+            doNotOptimize(visual.residentChunks());
+        });
+    }
+
+    ParkingLot lot;
+    generateParkingLot(lot);
+    for (int count : {30, 300, 3000}) {
+        Rng rng(3);
+        std::vector<Vec2> cones;
+        scatterTrafficCones(lot.center, lot.width, lot.depth, count, cones, rng);
+        bench.measure("scene/addTrafficCones/" + std::to_string(count), [&] {
+            Scene scene;
+            std::vector<std::shared_ptr<Mesh>> meshes;
+            addTrafficCones(scene, cones, meshes);
+            doNotOptimize(meshes.data());
+        });
+    }
+}
@@ -0,0 +1,224 @@
+// --------------------------------------------------------------------------------------
+// car_bench harness: batch timing with percentiles, allocation counting through
+// replaced global operator new/delete, and JSON output for regression tracking.
+// --------------------------------------------------------------------------------------
+
+#include "BenchHarness.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+// ---------------- allokeringstelling ----------------
+
+namespace {
+    std::atomic<std::uint64_t> allocCount{0};
+    std::atomic<std::uint64_t> allocBytes{0};
+
+    void* countedAlloc(std::size_t size) {
+        allocCount.fetch_add(1, std::memory_order_relaxed);
+        allocBytes.fetch_add(size, std::memory_order_relaxed);
+        if (void* p = std::malloc(size ? size : 1)) return p;
+        throw std::bad_alloc();
+    }
+
+    void* countedAlignedAlloc(std::size_t size, std::align_val_t al) {
+        allocCount.fetch_add(1, std::memory_order_relaxed);
+        allocBytes.fetch_add(size, std::memory_order_relaxed);
+        auto align = static_cast<std::size_t>(al);
+#ifdef _MSC_VER
+        if (void* p = _aligned_malloc(size ? size : 1, align)) return p;
+#else
+        std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+        if (void* p = std::aligned_alloc(align, rounded)) return p;
+#endif
+        throw std::bad_alloc();
+    }
+
+    void alignedFree(void* p) {
+#ifdef _MSC_VER
+        _aligned_free(p);
+#else
+        std::free(p);
+#endif
+    }
+}
+
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+void* operator new(std::size_t size, std::align_val_t al) { return countedAlignedAlloc(size, al); }
+void* operator new[](std::size_t size, std::align_val_t al) { return countedAlignedAlloc(size, al); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { alignedFree(p); }
+
+// ---------------- måling ----------------
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    double idx = q * static_cast<double>(sorted.size() - 1);
+    auto lo = static_cast<std::size_t>(idx);
+    std::size_t hi = std::min(lo + 1, sorted.size() - 1);
+    double f = idx - static_cast<double>(lo);
+    return sorted[lo] * (1.0 - f) + sorted[hi] * f;
+}
+
+}
+
+void Bench::measure(const std::string& name, const std::function<void()>& op) {
+    if (!filter.empty() && name.find(filter) == std::string::npos) return;
+
+    // oppvarming og estimat av tid per op
+    std::uint64_t warmOps = 0;
+    auto t0 = clock_type::now();
+    double elapsed = 0.0;
+    do {
+        op();
+        ++warmOps;
+        elapsed = std::chrono::duration<double, std::nano>(clock_type::now() - t0).count();
+    } while (elapsed < minTimeMs * 1e6 * 0.1 && warmOps < 1000000);
+    double estimate = elapsed / static_cast<double>(warmOps);
+
+    // batch-størrelse slik at targetSamples batcher fyller minTimeMs
+    double batchNs = minTimeMs * 1e6 / targetSamples;
+    auto batch = static_cast<std::uint64_t>(std::max(1.0, batchNs / std::max(estimate, 1.0)));
+
+    std::vector<double> samples;
+    samples.reserve(static_cast<std::size_t>(targetSamples) * 20 + 1);
+
+    std::uint64_t allocs0 = allocCount.load(std::memory_order_relaxed);
+    std::uint64_t bytes0 = allocBytes.load(std::memory_order_relaxed);
+    std::uint64_t ops = 0;
+    double total = 0.0;
+
+    auto start = clock_type::now();
+    while (static_cast<int>(samples.size()) < targetSamples ||
+           std::chrono::duration<double, std::milli>(clock_type::now() - start).count() < minTimeMs) {
+        auto b0 = clock_type::now();
+        for (std::uint64_t i = 0; i < batch; ++i) op();
+        double ns = std::chrono::duration<double, std::nano>(clock_type::now() - b0).count();
+
+        samples.push_back(ns / static_cast<double>(batch));
+        total += ns;
+        ops += batch;
+        if (static_cast<int>(samples.size()) >= targetSamples * 20) break;
+    }
+
+    std::uint64_t allocs = allocCount.load(std::memory_order_relaxed) - allocs0;
+    std::uint64_t bytes = allocBytes.load(std::memory_order_relaxed) - bytes0;
+
+    BenchResult r;
+    r.name = name;
+    r.ops = ops;
+    r.batchOps = batch;
+    r.nsPerOp = total / static_cast<double>(ops);
+    r.allocsPerOp = static_cast<double>(allocs) / static_cast<double>(ops);
+    r.bytesPerOp = static_cast<double>(bytes) / static_cast<double>(ops);
+
+    std::sort(samples.begin(), samples.end());
+    r.batchP50 = percentile(samples, 0.50);
+    r.batchP90 = percentile(samples, 0.90);
+    r.batchP99 = percentile(samples, 0.99);
+    r.batchMin = samples.front();
+    r.batchMax = samples.back();
+
+    std::fprintf(stderr, "%-48s %12.1f ns/op  batch p50 %10.1f  batch p99 %10.1f  allocs/op %8.2f\n",
+                 r.name.c_str(), r.nsPerOp, r.batchP50, r.batchP99, r.allocsPerOp);
+    results_.push_back(std::move(r));
+}
+
+// ---------------- registrering og main ----------------
+
+namespace {
+
+struct RegisteredCase {
+    const char* group;
+    BenchCaseFn fn;
+};
+
+std::vector<RegisteredCase>& registry() {
+    static std::vector<RegisteredCase> cases;
+    return cases;
+}
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+}
+
+void registerBenchCase(const char* group, BenchCaseFn fn) {
+    registry().push_back({group, fn});
+}
+
+int runBenchMain(int argc, char** argv, const char* suite) {
+    Bench bench;
+    std::string jsonPath = "-";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) bench.filter = argv[++i];
+        else if (arg == "--json" && i + 1 < argc) jsonPath = argv[++i];
+        else if (arg == "--min-time" && i + 1 < argc) bench.minTimeMs = std::atof(argv[++i]);
+        else {
+            std::fprintf(stderr, "usage: %s [--filter text] [--json file|-] [--min-time ms]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    for (const auto& c : registry()) {
+        c.fn(bench);
+    }
+
+    std::ostringstream json;
+    json << "{\n  \"suite\": \"" << suite << "\",\n  \"results\": [\n";
+    const auto& results = bench.results();
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        json << "    {\"name\": \"" << jsonEscape(r.name) << "\""
+             << ", \"ops\": " << r.ops
+             << ", \"ns_per_op\": " << r.nsPerOp
+             << ", \"batch_ops\": " << r.batchOps
+             << ", \"batch_p50_ns\": " << r.batchP50
+             << ", \"batch_p90_ns\": " << r.batchP90
+             << ", \"batch_p99_ns\": " << r.batchP99
+             << ", \"batch_min_ns\": " << r.batchMin
+             << ", \"batch_max_ns\": " << r.batchMax
+             << ", \"allocs_per_op\": " << r.allocsPerOp
+             << ", \"bytes_per_op\": " << r.bytesPerOp << "}"
+             << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    json << "  ]\n}\n";
+
+    if (jsonPath == "-") {
+        std::cout << json.str();
+    } else {
+        std::ofstream out(jsonPath);
+        if (!out) {
+            std::fprintf(stderr, "could not write %s\n", jsonPath.c_str());
+            return 1;
+        }
+        out << json.str();
+    }
+    return 0;
+}
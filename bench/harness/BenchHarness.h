@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Liten mikrobenchmark-harness for car_bench.
+// Hver måling kjøres i batcher; persentilene er over snittet ns/op per batch
+// (ikke enkelt-op-tider, som er for korte til å klokke), og globale
+// operator new/delete er hektet så allokeringer per op kan telles.
+
+struct BenchResult {
+    std::string name;
+    std::uint64_t ops = 0;
+    double nsPerOp = 0.0;   // gjennomsnitt
+    // fordeling av ns/op-snittet per batch på batchOps operasjoner
+    std::uint64_t batchOps = 0;
+    double batchP50 = 0.0;
+    double batchP90 = 0.0;
+    double batchP99 = 0.0;
+    double batchMin = 0.0;
+    double batchMax = 0.0;
+    double allocsPerOp = 0.0;
+    double bytesPerOp = 0.0;
+};
+
+class Bench {
+public:
+    // kjører op() gjentatte ganger og lagrer resultatet under name
+    void measure(const std::string& name, const std::function<void()>& op);
+
+    const std::vector<BenchResult>& results() const { return results_; }
+
+    std::string filter;
+    double minTimeMs = 200.0;   // per måling
+    int targetSamples = 100;
+
+private:
+    std::vector<BenchResult> results_;
+};
+
+// hindrer at kompilatoren fjerner beregninger som bare benchmarkes
+template <class T>
+inline void doNotOptimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// registrering av benchmark-grupper, som TEST_CASE i Catch2
+using BenchCaseFn = void (*)(Bench&);
+void registerBenchCase(const char* group, BenchCaseFn fn);
+
+struct BenchCaseRegistrar {
+    BenchCaseRegistrar(const char* group, BenchCaseFn fn) { registerBenchCase(group, fn); }
+};
+
+#define BENCH_CAT2(a, b) a##b
+#define BENCH_CAT(a, b) BENCH_CAT2(a, b)
+#define BENCH_CASE(group)                                                                  \
+    static void BENCH_CAT(benchCase_, __LINE__)(Bench&);                                   \
+    static BenchCaseRegistrar BENCH_CAT(benchReg_, __LINE__)(group, &BENCH_CAT(benchCase_, __LINE__)); \
+    static void BENCH_CAT(benchCase_, __LINE__)(Bench& bench)
+
+// kjører alle registrerte grupper; argumenter: [--filter tekst] [--json fil|-] [--min-time ms]
+int runBenchMain(int argc, char** argv, const char* suite);
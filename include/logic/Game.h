@@ -3,37 +3,67 @@
 #include <threepp/threepp.hpp>
 #include <vector>
 #include <memory>
+#include <string>
 
-#include "models/Car.h"
+#include "logic/Simulation.h"
 #include "models/CameraRig.h"
-#include "world/Parking.h"
-
-enum class GameState {
-    Playing,
-    Won
+#include "sim/SimThread.h"
+#include "util/EntityPool.h"
+#include "util/EventLog.h"
+#include "world/ChunkedLotVisual.h"
+#include "world/ParkingVisual.h"
+
+class ReplayWriter;
+class WorldCache;
+
+struct GameOptions {
+    float simHz = 120.f;
+    std::uint64_t seed = 0;      // 0 = tilfeldig (da brukes ikke verdens-cachen)
+    std::string worldCacheDir;   // tom = ingen cache
+    Scenario scenario;           // plass, regler, kjegler og bilfysikk
 };
 
+// Visning av Simulation: eier scene, kamera og input, og synker
+// meshene fra nyeste SimFrame én gang per rendret frame.
+// Simuleringen går i faste steg (simHz) på egen tråd (SimThread); visningen
+// interpolerer mellom de to siste stegene.
 class Game {
 public:
-    Game(threepp::Canvas& canvas, threepp::GLRenderer& renderer);
+    Game(threepp::Canvas& canvas, threepp::GLRenderer& renderer, const GameOptions& options = {});
     ~Game();
 
     void update(float dt);
     void render();
 
+    // tar opp seed, scenario og input per fast steg til en replay-fil; før første update()
+    bool startRecording(const std::string& path);
+
+    // true hvis verdenen ble lest fra en bakt cache-fil i stedet for generert
+    bool worldFromCache() const { return worldCache_ != nullptr; }
+
 
 private:
     // referanser
     threepp::Canvas& canvas_;
     threepp::GLRenderer& renderer_;
 
+    // HUD og hendelsesmeldinger skrives av en bakgrunnstråd, aldri fra update()
+    EventLog log_;
+
+    std::unique_ptr<WorldCache> worldCache_; // holdes åpen: lotVisual_ leser linjeverteksene fra mappingen
+    Simulation sim_; // eies av simThread_ etter første update()
+    Scenario scenario_; // det sim_ ble laget med; skrives i replay-headeren
+
+    // siste frame fra simuleringstråden
+    SimFrame frame_;
+
     // threepp scene
     std::shared_ptr<threepp::Scene> scene_;
     std::shared_ptr<threepp::PerspectiveCamera> camera_;
     CameraRig camRig_;
 
     std::shared_ptr<threepp::Mesh> carMesh_;
-    Car car_;
+    std::shared_ptr<threepp::MeshPhongMaterial> carMaterial_; // farges hver frame
     std::shared_ptr<threepp::Mesh> doorMesh_;
     std::shared_ptr<threepp::Mesh> keyMesh_;
     std::shared_ptr<threepp::Mesh> targetMarker_;
@@ -45,44 +75,27 @@ private:
     std::shared_ptr<threepp::Mesh> wheelRR_; // rear-right
     float wheelRadius_ = 0.25f;
 
-    std::vector<ParkingSpot> spots_;
-    threepp::Vector3 lotCenter_;
-    float lotW_ = 0.f;
-    float lotD_ = 0.f;
-
-    std::vector<std::shared_ptr<threepp::Mesh>> cones_;
+    // asfalt, oppmerking og kjegler strømmes i chunks rundt bilen
+    std::unique_ptr<ChunkedLotVisual> lotVisual_;
 
-    GameState state_ = GameState::Playing;
-
-    const int requiredTargets_ = 3;
-    int completedTargets_ = 0;
-    float parkedTimer_ = 0.f;
-    const float requiredParkTime_ = 1.5f;
-    bool lastInsideTarget_ = false;
-
-    std::vector<int> targetSequence_;
-    int currentTargetIdx_ = 0;
-
-    threepp::Vector3 doorPos_;
-    float doorHalfW_ = 3.f;
-    bool doorOpened_ = false;
-
-    bool keyAvailable_ = false;
-    bool keyCollected_ = false;
-    threepp::Vector3 keyPos_;
-
-    threepp::Vector3 startPos_;
-    float startYaw_ = 0.f;
+    // grønne markører gjenbrukes ved reset i stedet for å lages på nytt
+    CompletionMarkerAssets markerAssets_;
+    EntityPool<std::shared_ptr<threepp::Mesh>> markerPool_;
 
     float hudAccumulator_ = 0.f;
-    bool printedWin_ = false;
 
-    const float carHalfW_ = 0.5f;
-    const float carHalfD_ = 1.0f;
+    std::unique_ptr<ReplayWriter> recorder_;
 
     // input-håndtering (KeyListener)
     struct Controls;                       // nested type
     std::unique_ptr<Controls> controls_;   // peker til Controls
 
-    void resetGame();
+    // sist i klassen: stoppes (og joines) før alt den bruker rives ned
+    std::unique_ptr<SimThread> simThread_;
+
+    void onEpisodeReset(const SimFrame& next);
+    std::shared_ptr<threepp::Mesh> makeMarkerMesh();
+    void syncScene(float dt);
+    void handleProgress(const SimFrame& before, const SimFrame& now);
+    void printHud();
 };
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "math/Vec2.h"
+#include "models/Car.h"
+#include "sim/Scenario.h"
+#include "sim/ScriptRuntime.h"
+#include "util/Rng.h"
+#include "world/ConeGrid.h"
+#include "world/Obb.h"
+#include "world/Parking.h"
+#include "world/TriggerRegistry.h"
+
+struct BakedWorld;
+
+enum class GameState {
+    Playing,
+    Won
+};
+
+// Hendelser som visningen (Game) bruker til meldinger og mesh-oppdatering.
+enum class SimEventType {
+    TargetCompleted,
+    KeySpawned,
+    KeyCollected,
+    DoorOpened,
+    Won
+};
+
+struct SimEvent {
+    SimEventType type;
+    int spotIndex = -1;
+    int completedTargets = 0;
+};
+
+// Alt som endres mens en episode kjøres (utenom kjeglene og målsekvensen, som
+// bare endres av reset), samlet i én triviell struct: en savestate er en memcpy.
+// Spillreglene er parkingScript; her ligger bare hvor langt den har kommet.
+struct EpisodeState {
+    Car car;
+    Rng rng; // én strøm for kjegler og målsekvens; reset() fortsetter den
+    TriggerContacts triggers = {}; // volumene bilen er inne i (se Simulation::triggers())
+
+    double time = 0.0;        // episodens klokke (skriptets ScriptRuntime::now())
+    ParkingProgress progress = {}; // mål, parkert tid, når døra startet
+};
+
+static_assert(std::is_trivially_copyable_v<EpisodeState>);
+
+// Savestate fra Simulation::snapshot. Kjeglene og målsekvensen kopieres bare når
+// de er fra en annen verden (reset) enn snapshotet har fra før; bufferne gjenbrukes,
+// så gjentatte snapshot/restore i samme episode allokerer ikke.
+struct SimSnapshot {
+    EpisodeState episode;
+    std::uint64_t world = 0; // Simulation::worldId() da kjeglene ble kopiert
+    std::size_t spotCount = 0;
+    std::vector<Vec2> cones;
+    std::vector<int> targets;
+};
+
+// Hodeløs spillkjerne: bil, parkeringsplass, kjegler og
+// parkering -> nøkkel -> dør -> seier, kjørt som parkingScript i en egen
+// ScriptRuntime. Skriptet bygges fra ep_.progress ved konstruksjon, reset og
+// restore (og ved første step etter en kopi), så savestates forblir en memcpy.
+// Ingen threepp-avhengighet, slik at den kan kjøres uten vindu.
+class Simulation {
+public:
+    // kjeglenes kollisjonsradius (bilen er en boks, se carBox())
+    static constexpr float coneRadius = 0.35f;
+
+    // seedet fra std::random_device (ny bane hver gang)
+    Simulation();
+
+    // seeden Simulation() bruker
+    static std::uint64_t randomSeed();
+
+    // deterministisk: samme seed og samme input gir samme episode
+    explicit Simulation(std::uint64_t seed);
+
+    // som over, men med plass, regler, kjegler og bilfysikk fra et scenario
+    Simulation(std::uint64_t seed, const Scenario& scenario);
+
+    // samme tilstand som Simulation(seed, scenario) rett etter konstruksjon, men lest
+    // fra en bakt verden (WorldCache) i stedet for generert; world.seed blir seed().
+    // Plass, kjegleantall og antall mål kommer fra world.key, resten fra scenario.
+    explicit Simulation(const BakedWorld& world, const Scenario& scenario = {});
+
+    // seeden episoden startet med (lagres i replays)
+    std::uint64_t seed() const { return seed_; }
+
+    void reset();
+
+    void step(float dt, const CarInput& in);
+
+    const Car& car() const { return ep_.car; }
+    const ParkingLot& lot() const { return lot_; }
+    const std::vector<Vec2>& cones() const { return cones_; }
+    const ConeGrid& coneGrid() const { return coneGrid_; }
+    int coneCount() const { return coneCount_; }
+
+    // målsekvensen (indekser i lot().spots) og RNG-strømmen, for baking av verdenen
+    const std::vector<int>& targetSequence() const { return targetSequence_; }
+    const Rng& rng() const { return ep_.rng; }
+
+    GameState state() const { return ep_.progress.won(course_) ? GameState::Won : GameState::Playing; }
+
+    // hele episodetilstanden; snapshot/restore for planleggere og RL-forgreninger
+    const EpisodeState& episode() const { return ep_; }
+    void snapshot(SimSnapshot& out) const;
+
+    // tilbake til tilstanden i snapshotet (også fra en annen Simulation med samme
+    // plass); false og uendret hvis plassen ikke passer. Tømmer events().
+    bool restore(const SimSnapshot& in);
+
+    // ny verdi hver gang kjeglene og målsekvensen lages (konstruksjon og reset)
+    std::uint64_t worldId() const { return worldId_; }
+
+    int   requiredTargets()  const { return requiredTargets_; }
+    int   completedTargets() const { return ep_.progress.completedTargets(course_); }
+    float requiredParkTime() const { return course_.parkTime; }
+    float parkedTimer()      const { return ep_.progress.dwell; }
+    // i nåværende målplass og rolig nok til at parkedTimer teller
+    bool  insideTarget()     const;
+
+    // reglene parkingScript kjører med (targets er målsekvensen)
+    const ParkingCourse& course() const { return course_; }
+
+    // indeks i lot().spots for nåværende mål, -1 når alle er fullført
+    int currentTargetSpot() const;
+
+    bool keyAvailable() const { return ep_.progress.keyAvailable(course_); }
+    bool keyCollected() const { return ep_.progress.keyCollected(course_); }
+    Vec2 keyPos()       const { return keyPos_; }
+
+    Vec2  doorPos()    const { return doorPos_; }
+    float doorHalfW()  const { return doorHalfW_; }
+    float doorHeight() const { return ep_.progress.doorHeight(course_, ep_.time); }
+    bool  doorOpened() const { return ep_.progress.doorOpened(course_); }
+
+    Vec2  startPos() const { return startPos_; }
+    float startYaw() const { return startYaw_; }
+
+    float carHalfW() const { return carHalfW_; }
+    float carHalfD() const { return carHalfD_; }
+
+    // bilens kollisjonsboks (rotert med heading)
+    Obb carBox() const { return makeCarObb(ep_.car.position(), ep_.car.heading(), carHalfW_, carHalfD_); }
+
+    // kjegler testes med sveipet bilboks fra forrige posisjon (standard), så bilen ikke
+    // kan tunnelere gjennom dem ved store steg; av = gammel test mot sluttposisjonen
+    void setContinuousCollision(bool on) { continuousCollision_ = on; }
+    bool continuousCollision() const { return continuousCollision_; }
+
+    // trigger-volumer: plass i har id i, så nøkkel, dør og de fire veggene.
+    // triggerEvents() er enter/stay/exit for bilen (kropp 0) fra siste step().
+    const TriggerRegistry& triggers() const { return triggers_; }
+    const std::vector<TriggerEvent>& triggerEvents() const { return triggerEvents_; }
+    std::uint32_t keyTrigger()  const { return keyTrigger_; }
+    std::uint32_t doorTrigger() const { return doorTrigger_; }
+
+    const std::vector<SimEvent>& events() const { return events_; }
+    void clearEvents() { events_.clear(); }
+
+private:
+    std::uint64_t seed_;
+    EpisodeState ep_;
+    std::uint64_t worldId_ = 0;
+
+    ParkingLot lot_;
+    std::vector<Vec2> cones_;
+    ConeGrid coneGrid_;
+    const int coneCount_;
+    bool continuousCollision_ = true;
+
+    const int requiredTargets_;
+
+    std::vector<int> targetSequence_;
+    ParkingCourse course_; // targets peker inn i targetSequence_ (settes i restartScript)
+
+    // Runtimen for skriptet. Kopier og flytt gir en tom runtime (skriptet peker
+    // på eierens ep_), og neste step() bygger skriptet på nytt fra ep_.progress.
+    struct Script {
+        ScriptRuntime rt;
+        bool live = false;
+
+        Script() = default;
+        Script(const Script&) {}
+        Script& operator=(const Script&) = delete;
+    };
+    Script script_;
+
+    Vec2 doorPos_;
+    float doorHalfW_ = 3.f;
+
+    Vec2 keyPos_;
+
+    Vec2 startPos_;
+    float startYaw_ = 0.f;
+
+    const float carHalfW_ = 0.5f;
+    const float carHalfD_ = 1.0f;
+
+    TriggerRegistry triggers_;
+    std::uint32_t keyTrigger_ = 0;
+    std::uint32_t doorTrigger_ = 0;
+    std::vector<TriggerEvent> triggerEvents_;
+
+    std::vector<SimEvent> events_;
+
+    void configureConeGrid();
+    // cellStart/cellIds: ferdig fordelte triggerceller fra en WorldCache (tomme = bygg selv)
+    void configureTriggers(std::span<const std::uint32_t> cellStart = {},
+                           std::span<const std::uint32_t> cellIds = {});
+    void resetEpisodeState();
+    void moveCar(float dt, const CarInput& in);
+    void updateTriggers();
+    void updateProgress(float dt);
+    void restartScript();
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cmath>
+
+// Punkt/vektor i bakkeplanet (x/z i threepp-koordinater).
+// Simuleringen er 2D; høyde (y) er kun et visningsanliggende.
+struct Vec2 {
+    float x = 0.f;
+    float z = 0.f;
+};
+
+inline Vec2 operator+(Vec2 a, Vec2 b) { return {a.x + b.x, a.z + b.z}; }
+inline Vec2 operator-(Vec2 a, Vec2 b) { return {a.x - b.x, a.z - b.z}; }
+inline Vec2 operator*(Vec2 a, float s) { return {a.x * s, a.z * s}; }
+
+inline float dot(Vec2 a, Vec2 b) { return a.x * b.x + a.z * b.z; }
+inline float lengthSq(Vec2 a) { return dot(a, a); }
+inline float length(Vec2 a) { return std::sqrt(lengthSq(a)); }
@@ -9,6 +9,9 @@ public:
 
     void chase(const threepp::Object3D& target, float dt);
 
+    // kameraets synsvolum etter siste chase, for culling av chunks
+    threepp::Frustum frustum() const;
+
 private:
     std::shared_ptr<threepp::Camera> cam_;
 };
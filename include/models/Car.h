@@ -1,7 +1,6 @@
 #pragma once
 
-#include <threepp/threepp.hpp>
-#include <memory>
+#include "math/Vec2.h"
 
 struct CarPhysicsParams {
     float maxSpeed  = 20.f;
@@ -17,26 +16,31 @@ struct CarInput {
     bool  handbrake = false;
 };
 
+// Ren data-modell av bilen: posisjon i bakkeplanet, heading og fart.
+// Ingen threepp-avhengighet; visningen synker mesh fra denne tilstanden.
 class Car {
 public:
-    explicit Car(std::shared_ptr<threepp::Object3D> node,
-                 CarPhysicsParams p = {});
+    explicit Car(CarPhysicsParams p = {});
 
     void update(float dt, const CarInput& in);
 
-    void hardReset(const threepp::Vector3& pos, float yawRad);
+    void hardReset(Vec2 pos, float yawRad);
 
     void stop();
 
-    std::shared_ptr<threepp::Object3D> node() const { return node_; }
+    void setPosition(Vec2 pos) { pos_ = pos; }
+    void setHeading(float yawRad) { heading_ = yawRad; }
 
-    float speed()   const { return speed_; }
-    float heading() const { return heading_; }
+    Vec2  position() const { return pos_; }
+    float speed()    const { return speed_; }
+    float heading()  const { return heading_; }
+
+    const CarPhysicsParams& params() const { return base_; }
 
 private:
-    std::shared_ptr<threepp::Object3D> node_;
     CarPhysicsParams base_;
 
+    Vec2  pos_;
     float speed_   = 0.f;
     float heading_ = 0.f;
 };
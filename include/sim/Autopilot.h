@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "logic/Simulation.h"
+
+// Bevegelsesprimitiv: fast ratt og kjøreretning i en bit bue, integrert med samme
+// kinematikk som Car::update ved konstant fart. Posene er i startposens lokale ramme
+// (x = høyre, z = framover, heading relativt).
+struct MotionPrimitive {
+    float steer = 0.f;
+    float dir = 1.f;      // +1 fram, -1 rygg
+    float length = 0.f;   // buelengde i meter
+
+    static constexpr int samples = 4; // jevnt fordelt, siste er sluttposen
+    Vec2  pos[samples];
+    float dHeading[samples];
+    Vec2  axis[samples];  // (sin, cos) av dHeading: framover-aksen i startrammen
+};
+
+// Alt planleggeren kan regne ut på forhånd for én plassutforming og bilfysikk:
+// primitivene og en ikke-holonom avstandstabell (kostnaden for å nå en posisjon
+// relativt til bilen med primitivene, uten hindringer), pluss rutenettet over plassen.
+struct PlannerTables {
+    LotLayout        layout;
+    CarPhysicsParams car;
+
+    std::vector<MotionPrimitive> primitives;
+
+    // ikke-holon tabell: (2*window+1)^2 celler à 1 m rundt bilen, min over heading
+    int window = 0;
+    std::vector<float> reachCost;
+
+    // søkerutenett over plassen (1 m celler, headingBins retninger)
+    Vec2  gridMin;
+    int   cols = 0, rows = 0;
+    static constexpr int headingBins = 32;
+
+    double buildMs = 0.0;
+
+    // kostnaden for å nå rel (i bilens ramme), eller -1 utenfor tabellen
+    float reachCostAt(Vec2 rel) const;
+};
+
+// tabellene for (layout, bil); bygges første gang og deles av alle tråder
+std::shared_ptr<const PlannerTables> plannerTablesFor(const LotLayout& layout, const CarPhysicsParams& car);
+
+enum class PlanGoalKind { Spot, Key, Door };
+
+// målområde for bilens sentrum, litt strengere enn spillreglene så
+// sporingen har slakk
+struct PlanGoal {
+    PlanGoalKind kind = PlanGoalKind::Spot;
+    Vec2  center;
+    Vec2  half;         // Spot/Door: halvmål på området
+    float radius = 0.f; // Key
+
+    bool contains(Vec2 p) const;
+};
+
+// neste mål i episoden (plass, nøkkel, dør); false når episoden er vunnet
+bool nextPlanGoal(const Simulation& sim, PlanGoal& out);
+
+struct PathPoint {
+    Vec2  pos;
+    float heading = 0.f;
+    float dir = 1.f;
+};
+
+struct PlanStats {
+    bool   found = false;
+    bool   limitHit = false;  // ikke funnet fordi maxExpansions ble nådd (ellers: ingen vei)
+    bool   partial = false;   // limitHit, men path går til den utvidede posen nærmest målet
+    int    expansions = 0;
+    double micros = 0.0;
+    double fieldMicros = 0.0; // GoalField bygget for denne planen; 0 når feltet gjenbrukes
+};
+
+// Holonom avstand til målet over plassens rutenett (8-naboer, kjegler oppblåst
+// med bilens halve bredde). Brukes som den andre halvdelen av heuristikken.
+class GoalField {
+public:
+    void build(const PlannerTables& tables, const Simulation& sim, const PlanGoal& goal);
+    float at(Vec2 p) const;
+
+private:
+    const PlannerTables* tables_ = nullptr;
+    int stride_ = 0;            // cols + 2: rutenettet har en blokkert kant rundt
+    // tidels meter + 1; 0 = blokkert, max = ikke nådd. Gjenbrukes mellom byggene
+    std::vector<std::uint32_t> cost_;
+    std::array<std::vector<std::uint32_t>, 16> buckets_; // bøttekø, > største kant (14)
+};
+
+// Hybrid-A* over primitivene. Eier bare kladdeminne for søket, så én per tråd
+// holder for mange biler; tabellene er delte og konstante.
+class ParkingPlanner {
+public:
+    explicit ParkingPlanner(std::shared_ptr<const PlannerTables> tables);
+
+    const PlannerTables& tables() const { return *tables_; }
+
+    // sti fra bilens nåværende pose inn i goal, unna kjegler og kanter
+    PlanStats plan(const Simulation& sim, const PlanGoal& goal, const GoalField& field,
+                   std::vector<PathPoint>& path);
+
+    // budsjett per replan: ~2 us per utvidelse kald, så søket pluss feltet holder seg
+    // under 1 ms. Når det tar slutt, kjører bilen mot posen nærmest målet (partial)
+    // og planlegger på nytt derfra
+    int maxExpansions = 300;
+    float heuristicWeight = 1.5f;
+
+private:
+    struct Node {
+        Vec2 pos;
+        float heading;
+        float g;
+        float f;
+        std::int32_t parent;
+        std::int16_t prim;
+        std::uint8_t contact; // > 0: innenfor klaringen, så mange rette primitiver fra en start der
+    };
+
+    // f ligger i heapen, så sammenligningene ikke hopper rundt i nodes_
+    struct OpenEntry {
+        float f;
+        std::uint32_t node;
+    };
+
+    // per diskret tilstand: søket som sist så den og beste g der (sammen, så ett
+    // oppslag er én cache-linje)
+    struct Seen {
+        std::uint32_t search = 0;
+        float g = 0.f;
+    };
+
+    std::shared_ptr<const PlannerTables> tables_;
+    std::vector<Node> nodes_;
+    std::vector<OpenEntry> open_;          // heap
+    std::vector<Seen> seen_;
+    std::vector<std::uint8_t> nearCone_;   // per søkecelle: kan en bilboks her nå en kjegle
+    std::uint32_t search_ = 0;
+    std::vector<int> chain_;
+
+    void reserveNodes();
+};
+
+// Autopilot for én bil: planlegger mot neste mål, sporer stien (pure pursuit) og
+// planlegger på nytt når målet endres, bilen kommer ut av stien eller står fast.
+class Autopilot {
+public:
+    // input for neste steg; planner kan deles med andre biler på samme tråd
+    CarInput drive(const Simulation& sim, ParkingPlanner& planner, float dt);
+
+    const std::vector<PathPoint>& path() const { return path_; }
+    const PlanStats& lastPlan() const { return lastPlan_; } // micros + fieldMicros = hele replanleggingen
+    std::uint64_t plans() const { return plans_; }
+    std::uint64_t failedPlans() const { return failed_; }
+
+private:
+    std::vector<PathPoint> path_;
+    std::size_t pathIdx_ = 0;
+    GoalField field_;
+
+    std::uint64_t world_ = 0;
+    PlanGoalKind goalKind_ = PlanGoalKind::Spot;
+    int goalSpot_ = -2;
+    bool hasGoal_ = false;
+
+    float stuckTime_ = 0.f;
+    float retryIn_ = 0.f;
+    float pivotDir_ = 1.f;
+
+    PlanStats lastPlan_;
+    double fieldMicros_ = 0.0; // bygget siden forrige plan
+    std::uint64_t plans_ = 0;
+    std::uint64_t failed_ = 0;
+
+    void replan(const Simulation& sim, ParkingPlanner& planner, const PlanGoal& goal);
+    CarInput pivot(const Car& car) const;
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "math/Vec2.h"
+#include "models/Car.h"
+
+// Mange biler lagret som struktur-av-arrays, slik at Car::update-fysikken
+// kan kjøres vektorisert (AVX2/SSE2) over hele flåten per tick.
+// Semantikken er den samme som Car::update (innenfor flyttallstoleranse).
+class CarFleet {
+public:
+    CarFleet() = default;
+
+    // legger til en bil og returnerer indeksen
+    std::size_t add(const CarPhysicsParams& p = {}, Vec2 pos = {}, float heading = 0.f);
+
+    void reserve(std::size_t n);
+    void clear();
+
+    std::size_t size() const { return speed_.size(); }
+
+    // inputs.size() må være lik size()
+    void update(float dt, std::span<const CarInput> inputs);
+
+    // samme kjerne uten SIMD (brukes som fallback og i tester)
+    void updateScalar(float dt, std::span<const CarInput> inputs);
+
+    void hardReset(std::size_t i, Vec2 pos, float yawRad);
+    void stop(std::size_t i) { speed_[i] = 0.f; }
+
+    Vec2  position(std::size_t i) const { return {x_[i], z_[i]}; }
+    float speed(std::size_t i)    const { return speed_[i]; }
+    float heading(std::size_t i)  const { return heading_[i]; }
+
+    const float* xs()       const { return x_.data(); }
+    const float* zs()       const { return z_.data(); }
+    const float* speeds()   const { return speed_.data(); }
+    const float* headings() const { return heading_.data(); }
+
+    // "avx2", "sse2" eller "scalar", avhengig av hva som ble kompilert inn
+    static const char* simdPath();
+
+private:
+    std::vector<float> speed_;
+    std::vector<float> heading_;
+    std::vector<float> x_;
+    std::vector<float> z_;
+
+    // CarPhysicsParams, en array per felt
+    std::vector<float> maxSpeed_;
+    std::vector<float> accel_;
+    std::vector<float> brake_;
+    std::vector<float> steerRate_;
+    std::vector<float> friction_;
+
+    // inputs transponert til SoA før kjernen kjøres
+    std::vector<float> inThrottle_;
+    std::vector<float> inSteer_;
+    std::vector<float> inHandbrake_;
+
+    void transposeInputs(std::span<const CarInput> inputs);
+};
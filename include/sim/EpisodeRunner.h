@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "logic/Simulation.h"
+#include "util/ThreadPool.h"
+
+// policy(episode, sim) -> input for neste steg; må være trådsikker (kalles parallelt)
+using EpisodePolicy = std::function<CarInput(std::size_t episode, const Simulation& sim)>;
+
+struct EpisodeRunStats {
+    std::uint64_t episodeSteps = 0;
+    double seconds = 0.0;
+    double stepsPerSec = 0.0;
+};
+
+// Eier N uavhengige episoder (hver sin Simulation med egen seed) og stepper
+// dem parallelt på en ThreadPool. Hver episode er deterministisk gitt sin
+// seed og policy, uansett antall tråder og hvordan arbeidet blir fordelt.
+class EpisodeRunner {
+public:
+    EpisodeRunner(std::size_t episodes, std::uint64_t baseSeed, const Scenario& scenario = {});
+
+    std::size_t size() const { return slots_.size(); }
+
+    const Simulation& episode(std::size_t i) const { return slots_[i].sim; }
+    Simulation& episode(std::size_t i) { return slots_[i].sim; }
+
+    // starter en ny episode i alle (hver fortsetter sin egen RNG-strøm)
+    void resetAll();
+
+    // kjører steps faste steg i alle episoder
+    EpisodeRunStats run(ThreadPool& pool, int steps, float dt, const EpisodePolicy& policy);
+
+    // seed for episode i; uavhengig av trådantall
+    static std::uint64_t episodeSeed(std::uint64_t baseSeed, std::size_t episode);
+
+private:
+    // egen cache-linje per episode, så tråder ikke deler linjer
+    struct alignas(64) Slot {
+        Slot(std::uint64_t seed, const Scenario& scenario) : sim(seed, scenario) {}
+        Simulation sim;
+    };
+
+    std::vector<Slot> slots_;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+
+struct FixedStepStats {
+    std::uint64_t frames = 0;
+    std::uint64_t steps = 0;
+    std::uint64_t catchUpSteps = 0;  // ekstra steg slått sammen i samme frame
+    std::uint64_t droppedSteps = 0;  // steg kastet pga. maxStepsPerFrame
+};
+
+// Akkumulator-basert fast tidssteg: vegg-klokke-dt fra render-løkka samles opp
+// og simuleringen kjøres i hele steg på 1/hz sekunder. Resten (alpha) brukes
+// til å interpolere visningen mellom de to siste tilstandene.
+class FixedStepper {
+public:
+    explicit FixedStepper(float hz = 120.f, int maxStepsPerFrame = 8)
+        : stepDt_(1.0 / hz), maxStepsPerFrame_(maxStepsPerFrame) {}
+
+    // kjører step(dt) null eller flere ganger; returnerer antall steg
+    template <class StepFn>
+    int advance(double frameDt, StepFn&& step);
+
+    // andel av et steg som ligger i akkumulatoren, [0, 1]
+    float alpha() const { return static_cast<float>(accumulator_ / stepDt_); }
+
+    float stepDt() const { return static_cast<float>(stepDt_); }
+    const FixedStepStats& stats() const { return stats_; }
+
+    void resetAccumulator() { accumulator_ = 0.0; }
+
+private:
+    double stepDt_;
+    int    maxStepsPerFrame_;
+    double accumulator_ = 0.0;
+    FixedStepStats stats_;
+};
+
+template <class StepFn>
+int FixedStepper::advance(double frameDt, StepFn&& step) {
+    ++stats_.frames;
+    accumulator_ += frameDt;
+
+    int steps = 0;
+    while (accumulator_ >= stepDt_) {
+        if (steps == maxStepsPerFrame_) {
+            // ikke prøv å ta igjen alt (spiral of death); kast hele steg som ligger igjen
+            auto dropped = static_cast<std::uint64_t>(accumulator_ / stepDt_);
+            stats_.droppedSteps += dropped;
+            accumulator_ -= static_cast<double>(dropped) * stepDt_;
+            break;
+        }
+        step(static_cast<float>(stepDt_));
+        accumulator_ -= stepDt_;
+        ++steps;
+    }
+
+    stats_.steps += static_cast<std::uint64_t>(steps);
+    if (steps > 1) stats_.catchUpSteps += static_cast<std::uint64_t>(steps - 1);
+    return steps;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "sim/EpisodeRunner.h"
+#include "sim/car_gym.h"
+#include "util/ThreadPool.h"
+
+struct GymConfig {
+    std::size_t episodes = 64;
+    std::uint64_t seed = 1;
+    unsigned threads = 0;       // 0 = alle kjerner
+    float dt = 1.f / 60.f;
+    int   frameSkip = 1;
+    int   maxSteps = 60 * 120;  // fysikksteg før tidsgrensen, 0 = ingen
+    bool  autoReset = true;
+    float coneRange = 12.f;
+
+    float rewardTarget = 1.f;
+    float rewardKey = 1.f;
+    float rewardWin = 5.f;
+    float rewardStep = -0.001f;
+    float rewardProgress = 0.05f;
+
+    Scenario scenario;
+};
+
+// Batch-miljø for trening bak C-API-et i car_gym.h: N episoder i en EpisodeRunner,
+// stegget parallelt med handlingene fra en flat float-buffer. Observasjoner,
+// belønninger og done skrives rett inn i kallerens buffere, rad per episode, så
+// hver tråd skriver bare sine egne rader. step() allokerer ikke.
+class GymPool {
+public:
+    static constexpr int obsSize = CAR_GYM_OBS_SIZE;
+    static constexpr int actionSize = CAR_GYM_ACTION_SIZE;
+
+    explicit GymPool(const GymConfig& cfg);
+
+    std::size_t size() const { return runner_.size(); }
+    const GymConfig& config() const { return cfg_; }
+    const Simulation& episode(std::size_t i) const { return runner_.episode(i); }
+
+    // observations: size() x obsSize
+    void reset(float* observations);
+    void resetOne(std::size_t i, float* observations);
+
+    // finalObservations (valgfri): raden episoden sluttet i, før auto-reset, for
+    // episoder med done != CAR_GYM_RUNNING; de andre radene røres ikke
+    void step(const float* actions, float* observations, float* rewards, std::uint8_t* dones,
+              float* finalObservations = nullptr);
+
+    // én rad, for tester og verktøy
+    void observe(std::size_t i, float* row) const;
+
+private:
+    // per episode, for belønning og tidsgrense
+    struct alignas(64) Track {
+        int   steps = 0;
+        std::uint8_t finished = CAR_GYM_RUNNING; // uten auto-reset: hvordan episoden sluttet
+        int   completed = 0;
+        bool  keyCollected = false;
+        float goalDist = 0.f;
+    };
+
+    GymConfig cfg_;
+    EpisodeRunner runner_;
+    ThreadPool pool_;
+    std::vector<Track> tracks_;
+    std::size_t grain_ = 1;
+
+    // argumentene til step(), så parallelFor-lambdaen bare trenger this
+    const float* actions_ = nullptr;
+    float* observations_ = nullptr;
+    float* rewards_ = nullptr;
+    std::uint8_t* dones_ = nullptr;
+    float* finalObservations_ = nullptr;
+
+    void stepRange(std::size_t begin, std::size_t end);
+    void startTrack(std::size_t i);
+    float goalDistance(const Simulation& sim) const;
+};
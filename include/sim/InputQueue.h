@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "models/Car.h"
+#include "util/LatencyWindow.h"
+#include "util/SpscQueue.h"
+
+enum class InputControl : std::uint8_t { Throttle, Steer, Handbrake };
+
+// én endring av én kontroll, med tidsstempel i Profiler::nowNs()-klokka
+struct InputEvent {
+    std::uint64_t timeNs = 0;
+    InputControl control = InputControl::Throttle;
+    float value = 0.f; // handbrekk: 0 eller 1
+};
+
+// Tidsstemplede input-hendelser inn i de faste stegene.
+// Produsenten (tastatur-callbacks, eller et skript i benchmarks) legger hendelser
+// i en lock-free SPSC-kø. Konsumenten ber om input for et steg som dekker
+// [beginNs, endNs) og får et tidsveid snitt: en hendelse midt i steget gir halv
+// virkning der, og et trykk kortere enn et steg blir ikke borte. Throttle og ratt
+// virker lineært i Car::update, så snittet gir samme fartsendring og sving som å
+// dele steget ved hendelsen; handbrekket (bool) er på hvis det holdes minst halve steget.
+class InputQueue {
+public:
+    // minHoldNs: hver endring varer minst så lenge (for trykk der trykk og slipp
+    // kommer i samme event-poll og får nesten samme tidsstempel)
+    explicit InputQueue(std::size_t capacity = 1024, std::uint64_t minHoldNs = 0);
+
+    // før første hendelse
+    void setMinHoldNs(std::uint64_t ns) { minHoldNs_ = ns; }
+
+    // --- produsent (én tråd om gangen) ---
+
+    // false hvis køen er full (hendelsen telles som droppet)
+    bool push(const InputEvent& e);
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    // --- konsument ---
+
+    // input for steget [beginNs, endNs); nowNs er når steget kjøres (for latens)
+    CarInput integrate(std::uint64_t beginNs, std::uint64_t endNs, std::uint64_t nowNs);
+
+    // kontrollene slik de står etter siste integrate()
+    const CarInput& held() const { return held_; }
+
+    // tidsstempel for siste hendelse som er brukt (0 = ingen ennå)
+    std::uint64_t lastAppliedNs() const { return lastAppliedNs_; }
+
+    // fra hendelsens tidsstempel til steget som bruker den kjøres
+    const LatencyWindow<>& latency() const { return latency_; }
+
+private:
+    SpscQueue<InputEvent> queue_;
+    std::atomic<std::uint64_t> dropped_{0};
+    std::uint64_t minHoldNs_;
+
+    CarInput held_;
+    std::uint64_t holdUntilNs_[3] = {}; // per kontroll: tidligste tid for neste endring
+    InputEvent pending_;
+    bool hasPending_ = false;
+    std::uint64_t lastAppliedNs_ = 0;
+    LatencyWindow<> latency_;
+};
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/Vec2.h"
+#include "world/Obb.h"
+#include "world/RayBvh.h"
+
+class Simulation;
+class ThreadPool;
+
+struct LidarConfig {
+    int   beams = 360;            // stråler per kanal, jevnt fordelt over fov
+    float fov = 6.2831853f;       // rundt bilens heading; 2 pi = hele sirkelen
+    int   channels = 1;           // vertikale kanaler; 1 = plan 2D-skanning
+    float minElevation = -0.25f;  // radianer, brukes når channels > 1
+    float maxElevation = 0.15f;
+    float maxRange = 40.f;        // stråler uten treff gir maxRange
+    float mountHeight = 0.6f;     // under kjeglene (1 m), så en plan skanning ser dem
+    float mountForward = 0.f;     // meter foran bilens sentrum
+    bool  hitGround = true;       // stråler nedover stopper i bakken
+};
+
+// Høyder i verden, omtrent som det som vises i Game
+struct LidarWorldHeights {
+    float cone = 1.0f;
+    float wall = 1.0f;
+    float car = 1.0f;
+    float doorHalfHeight = 1.0f;  // døra er 2 m høy rundt Simulation::doorHeight
+    float doorHalfDepth = 0.25f;
+};
+
+// hva en stråle traff; øverste byte i RayPrim::tag
+enum class LidarHit : std::uint8_t { None = 0, Cone, Wall, Door, Car, Ground };
+
+struct LidarPose {
+    Vec2  pos;
+    float heading = 0.f;
+    std::uint32_t self = RayPacket::noHit; // bilens egen tag (carTag), hoppes over
+};
+
+// Simulert lidar på bilen, kun CPU (ingen GL): kjegler og vegger ligger i en
+// statisk RayBvh, døra og andre biler i en dynamisk som bygges på nytt per steg.
+// Strålene skytes i pakker på 8 nabostråler fra samme kanal. Avstandene skrives
+// som float per stråle, kanal for kanal, rett inn i kallerens buffer (f.eks. en
+// rad i observasjonsbufferet); scan() allokerer ikke.
+//
+// Verden er 2.5D: prismer med høyde, og kanaler med elevasjon gir 3D-skanning.
+// Kjeglene er sylindre med kollisjonsradiusen.
+class Lidar {
+public:
+    explicit Lidar(const LidarConfig& cfg = {}, const LidarWorldHeights& heights = {});
+
+    const LidarConfig& config() const { return cfg_; }
+    int raysPerScan() const { return cfg_.beams * cfg_.channels; }
+
+    static std::uint32_t carTag(std::uint32_t i) { return tag(LidarHit::Car, i); }
+
+    // kjeglene og veggene rundt plassen
+    void buildStatic(const Simulation& sim);
+
+    // døra (i høyden den har nå) og andre biler; kalles hvert steg
+    void updateDynamic(const Simulation& sim, std::span<const Obb> cars = {});
+
+    // én skanning; ranges har raysPerScan() plasser, hits (valgfri) like mange
+    void scan(const LidarPose& pose, float* ranges, LidarHit* hits = nullptr) const;
+
+    // mange biler parallelt over biler og stråler: ranges er poses.size() x raysPerScan()
+    void scan(std::span<const LidarPose> poses, float* ranges, LidarHit* hits, ThreadPool& pool) const;
+
+    // samme skanning mot hvert prisme uten BVH og SIMD (referanse for tester og benchmark)
+    void scanLinear(const LidarPose& pose, float* ranges, LidarHit* hits = nullptr) const;
+
+    const RayBvh& staticBvh() const { return static_; }
+    const RayBvh& dynamicBvh() const { return dynamic_; }
+
+private:
+    LidarConfig cfg_;
+    LidarWorldHeights heights_;
+    RayBvh static_;
+    RayBvh dynamic_;
+
+    // per stråle i en kanal (sin/cos av vinkelen mot heading) og per kanal
+    std::vector<float> beamSin_, beamCos_;
+    std::vector<float> slope_, cosElevation_;
+
+    static std::uint32_t tag(LidarHit kind, std::uint32_t index) {
+        return static_cast<std::uint32_t>(kind) << 24 | (index & 0xffffffu);
+    }
+
+    // stråler [first, first + count) i kanal ch
+    template <bool Linear>
+    void scanRange(const LidarPose& pose, int ch, int first, int count, float* ranges, LidarHit* hits) const;
+};
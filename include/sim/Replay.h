@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "logic/Simulation.h"
+
+// Binært replay-format (little-endian), versjon 2:
+//   header (144 byte): "BSRP", u16 versjon, u16 headerstørrelse, u64 seed,
+//                      f32 stegtid, u32 reservert, u64 antall steg, u64 payload-bytes,
+//                      så scenarioet (104 byte): char[48] navn, i32 rows, i32 cols,
+//                      f32 slotW, slotD, laneWidth, margin, i32 requiredTargets,
+//                      f32 parkTime, i32 coneCount, f32 maxSpeed, accel, brake,
+//                      steerRate, friction
+//   payload: runs av like input. Hver run er en tag-byte (throttle/steer-koding,
+//            handbrekk, reset før run), eventuelle rå floats, og varint antall steg.
+// Siden header oppgir payload-lengden kan flere replays legges etter hverandre i ett arkiv.
+// Avspilling er bare deterministisk på samme plattform/bygg (std::sin/cos kan variere).
+
+struct ReplayRun {
+    CarInput input;
+    std::uint64_t steps = 0;
+    bool resetBefore = false;
+};
+
+class ReplayWriter {
+public:
+    ReplayWriter() = default;
+    ~ReplayWriter();
+
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    // scenario må være det Simulation(seed, scenario) ble laget med
+    bool open(const std::string& path, std::uint64_t seed, float stepDt, const Scenario& scenario = {});
+    bool isOpen() const { return out_.is_open(); }
+
+    // kalles før reset av simuleringen
+    void recordReset();
+    // kalles for hvert faste steg med input som ble brukt
+    void recordStep(const CarInput& in);
+
+    // skriver siste run og fyller inn header
+    void close();
+
+    std::uint64_t steps() const { return steps_; }
+
+private:
+    std::ofstream out_;
+    std::vector<std::uint8_t> buf_;
+
+    std::uint64_t seed_ = 0;
+    float stepDt_ = 0.f;
+    Scenario scenario_;
+    std::uint64_t steps_ = 0;
+    std::uint64_t payloadBytes_ = 0;
+
+    ReplayRun run_;
+    bool hasRun_ = false;
+    bool pendingReset_ = false;
+
+    void flushRun();
+    void flushBuffer();
+    void writeHeader();
+};
+
+// Leser ett replay fra en bytebuffer (typisk en MappedFile); kopierer ingenting.
+class ReplayReader {
+public:
+    static constexpr std::size_t headerSize = 144;
+
+    // bytes starter på en header; false hvis ugyldig (også et scenario som
+    // validateScenario avviser, eller en eldre versjon uten scenario)
+    bool open(std::span<const std::byte> bytes);
+
+    std::uint64_t   seed()      const { return seed_; }
+    float           stepDt()    const { return stepDt_; }
+    std::uint64_t   stepCount() const { return stepCount_; }
+    const Scenario& scenario()  const { return scenario_; }
+
+    // header + payload, dvs. avstanden til neste replay i et arkiv
+    std::size_t sizeBytes() const { return headerSize + payload_.size(); }
+
+    // neste run; false ved slutt eller korrupt data
+    bool next(ReplayRun& run);
+
+    // next() stoppet på korrupt data, eller runs med flere steg enn stepCount()
+    bool corrupt() const { return corrupt_; }
+
+private:
+    std::span<const std::byte> payload_;
+    std::size_t pos_ = 0;
+    std::uint64_t seed_ = 0;
+    float stepDt_ = 0.f;
+    std::uint64_t stepCount_ = 0;
+    std::uint64_t consumed_ = 0; // steg i runs lest så langt
+    bool corrupt_ = false;
+    Scenario scenario_;
+
+    bool parseRun(ReplayRun& run);
+};
+
+// kaller f(ReplayReader&) for hvert replay i et arkiv; returnerer antall gyldige
+template <class F>
+std::size_t forEachReplay(std::span<const std::byte> archive, F&& f) {
+    std::size_t count = 0;
+    while (!archive.empty()) {
+        ReplayReader reader;
+        if (!reader.open(archive)) break;
+        std::size_t size = reader.sizeBytes();
+        f(reader);
+        ++count;
+        archive = archive.subspan(size);
+    }
+    return count;
+}
+
+struct ReplayResult {
+    bool valid = true;           // false: korrupt payload, eller steg != headerens stepCount
+    std::uint64_t steps = 0;
+    double seconds = 0.0;
+    double realTimeFactor = 0.0; // simulert tid / veggtid
+    GameState state = GameState::Playing;
+    int completedTargets = 0;
+    Vec2 carPos;
+};
+
+// spiller av hodeløst med en ny Simulation(seed, scenario) fra headeren; stopper
+// på korrupt data (aldri flere steg enn stepCount()) og melder det i valid
+ReplayResult playReplay(ReplayReader& reader);
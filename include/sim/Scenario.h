@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "models/Car.h"
+#include "world/Parking.h"
+
+// Alt som varierer mellom scenarioer: plassens utforming, spillregler, antall
+// kjegler og bilens fysikk. Standardverdiene er det vanlige spillet.
+struct Scenario {
+    char name[48] = "default";
+
+    LotLayout layout;
+    int   requiredTargets  = 3;
+    float requiredParkTime = 1.5f;
+    int   coneCount        = 30;
+    CarPhysicsParams car;
+
+    std::string_view nameView() const { return name; }
+};
+
+// Øvre grenser parseren håndhever, så verdier fra en fil aldri kan gi int-overløp
+// eller rutenett (ConeGrid, ParkingLotIndex, LotChunks) på gigabyte:
+// lot.rows * lot.cols, cones.count, og plassens bredde og dybde i meter
+// (cols * slotW + 2 margin og rows * slotD + (rows - 1) laneWidth + 2 margin).
+inline constexpr int   scenarioMaxSpots  = 1 << 20;
+inline constexpr int   scenarioMaxCones  = 1 << 20;
+inline constexpr float scenarioMaxExtent = 4096.f;
+
+struct ScenarioError {
+    int line = 0;              // 1-basert, 0 = hele filen
+    const char* message = "";  // strengliteral
+};
+
+// Scenario-format: én "nøkkel = verdi" per linje, # starter en kommentar.
+// Nøkler: name, lot.rows, lot.cols, lot.slotW, lot.slotD, lot.laneWidth, lot.margin,
+// rules.requiredTargets, rules.parkTime, cones.count, car.maxSpeed, car.accel,
+// car.brake, car.steerRate, car.friction. Manglende nøkler beholder standardverdien.
+// Flyttall må være endelige (nan og inf avvises), og grensene over gjelder.
+//
+// Parseren allokerer ikke: den går gjennom teksten med string_view og from_chars.
+// Ved feil er out uendret og err (hvis gitt) sier hvilken linje og hvorfor.
+bool parseScenario(std::string_view text, Scenario& out, ScenarioError* err = nullptr);
+
+// samme sjekk som parseScenario gjør til slutt (endelige tall, grensene over);
+// for scenarioer som kommer fra andre steder enn tekst, f.eks. en replay-header
+bool validateScenario(const Scenario& s, ScenarioError* err = nullptr);
+
+// minnemapper og parser én fil
+bool loadScenario(const std::string& path, Scenario& out, ScenarioError* err = nullptr);
+
+// alle *.scn i dir, sortert på filnavn, lagt til i out; feil ("fil:linje: melding")
+// legges i errors og hopper over filen. Returnerer antall scenarioer som ble lastet.
+std::size_t loadScenarioDirectory(const std::string& dir, std::vector<Scenario>& out,
+                                  std::vector<std::string>* errors = nullptr);
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "world/TriggerRegistry.h"
+
+// Skript-coroutine. Starter suspendert; ScriptRuntime::spawn() overtar den og kjører
+// den fram til første co_await. Eies av runtimen til den er ferdig.
+// Rammene gjenbrukes per tråd (samme størrelse om igjen), så et skript som bygges
+// på nytt etter reset/restore ikke går til allokatoren.
+class ScriptTask {
+public:
+    struct promise_type {
+        std::size_t slot = 0; // plass i ScriptRuntime sin liste over levende skript
+
+        static void* operator new(std::size_t size);
+        static void operator delete(void* p, std::size_t size) noexcept;
+
+        ScriptTask get_return_object() { return ScriptTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() noexcept;
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    ScriptTask() = default;
+    ScriptTask(ScriptTask&& o) noexcept : h_(o.h_) { o.h_ = nullptr; }
+    ScriptTask& operator=(ScriptTask&& o) noexcept;
+    ~ScriptTask();
+
+    // gir fra seg eierskapet (til runtimen)
+    Handle release();
+
+private:
+    explicit ScriptTask(Handle h) : h_(h) {}
+    Handle h_;
+};
+
+// Lineær animasjon fra from mot to med rate per sekund, regnet ut fra tiden i stedet
+// for å telles opp hvert steg (visningen sampler value(now)).
+struct ScriptAnimation {
+    double start = 0.0;
+    float from = 0.f;
+    float to = 0.f;
+    float rate = 1.f;
+    bool  running = false;
+
+    float value(double now) const;
+    double duration() const;
+};
+
+// Kjører mange skript (ett per scenario-instans) drevet av trigger-hendelser og
+// timere. Et skript som venter koster ingenting per steg: ventende trigger-skript
+// ligger i en plass per kropp og vekkes bare av hendelser for den kroppen og det
+// volumet, timere ligger i en min-heap og vekkes når tiden er nådd.
+// Én tråd; flere runtimer kan kjøre på hver sin tråd.
+class ScriptRuntime {
+public:
+    ScriptRuntime() = default;
+    ~ScriptRuntime();
+
+    ScriptRuntime(const ScriptRuntime&) = delete;
+    ScriptRuntime& operator=(const ScriptRuntime&) = delete;
+
+    // kroppene har id 0..bodies-1 (samme som i TriggerEvent::body)
+    void reserveBodies(std::size_t bodies);
+
+    // kjører skriptet fram til første co_await
+    void spawn(ScriptTask task);
+
+    // ett steg: klokka flyttes dt, timere som har gått ut vekkes, og så deles
+    // hendelsene ut til skriptene som venter på dem. speeds[body] brukes av parkedIn.
+    void step(float dt, std::span<const TriggerEvent> events, const float* speeds);
+
+    // avslutter alle skript (rammene frigis) og stiller klokka til now
+    void clear(double now = 0.0);
+
+    double now() const { return now_; }
+    std::size_t live() const { return live_; }
+    std::uint64_t resumes() const { return resumes_; }
+
+    // --- awaitables (co_await rt.parkedIn(...)) ---
+
+    struct TriggerAwait;
+    struct TimerAwait;
+
+    // kroppen er inne i volumet og roligere enn maxSpeed sammenhengende i seconds.
+    // Med dwell telles tiden der i stedet for i runtimen, fra verdien den har, så
+    // den kan ligge i en savestate og et gjenoppbygd skript fortsetter tellingen.
+    TriggerAwait parkedIn(std::uint32_t body, std::uint32_t trigger, float seconds, float maxSpeed,
+                          float* dwell = nullptr);
+
+    // kroppen er inne i volumet (enter, eller allerede inne)
+    TriggerAwait reached(std::uint32_t body, std::uint32_t trigger);
+
+    TimerAwait delay(double seconds);
+
+    // til klokka er time; et tidspunkt som alt er passert fortsetter med en gang
+    TimerAwait until(double time);
+
+    // starter animasjonen nå og fortsetter når den er ferdig
+    TimerAwait animate(ScriptAnimation& anim, float from, float to, float rate);
+
+    struct TriggerAwait {
+        ScriptRuntime& rt;
+        std::uint32_t body, trigger;
+        float seconds, maxSpeed;
+        float* dwell;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(ScriptTask::Handle h);
+        void await_resume() const noexcept {}
+    };
+
+    struct TimerAwait {
+        ScriptRuntime& rt;
+        double due;
+
+        bool await_ready() const noexcept { return due <= rt.now_; }
+        void await_suspend(ScriptTask::Handle h);
+        void await_resume() const noexcept {}
+    };
+
+private:
+    // ett ventende trigger-skript per kropp
+    struct BodyWait {
+        ScriptTask::Handle h;
+        std::uint32_t trigger = 0;
+        float need = 0.f;     // sammenhengende tid inne (0 = holder å komme inn)
+        float maxSpeed = 0.f;
+        float dwell = 0.f;
+        float* dwellAt = nullptr; // ekstern teller (parkedIn med dwell), ellers &dwell
+    };
+
+    struct Timer {
+        double due;
+        std::uint64_t seq; // lik due: i rekkefølgen de ble lagt inn
+        ScriptTask::Handle h;
+    };
+
+    std::vector<BodyWait> waits_;
+    std::vector<Timer> timers_; // min-heap på (due, seq)
+    std::vector<ScriptTask::Handle> scripts_; // alle levende, for clear()
+    std::uint64_t timerSeq_ = 0;
+    double now_ = 0.0;
+    std::size_t live_ = 0;
+    std::uint64_t resumes_ = 0;
+
+    void resume(ScriptTask::Handle h);
+};
+
+// Banen for standardscenariet og reglene for den: plassene (trigger-id = plassindeks)
+// i rekkefølge, parkering (rolig nok, lenge nok), nøkkelen, døra som åpnes og dørsonen.
+// Simulation kjører spillet sitt gjennom parkingScript med disse verdiene.
+struct ParkingCourse {
+    std::span<const int> targets;
+    float parkTime = 0.f;         // Scenario::requiredParkTime
+    float maxSpeed = 0.4f;        // m/s; raskere teller ikke som parkert
+    std::uint32_t keyTrigger = 0;
+    std::uint32_t doorTrigger = 0;
+    float doorFrom = 1.f;         // dørhøyde (m) før og etter åpning, og fart (m/s)
+    float doorTo = 4.f;
+    float doorRate = 3.f;
+
+    int targetCount() const { return static_cast<int>(targets.size()); }
+
+    // døra som animasjon fra start (ScriptRuntime-tid)
+    ScriptAnimation door(double start) const { return {start, doorFrom, doorTo, doorRate, true}; }
+};
+
+// Hvor langt skriptet har kommet, som ren data (trivielt kopierbar, ligger i
+// EpisodeState). parkingScript bygget fra denne fortsetter der den slapp.
+struct ParkingProgress {
+    // 0..targets-1: parker i plass nr. objective; så nøkkel, dør som åpnes,
+    // kjør gjennom døra, vunnet (se stegene under)
+    int    objective = 0;
+    float  dwell = 0.f;      // sammenhengende tid parkert i nåværende plass
+    double doorStart = 0.0;  // da nøkkelen ble tatt og døra begynte å gå opp
+    double wonAt = 0.0;
+
+    int  completedTargets(const ParkingCourse& c) const { return objective < c.targetCount() ? objective : c.targetCount(); }
+    bool keyAvailable(const ParkingCourse& c) const { return objective >= c.targetCount(); }
+    bool keyCollected(const ParkingCourse& c) const { return objective >= c.targetCount() + 1; }
+    bool doorOpened(const ParkingCourse& c)   const { return objective >= c.targetCount() + 2; }
+    bool won(const ParkingCourse& c)          const { return objective >= c.targetCount() + 3; }
+
+    float doorHeight(const ParkingCourse& c, double now) const {
+        return keyCollected(c) ? c.door(doorStart).value(now) : c.doorFrom;
+    }
+};
+
+// parkering -> nøkkel -> dør -> seier som skript for kroppen body, fra der progress
+// står; course (og plassene den peker på) og progress må leve til skriptet er ferdig
+ScriptTask parkingScript(ScriptRuntime& rt, std::uint32_t body, const ParkingCourse& course,
+                         ParkingProgress& progress);
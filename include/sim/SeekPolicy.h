@@ -0,0 +1,7 @@
+#pragma once
+
+#include "logic/Simulation.h"
+
+// Enkel tilstandsløs styring mot neste mål (målplass, så nøkkel, så dør).
+// Ignorerer kjegler; brukes som last i benchmarks og batch-kjøringer.
+CarInput seekPolicy(const Simulation& sim);
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "logic/Simulation.h"
+#include "sim/FixedStepper.h"
+#include "sim/InputQueue.h"
+#include "util/LatencyWindow.h"
+#include "util/TripleBuffer.h"
+
+class ReplayWriter;
+
+// Uforanderlig bilde av simuleringen etter et fast steg; alt visningen trenger
+// uten å røre Simulation. Kjeglene publiseres som en delt kopi per episode (cones),
+// så visningen kan holde på dem mens simuleringstråden resetter. Målsekvens og
+// plassens geometri endres bare ved reset og leses direkte fra Simulation når
+// episode er den render-tråden ba om.
+struct SimFrame {
+    std::uint64_t step = 0;        // faste steg siden start
+    std::uint32_t episode = 0;     // resets som er utført (se SimThread::requestReset)
+    std::uint64_t publishedNs = 0;
+    std::uint64_t inputNs = 0;     // tidsstempel for nyeste input-hendelse som er brukt
+    float stepDt = 0.f;
+
+    // før og etter siste steg, for interpolering
+    Vec2  prevCarPos;
+    float prevCarHeading = 0.f;
+    Vec2  carPos;
+    float carHeading = 0.f;
+    float carSpeed = 0.f;
+
+    GameState state = GameState::Playing;
+    int   completedTargets = 0;
+    int   currentTargetSpot = -1;
+    bool  insideTarget = false;
+    float parkedTimer = 0.f;
+    bool  keyAvailable = false;
+    bool  keyCollected = false;
+    bool  doorOpened = false;
+    float doorHeight = 1.f;
+
+    // episodens kjegleposisjoner; nytt objekt ved hver reset, aldri endret etterpå
+    std::shared_ptr<const std::vector<Vec2>> cones;
+
+    std::uint64_t droppedSteps = 0;
+
+    // fra hendelsens tidsstempel til steget som bruker den er kjørt
+    LatencySummary inputToPhysics;
+    std::uint64_t droppedInputs = 0;
+};
+
+// andeler av veggtid siden forrige takeStats()
+struct ThreadSplitStats {
+    LatencySummary inputToPhoton;
+    double simBusy = 0.0;
+    double renderBusy = 0.0;
+    double overlap = 0.0; // begge opptatt samtidig
+};
+
+// Kjører Simulation på egen tråd i faste steg (FixedStepper mot veggklokka) og
+// publiserer et SimFrame gjennom en trippelbuffer etter hvert steg. Input kommer
+// som tidsstemplede hendelser (InputQueue) og legges inn der de hører hjemme i
+// stegene. Render-tråden henter nyeste frame med poll() og melder fra rundt hver
+// frame (beginRender/endRender) så input-til-bilde og overlapp kan måles.
+// Etter start() eier simuleringstråden Simulation alene.
+class SimThread {
+public:
+    explicit SimThread(Simulation& sim, float hz = 120.f, int maxStepsPerFrame = 8);
+    ~SimThread();
+
+    SimThread(const SimThread&) = delete;
+    SimThread& operator=(const SimThread&) = delete;
+
+    // før start(): tar opp input og resets på simuleringstråden; false hvis den kjører
+    bool setRecorder(ReplayWriter* recorder);
+
+    void start();
+    void stop();
+    bool running() const { return thread_.joinable(); }
+
+    float stepDt() const { return stepper_.stepDt(); }
+
+    // --- input: én produsenttråd om gangen (tastatur, eller et skript i benchmarks) ---
+
+    bool push(const InputEvent& e) { return input_.push(e); }
+    InputQueue& input() { return input_; }
+
+    // reset før neste steg; frames med episode == resetsRequested() kommer etter den
+    void requestReset() { resets_.fetch_add(1, std::memory_order_relaxed); }
+    std::uint32_t resetsRequested() const { return resets_.load(std::memory_order_relaxed); }
+
+    // --- render-tråden ---
+
+    // bytter inn nyeste frame; false hvis ingen ny siden sist
+    bool poll() { return frames_.update(); }
+    const SimFrame& frame() const { return frames_.front(); }
+
+    void beginRender();
+    // framen som ble tegnet; nytt inputNs gir en måling av input-til-bilde
+    void endRender(const SimFrame& shown);
+
+    ThreadSplitStats takeStats();
+
+    static constexpr std::size_t latencyWindow = 256;
+
+private:
+    Simulation& sim_;
+    FixedStepper stepper_;
+    ReplayWriter* recorder_ = nullptr;
+
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+
+    InputQueue input_;
+    std::atomic<std::uint32_t> resets_{0};
+    TripleBuffer<SimFrame> frames_;
+
+    // bare simuleringstråden
+    SimFrame next_;
+    std::uint64_t simClockNs_ = 0; // veggtiden simuleringen har kommet til
+
+    // opptatt-intervaller: starttid (0 = ledig) og summer, for overlapp
+    std::atomic<std::uint64_t> simBusySince_{0};
+    std::atomic<std::uint64_t> renderBusySince_{0};
+    std::atomic<std::uint64_t> simBusyNs_{0};
+    std::atomic<std::uint64_t> renderBusyNs_{0};
+    std::atomic<std::uint64_t> overlapNs_{0};
+
+    // bare render-tråden
+    LatencyWindow<latencyWindow> photonLatency_;
+    std::uint64_t lastShownInputNs_ = 0;
+    std::uint64_t statsSinceNs_ = 0;
+
+    void run();
+    void capture();
+    void endBusy(std::atomic<std::uint64_t>& mine, const std::atomic<std::uint64_t>& other,
+                 std::atomic<std::uint64_t>& total);
+};
@@ -0,0 +1,123 @@
+#pragma once
+
+/*
+ * C ABI for batched training: N independent episodes (EpisodeRunner seeds) stepped
+ * together, gym-style. All output goes into caller-owned contiguous buffers (plain
+ * pointers, so they can live in numpy arrays or shared memory); a step copies no
+ * episode state out except the observation rows and allocates nothing.
+ *
+ * Layout (row-major, one row per episode):
+ *   actions       N x CAR_GYM_ACTION_SIZE  float  throttle -1..1, steer -1..1, handbrake (> 0.5 = on)
+ *   observations  N x CAR_GYM_OBS_SIZE     float  see CAR_GYM_OBS_*; offsets are in the car's frame
+ *                                                 (x = right, z = forward)
+ *   rewards       N                        float
+ *   dones         N                        uint8  CAR_GYM_RUNNING / CAR_GYM_WON / CAR_GYM_TIME_LIMIT
+ *   final_observations  N x CAR_GYM_OBS_SIZE  float  optional, see car_gym_step
+ *
+ * With auto_reset, a finished episode is reset inside the same step and its row holds
+ * the first observation of the next episode; rewards and dones still describe the
+ * step that finished it. Pass final_observations to car_gym_step to also get the
+ * observation the episode finished in (needed to bootstrap the value of a truncated
+ * episode).
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32) && defined(CAR_GYM_BUILD)
+#define CAR_GYM_API __declspec(dllexport)
+#elif defined(_WIN32)
+#define CAR_GYM_API __declspec(dllimport)
+#else
+#define CAR_GYM_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    CAR_GYM_OBS_POS_X = 0,
+    CAR_GYM_OBS_POS_Z,
+    CAR_GYM_OBS_HEADING_SIN,
+    CAR_GYM_OBS_HEADING_COS,
+    CAR_GYM_OBS_SPEED,
+    CAR_GYM_OBS_TARGET_DX,     /* current target spot (0 when none left) */
+    CAR_GYM_OBS_TARGET_DZ,
+    CAR_GYM_OBS_HAS_TARGET,
+    CAR_GYM_OBS_PARKED,        /* parked time / required park time */
+    CAR_GYM_OBS_COMPLETED,     /* completed targets / required targets */
+    CAR_GYM_OBS_KEY_AVAILABLE,
+    CAR_GYM_OBS_KEY_COLLECTED,
+    CAR_GYM_OBS_DOOR_OPENED,
+    CAR_GYM_OBS_KEY_DX,
+    CAR_GYM_OBS_KEY_DZ,
+    CAR_GYM_OBS_DOOR_DX,
+    CAR_GYM_OBS_DOOR_DZ,
+    CAR_GYM_OBS_CONES          /* CAR_GYM_NEAREST_CONES x (dx, dz, present), nearest first */
+};
+
+enum {
+    CAR_GYM_NEAREST_CONES = 4,
+    CAR_GYM_OBS_SIZE = CAR_GYM_OBS_CONES + 3 * CAR_GYM_NEAREST_CONES,
+    CAR_GYM_ACTION_SIZE = 3
+};
+
+enum {
+    CAR_GYM_RUNNING = 0,
+    CAR_GYM_WON = 1,        /* terminated */
+    CAR_GYM_TIME_LIMIT = 2  /* truncated */
+};
+
+enum {
+    CAR_GYM_OK = 0,
+    CAR_GYM_EINVAL = -1,    /* null handle or buffer, or index out of range */
+    CAR_GYM_EFAIL = -2      /* internal error (e.g. out of memory); output rows may be partly
+                               written, so reset before stepping again */
+};
+
+typedef struct car_gym_config {
+    uint32_t episodes;
+    uint64_t seed;             /* base seed; episode i gets EpisodeRunner::episodeSeed(seed, i) */
+    uint32_t threads;          /* 0 = hardware concurrency */
+    float    dt;               /* physics step */
+    uint32_t frame_skip;       /* physics steps per car_gym_step, same action */
+    uint32_t max_steps;        /* physics steps before CAR_GYM_TIME_LIMIT (0 = none) */
+    int32_t  auto_reset;
+    float    cone_range;       /* cones further away than this are not observed */
+
+    float reward_target;       /* per completed target spot */
+    float reward_key;
+    float reward_win;
+    float reward_step;         /* per physics step (usually negative) */
+    float reward_progress;     /* per metre closer to the current goal */
+
+    const char* scenario_path; /* .scn file, or NULL for the default game */
+} car_gym_config;
+
+typedef struct car_gym car_gym;
+
+CAR_GYM_API void car_gym_default_config(car_gym_config* cfg);
+
+/* NULL if cfg is invalid or the scenario file cannot be loaded */
+CAR_GYM_API car_gym* car_gym_create(const car_gym_config* cfg);
+CAR_GYM_API void car_gym_destroy(car_gym* gym);
+
+CAR_GYM_API uint32_t car_gym_size(const car_gym* gym);
+
+/* resets every episode and writes their first observations */
+CAR_GYM_API int car_gym_reset(car_gym* gym, float* observations);
+
+/* resets one episode and writes its row (observations points at the whole N-row buffer) */
+CAR_GYM_API int car_gym_reset_one(car_gym* gym, uint32_t episode, float* observations);
+
+/* final_observations may be NULL. Otherwise, for every episode whose done is not
+ * CAR_GYM_RUNNING, its row gets the observation from before the auto reset (the same
+ * as the observations row when auto_reset is off); rows of running episodes are left
+ * untouched. */
+CAR_GYM_API int car_gym_step(car_gym* gym, const float* actions, float* observations,
+                             float* rewards, uint8_t* dones, float* final_observations);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Gjenbrukbare entiteter (meshes, markører): alt lages på forhånd eller første
+// gang det trengs, og releaseAll() gir dem tilbake uten å frigjøre noe.
+// Aktive elementer ligger først i items_, så iterasjon er bare en span.
+template <class T>
+class EntityPool {
+public:
+    // lager n elementer med make() (kalles med indeks) på forhånd
+    template <class Make>
+    void preallocate(std::size_t n, Make&& make) {
+        items_.reserve(n);
+        while (items_.size() < n) items_.push_back(make(items_.size()));
+    }
+
+    // neste ledige element; lager et nytt med make() bare hvis poolen er tom
+    template <class Make>
+    T& acquire(Make&& make) {
+        if (active_ == items_.size()) {
+            items_.push_back(make(items_.size()));
+            ++grown_;
+        }
+        return items_[active_++];
+    }
+
+    // kaller onRelease(element) for alle aktive og gjør dem ledige igjen
+    template <class OnRelease>
+    void releaseAll(OnRelease&& onRelease) {
+        for (std::size_t i = 0; i < active_; ++i) onRelease(items_[i]);
+        active_ = 0;
+    }
+
+    std::span<T> active() { return {items_.data(), active_}; }
+    std::span<const T> active() const { return {items_.data(), active_}; }
+
+    std::size_t activeCount() const { return active_; }
+    std::size_t capacity() const { return items_.size(); }
+    // antall ganger acquire måtte lage et nytt element etter preallokering
+    std::size_t grown() const { return grown_; }
+
+private:
+    std::vector<T> items_;
+    std::size_t active_ = 0;
+    std::size_t grown_ = 0;
+};
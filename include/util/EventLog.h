@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+// Asynkron logg for HUD og spillhendelser.
+// Produsenten (simuleringstråden) legger binære poster i en lock-free SPSC-ringbuffer;
+// en bakgrunnstråd formaterer og skriver dem. write() blokkerer aldri: er ringen full
+// telles posten som droppet. Én produsenttråd per EventLog.
+
+enum class LogKind : std::uint8_t {
+    Text,            // text er en strengliteral
+    Intro,           // requiredTargets, requiredParkTime
+    Reset,
+    TargetCompleted, // completedTargets, spotIndex
+    KeySpawned,
+    KeyCollected,
+    DoorOpened,
+    Won,
+    Hud,             // speed, completed, required, parkHold (<0 = ikke i mål), requiredParkTime
+    HudDrops,        // droppede steg, droppede loggposter, droppede input-hendelser
+    PhaseStats,      // p50, p99, maks (ms); text = fasenavn
+    HudLatency,      // p50, p99, maks (ms), antall målinger; text = hva som er målt
+    HudThreads,      // sim opptatt, render opptatt, begge samtidig (% av veggtid)
+};
+
+struct LogRecord {
+    std::uint64_t timeNs = 0;
+    const char* text = nullptr; // bare strengliteraler (lever hele programmet)
+    LogKind kind = LogKind::Text;
+    std::uint8_t count = 0;
+    double args[5] = {};
+};
+
+// formaterer en post som tekst (med linjeskift); returnerer antall tegn skrevet
+std::size_t formatLogRecord(const LogRecord& rec, char* buf, std::size_t cap);
+
+class EventLog {
+public:
+    // out må leve til loggen er ødelagt; capacity rundes opp til en toerpotens
+    explicit EventLog(std::FILE* out = stdout, std::size_t capacity = 4096);
+    // flush med tidsgrense (exitFlushTimeout) og stopp; henger skriveren, slippes tråden
+    ~EventLog();
+
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    static constexpr std::chrono::milliseconds exitFlushTimeout{200};
+
+    template <class... Args>
+    bool write(LogKind kind, Args... args) {
+        static_assert(sizeof...(Args) <= 5, "at most 5 log arguments");
+        LogRecord rec;
+        rec.kind = kind;
+        rec.count = static_cast<std::uint8_t>(sizeof...(Args));
+        std::size_t i = 0;
+        ((rec.args[i++] = static_cast<double>(args)), ...);
+        return push(rec);
+    }
+
+    bool text(const char* literal) {
+        LogRecord rec;
+        rec.text = literal;
+        return push(rec);
+    }
+
+    bool push(LogRecord rec);
+
+    // venter til alt som er skrevet før kallet er formatert og flushet, maks timeout
+    bool flush(std::chrono::milliseconds timeout);
+
+    std::uint64_t dropped() const;
+    std::uint64_t written() const;
+
+private:
+    struct State;
+    std::shared_ptr<State> state_;
+    std::thread drain_;
+};
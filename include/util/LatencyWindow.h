@@ -0,0 +1,43 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+struct LatencySummary {
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    std::size_t samples = 0;
+};
+
+// Rullerende vindu med de siste N målingene (ms); én tråd skriver og leser.
+template <std::size_t N = 256>
+class LatencyWindow {
+public:
+    void add(double ms) {
+        samples_[count_ % N] = ms;
+        ++count_;
+    }
+
+    LatencySummary summary() const {
+        LatencySummary s;
+        const std::size_t n = std::min(count_, N);
+        if (n == 0) return s;
+
+        std::array<double, N> sorted;
+        std::copy_n(samples_.begin(), n, sorted.begin());
+        std::sort(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(n));
+        s.p50Ms = sorted[n / 2];
+        s.p99Ms = sorted[std::min(n - 1, n * 99 / 100)];
+        s.maxMs = sorted[n - 1];
+        s.samples = n;
+        return s;
+    }
+
+    std::size_t total() const { return count_; }
+
+private:
+    std::array<double, N> samples_{};
+    std::size_t count_ = 0;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Fase-profiler for frame-løkken.
+// PROFILE_SCOPE(fase) måler tiden til slutten av scopet og skriver et event i en
+// ringbuffer per tråd (én skriver, ingen låser på den varme stien). Ringbufferne
+// kan dumpes som Chrome trace-event JSON (chrome://tracing, Perfetto).
+// Hver tråd summerer også tid per fase per frame; endFrame(vindu) legger den
+// kallende trådens summer inn i et rullerende vindu som gir p50/p99/maks per fase.
+// Render-tråden lukker en frame per rendret bilde (ProfWindow::Render), simuleringstråden
+// en per publiserte SimFrame (ProfWindow::Sim).
+//
+// Bygg med CAR_SIM_PROFILE=0 for å fjerne alle målepunktene ved kompilering.
+// Ellers er de av til Profiler::setEnabled(true) (én relaxed load per scope).
+
+#ifndef CAR_SIM_PROFILE
+#define CAR_SIM_PROFILE 1
+#endif
+
+enum class ProfPhase : std::uint8_t {
+    Frame,
+    SimStep,
+    CarUpdate,
+    Cones,
+    Triggers,
+    Script,
+    Events,
+    SyncScene,
+    CameraChase,
+    Streaming,
+    Hud,
+    Render,
+    Count
+};
+
+const char* profPhaseName(ProfPhase phase);
+
+// hvilken tråds frames et rullerende vindu samler
+enum class ProfWindow : std::uint8_t {
+    Render,
+    Sim,
+    Count
+};
+
+struct ProfEvent {
+    ProfPhase phase = ProfPhase::Frame;
+    std::uint32_t tid = 0;
+    std::uint64_t startNs = 0;
+    std::uint64_t durNs = 0;
+};
+
+struct PhaseSummary {
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    std::size_t frames = 0;
+};
+
+class Profiler {
+public:
+    static constexpr std::size_t ringCapacity = 1u << 14; // events per tråd
+    static constexpr std::size_t windowFrames = 240;      // rullerende vindu
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void setEnabled(bool on) { enabled_.store(on, std::memory_order_relaxed); }
+
+    static std::uint64_t nowNs() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // kalles av ProfileScope; skriver til den kallende trådens ringbuffer
+    static void record(ProfPhase phase, std::uint64_t startNs, std::uint64_t endNs);
+
+    // lukker en frame på kallende tråd: legger trådens fasesummer i vinduet
+    static void endFrame(ProfWindow window = ProfWindow::Render);
+
+    // p50/p99/maks av tid per frame i fasen over de siste windowFrames framene i vinduet
+    static PhaseSummary summary(ProfPhase phase, ProfWindow window = ProfWindow::Render);
+
+    // kopi av alle events som fortsatt ligger i ringbufferne, sortert på starttid
+    static std::vector<ProfEvent> snapshot();
+
+    // Chrome trace-event JSON ("ph": "X"); false hvis filen ikke kunne skrives
+    static bool writeChromeTrace(const std::string& path);
+
+    // tømmer ringbuffere og vinduer (for tester)
+    static void clear();
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfPhase phase)
+        : phase_(phase), start_(Profiler::enabled() ? Profiler::nowNs() : 0) {}
+
+    ~ProfileScope() {
+        if (start_ != 0) Profiler::record(phase_, start_, Profiler::nowNs());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfPhase phase_;
+    std::uint64_t start_;
+};
+
+#define CAR_PROF_CAT2(a, b) a##b
+#define CAR_PROF_CAT(a, b) CAR_PROF_CAT2(a, b)
+
+#if CAR_SIM_PROFILE
+#define PROFILE_SCOPE(phase) ProfileScope CAR_PROF_CAT(profScope_, __LINE__)(ProfPhase::phase)
+#else
+#define PROFILE_SCOPE(phase) ((void) 0)
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+// PCG32 (pcg-random.org): 16 byte tilstand, rask og lik på alle plattformer.
+// Brukes i stedet for std::mt19937 + std::*_distribution, hvis resultater
+// er implementasjonsavhengige; replays må gi samme bane overalt.
+class Rng {
+public:
+    using result_type = std::uint32_t;
+
+    explicit Rng(std::uint64_t seed = 0x853c49e6748fea9bull, std::uint64_t stream = 0xda3e39cb94b95bdbull) {
+        reseed(seed, stream);
+    }
+
+    void reseed(std::uint64_t seed, std::uint64_t stream = 0xda3e39cb94b95bdbull) {
+        state_ = 0u;
+        inc_ = (stream << 1u) | 1u;
+        next();
+        state_ += seed;
+        next();
+    }
+
+    std::uint32_t next() {
+        std::uint64_t old = state_;
+        state_ = old * 6364136223846793005ull + inc_;
+        auto xorshifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+        auto rot = static_cast<std::uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+    }
+
+    // [0, 1) med 24 bits oppløsning
+    float uniform01() { return static_cast<float>(next() >> 8) * (1.f / 16777216.f); }
+
+    // [a, b)
+    float uniform(float a, float b) { return a + (b - a) * uniform01(); }
+
+    // heltall i [0, n), uten skjevhet (Lemire)
+    std::uint32_t below(std::uint32_t n) {
+        std::uint64_t m = static_cast<std::uint64_t>(next()) * n;
+        auto low = static_cast<std::uint32_t>(m);
+        if (low < n) {
+            std::uint32_t threshold = (0u - n) % n;
+            while (low < threshold) {
+                m = static_cast<std::uint64_t>(next()) * n;
+                low = static_cast<std::uint32_t>(m);
+            }
+        }
+        return static_cast<std::uint32_t>(m >> 32u);
+    }
+
+    // UniformRandomBitGenerator
+    static constexpr result_type min() { return 0u; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    result_type operator()() { return next(); }
+
+    bool operator==(const Rng&) const = default;
+
+private:
+    std::uint64_t state_ = 0u;
+    std::uint64_t inc_ = 1u;
+};
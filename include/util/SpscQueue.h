@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Begrenset lock-free kø for én produsent og én konsument (samme oppsett som
+// ringen i EventLog). push() og pop() blokkerer aldri; full kø gir false.
+template <class T>
+class SpscQueue {
+public:
+    // capacity rundes opp til en toerpotens
+    explicit SpscQueue(std::size_t capacity = 1024) {
+        std::size_t cap = 1;
+        while (cap < capacity) cap <<= 1;
+        slots_ = std::make_unique<T[]>(cap);
+        mask_ = cap - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    std::size_t capacity() const { return mask_ + 1; }
+
+    // produsent
+    bool push(const T& value) {
+        const std::uint64_t h = head_.load(std::memory_order_relaxed);
+        if (h - tail_.load(std::memory_order_acquire) > mask_) return false;
+        slots_[h & mask_] = value;
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // konsument
+    bool pop(T& out) {
+        const std::uint64_t t = tail_.load(std::memory_order_relaxed);
+        if (t == head_.load(std::memory_order_acquire)) return false;
+        out = slots_[t & mask_];
+        tail_.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::unique_ptr<T[]> slots_;
+    std::size_t mask_ = 0;
+
+    alignas(64) std::atomic<std::uint64_t> head_{0}; // skrevet av produsent
+    alignas(64) std::atomic<std::uint64_t> tail_{0}; // skrevet av konsument
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Enkel work-stealing trådpool for parallelFor over uavhengige biter.
+// Hver arbeider har sin egen kø: den tar fra bakenden av sin egen og stjeler
+// fra forenden av de andre når den går tom. Kallende tråd er arbeider 0.
+// parallelFor er ikke reentrant (én jobb om gangen).
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // antall arbeidere, inkludert kallende tråd
+    unsigned size() const { return static_cast<unsigned>(queues_.size()); }
+
+    // kaller fn(begin, end) for biter av [0, n) på maks grain elementer; blokkerer til alt er ferdig.
+    // Kaster fn, hoppes resten av bitene over og det første unntaket kastes videre her.
+    void parallelFor(std::size_t n, std::size_t grain,
+                     const std::function<void(std::size_t, std::size_t)>& fn);
+
+    // antall biter som ble stjålet fra en annen kø (for statistikk)
+    std::size_t steals() const { return steals_.load(std::memory_order_relaxed); }
+
+private:
+    struct Range {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    // [head, ranges.size()) er køen; vektoren tømmes når den går tom og beholder
+    // kapasiteten, så en parallelFor etter den første allokerer ikke
+    struct alignas(64) WorkQueue {
+        std::mutex m;
+        std::vector<Range> ranges;
+        std::size_t head = 0;
+
+        bool empty() const { return head == ranges.size(); }
+        void trim() {
+            if (empty()) {
+                ranges.clear();
+                head = 0;
+            }
+        }
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::uint64_t generation_ = 0;
+    bool stop_ = false;
+
+    const std::function<void(std::size_t, std::size_t)>* job_ = nullptr;
+    std::atomic<std::size_t> remaining_{0};
+    std::atomic<bool> failed_{false};
+    std::exception_ptr error_; // første unntak fra jobben, under wakeMutex_
+    std::atomic<std::size_t> steals_{0};
+
+    void workerLoop(unsigned index);
+    bool runOne(unsigned index);
+    bool popLocal(unsigned index, Range& out);
+    bool steal(unsigned index, Range& out);
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Lock-free trippelbuffer for én skriver og én leser: skriveren fyller en bakbuffer
+// og bytter den inn som "nyeste" med én atomisk exchange; leseren bytter til seg
+// nyeste når det finnes noe nytt. Ingen av sidene venter på den andre, og leseren
+// ser alltid en hel verdi (mellomliggende verdier kan hoppes over).
+template <class T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& initial) : slots_{initial, initial, initial} {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // skriversiden: fyll back() og kall publish()
+    T& back() { return slots_[back_]; }
+
+    void publish() {
+        // bakbufferen blir midtbuffer (merket ny); den gamle midtbufferen blir ny bakbuffer
+        std::uint8_t prev = middle_.exchange(static_cast<std::uint8_t>(back_ | freshBit), std::memory_order_acq_rel);
+        back_ = prev & indexMask;
+    }
+
+    void publish(const T& value) {
+        back() = value;
+        publish();
+    }
+
+    // lesersiden: bytter inn nyeste verdi hvis det er kommet en; false ellers
+    bool update() {
+        if (!(middle_.load(std::memory_order_relaxed) & freshBit)) return false;
+        std::uint8_t prev = middle_.exchange(front_, std::memory_order_acq_rel);
+        front_ = prev & indexMask;
+        return true;
+    }
+
+    // siste verdi leseren har byttet inn
+    const T& front() const { return slots_[front_]; }
+
+private:
+    static constexpr std::uint8_t freshBit = 0x4;
+    static constexpr std::uint8_t indexMask = 0x3;
+
+    T slots_[3]{};
+    std::uint8_t back_ = 0;               // bare skriveren
+    std::uint8_t front_ = 1;              // bare leseren
+    std::atomic<std::uint8_t> middle_{2}; // delt: indeks + ny-bit
+};
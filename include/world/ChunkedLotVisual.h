@@ -0,0 +1,63 @@
+#pragma once
+
+#include <threepp/threepp.hpp>
+#include <memory>
+#include <vector>
+
+#include "world/LotChunks.h"
+
+struct BakedWorld;
+
+// Strømmet visning av parkeringsplassen: asfalt, oppmerking og kjegler bygges per
+// chunk rundt bilen (LotChunks/ChunkStreamer) og fjernes når den kjører bort.
+// Nære chunks har full detalj (instansierte streker, kjegler med 12 segmenter),
+// fjerne chunks har én sammenslått LineSegments og kjegler med 5 segmenter.
+// Chunks utenfor kameraets frustum skjules.
+class ChunkedLotVisual {
+public:
+    ChunkedLotVisual(threepp::Scene& scene, const ParkingLot& lot,
+                     float chunkSize = 32.f, StreamingParams params = {});
+
+    // bruker chunk-bøttene og linjeverteksene fra en bakt verden (må leve like lenge)
+    ChunkedLotVisual(threepp::Scene& scene, const ParkingLot& lot,
+                     const BakedWorld& baked, StreamingParams params = {});
+    ~ChunkedLotVisual();
+
+    ChunkedLotVisual(const ChunkedLotVisual&) = delete;
+    ChunkedLotVisual& operator=(const ChunkedLotVisual&) = delete;
+
+    // nye kjegleposisjoner (reset); residente chunks oppdateres på stedet. Visningen
+    // holder på kopien (SimFrame::cones), aldri på Simulation sin vektor
+    void setCones(std::shared_ptr<const std::vector<Vec2>> cones);
+
+    // laster alt innenfor loadRadius med én gang (oppstart, reset)
+    void prime(Vec2 focus);
+
+    // strømmer chunks rundt focus med byggebudsjett, og culler mot frustum
+    void update(Vec2 focus, const threepp::Frustum& frustum);
+
+    std::size_t residentChunks() const { return streamer_.resident().size(); }
+    std::size_t visibleChunks() const { return visible_; }
+    const LotChunks& chunks() const { return chunks_; }
+
+private:
+    struct Assets;
+    struct Chunk;
+
+    threepp::Scene& scene_;
+    const ParkingLot& lot_;
+    LotChunks chunks_;
+    ChunkStreamer streamer_;
+    std::unique_ptr<Assets> assets_;
+    std::vector<std::unique_ptr<Chunk>> slots_; // indeksert på chunk, tom når ikke lastet
+    std::vector<std::unique_ptr<Chunk>> free_;  // gjenbrukes ved neste lasting
+    std::shared_ptr<const std::vector<Vec2>> cones_;
+    std::span<const float> bakedLines_; // 18 float per plass i chunk-rekkefølge
+    std::size_t visible_ = 0;
+
+    void applyChanges();
+    void build(int chunk, ChunkLod lod);
+    void buildLines(Chunk& c, int chunk, ChunkLod lod);
+    void buildCones(Chunk& c, int chunk, ChunkLod lod);
+    void evict(int chunk);
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "math/Vec2.h"
+#include "world/Obb.h"
+
+// Uniformt rutenett over parkeringsplassen for kjegle-kollisjoner.
+// Kjeglene lagres sortert per celle (CSR: cellStart_ + flate arrays), så et
+// oppslag leser bare de sammenhengende kjeglene i cellene rundt bilen.
+class ConeGrid {
+public:
+    // rutenett som dekker [minCorner, minCorner + (width, depth)]
+    void configure(Vec2 minCorner, float width, float depth, float cellSize);
+
+    // bygger cellene på nytt fra posisjonene; gjenbruker bufferne
+    void rebuild(const std::vector<Vec2>& positions);
+
+    // indeks (i positions fra rebuild) til første kjegle nærmere enn radius, ellers -1
+    int firstWithin(Vec2 p, float radius) const;
+
+    // indeks til første kjegle (sirkel med radius) som overlapper boksen, ellers -1
+    int firstOverlapping(const Obb& box, float radius) const;
+
+    // sveip: sirkel med radius fra from til to; indeks til kjeglen den treffer først
+    // (toi = andel av strekningen før kontakt), ellers -1. Fanger også kjegler
+    // som et diskret test mot sluttposisjonen ville hoppet over.
+    int sweepFirst(Vec2 from, Vec2 to, float radius, float& toi) const;
+
+    // samme for en boks som flyttes med d (kjeglene som sirkler med radius)
+    int sweepFirstBox(const Obb& box, Vec2 d, float radius, float& toi) const;
+
+    // kaller f(index, pos) for alle kjegler i cellene som overlapper boksen
+    template <class F>
+    void forEachInBox(Vec2 boxMin, Vec2 boxMax, F&& f) const;
+
+    int   cols()     const { return cols_; }
+    int   rows()     const { return rows_; }
+    float cellSize() const { return cellSize_; }
+    std::size_t size() const { return cellPos_.size(); }
+
+private:
+    Vec2  origin_;
+    float cellSize_ = 1.f;
+    float invCell_  = 1.f;
+    int   cols_ = 0;
+    int   rows_ = 0;
+
+    std::vector<std::uint32_t> cellStart_; // cols_*rows_ + 1
+    std::vector<Vec2>          cellPos_;   // posisjoner i cellerekkefølge
+    std::vector<std::uint32_t> cellIds_;   // opprinnelig indeks for hver cellPos_
+    std::vector<std::uint32_t> coneCell_;  // scratch: celle per kjegle under rebuild
+
+    int cellX(float x) const;
+    int cellZ(float z) const;
+};
+
+// klemmes i flyttall før konvertering: NaN og verdier utenfor int er UB i static_cast
+// (NaN havner i celle 0)
+inline int ConeGrid::cellX(float x) const {
+    const float c = std::floor((x - origin_.x) * invCell_);
+    return c >= static_cast<float>(cols_) ? cols_ - 1 : (c >= 0.f ? static_cast<int>(c) : 0);
+}
+
+inline int ConeGrid::cellZ(float z) const {
+    const float r = std::floor((z - origin_.z) * invCell_);
+    return r >= static_cast<float>(rows_) ? rows_ - 1 : (r >= 0.f ? static_cast<int>(r) : 0);
+}
+
+template <class F>
+void ConeGrid::forEachInBox(Vec2 boxMin, Vec2 boxMax, F&& f) const {
+    if (cellPos_.empty()) return;
+
+    const int c0 = cellX(boxMin.x), c1 = cellX(boxMax.x);
+    const int r0 = cellZ(boxMin.z), r1 = cellZ(boxMax.z);
+
+    for (int r = r0; r <= r1; ++r) {
+        // cellene c0..c1 i en rad ligger etter hverandre i cellPos_
+        const std::uint32_t begin = cellStart_[r * cols_ + c0];
+        const std::uint32_t end   = cellStart_[r * cols_ + c1 + 1];
+        for (std::uint32_t k = begin; k < end; ++k) {
+            f(static_cast<int>(cellIds_[k]), cellPos_[k]);
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/Vec2.h"
+#include "world/Parking.h"
+
+// Deler parkeringsplassen i kvadratiske chunks for strømming av visningen.
+// Plasser (etter senter) og kjegler bøttes per chunk med tellesortering (CSR),
+// så en chunk kan bygges uten å se på resten av plassen.
+class LotChunks {
+public:
+    void configure(const ParkingLot& lot, float chunkSize);
+
+    // som configure, men med plassbøttene ferdig sortert (WorldCache); faller tilbake
+    // til å bøtte selv hvis antall chunks ikke stemmer
+    void configure(const ParkingLot& lot, float chunkSize,
+                   std::span<const std::uint32_t> chunkStart,
+                   std::span<const std::uint32_t> chunkSpots);
+
+    // nye kjegleposisjoner (reset); gjenbruker bufferne
+    void setCones(const std::vector<Vec2>& cones);
+
+    int cols()  const { return cols_; }
+    int rows()  const { return rows_; }
+    int count() const { return cols_ * rows_; }
+    float chunkSize() const { return chunkSize_; }
+
+    // chunk som inneholder p (klampet til rutenettet)
+    int chunkAt(Vec2 p) const;
+    int chunkX(int chunk) const { return chunk % cols_; }
+    int chunkZ(int chunk) const { return chunk / cols_; }
+
+    // utstrekning klippet mot plassen
+    Vec2 chunkMin(int chunk) const;
+    Vec2 chunkMax(int chunk) const;
+
+    // avstand fra p til nærmeste punkt i chunken (0 inne i den)
+    float distanceTo(int chunk, Vec2 p) const;
+
+    std::span<const std::uint32_t> spotsIn(int chunk) const;
+    std::span<const std::uint32_t> conesIn(int chunk) const;
+
+    // posisjonen til chunkens første plass i den chunk-sorterte rekkefølgen
+    std::size_t spotOffset(int chunk) const { return spotStart_[static_cast<std::size_t>(chunk)]; }
+
+private:
+    Vec2 origin_;
+    Vec2 extent_;
+    float chunkSize_ = 1.f;
+    float invChunk_ = 1.f;
+    int cols_ = 0;
+    int rows_ = 0;
+
+    std::vector<std::uint32_t> spotStart_, spotIds_;
+    std::vector<std::uint32_t> coneStart_, coneIds_;
+
+    void configureGrid(const ParkingLot& lot, float chunkSize);
+    void bucket(std::span<const Vec2> points, std::vector<std::uint32_t>& start,
+                std::vector<std::uint32_t>& ids) const;
+
+    std::vector<Vec2> scratch_;
+};
+
+enum class ChunkLod : std::int8_t { None = -1, Near = 0, Far = 1 };
+
+struct StreamingParams {
+    float loadRadius  = 120.f; // chunks nærmere enn dette lastes
+    float evictRadius = 160.f; // og fjernes først når de er lenger unna (hysterese)
+    float lodDistance = 50.f;  // lenger unna enn dette: forenklet geometri
+    int   maxLoadsPerUpdate = 4; // begrenser byggekostnaden per frame
+};
+
+struct ChunkChange {
+    int chunk = 0;
+    ChunkLod from = ChunkLod::None;
+    ChunkLod to = ChunkLod::None; // None = fjern
+};
+
+// Bestemmer hvilke chunks som skal ligge i minnet og med hvilken LOD.
+// Antall residente chunks er begrenset av evictRadius, ikke av plassens størrelse.
+class ChunkStreamer {
+public:
+    explicit ChunkStreamer(StreamingParams params = {}) : params_(params) {}
+
+    // glemmer alle residente chunks
+    void reset(const LotChunks& chunks);
+
+    // flytter fokus (bilen); endringene ligger i changes() til neste kall
+    void update(const LotChunks& chunks, Vec2 focus);
+    // som update, men uten grense på antall lastinger (oppstart, teleport)
+    void loadAll(const LotChunks& chunks, Vec2 focus);
+
+    std::span<const ChunkChange> changes() const { return changes_; }
+    std::span<const int> resident() const { return resident_; }
+    ChunkLod lod(int chunk) const { return lod_[static_cast<std::size_t>(chunk)]; }
+    // chunks innenfor loadRadius som ikke er lastet ennå (budsjettet brukt opp)
+    std::size_t pending() const { return pending_; }
+
+    const StreamingParams& params() const { return params_; }
+
+private:
+    StreamingParams params_;
+    std::vector<ChunkLod> lod_;
+    std::vector<int> resident_;
+    std::vector<ChunkChange> changes_;
+    std::vector<std::pair<float, int>> candidates_;
+    std::size_t pending_ = 0;
+
+    void step(const LotChunks& chunks, Vec2 focus, std::size_t maxLoads);
+    ChunkLod lodFor(float distance) const;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/Vec2.h"
+
+// Orientert boks i bakkeplanet. axis er enhetsvektoren framover (samme retning som
+// Car::heading: (sin h, cos h)); halfD langs axis, halfW langs høyre-aksen.
+struct Obb {
+    Vec2  center;
+    Vec2  axis{0.f, 1.f};
+    float halfW = 0.f;
+    float halfD = 0.f;
+
+    Vec2 right() const { return {axis.z, -axis.x}; }
+};
+
+inline Obb makeCarObb(Vec2 pos, float heading, float halfW, float halfD) {
+    return {pos, {std::sin(heading), std::cos(heading)}, halfW, halfD};
+}
+
+// halve utstrekninger langs x og z (AABB rundt boksen)
+inline Vec2 obbExtents(const Obb& b) {
+    return {std::abs(b.axis.z) * b.halfW + std::abs(b.axis.x) * b.halfD,
+            std::abs(b.axis.x) * b.halfW + std::abs(b.axis.z) * b.halfD};
+}
+
+// separerende akse-test (SAT) over de fire kantnormalene
+bool overlaps(const Obb& a, const Obb& b);
+
+// boks mot sirkel (kjegle): nærmeste punkt i boksens lokale ramme
+bool overlapsCircle(const Obb& b, Vec2 c, float r);
+
+// hele boksen innenfor [min, max]
+bool insideRect(const Obb& b, Vec2 min, Vec2 max);
+
+// Sveipet boks mot sirkel: boksen flyttes med d (uten rotasjon, som i ett
+// Car::update-steg). Tiden t i [0, 1] for første kontakt; overlapper de allerede,
+// er det treff (t = 0) bare når boksen beveger seg innover.
+bool sweepObbCircle(const Obb& b, Vec2 d, Vec2 c, float r, float& toi);
+
+struct BodyPair {
+    std::uint32_t a, b; // a < b
+};
+
+// smalfase for mange par: legger parene der boksene overlapper til i hits.
+// Parene hentes inn i blokker som SoA, så SAT-testen kjøres uten greiner og
+// kan vektoriseres av kompilatoren.
+void overlapsBatch(std::span<const Obb> bodies, std::span<const BodyPair> pairs,
+                   std::vector<BodyPair>& hits);
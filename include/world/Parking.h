@@ -1,31 +1,55 @@
 #pragma once
 
-#include <threepp/threepp.hpp>
+#include "math/Vec2.h"
+#include "util/Rng.h"
+
 #include <vector>
-#include <memory>
 
 struct ParkingSpot {
-    threepp::Vector3 center;
-    float halfW;
-    float halfD;
+    Vec2  center;
+    float halfW = 0.f;
+    float halfD = 0.f;
     bool  completed = false;
+};
+
+// Regulært rutenett av plasser: rows rader med cols plasser, kjørefelt mellom radene.
+struct LotLayout {
+    int   rows      = 12;
+    int   cols      = 24;
+    float slotW     = 2.6f;
+    float slotD     = 5.2f;
+    float laneWidth = 3.0f;
+    float margin    = 1.0f;
+};
 
-    std::shared_ptr<threepp::Group> visual;
-    std::shared_ptr<threepp::Mesh>  completeMarker;
+struct ParkingLot {
+    LotLayout layout;
+    Vec2  center;
+    float width = 0.f;
+    float depth = 0.f;
+    std::vector<ParkingSpot> spots;
 };
 
-void addParkingLot(threepp::Scene& scene,
-                   std::vector<ParkingSpot>& spots,
-                   threepp::Vector3& lotCenterOut,
-                   float& lotWidthOut,
-                   float& lotDepthOut);
+void generateParkingLot(ParkingLot& lot, const LotLayout& layout = {});
 
 bool isCarInsideSpot(const ParkingSpot& s,
-                     const threepp::Vector3& carPos,
+                     Vec2 carPos,
                      float carHalfW,
                      float carHalfD);
 
-std::vector<int> makeRandomTargetSequence(int totalSpots, int count);
+// samme regel, men rotert med bilen: en boks på en fjerdedel av bilens mål, rundt
+// bilens sentrum og med bilens heading, må ligge inne i plassen. Lik versjonen
+// over når heading er 0 eller pi.
+bool isCarInsideSpot(const ParkingSpot& s,
+                     Vec2 carPos,
+                     float carHeading,
+                     float carHalfW,
+                     float carHalfD);
+
+std::vector<int> makeRandomTargetSequence(int totalSpots, int count, Rng& rng);
 
-void updateTargetMarkerPosition(const std::shared_ptr<threepp::Mesh>& marker,
-                                const ParkingSpot& spot);
+// samme sekvens, skrevet til out; gjenbruker kapasiteten (out er også stokkebuffer)
+void makeRandomTargetSequence(int totalSpots, int count, Rng& rng, std::vector<int>& out);
+
+// samme, seedet fra std::random_device
+std::vector<int> makeRandomTargetSequence(int totalSpots, int count);
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/Vec2.h"
+#include "world/Parking.h"
+
+// Svarer på "hvilken plass står denne posisjonen i?" for mange biler.
+// For regulære rows x cols-plasser (fra generateParkingLot) regnes indeksen ut
+// aritmetisk; for uregelmessige plasser brukes et BVH over plassenes AABB-er.
+// En plass dekker [center - half, center + half) i begge akser.
+class ParkingLotIndex {
+public:
+    void build(const ParkingLot& lot);
+
+    bool isRegular() const { return regular_; }
+    std::size_t size() const { return cx_.size(); }
+
+    // spot-indeks eller -1
+    int locate(Vec2 p) const;
+
+    // batch: out[i] = locate(positions[i])
+    void locate(std::span<const Vec2> positions, std::span<int> out) const;
+
+    // samme, men for posisjoner lagret som SoA (f.eks. CarFleet::xs()/zs())
+    void locate(const float* xs, const float* zs, int* out, std::size_t n) const;
+
+    // kompakte plass-utstrekninger (SoA)
+    const std::vector<float>& centersX() const { return cx_; }
+    const std::vector<float>& centersZ() const { return cz_; }
+    const std::vector<float>& halfWidths() const { return hw_; }
+    const std::vector<float>& halfDepths() const { return hd_; }
+
+private:
+    std::vector<float> cx_, cz_, hw_, hd_;
+
+    // regulært rutenett
+    bool  regular_ = false;
+    int   rows_ = 0;
+    int   cols_ = 0;
+    float originX_ = 0.f;   // venstre kant av kolonne 0
+    float originZ_ = 0.f;   // fremre kant av rad 0
+    float invSlotW_ = 0.f;
+    float slotD_ = 0.f;
+    float rowPitch_ = 0.f;  // slotD + laneWidth
+    float invRowPitch_ = 0.f;
+
+    // BVH for uregelmessige plasser
+    // venstre barn ligger rett etter sin forelder i bvh_
+    struct BvhNode {
+        float minX, minZ, maxX, maxZ;
+        std::uint32_t first; // høyre barn (indre node) eller første i bvhSpots_ (løv)
+        std::uint32_t count; // 0 for indre node
+    };
+    std::vector<BvhNode> bvh_;
+    std::vector<std::uint32_t> bvhSpots_;
+
+    int locateRegular(float x, float z) const;
+    int locateBvh(Vec2 p) const;
+    std::uint32_t buildBvhNode(std::uint32_t first, std::uint32_t count);
+    bool contains(std::uint32_t spot, Vec2 p) const;
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <threepp/threepp.hpp>
+#include <memory>
+
+#include "world/Parking.h"
+
+// Bygger asfalt og oppmerking for en generert parkeringsplass.
+void addParkingLot(threepp::Scene& scene, const ParkingLot& lot);
+
+// felles geometri og materiale for de grønne markørene på fullførte plasser
+struct CompletionMarkerAssets {
+    std::shared_ptr<threepp::BoxGeometry> geometry;
+    std::shared_ptr<threepp::MeshPhongMaterial> material;
+};
+
+CompletionMarkerAssets makeCompletionMarkerAssets();
+
+void placeCompletionMarker(threepp::Mesh& marker, const ParkingSpot& spot);
+
+void updateTargetMarkerPosition(const std::shared_ptr<threepp::Mesh>& marker,
+                                const ParkingSpot& spot);
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "math/Vec2.h"
+#include "world/Obb.h"
+
+// Prisme for stråletesting: et fotavtrykk i bakkeplanet (sirkel eller orientert
+// boks) løftet fra y0 til y1. tag er det kalleren vil ha tilbake ved treff.
+struct RayPrim {
+    Obb   box;            // sirkel: box.center og radius i box.halfW
+    float y0 = 0.f;
+    float y1 = 1.f;
+    std::uint32_t tag = 0;
+    bool  circle = false;
+};
+
+inline RayPrim makeCirclePrim(Vec2 c, float r, float y0, float y1, std::uint32_t tag) {
+    RayPrim p;
+    p.box.center = c;
+    p.box.halfW = p.box.halfD = r;
+    p.y0 = y0;
+    p.y1 = y1;
+    p.tag = tag;
+    p.circle = true;
+    return p;
+}
+
+inline RayPrim makeBoxPrim(const Obb& b, float y0, float y1, std::uint32_t tag) {
+    return {b, y0, y1, tag, false};
+}
+
+// Inntil width stråler fra samme punkt (én sensor). t er horisontal avstand langs
+// (dx, dz); høyden langs strålen er height + slope * t. Bruk set() for å fylle inn.
+struct RayPacket {
+    static constexpr int width = 8;
+    static constexpr std::uint32_t noHit = 0xffffffffu;
+
+    Vec2  origin;
+    float height = 0.f;
+
+    alignas(32) float dx[width];
+    alignas(32) float dz[width];
+    alignas(32) float invDx[width];
+    alignas(32) float invDz[width];
+    alignas(32) float invSlope[width];
+    alignas(32) float t[width];            // inn: lengste avstand; ut: nærmeste treff
+    alignas(32) std::uint32_t hit[width];  // tag, eller noHit
+
+    // dir må ha lengde 1; tmax = 0 slår av strålen
+    void set(int i, Vec2 dir, float slope, float tmax);
+};
+
+// BVH over prismer (median-split på lengste akse, som ParkingLotIndex) som
+// skytes mot med pakker på 8 stråler: hver node testes mot hele pakken med
+// SIMD (AVX2/SSE2), og barna besøkes nærmeste først etter pakkens retning.
+// Bygges om fra add()-lista med build(); bufferne gjenbrukes, så en dynamisk
+// BVH (biler, dør) kan bygges på nytt hvert steg uten å allokere.
+class RayBvh {
+public:
+    void clear();
+    void reserve(std::size_t prims);
+    void add(const RayPrim& p) { pending_.push_back(p); }
+    void build();
+
+    std::size_t size() const { return tag_.size(); }
+    std::size_t nodeCount() const { return nodes_.size(); }
+
+    // nærmeste treff for hver stråle i pakken; oppdaterer bare t og hit der et
+    // prisme er nærmere enn t allerede er. Prismer med tag == skipTag hoppes over.
+    void intersect(RayPacket& p, std::uint32_t skipTag = RayPacket::noHit) const;
+
+    // samme resultat uten BVH og uten SIMD: hver stråle mot hvert prisme (referanse)
+    void intersectLinear(RayPacket& p, std::uint32_t skipTag = RayPacket::noHit) const;
+
+    // "avx2", "sse2" eller "scalar", avhengig av hva som ble kompilert inn
+    static const char* simdPath();
+
+private:
+    // venstre barn ligger rett etter forelderen; first er høyre barn (indre node)
+    // eller første prisme (løv), axis er delingsaksen (0 = x, 1 = z). minY/maxY
+    // lar stråler som går over (eller under) alt i noden hoppe over den.
+    struct Node {
+        float minX, minZ, maxX, maxZ, minY, maxY;
+        std::uint32_t first;
+        std::uint16_t count; // 0 for indre node
+        std::uint16_t axis;
+    };
+
+    std::vector<RayPrim> pending_;
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> order_;   // scratch under build
+
+    // prismene i løvrekkefølge (SoA); sirkler har ax = az = 0 og hw = radius
+    std::vector<float> cx_, cz_, ax_, az_, hw_, hd_, y0_, y1_;
+    std::vector<std::uint32_t> tag_;
+    std::vector<std::uint8_t> circle_;
+
+    std::uint32_t buildNode(std::uint32_t first, std::uint32_t count);
+
+    template <class Ops>
+    friend struct PacketTraversal;
+};
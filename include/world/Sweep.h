@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cmath>
+
+#include "math/Vec2.h"
+
+// Sveipet sirkel mot punkt: tiden t i [0, 1] da en sirkel med radius r som beveger
+// seg fra p0 til p0 + d først berører c. false hvis den ikke gjør det i dette steget.
+// Starter sirkelen allerede inni, er det bare treff (t = 0) når den beveger seg innover,
+// så noe som sitter fast kan kjøre seg løs.
+inline bool sweepCircle(Vec2 p0, Vec2 d, Vec2 c, float r, float& toi) {
+    Vec2 m = p0 - c;
+    float b = dot(m, d);
+    float cc = lengthSq(m) - r * r;
+
+    if (b >= 0.f) return false; // står stille eller beveger seg bort
+    if (cc < 0.f) {
+        toi = 0.f;
+        return true;
+    }
+
+    float a = lengthSq(d);
+    float disc = b * b - a * cc;
+    if (disc < 0.f) return false;
+
+    float t = (-b - std::sqrt(disc)) / a;
+    if (t > 1.f) return false;
+    toi = t;
+    return true;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/Vec2.h"
+#include "world/Obb.h"
+
+struct Aabb {
+    Vec2 min, max;
+};
+
+inline Aabb obbBounds(const Obb& b) {
+    Vec2 e = obbExtents(b);
+    return {b.center - e, b.center + e};
+}
+
+// Sweep-and-prune-bredfase: kroppene holdes sortert på min.x, og rekkefølgen fra
+// forrige update er startpunktet for neste. Når kroppene bare flytter seg litt per
+// frame, er sorteringen (innsetting) nesten lineær. Sveipet langs x gjøres per
+// z-bånd (noen få kroppshøyder), så en stor, kvadratisk plass ikke gir en lang
+// liste x-kandidater som ligger langt unna i z.
+class SweepAndPrune {
+public:
+    // boxes[i] er kropp i; endres antallet, sorteres det på nytt fra bunnen
+    void update(std::span<const Aabb> boxes);
+
+    // alle par med overlappende AABB fra siste update (a < b)
+    const std::vector<BodyPair>& pairs() const { return pairs_; }
+
+    // antall ombyttinger i siste sortering (lite = god koherens)
+    std::size_t lastSwaps() const { return swaps_; }
+
+private:
+    std::vector<std::uint32_t> order_; // kroppsindekser sortert på min.x
+
+    // boksene i sortert rekkefølge (SoA) for sveipet
+    std::vector<float> minX_, maxX_, minZ_, maxZ_;
+
+    // z-bånd: sorterte posisjoner per bånd, fortsatt i x-rekkefølge (CSR)
+    std::vector<std::uint32_t> bandStart_;
+    std::vector<std::uint32_t> bandEntries_;
+
+    std::vector<BodyPair> pairs_;
+    std::size_t swaps_ = 0;
+};
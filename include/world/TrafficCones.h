@@ -1,12 +1,21 @@
 #pragma once
 
-#include <threepp/threepp.hpp>
+#include "math/Vec2.h"
+#include "util/Rng.h"
+
 #include <vector>
-#include <memory>
-
-void addTrafficCones(threepp::Scene& scene,
-                     const threepp::Vector3& lotCenter,
-                     float lotW,
-                     float lotD,
-                     int count,
-                     std::vector<std::shared_ptr<threepp::Mesh>>& outCones);
+
+// Trekker tilfeldige kjegleposisjoner innenfor parkeringsplassen (2 m fra kanten).
+void scatterTrafficCones(Vec2 lotCenter,
+                         float lotW,
+                         float lotD,
+                         int count,
+                         std::vector<Vec2>& outCones,
+                         Rng& rng);
+
+// samme, seedet fra std::random_device
+void scatterTrafficCones(Vec2 lotCenter,
+                         float lotW,
+                         float lotD,
+                         int count,
+                         std::vector<Vec2>& outCones);
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <threepp/threepp.hpp>
+#include <vector>
+#include <memory>
+
+#include "math/Vec2.h"
+
+// felles geometri og materiale for alle kjeglemeshene
+struct ConeAssets {
+    std::shared_ptr<threepp::ConeGeometry> geometry;
+    std::shared_ptr<threepp::MeshPhongMaterial> material;
+};
+
+ConeAssets makeConeAssets();
+
+void addTrafficCones(threepp::Scene& scene,
+                     const std::vector<Vec2>& cones,
+                     std::vector<std::shared_ptr<threepp::Mesh>>& outCones);
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "math/Vec2.h"
+#include "world/Obb.h"
+
+enum class TriggerShape : std::uint8_t { Aabb, Circle, Obb };
+
+// når en kropp (bilboksen) regnes som inne i et volum
+enum class TriggerTest : std::uint8_t {
+    Center,  // boksens sentrum er inne
+    Overlap, // boksen berører volumet
+    Contain  // boksen, skalert med fit, ligger helt inne
+};
+
+enum class TriggerKind : std::uint8_t { Spot, Key, Door, Boundary };
+
+// Et volum i bakkeplanet. Aabb og Obb bruker box (Aabb med aksen (0, 1));
+// Circle har sentrum i box.center og radius i box.halfW.
+struct TriggerVolume {
+    TriggerShape shape = TriggerShape::Aabb;
+    TriggerTest  test = TriggerTest::Center;
+    TriggerKind  kind = TriggerKind::Spot;
+    Obb   box;
+    float fit = 1.f; // Contain: andel av kroppens mål som må være inne
+    int   ref = -1;  // f.eks. indeks i ParkingLot::spots
+};
+
+TriggerVolume makeAabbTrigger(TriggerKind kind, TriggerTest test, Vec2 center, Vec2 half, int ref = -1);
+TriggerVolume makeCircleTrigger(TriggerKind kind, TriggerTest test, Vec2 center, float radius, int ref = -1);
+TriggerVolume makeObbTrigger(TriggerKind kind, TriggerTest test, const Obb& box, int ref = -1);
+
+// Volumene én kropp er inne i, sortert på id. Fast størrelse og triviell, så den
+// kan ligge i EpisodeState (savestate = memcpy).
+struct TriggerContacts {
+    static constexpr int capacity = 8;
+
+    std::uint32_t ids[capacity] = {};
+    std::uint8_t count = 0;
+
+    bool contains(std::uint32_t id) const;
+    void clear() { count = 0; }
+};
+
+enum class TriggerPhase : std::uint8_t { Enter, Stay, Exit };
+
+struct TriggerEvent {
+    std::uint32_t body;
+    std::uint32_t trigger;
+    TriggerPhase phase;
+};
+
+// Register av trigger-volumer (plasser, nøkkel, dør, vegger) i et uniformt rutenett.
+// Hvert volum legges i cellene dets AABB, utvidet med kroppenes rekkevidde, dekker;
+// en kropp slår opp én celle (der sentrum er) og tester bare volumene der. En kropp
+// langt fra alle volumer koster ett oppslag, uansett hvor mange volumer det er.
+// Etter build() endres registeret ikke: update() er const og all tilstand per kropp
+// ligger hos kalleren (TriggerContacts), så mange tråder kan oppdatere hver sine
+// kropper samtidig uten låser.
+class TriggerRegistry {
+public:
+    // id = rekkefølgen volumene legges til i; ugyldig etter build() til neste clear()
+    std::uint32_t add(const TriggerVolume& v);
+    void reserve(std::size_t volumes) { volumes_.reserve(volumes); }
+    void clear();
+
+    // bodyReach: største avstand fra en kropps sentrum til kanten av boksen
+    // (halve diagonalen for bilen)
+    void build(float bodyReach, float cellSize = 4.f);
+
+    // som build, men med cellene ferdig fordelt (WorldCache); faller tilbake til å
+    // fordele selv hvis de ikke passer til rutenettet og volumene
+    void build(float bodyReach, float cellSize,
+               std::span<const std::uint32_t> cellStart,
+               std::span<const std::uint32_t> cellIds);
+
+    std::size_t size() const { return volumes_.size(); }
+    const TriggerVolume& volume(std::uint32_t id) const { return volumes_[id]; }
+
+    // er kroppen (boksen) inne i volumet? samme test som update() bruker
+    bool touches(std::uint32_t id, const Obb& body) const;
+
+    // nye kontakter for kroppen; legger Enter/Stay/Exit mot de forrige i out
+    void update(std::uint32_t body, const Obb& box, TriggerContacts& contacts,
+                std::vector<TriggerEvent>& out) const;
+
+    // samme for kroppene firstBody, firstBody + 1, ... (én TriggerContacts per boks)
+    void update(std::uint32_t firstBody, std::span<const Obb> boxes, std::span<TriggerContacts> contacts,
+                std::vector<TriggerEvent>& out) const;
+
+    // volumene (id-er) som kan berøre en kropp med sentrum i p
+    std::span<const std::uint32_t> candidates(Vec2 p) const;
+
+    int cols() const { return cols_; }
+    int rows() const { return rows_; }
+    float cellSize() const { return cellSize_; }
+    float bodyReach() const { return bodyReach_; }
+
+    // cellelistene slik build() fordelte dem (for baking)
+    std::span<const std::uint32_t> cellStarts() const { return cellStart_; }
+    std::span<const std::uint32_t> cellIds() const { return cellIds_; }
+
+private:
+    std::vector<TriggerVolume> volumes_;
+
+    // CSR som i ConeGrid: volumene i celle c er cellIds_[cellStart_[c], cellStart_[c + 1])
+    Vec2  origin_;
+    float invCell_ = 1.f;
+    float cellSize_ = 1.f;
+    float bodyReach_ = 0.f;
+    int   cols_ = 0;
+    int   rows_ = 0;
+    std::vector<std::uint32_t> cellStart_;
+    std::vector<std::uint32_t> cellIds_;
+
+    bool configureGrid(float bodyReach, float cellSize);
+    void fillCells(float bodyReach);
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "math/Vec2.h"
+#include "util/MappedFile.h"
+#include "util/Rng.h"
+#include "world/Parking.h"
+
+class Simulation;
+
+// Bakt verden: alt Simulation(seed) og ChunkedLotVisual ellers genererer og bøtter ved
+// oppstart, lagret i én fil som kan minnemappes og leses uten parsing. Simulation
+// kopierer plasser, kjegler, mål og triggerceller inn i egne buffere (de endres per
+// episode og må overleve filen); ChunkedLotVisual bruker linjeverteksene der de ligger.
+//
+// Format (little-endian, versjon 3): en header på 256 byte (magic "BSWC", versjon,
+// nøkkel, triggerrutenettets rekkevidde og cellestørrelse, plassens mål, dør/nøkkel/
+// start-posisjoner, RNG-tilstand og en seksjonstabell), deretter 16-byte-justerte
+// seksjoner: plasser (4 float), kjegler (2 float), målsekvens (i32), triggerceller
+// (start og id-er, u32, som TriggerRegistry), chunk-start og plassindekser per chunk
+// (u32, som LotChunks), og linjevertekser for fjerne chunks (6 vertekser * 3 float per
+// plass, i chunk-rekkefølge).
+
+// alt som bestemmer innholdet; filnavnet er en hash av dette
+struct WorldKey {
+    LotLayout     layout;
+    std::uint64_t seed = 0;
+    int           coneCount = 0;
+    int           requiredTargets = 3; // lengden på målsekvensen
+    float         chunkSize = 32.f;
+};
+
+std::uint64_t worldKeyHash(const WorldKey& key);
+
+// dir/world_<hash>.bswc
+std::string worldCachePath(const std::string& dir, const WorldKey& key);
+
+struct BakedSpot {
+    float cx, cz, halfW, halfD;
+};
+
+// Visning inn i en mappet fil; gyldig så lenge WorldCache-en er åpen.
+struct BakedWorld {
+    WorldKey key;
+
+    Vec2  lotCenter;
+    float lotWidth = 0.f;
+    float lotDepth = 0.f;
+
+    Vec2  doorPos;
+    float doorHalfW = 0.f;
+    Vec2  keyPos;
+    Vec2  startPos;
+    float startYaw = 0.f;
+
+    Rng rng; // strømmen etter første reset()
+
+    std::span<const BakedSpot>     spots;
+    std::span<const Vec2>          cones;
+    std::span<const std::int32_t>  targets;
+
+    float triggerReach = 0.f;    // TriggerRegistry::build-parametrene cellene gjelder for
+    float triggerCellSize = 0.f;
+    std::span<const std::uint32_t> triggerStart; // celler + 1
+    std::span<const std::uint32_t> triggerIds;
+    std::span<const std::uint32_t> chunkStart;   // chunks + 1
+    std::span<const std::uint32_t> chunkSpots;   // plassindekser sortert per chunk
+    std::span<const float>         lineVertices; // 18 float per plass i chunkSpots-rekkefølge
+};
+
+// skriver verdenen til sim (må være nykonstruert, før første step) til path
+bool bakeWorld(const std::string& path, const Simulation& sim, float chunkSize);
+
+class WorldCache {
+public:
+    // mapper filen; false hvis den mangler, er ødelagt, ble bakt med en annen nøkkel
+    // eller ikke har like mange plasser og kjegler som nøkkelen gir
+    bool open(const std::string& path, const WorldKey& key);
+
+    const BakedWorld& world() const { return world_; }
+
+private:
+    MappedFile file_;
+    BakedWorld world_;
+};
@@ -1,32 +1,55 @@
 // --------------------------------------------------------------------------------------
 // Parts of this file are inspired by the threepp project (https://github.com/markaren/threepp)
 // especially the structure used in example scenes.
-// Additional logic (parking system, key, door, win state, boundaries, cones, HUD, etc.)
+// Game logic itself lives in Simulation; this file is the threepp view and HUD.
 // --------------------------------------------------------------------------------------
 
 #include "logic/Game.h"
-#include "world/TrafficCones.h"
+#include "sim/Replay.h"
+#include "util/Profiler.h"
+#include "world/WorldCache.h"
 
 #include <threepp/input/KeyListener.hpp>
 #include <iostream>
+#include <algorithm>
 #include <cmath>
+#include <filesystem>
 
 using namespace threepp;
 
 // ---------------- Controls ----------------
 
+// Tastene blir tidsstemplede hendelser i simuleringstrådens InputQueue, så et
+// trykk kortere enn en frame ikke går tapt og timingen ikke rundes av til framene.
 struct Game::Controls : KeyListener {
+    explicit Controls(SimThread& sim) : sim(sim) {}
+
+    SimThread& sim;
     CarInput in;
     bool reset = false;
+    bool dumpTrace = false;
+
+    void set(InputControl control, float& current, float value) {
+        if (current == value) return; // tasterepetisjon
+        current = value;
+        sim.push({Profiler::nowNs(), control, value});
+    }
+
+    void setHandbrake(bool on) {
+        if (in.handbrake == on) return;
+        in.handbrake = on;
+        sim.push({Profiler::nowNs(), InputControl::Handbrake, on ? 1.f : 0.f});
+    }
 
     void onKeyPressed(KeyEvent e) override {
         switch (e.key) {
-            case Key::W: in.throttle = +1.f; break;
-            case Key::S: in.throttle = -1.f; break;
-            case Key::A: in.steer    = +1.f; break;
-            case Key::D: in.steer    = -1.f; break;
-            case Key::SPACE: in.handbrake = true; break;
+            case Key::W: set(InputControl::Throttle, in.throttle, +1.f); break;
+            case Key::S: set(InputControl::Throttle, in.throttle, -1.f); break;
+            case Key::A: set(InputControl::Steer, in.steer, +1.f); break;
+            case Key::D: set(InputControl::Steer, in.steer, -1.f); break;
+            case Key::SPACE: setHandbrake(true); break;
             case Key::R: reset = true; break;
+            case Key::P: dumpTrace = true; break;
             default: break;
         }
     }
@@ -34,10 +57,10 @@ struct Game::Controls : KeyListener {
     void onKeyReleased(KeyEvent e) override {
         switch (e.key) {
             case Key::W:
-            case Key::S: in.throttle = 0.f; break;
+            case Key::S: set(InputControl::Throttle, in.throttle, 0.f); break;
             case Key::A:
-            case Key::D: in.steer    = 0.f; break;
-            case Key::SPACE: in.handbrake = false; break;
+            case Key::D: set(InputControl::Steer, in.steer, 0.f); break;
+            case Key::SPACE: setHandbrake(false); break;
             case Key::R: reset = false; break;
             default: break;
         }
@@ -46,17 +69,48 @@ struct Game::Controls : KeyListener {
 
 Game::~Game() = default;
 
+namespace {
+
+constexpr float lotChunkSize = 32.f;
+
+WorldKey worldKey(const GameOptions& options) {
+    WorldKey key;
+    key.layout = options.scenario.layout;
+    key.seed = options.seed;
+    key.coneCount = options.scenario.coneCount;
+    key.requiredTargets = options.scenario.requiredTargets;
+    key.chunkSize = lotChunkSize;
+    return key;
+}
+
+// bare med fast seed; en tilfeldig seed ville aldri truffet
+std::unique_ptr<WorldCache> openWorldCache(const GameOptions& options) {
+    if (options.worldCacheDir.empty() || options.seed == 0) return nullptr;
+    auto cache = std::make_unique<WorldCache>();
+    auto key = worldKey(options);
+    if (!cache->open(worldCachePath(options.worldCacheDir, key), key)) return nullptr;
+    return cache;
+}
+
+}
+
 // ---------------- Game ctor ----------------
 
-Game::Game(Canvas& canvas, GLRenderer& renderer)
+Game::Game(Canvas& canvas, GLRenderer& renderer, const GameOptions& options)
     : canvas_(canvas),
       renderer_(renderer),
+      worldCache_(openWorldCache(options)),
+      sim_(worldCache_ ? Simulation(worldCache_->world(), options.scenario)
+                       : Simulation(options.seed != 0 ? options.seed : Simulation::randomSeed(), options.scenario)),
+      scenario_(options.scenario),
       scene_(Scene::create()),
       camera_(PerspectiveCamera::create(70, canvas.aspect(), 0.1f, 1000)),
       camRig_(camera_),
-      carMesh_(Mesh::create(BoxGeometry::create(1.f, 0.5f, 2.f),
-                            MeshPhongMaterial::create())),
-      car_(carMesh_) {
+      carMaterial_(MeshPhongMaterial::create()),
+      markerAssets_(makeCompletionMarkerAssets()),
+      simThread_(std::make_unique<SimThread>(sim_, options.simHz)) {
+
+    carMesh_ = Mesh::create(BoxGeometry::create(1.f, 0.5f, 2.f), carMaterial_);
 
     scene_->background = Color(0x87CEEBu);
 
@@ -67,30 +121,42 @@ Game::Game(Canvas& canvas, GLRenderer& renderer)
     light->position.set(40, 60, 40);
     scene_->add(light);
 
-    // parkeringsplass
-    addParkingLot(*scene_, spots_, lotCenter_, lotW_, lotD_);
-    if (spots_.empty()) {
+    const auto& lot = sim_.lot();
+
+    // cache-miss: bak verdenen nå, før første steg, så neste oppstart kan mappe den
+    if (!worldCache_ && !options.worldCacheDir.empty() && options.seed != 0) {
+        std::error_code ec;
+        std::filesystem::create_directories(options.worldCacheDir, ec);
+        auto path = worldCachePath(options.worldCacheDir, worldKey(options));
+        if (!bakeWorld(path, sim_, lotChunkSize)) {
+            std::cerr << "Could not write world cache " << path << "\n";
+        }
+    }
+
+    // parkeringsplass og kjegler, lastet rundt startposisjonen
+    if (worldCache_) {
+        lotVisual_ = std::make_unique<ChunkedLotVisual>(*scene_, lot, worldCache_->world());
+    } else {
+        lotVisual_ = std::make_unique<ChunkedLotVisual>(*scene_, lot, lotChunkSize);
+    }
+    lotVisual_->setCones(simThread_->frame().cones);
+    lotVisual_->prime(sim_.car().position());
+    if (lot.spots.empty()) {
         std::cerr << "No parking spots created!\n";
     }
 
-    // trafikkjegler
-    addTrafficCones(*scene_, lotCenter_, lotW_, lotD_, 30, cones_);
+    // markører; én per påkrevd plass, laget på forhånd
+    markerPool_.preallocate(static_cast<std::size_t>(sim_.requiredTargets()),
+                            [this](std::size_t) { return makeMarkerMesh(); });
 
     // dør
-    doorPos_ = {0.f, 1.0f, -lotD_ * 0.5f - 2.f};
-    doorHalfW_ = 3.f;
-
     auto doorMat = MeshPhongMaterial::create();
     doorMat->color = Color(0x5555ff);
-    auto doorGeo = BoxGeometry::create(doorHalfW_ * 2.f, 2.0f, 0.5f);
+    auto doorGeo = BoxGeometry::create(sim_.doorHalfW() * 2.f, 2.0f, 0.5f);
     doorMesh_ = Mesh::create(doorGeo, doorMat);
-    doorMesh_->position.copy(doorPos_);
     scene_->add(doorMesh_);
 
     // bil
-    if (auto carPhong = std::dynamic_pointer_cast<MeshPhongMaterial>(carMesh_->material())) {
-        carPhong->color = Color(0xff3b2fu);
-    }
     scene_->add(carMesh_);
 
     // --- Wheels (4 cylinders as children of the car) ---
@@ -120,23 +186,12 @@ Game::Game(Canvas& canvas, GLRenderer& renderer)
     carMesh_->add(wheelRL_);
     carMesh_->add(wheelRR_);
 
-
-    startPos_ = {0.f, 0.25f, doorPos_.z - 8.f};
-    startYaw_ = 0.f;
-    car_.hardReset(startPos_, startYaw_);
-
     // nøkkel
     auto keyMat = MeshPhongMaterial::create();
     keyMat->color = Color(0xffff00);
     auto keyGeo = SphereGeometry::create(0.6f, 16, 12);
     keyMesh_ = Mesh::create(keyGeo, keyMat);
-    keyPos_ = {
-        lotCenter_.x + lotW_ * 0.5f - 3.f,
-        0.6f,
-        lotCenter_.z + lotD_ * 0.5f - 3.f
-    };
-    keyMesh_->position.copy(keyPos_);
-    keyMesh_->visible = false;
+    keyMesh_->position.set(sim_.keyPos().x, 0.6f, sim_.keyPos().z);
     scene_->add(keyMesh_);
 
     // target marker
@@ -146,16 +201,14 @@ Game::Game(Canvas& canvas, GLRenderer& renderer)
     targetMarker_ = Mesh::create(targetGeo, targetMat);
     scene_->add(targetMarker_);
 
-    // target-sekvens
-    targetSequence_ =
-        makeRandomTargetSequence(static_cast<int>(spots_.size()),
-                                 requiredTargets_);
-    currentTargetIdx_ = 0;
-    updateTargetMarkerPosition(targetMarker_,
-                               spots_[targetSequence_[currentTargetIdx_]]);
+    frame_ = simThread_->frame();
+    syncScene(0.f);
 
     // input
-    controls_ = std::make_unique<Controls>();
+    // GLFW leverer tastene når vinduet polles; trykk og slipp i samme poll
+    // får nesten samme tidsstempel, så hver endring varer minst ett steg
+    simThread_->input().setMinHoldNs(static_cast<std::uint64_t>(simThread_->stepDt() * 1e9f));
+    controls_ = std::make_unique<Controls>(*simThread_);
     canvas_.addKeyListener(*controls_);
 
     // resize
@@ -165,108 +218,124 @@ Game::Game(Canvas& canvas, GLRenderer& renderer)
         camera_->updateProjectionMatrix();
     });
 
-    std::cout << "PARKING QUEST (Game class):\n";
-    std::cout << "- Park in " << requiredTargets_
-              << " random spots (yellow pole).\n";
-    std::cout << "- Stay inside for " << requiredParkTime_
-              << " seconds for it to count.\n";
-    std::cout << "- Then collect key and drive through the door.\n";
-    std::cout << "Controls: W/S/A/D, SPACE = handbrake, R = reset.\n\n";
+    log_.write(LogKind::Intro, sim_.requiredTargets(), sim_.requiredParkTime());
+
+    Profiler::setEnabled(true);
 }
 
-// ---------------- resetGame ----------------
+// ---------------- recording / reset ----------------
 
-void Game::resetGame() {
-    state_ = GameState::Playing;
+bool Game::startRecording(const std::string& path) {
+    if (simThread_->running()) {
+        std::cerr << "Recording must start before the first frame\n";
+        return false;
+    }
+    recorder_ = std::make_unique<ReplayWriter>();
+    if (!recorder_->open(path, sim_.seed(), simThread_->stepDt(), scenario_)) {
+        std::cerr << "Could not open replay file " << path << "\n";
+        recorder_.reset();
+        return false;
+    }
+    simThread_->setRecorder(recorder_.get());
+    std::cout << "Recording replay to " << path << "\n";
+    return true;
+}
 
-    completedTargets_ = 0;
-    parkedTimer_ = 0.f;
-    keyAvailable_ = false;
-    keyCollected_ = false;
-    doorOpened_ = false;
-    printedWin_ = false;
+// simuleringstråden har resatt: kjegler og målsekvens er nye og står stille til neste reset
+void Game::onEpisodeReset(const SimFrame& next) {
     hudAccumulator_ = 0.f;
 
-    // dør tilbake til startposisjon
-    doorMesh_->position.copy(doorPos_);
-
-    // ny bakgrunn og bilfarge
-    scene_->background = Color(0x87CEEBu);
-    if (auto carPhong = std::dynamic_pointer_cast<MeshPhongMaterial>(carMesh_->material())) {
-        carPhong->color = Color(0xff3b2fu);
-    }
-
-    // nøkkel reset
-    keyMesh_->position.copy(keyPos_);
-    keyMesh_->visible = false;
+    // skjul grønne markører og flytt kjeglene til simuleringens nye posisjoner
+    markerPool_.releaseAll([](const std::shared_ptr<Mesh>& m) { m->visible = false; });
+    lotVisual_->setCones(next.cones);
+    lotVisual_->prime(sim_.startPos());
+}
 
-    // reset parkeringsplasser og fjern grønne markører
-    for (auto& s : spots_) {
-        s.completed = false;
-        if (s.completeMarker) {
-            scene_->remove(*s.completeMarker);
-            s.completeMarker.reset();
-        }
-    }
 
-    // ❗ NYTT: fjern gamle kjegler og lag nye med nye tilfeldige posisjoner
-    for (auto& cone : cones_) {
-        scene_->remove(*cone);
-    }
-    cones_.clear();
-    addTrafficCones(*scene_, lotCenter_, lotW_, lotD_, 30, cones_);
-
-    // ny target-sekvens
-    targetSequence_ = makeRandomTargetSequence(static_cast<int>(spots_.size()),
-                                               requiredTargets_);
-    currentTargetIdx_ = 0;
-    targetMarker_->visible = true;
-    updateTargetMarkerPosition(targetMarker_,
-                               spots_[targetSequence_[currentTargetIdx_]]);
-
-    // bil tilbake til start
-    car_.hardReset(startPos_, startYaw_);
+// nye markører legges i scenen skjult og deler geometri og materiale
+std::shared_ptr<Mesh> Game::makeMarkerMesh() {
+    auto mesh = Mesh::create(markerAssets_.geometry, markerAssets_.material);
+    mesh->visible = false;
+    scene_->add(mesh);
+    return mesh;
 }
 
-
 // ---------------- update ----------------
 
 void Game::update(float dt) {
+    simThread_->beginRender();
+    if (!simThread_->running()) simThread_->start();
+
     hudAccumulator_ += dt;
 
     if (controls_->reset) {
-        std::cout << "Resetting game (R pressed).\n";
-        resetGame();
+        log_.write(LogKind::Reset);
+        simThread_->requestReset();
         controls_->reset = false;
     }
 
-    // bil & kollisjoner
-    Vector3 prevPos = car_.node()->position;
-    car_.update(dt, controls_->in);
-    Vector3 carPos = car_.node()->position;
+    if (controls_->dumpTrace) {
+        controls_->dumpTrace = false;
+        if (Profiler::writeChromeTrace("car_trace.json")) {
+            log_.text("Wrote profiler trace to car_trace.json (open in chrome://tracing or Perfetto).");
+        } else {
+            log_.text("Could not write car_trace.json");
+        }
+    }
+
+    // Frames fra før en reset vi har bedt om er utdaterte, og mens reseten pågår
+    // skriver simuleringstråden kjegler og målsekvens; de vises ikke.
+    if (simThread_->poll() && simThread_->frame().episode == simThread_->resetsRequested()) {
+        PROFILE_SCOPE(Events);
+        const SimFrame& next = simThread_->frame();
+        if (next.episode != frame_.episode) {
+            onEpisodeReset(next);
+            handleProgress(SimFrame{}, next);
+        } else {
+            handleProgress(frame_, next);
+        }
+        frame_ = next;
+    }
+
+    {
+        PROFILE_SCOPE(SyncScene);
+        syncScene(dt);
+    }
+    {
+        PROFILE_SCOPE(CameraChase);
+        camRig_.chase(*carMesh_, dt);
+    }
+    {
+        PROFILE_SCOPE(Streaming);
+        lotVisual_->update(frame_.carPos, camRig_.frustum());
+    }
 
-    // --- boundary walls: car cannot leave the parking lot ---
-    float minX = lotCenter_.x - lotW_ * 0.5f + 1.0f;
-    float maxX = lotCenter_.x + lotW_ * 0.5f - 1.0f;
-    float minZ = lotCenter_.z - lotD_ * 0.5f + 1.0f;
-    float maxZ = lotCenter_.z + lotD_ * 0.5f - 1.0f;
+    if (hudAccumulator_ > 0.5f) {
+        PROFILE_SCOPE(Hud);
+        hudAccumulator_ = 0.f;
+        printHud();
+    }
+}
 
-    bool outOfBounds = false;
+// ---------------- view sync ----------------
 
-    if (carPos.x < minX) { carPos.x = minX; outOfBounds = true; }
-    if (carPos.x > maxX) { carPos.x = maxX; outOfBounds = true; }
-    if (carPos.z < minZ) { carPos.z = minZ; outOfBounds = true; }
-    if (carPos.z > maxZ) { carPos.z = maxZ; outOfBounds = true; }
+void Game::syncScene(float dt) {
+    const SimFrame& f = frame_;
 
-    if (outOfBounds) {
-        // flytt bilen tilbake til kanten og stopp den
-        car_.node()->position.copy(carPos);
-        car_.stop();
+    // interpoler mellom de to siste faste stegene etter hvor lenge siden framen kom
+    float alpha = 1.f;
+    if (f.stepDt > 0.f && f.publishedNs != 0) {
+        double since = static_cast<double>(Profiler::nowNs() - f.publishedNs) * 1e-9;
+        alpha = static_cast<float>(std::clamp(since / f.stepDt, 0.0, 1.0));
     }
+    Vec2 pos = f.prevCarPos + (f.carPos - f.prevCarPos) * alpha;
+    float heading = f.prevCarHeading + (f.carHeading - f.prevCarHeading) * alpha;
 
+    carMesh_->position.set(pos.x, 0.25f, pos.z);
+    carMesh_->rotation.y = heading;
 
     // Rotate wheels based on car speed
-    float v = car_.speed(); // m/s
+    float v = f.carSpeed; // m/s
     if (wheelFL_ && std::abs(v) > 0.01f) {
         float angular = v / wheelRadius_;   // rad/s
         float dAngle  = angular * dt;       // radians per frame
@@ -278,174 +347,107 @@ void Game::update(float dt) {
         wheelRR_->rotation.x -= dAngle;
     }
 
-
-    {
-        const float carRadius  = 0.9f;
-        const float coneRadius = 0.35f;
-
-        for (const auto& cone : cones_) {
-            Vector3 cp = cone->position;
-            float dx = carPos.x - cp.x;
-            float dz = carPos.z - cp.z;
-            float dist2 = dx * dx + dz * dz;
-            float minDist = carRadius + coneRadius;
-
-            if (dist2 < minDist * minDist) {
-                car_.node()->position.copy(prevPos);
-                car_.stop();
-                carPos = prevPos;
-                break;
-            }
-        }
+    // bilfarge: rød -> grønn mens man står i mål, gul ved seier
+    if (f.state == GameState::Won) {
+        carMaterial_->color = Color(0xffff00);
+    } else if (f.insideTarget && f.parkedTimer > 0.f) {
+        float t = std::min(1.f, f.parkedTimer / sim_.requiredParkTime());
+        int r = static_cast<int>((1.f - t) * 255.f);
+        int g = static_cast<int>(t * 255.f);
+        carMaterial_->color = Color((r << 16) | (g << 8));
+    } else {
+        carMaterial_->color = Color(0xff3b2fu);
     }
 
-    if (state_ == GameState::Won) {
-        camRig_.chase(*car_.node(), dt);
-
-        if (!printedWin_) {
-            printedWin_ = true;
-            std::cout << "\n************************\n";
-            std::cout << "         YOU WIN!       \n";
-            std::cout << "************************\n\n";
-        }
+    scene_->background = f.state == GameState::Won ? Color(0x22aa22) : Color(0x87CEEBu);
 
-        if (hudAccumulator_ > 0.5f) {
-            hudAccumulator_ = 0.f;
-            std::cout << "[HUD] Speed: " << car_.speed()
-                      << " m/s | Targets: " << completedTargets_
-                      << "/" << requiredTargets_
-                      << " | Required park time: " << requiredParkTime_ << " s\n";
-        }
-        return;
-    }
+    doorMesh_->position.set(sim_.doorPos().x, f.doorHeight, sim_.doorPos().z);
+    keyMesh_->visible = f.keyAvailable && !f.keyCollected;
 
-    camRig_.chase(*car_.node(), dt);
-    lastInsideTarget_ = false;
-
-    // parkeringslogikk
-    if (currentTargetIdx_ < static_cast<int>(targetSequence_.size())) {
-        int spotIndex = targetSequence_[currentTargetIdx_];
-        auto& spot = spots_[spotIndex];
-
-        bool insideTarget =
-            isCarInsideSpot(spot, carPos, carHalfW_, carHalfD_) &&
-            std::abs(car_.speed()) < 0.4f;
-
-        lastInsideTarget_ = insideTarget;
-
-        auto carPhong = std::dynamic_pointer_cast<MeshPhongMaterial>(carMesh_->material());
-
-        if (insideTarget) {
-            parkedTimer_ += dt;
-
-            float t = std::min(1.f, parkedTimer_ / requiredParkTime_);
-            int r = static_cast<int>((1.f - t) * 255.f);
-            int g = static_cast<int>(t * 255.f);
-
-            if (carPhong) {
-                carPhong->color = Color((r << 16) | (g << 8));
-            }
-
-            if (!spot.completed && parkedTimer_ >= requiredParkTime_) {
-                spot.completed = true;
-                completedTargets_++;
-
-                auto markerMat = MeshPhongMaterial::create();
-                markerMat->color = Color(0x00ff00);
-                auto markerGeo2 = BoxGeometry::create(0.3f, 1.2f, 0.3f);
-                auto marker = Mesh::create(markerGeo2, markerMat);
-                marker->position.set(spot.center.x, 0.6f,
-                                     spot.center.z - spot.halfD * 0.5f);
-                scene_->add(marker);
-                spot.completeMarker = marker;
-
-                std::cout << "Target parking #" << completedTargets_
-                          << " completed (spot " << spotIndex << ").\n";
-
-                parkedTimer_ = 0.f;
-                if (carPhong) {
-                    carPhong->color = Color(0xff3b2fu);
-                }
-
-                currentTargetIdx_++;
-                if (currentTargetIdx_ < static_cast<int>(targetSequence_.size())) {
-                    updateTargetMarkerPosition(targetMarker_,
-                        spots_[targetSequence_[currentTargetIdx_]]);
-                } else {
-                    targetMarker_->visible = false;
-                }
-            }
-        } else {
-            if (parkedTimer_ > 0.f) {
-                parkedTimer_ = 0.f;
-                if (carPhong) {
-                    carPhong->color = Color(0xff3b2fu);
-                }
-            }
-        }
+    // plassenes geometri endres aldri, bare completed-flaggene
+    int target = f.currentTargetSpot;
+    targetMarker_->visible = target >= 0;
+    if (target >= 0) {
+        updateTargetMarkerPosition(targetMarker_, sim_.lot().spots[target]);
     }
+}
 
-    // nøkkel
-    if (!keyAvailable_ && completedTargets_ >= requiredTargets_) {
-        keyAvailable_ = true;
-        keyMesh_->visible = true;
-        std::cout << "All target spots done! Yellow key spawned.\n";
-    }
+// hendelser utledes av forskjellen mellom to frames, så ingen går tapt når
+// trippelbufferen hopper over mellomliggende frames
+void Game::handleProgress(const SimFrame& before, const SimFrame& now) {
+    for (int k = before.completedTargets; k < now.completedTargets; ++k) {
+        int spot = sim_.targetSequence()[k];
+        auto& marker = markerPool_.acquire([this](std::size_t) { return makeMarkerMesh(); });
+        placeCompletionMarker(*marker, sim_.lot().spots[spot]);
+        marker->visible = true;
 
-    if (keyAvailable_ && !keyCollected_) {
-        float dx = carPos.x - keyMesh_->position.x;
-        float dz = carPos.z - keyMesh_->position.z;
-        float dist2 = dx * dx + dz * dz;
-        if (dist2 < 2.0f) {
-            keyCollected_ = true;
-            keyMesh_->visible = false;
-            std::cout << "Key collected! Door will open.\n";
-        }
+        log_.write(LogKind::TargetCompleted, k + 1, spot);
     }
+    if (now.keyAvailable && !before.keyAvailable) log_.write(LogKind::KeySpawned);
+    if (now.keyCollected && !before.keyCollected) log_.write(LogKind::KeyCollected);
+    if (now.doorOpened && !before.doorOpened) log_.write(LogKind::DoorOpened);
+    if (now.state == GameState::Won && before.state != GameState::Won) log_.write(LogKind::Won);
+}
 
-    if (keyCollected_ && !doorOpened_) {
-        doorMesh_->position.y += 3.f * dt;
-        if (doorMesh_->position.y > 4.f) {
-            doorOpened_ = true;
-            std::cout << "Door is open! Drive through to win.\n";
-        }
-    }
+void Game::printHud() {
+    bool holding = frame_.state == GameState::Playing && frame_.insideTarget;
+    log_.write(LogKind::Hud, frame_.carSpeed, frame_.completedTargets, sim_.requiredTargets(),
+               holding ? frame_.parkedTimer : -1.f, sim_.requiredParkTime());
 
-    if (doorOpened_) {
-        if (std::abs(carPos.x - doorPos_.x) <= doorHalfW_ &&
-            carPos.z < doorPos_.z + 5.f && carPos.z > doorPos_.z) {
-
-            state_ = GameState::Won;
-            scene_->background = Color(0x22aa22);
-            if (auto carPhong = std::dynamic_pointer_cast<MeshPhongMaterial>(carMesh_->material())) {
-                carPhong->color = Color(0xffff00);
-            }
-
-            if (!printedWin_) {
-                printedWin_ = true;
-                std::cout << "\n************************\n";
-                std::cout << "         YOU WIN!       \n";
-                std::cout << "************************\n\n";
-            }
-        }
+    if (frame_.droppedSteps > 0 || log_.dropped() > 0 || frame_.droppedInputs > 0) {
+        log_.write(LogKind::HudDrops, frame_.droppedSteps, log_.dropped(), frame_.droppedInputs);
     }
 
-    if (hudAccumulator_ > 0.5f) {
-        hudAccumulator_ = 0.f;
-        std::cout << "[HUD] Speed: " << car_.speed()
-                  << " m/s | Targets: " << completedTargets_
-                  << "/" << requiredTargets_
-                  << " | Required park time: " << requiredParkTime_ << " s";
-        if (lastInsideTarget_) {
-            std::cout << " | Park hold: " << parkedTimer_
-                      << " / " << requiredParkTime_ << " s";
+    // tastetrykk til steget som bruker det og til tegnet bilde, og hvor mye
+    // simulering og rendering går samtidig
+    ThreadSplitStats split = simThread_->takeStats();
+    auto latency = [this](const char* label, const LatencySummary& l) {
+        if (l.samples == 0) return;
+        LogRecord rec;
+        rec.kind = LogKind::HudLatency;
+        rec.text = label;
+        rec.count = 4;
+        rec.args[0] = l.p50Ms;
+        rec.args[1] = l.p99Ms;
+        rec.args[2] = l.maxMs;
+        rec.args[3] = static_cast<double>(l.samples);
+        log_.push(rec);
+    };
+    latency("Input to physics", frame_.inputToPhysics);
+    latency("Input to photon", split.inputToPhoton);
+    log_.write(LogKind::HudThreads, split.simBusy * 100.0, split.renderBusy * 100.0, split.overlap * 100.0);
+
+    // tid per fase per frame over de siste framene (ms): p50 / p99 / maks, for
+    // render-tråden (per rendret frame) og simuleringstråden (per publiserte SimFrame)
+    auto phases = [&](ProfWindow window, const char* title) {
+        bool first = true;
+        for (int p = 0; p < static_cast<int>(ProfPhase::Count); ++p) {
+            auto phase = static_cast<ProfPhase>(p);
+            auto s = Profiler::summary(phase, window);
+            if (s.frames == 0 || s.maxMs <= 0.0) continue;
+            if (first) log_.text(title);
+            first = false;
+
+            LogRecord rec;
+            rec.kind = LogKind::PhaseStats;
+            rec.text = profPhaseName(phase);
+            rec.count = 3;
+            rec.args[0] = s.p50Ms;
+            rec.args[1] = s.p99Ms;
+            rec.args[2] = s.maxMs;
+            log_.push(rec);
         }
-        std::cout << "\n";
-    }
+    };
+    phases(ProfWindow::Render, "[HUD] Render thread, ms per frame:");
+    phases(ProfWindow::Sim, "[HUD] Sim thread, ms per published step:");
 }
 
 // ---------------- render ----------------
 
 void Game::render() {
-    renderer_.render(*scene_, *camera_);
+    {
+        PROFILE_SCOPE(Render);
+        renderer_.render(*scene_, *camera_);
+    }
+    simThread_->endRender(frame_);
 }
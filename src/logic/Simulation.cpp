@@ -0,0 +1,343 @@
+// --------------------------------------------------------------------------------------
+// Headless game logic (parking system, key, door, win state, boundaries, cones).
+// Moved out of Game so it can be stepped without a window or scene graph. Spots, key,
+// door and walls are trigger volumes in a grid; the rules are a coroutine script
+// (parkingScript) woken by the car's trigger events, rebuilt from plain-data progress.
+// --------------------------------------------------------------------------------------
+
+#include "logic/Simulation.h"
+#include "world/TrafficCones.h"
+#include "world/WorldCache.h"
+#include "util/Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+namespace {
+    const float contactSkin = 1e-3f;
+
+    // veggtriggerne er striper så tykke innenfor kanten; bilen klemmes mot kanten
+    const float wallTriggerDepth = 0.1f;
+    const float triggerCellSize = 4.f;
+
+    // unik på tvers av alle Simulation-er, så snapshots kan flyttes mellom dem
+    std::atomic<std::uint64_t> nextWorldId{1};
+}
+
+Simulation::Simulation()
+    : Simulation(randomSeed()) {}
+
+std::uint64_t Simulation::randomSeed() {
+    return (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+}
+
+Simulation::Simulation(std::uint64_t seed)
+    : Simulation(seed, Scenario{}) {}
+
+Simulation::Simulation(std::uint64_t seed, const Scenario& scenario)
+    : seed_(seed),
+      ep_{Car(scenario.car), Rng(seed)},
+      coneCount_(scenario.coneCount),
+      requiredTargets_(scenario.requiredTargets) {
+    course_.parkTime = scenario.requiredParkTime;
+
+    // parkeringsplass
+    generateParkingLot(lot_, scenario.layout);
+
+    configureConeGrid();
+
+    // dør
+    doorPos_ = {0.f, -lot_.depth * 0.5f - 2.f};
+    doorHalfW_ = 3.f;
+
+    // bil
+    startPos_ = {0.f, doorPos_.z - 8.f};
+    startYaw_ = 0.f;
+
+    // nøkkel
+    keyPos_ = {
+        lot_.center.x + lot_.width * 0.5f - 3.f,
+        lot_.center.z + lot_.depth * 0.5f - 3.f
+    };
+
+    configureTriggers();
+    events_.reserve(8);
+    reset();
+}
+
+Simulation::Simulation(const BakedWorld& world, const Scenario& scenario)
+    : seed_(world.key.seed),
+      ep_{Car(scenario.car), world.rng},
+      coneCount_(world.key.coneCount),
+      requiredTargets_(world.key.requiredTargets) {
+    course_.parkTime = scenario.requiredParkTime;
+    lot_.layout = world.key.layout;
+    lot_.center = world.lotCenter;
+    lot_.width = world.lotWidth;
+    lot_.depth = world.lotDepth;
+    lot_.spots.resize(world.spots.size());
+    for (std::size_t i = 0; i < world.spots.size(); ++i) {
+        const auto& b = world.spots[i];
+        lot_.spots[i] = {{b.cx, b.cz}, b.halfW, b.halfD, false};
+    }
+
+    configureConeGrid();
+
+    doorPos_ = world.doorPos;
+    doorHalfW_ = world.doorHalfW;
+    startPos_ = world.startPos;
+    startYaw_ = world.startYaw;
+    keyPos_ = world.keyPos;
+    // cellene gjelder bare for samme bilboks og cellestørrelse som de ble bakt med
+    if (world.triggerReach == length({carHalfW_, carHalfD_}) && world.triggerCellSize == triggerCellSize) {
+        configureTriggers(world.triggerStart, world.triggerIds);
+    } else {
+        configureTriggers();
+    }
+
+    // kjegler og målsekvens slik de var etter første reset(); ep_.rng fortsetter derfra
+    cones_.assign(world.cones.begin(), world.cones.end());
+    coneGrid_.rebuild(cones_);
+    targetSequence_.assign(world.targets.begin(), world.targets.end());
+    worldId_ = nextWorldId.fetch_add(1, std::memory_order_relaxed);
+
+    events_.reserve(8);
+    resetEpisodeState();
+}
+
+// kollisjonsrutenett for kjeglene; celle = 2 * kontaktavstand langs bilen
+void Simulation::configureConeGrid() {
+    coneGrid_.configure({lot_.center.x - lot_.width * 0.5f, lot_.center.z - lot_.depth * 0.5f},
+                        lot_.width, lot_.depth, 2.f * (carHalfD_ + coneRadius));
+}
+
+// plassene først (id = plassindeks), så nøkkel, dør og vegger
+void Simulation::configureTriggers(std::span<const std::uint32_t> cellStart,
+                                   std::span<const std::uint32_t> cellIds) {
+    triggers_.clear();
+    triggers_.reserve(lot_.spots.size() + 6);
+    for (std::size_t i = 0; i < lot_.spots.size(); ++i) {
+        const auto& s = lot_.spots[i];
+        // samme regel som isCarInsideSpot: en kvart bilboks må ligge inne i plassen
+        TriggerVolume v = makeAabbTrigger(TriggerKind::Spot, TriggerTest::Contain, s.center,
+                                          {s.halfW, s.halfD}, static_cast<int>(i));
+        v.fit = 0.25f;
+        triggers_.add(v);
+    }
+
+    keyTrigger_ = triggers_.add(makeCircleTrigger(TriggerKind::Key, TriggerTest::Center, keyPos_, std::sqrt(2.f)));
+    doorTrigger_ = triggers_.add(makeAabbTrigger(TriggerKind::Door, TriggerTest::Center,
+                                                 {doorPos_.x, doorPos_.z + 2.5f}, {doorHalfW_, 2.5f}));
+
+    const float hw = lot_.width * 0.5f, hd = lot_.depth * 0.5f, t = wallTriggerDepth * 0.5f;
+    const Vec2 c = lot_.center;
+    triggers_.add(makeAabbTrigger(TriggerKind::Boundary, TriggerTest::Overlap, {c.x - hw + t, c.z}, {t, hd}));
+    triggers_.add(makeAabbTrigger(TriggerKind::Boundary, TriggerTest::Overlap, {c.x + hw - t, c.z}, {t, hd}));
+    triggers_.add(makeAabbTrigger(TriggerKind::Boundary, TriggerTest::Overlap, {c.x, c.z - hd + t}, {hw, t}));
+    triggers_.add(makeAabbTrigger(TriggerKind::Boundary, TriggerTest::Overlap, {c.x, c.z + hd - t}, {hw, t}));
+
+    if (cellStart.empty()) {
+        triggers_.build(length({carHalfW_, carHalfD_}), triggerCellSize);
+    } else {
+        triggers_.build(length({carHalfW_, carHalfD_}), triggerCellSize, cellStart, cellIds);
+    }
+    triggerEvents_.reserve(TriggerContacts::capacity * 2);
+
+    course_.keyTrigger = keyTrigger_;
+    course_.doorTrigger = doorTrigger_;
+}
+
+// ---------------- reset ----------------
+
+void Simulation::reset() {
+    // nye kjegler med nye tilfeldige posisjoner
+    scatterTrafficCones(lot_.center, lot_.width, lot_.depth, coneCount_, cones_, ep_.rng);
+    coneGrid_.rebuild(cones_);
+
+    // ny target-sekvens
+    makeRandomTargetSequence(static_cast<int>(lot_.spots.size()),
+                             requiredTargets_, ep_.rng, targetSequence_);
+    worldId_ = nextWorldId.fetch_add(1, std::memory_order_relaxed);
+
+    resetEpisodeState();
+}
+
+void Simulation::resetEpisodeState() {
+    ep_.time = 0.0;
+    ep_.progress = {};
+
+    for (auto& s : lot_.spots) {
+        s.completed = false;
+    }
+
+    ep_.car.hardReset(startPos_, startYaw_);
+    ep_.triggers.clear();
+    triggerEvents_.clear();
+    events_.clear();
+    restartScript();
+}
+
+// bygger skriptet på nytt fra ep_.progress og målsekvensen slik de er nå; det kjører
+// fram til første co_await. Rammen kommer fra runtimens gjenbruk, så det allokerer ikke.
+void Simulation::restartScript() {
+    course_.targets = {targetSequence_.data(),
+                       std::min(targetSequence_.size(), static_cast<std::size_t>(std::max(requiredTargets_, 0)))};
+    script_.rt.clear(ep_.time);
+    script_.rt.spawn(parkingScript(script_.rt, 0, course_, ep_.progress));
+    script_.live = true;
+}
+
+// ---------------- savestate ----------------
+
+void Simulation::snapshot(SimSnapshot& out) const {
+    std::memcpy(&out.episode, &ep_, sizeof(EpisodeState));
+    if (out.world != worldId_) {
+        out.world = worldId_;
+        out.spotCount = lot_.spots.size();
+        out.cones = cones_;
+        out.targets = targetSequence_;
+    }
+}
+
+bool Simulation::restore(const SimSnapshot& in) {
+    if (in.spotCount != lot_.spots.size()) return false;
+
+    // fullførte plasser er de første completedTargets() i målsekvensen
+    for (int t : targetSequence_) lot_.spots[t].completed = false;
+
+    std::memcpy(&ep_, &in.episode, sizeof(EpisodeState));
+    triggerEvents_.clear();
+    if (worldId_ != in.world) {
+        worldId_ = in.world;
+        cones_ = in.cones;
+        coneGrid_.rebuild(cones_);
+        targetSequence_ = in.targets;
+    }
+
+    restartScript();
+    for (int i = 0; i < completedTargets(); ++i) {
+        lot_.spots[targetSequence_[i]].completed = true;
+    }
+    events_.clear();
+    return true;
+}
+
+int Simulation::currentTargetSpot() const {
+    if (ep_.progress.objective < course_.targetCount()) {
+        return targetSequence_[ep_.progress.objective];
+    }
+    return -1;
+}
+
+bool Simulation::insideTarget() const {
+    const int spot = currentTargetSpot();
+    return spot >= 0 && ep_.triggers.contains(static_cast<std::uint32_t>(spot)) &&
+           std::abs(ep_.car.speed()) < course_.maxSpeed;
+}
+
+// ---------------- step ----------------
+
+void Simulation::step(float dt, const CarInput& in) {
+    PROFILE_SCOPE(SimStep);
+    moveCar(dt, in);
+    {
+        PROFILE_SCOPE(Triggers);
+        updateTriggers();
+    }
+    {
+        // etter seier er skriptet ferdig: man kan kjøre rundt, men ingenting skjer
+        PROFILE_SCOPE(Script);
+        updateProgress(dt);
+    }
+}
+
+void Simulation::moveCar(float dt, const CarInput& in) {
+    Vec2 prevPos = ep_.car.position();
+    float prevHeading = ep_.car.heading();
+    Vec2 carPos;
+    {
+        PROFILE_SCOPE(CarUpdate);
+        ep_.car.update(dt, in);
+        carPos = ep_.car.position();
+    }
+
+    // --- boundary walls: the whole car box (rotated with heading) stays inside the lot ---
+    const Vec2 ext = obbExtents(makeCarObb(carPos, ep_.car.heading(), carHalfW_, carHalfD_));
+    float minX = lot_.center.x - lot_.width * 0.5f + ext.x;
+    float maxX = lot_.center.x + lot_.width * 0.5f - ext.x;
+    float minZ = lot_.center.z - lot_.depth * 0.5f + ext.z;
+    float maxZ = lot_.center.z + lot_.depth * 0.5f - ext.z;
+
+    bool outOfBounds = false;
+
+    if (carPos.x < minX) { carPos.x = minX; outOfBounds = true; }
+    if (carPos.x > maxX) { carPos.x = maxX; outOfBounds = true; }
+    if (carPos.z < minZ) { carPos.z = minZ; outOfBounds = true; }
+    if (carPos.z > maxZ) { carPos.z = maxZ; outOfBounds = true; }
+
+    if (outOfBounds) {
+        // flytt bilen tilbake til kanten og stopp den
+        ep_.car.setPosition(carPos);
+        ep_.car.stop();
+    }
+
+    // bilboksen mot kjeglene i cellene langs strekningen
+    PROFILE_SCOPE(Cones);
+    if (continuousCollision_) {
+        // Car::update snur først og flytter så rett fram, så boksen sveipes med
+        // den nye headingen fra forrige posisjon
+        const Obb box = makeCarObb(prevPos, ep_.car.heading(), carHalfW_, carHalfD_);
+        const Vec2 d = carPos - prevPos;
+        float toi;
+        if (coneGrid_.firstOverlapping(box, coneRadius) >= 0 &&
+            coneGrid_.firstOverlapping(makeCarObb(prevPos, prevHeading, carHalfW_, carHalfD_), coneRadius) < 0) {
+            // å snu på stedet ville dreid boksen inn i en kjegle: behold heading og stå
+            ep_.car.setHeading(prevHeading);
+            ep_.car.setPosition(prevPos);
+            ep_.car.stop();
+        } else if (coneGrid_.sweepFirstBox(box, d, coneRadius, toi) >= 0) {
+            // stopp ved kontakt, en hårsbredd før så neste steg ikke starter inni
+            float len = length(d);
+            float t = len > 0.f ? std::max(0.f, toi - contactSkin / len) : 0.f;
+            ep_.car.setPosition(prevPos + d * t);
+            ep_.car.stop();
+        }
+    } else if (coneGrid_.firstOverlapping(carBox(), coneRadius) >= 0) {
+        ep_.car.setPosition(prevPos);
+        ep_.car.stop();
+    }
+}
+
+void Simulation::updateTriggers() {
+    triggerEvents_.clear();
+    triggers_.update(0, carBox(), ep_.triggers, triggerEvents_);
+}
+
+// Skriptet vekkes av bilens trigger-hendelser (kropp 0); det det har kommet
+// videre blir til fullførte plasser og SimEvent-er her.
+void Simulation::updateProgress(float dt) {
+    const int before = ep_.progress.objective;
+    if (!script_.live) restartScript(); // kopiert Simulation
+    const float speed = ep_.car.speed();
+    script_.rt.step(dt, triggerEvents_, &speed);
+    ep_.time = script_.rt.now();
+
+    const int targets = course_.targetCount();
+    for (int k = before; k < ep_.progress.objective; ++k) {
+        if (k < targets) {
+            const int spot = targetSequence_[k];
+            lot_.spots[spot].completed = true;
+            events_.push_back({SimEventType::TargetCompleted, spot, k + 1});
+            if (k + 1 == targets) events_.push_back({SimEventType::KeySpawned, -1, targets});
+        } else if (k == targets) {
+            events_.push_back({SimEventType::KeyCollected, -1, targets});
+        } else if (k == targets + 1) {
+            events_.push_back({SimEventType::DoorOpened, -1, targets});
+        } else {
+            events_.push_back({SimEventType::Won, -1, targets});
+        }
+    }
+}
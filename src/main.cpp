@@ -5,27 +5,67 @@
 
 #include <threepp/threepp.hpp>
 #include "logic/Game.h"
+#include "sim/Scenario.h"
+#include "util/Profiler.h"
 
 #include <chrono>
+#include <iostream>
+#include <string>
 
 using namespace threepp;
 
-int main() {
+int main(int argc, char** argv) {
     Canvas canvas("Parking Quest");
     GLRenderer renderer(canvas.size());
 
-    Game game(canvas, renderer);
+    // simuleringen går i faste steg på 120 Hz uavhengig av bildefrekvensen
+    GameOptions options;
+    options.simHz = 120.f;
+
+    // --seed N: fast verden; --world-cache dir: bak/map verdenen for den seeden;
+    // --scenario fil.scn: plass, regler og bilfysikk fra fil
+    std::string recordPath;
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--record") recordPath = argv[i + 1];
+        else if (arg == "--seed") options.seed = std::stoull(argv[i + 1]);
+        else if (arg == "--world-cache") options.worldCacheDir = argv[i + 1];
+        else if (arg == "--scenario") {
+            ScenarioError err;
+            if (!loadScenario(argv[i + 1], options.scenario, &err)) {
+                std::cerr << argv[i + 1] << ":" << err.line << ": " << err.message << "\n";
+                return 1;
+            }
+        }
+    }
 
     using clock = std::chrono::steady_clock;
+
+    auto startupBegin = clock::now();
+    Game game(canvas, renderer, options);
+    double startupMs = std::chrono::duration<double, std::milli>(clock::now() - startupBegin).count();
+    std::cout << "Startup: " << startupMs << " ms (world "
+              << (game.worldFromCache() ? "mapped from cache" : "generated") << ")\n";
+
+    // car --record fil.bsrp: ta opp økten (spill av med replay_player)
+    if (!recordPath.empty()) {
+        game.startRecording(recordPath);
+    }
+
     auto last = clock::now();
 
     canvas.animate([&] {
-        float dt = std::chrono::duration<float>(clock::now() - last).count();
-        last = clock::now();
-        if (dt > 0.1f) dt = 0.1f;
+        // ingen clamp her: FixedStepper begrenser antall innhentingssteg per frame
+        auto now = clock::now();
+        float dt = std::chrono::duration<float>(now - last).count();
+        last = now;
 
-        game.update(dt);
-        game.render();
+        {
+            PROFILE_SCOPE(Frame);
+            game.update(dt);
+            game.render();
+        }
+        Profiler::endFrame();
     });
 
     return 0;
@@ -25,3 +25,13 @@ void CameraRig::chase(const Object3D& target, float dt) {
     cam_->position.lerp(desired, alpha);
     cam_->lookAt({p.x, p.y + 0.5f, p.z});
 }
+
+Frustum CameraRig::frustum() const {
+    cam_->updateMatrixWorld(); // oppdaterer også matrixWorldInverse
+    Matrix4 viewProjection;
+    viewProjection.multiplyMatrices(cam_->projectionMatrix, cam_->matrixWorldInverse);
+
+    Frustum f;
+    f.setFromProjectionMatrix(viewProjection);
+    return f;
+}
@@ -8,10 +8,8 @@
 #include <algorithm>
 #include <cmath>
 
-using namespace threepp;
-
-Car::Car(std::shared_ptr<Object3D> node, CarPhysicsParams p)
-    : node_(std::move(node)), base_(p) {}
+Car::Car(CarPhysicsParams p)
+    : base_(p) {}
 
 void Car::update(float dt, const CarInput& in) {
 
@@ -22,7 +20,6 @@ void Car::update(float dt, const CarInput& in) {
     // steering (mindre styring ved høy fart)
     float steerScale = std::clamp(10.f / (std::abs(speed_) + 5.f), 0.4f, 1.2f);
     heading_ += in.steer * base_.steerRate * steerScale * dt;
-    node_->rotation.y = heading_;
 
     float a = in.throttle * accel;
 
@@ -40,15 +37,13 @@ void Car::update(float dt, const CarInput& in) {
     speed_ = std::clamp(speed_ + a * dt, -maxSpeed * 0.25f, maxSpeed);
 
     float s = std::sin(heading_), c = std::cos(heading_);
-    node_->position.y = 0.25f;
-    node_->position.x += speed_ * s * dt;
-    node_->position.z += speed_ * c * dt;
+    pos_.x += speed_ * s * dt;
+    pos_.z += speed_ * c * dt;
 }
 
-void Car::hardReset(const Vector3& pos, float yawRad) {
-    node_->position.copy(pos);
+void Car::hardReset(Vec2 pos, float yawRad) {
+    pos_ = pos;
     heading_ = yawRad;
-    node_->rotation.y = yawRad;
     speed_ = 0.f;
 }
 
@@ -0,0 +1,619 @@
+// --------------------------------------------------------------------------------------
+// Parking autopilot: Hybrid-A* (Dolgov et al., "Practical Search Techniques in Path
+// Planning for Autonomous Driving") over a small set of motion primitives, with the
+// max of a precomputed obstacle-free non-holonomic cost table and a per-goal
+// holonomic distance field as heuristic, and pure pursuit to follow the result.
+// --------------------------------------------------------------------------------------
+
+#include "sim/Autopilot.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace {
+
+constexpr float pi = 3.14159265f;
+constexpr float unreachable = std::numeric_limits<float>::infinity();
+
+// planleggingsfart fram/bak (bestemmer hvor mye rattet svinger, som i Car::update)
+constexpr float planSpeedFwd = 6.f;
+constexpr float planSpeedRev = -2.f;
+constexpr float primitiveLength = 2.f;
+
+// kostnadsvekter
+constexpr float reversePenalty = 2.f;
+constexpr float switchPenalty = 3.f;
+constexpr float steerPenalty = 0.1f;
+
+// litt klaring til kjegler, så sporingsfeil ikke gir kollisjon
+constexpr float clearance = 0.15f;
+// rette primitiver en start inntil en kjegle eller kant kan bruke på å komme ut av
+// klaringen (rett fram/bak klarer sporingen fra stillstand; rattet venter til bilen ruller)
+constexpr int maxContactSteps = 2;
+
+float wrapAngle(float a) {
+    return std::remainder(a, 2.f * pi);
+}
+
+// som wrapAngle for en heading i [-pi, pi] pluss en liten dreiing; gir samme tall
+// (a - 2pi er eksakt når a ligger mellom pi og 4pi)
+float wrapTurn(float a) {
+    if (a > pi) return a - 2.f * pi;
+    if (a < -pi) return a + 2.f * pi;
+    return a;
+}
+
+// kantene med litt slakk: bilen står ofte klemt helt inntil dem
+void lotBounds(const ParkingLot& lot, Vec2& lo, Vec2& hi) {
+    const float slack = 0.1f;
+    lo = {lot.center.x - lot.width * 0.5f - slack, lot.center.z - lot.depth * 0.5f - slack};
+    hi = {lot.center.x + lot.width * 0.5f + slack, lot.center.z + lot.depth * 0.5f + slack};
+}
+
+// Car::update ved konstant fart v, uten aks/friksjon
+MotionPrimitive integratePrimitive(const CarPhysicsParams& p, float steer, float dir) {
+    MotionPrimitive m;
+    m.steer = steer;
+    m.dir = dir;
+    m.length = primitiveLength;
+
+    const float v = dir > 0.f ? planSpeedFwd : planSpeedRev;
+    const float dt = 1.f / 240.f;
+    const float steerScale = std::clamp(10.f / (std::abs(v) + 5.f), 0.4f, 1.2f);
+
+    float x = 0.f, z = 0.f, h = 0.f, s = 0.f;
+    int next = 0;
+    while (next < MotionPrimitive::samples) {
+        h += steer * p.steerRate * steerScale * dt;
+        x += v * std::sin(h) * dt;
+        z += v * std::cos(h) * dt;
+        s += std::abs(v) * dt;
+        if (s >= primitiveLength * static_cast<float>(next + 1) / MotionPrimitive::samples) {
+            m.pos[next] = {x, z};
+            m.dHeading[next] = h;
+            m.axis[next] = {std::sin(h), std::cos(h)};
+            ++next;
+        }
+    }
+    return m;
+}
+
+// lokal pose (x høyre, z framover) fra bilens pose til verden
+Vec2 toWorld(Vec2 pos, float heading, Vec2 local) {
+    float s = std::sin(heading), c = std::cos(heading);
+    Vec2 fwd{s, c}, right{c, -s};
+    return pos + right * local.x + fwd * local.z;
+}
+
+std::shared_ptr<PlannerTables> buildTables(const LotLayout& layout, const CarPhysicsParams& car) {
+    auto t0 = std::chrono::steady_clock::now();
+    auto tables = std::make_shared<PlannerTables>();
+    tables->layout = layout;
+    tables->car = car;
+
+    for (float dir : {1.f, -1.f}) {
+        for (float steer : {-1.f, -0.5f, 0.f, 0.5f, 1.f}) {
+            tables->primitives.push_back(integratePrimitive(car, steer, dir));
+        }
+    }
+
+    // ikke-holon tabell: Dijkstra over primitivene fra origo i fritt rom
+    const int w = 20;
+    const int side = 2 * w + 1;
+    const int bins = PlannerTables::headingBins;
+    tables->window = w;
+    tables->reachCost.assign(static_cast<std::size_t>(side) * side, unreachable);
+
+    struct State { float x, z, h, g; };
+    std::vector<float> best(static_cast<std::size_t>(side) * side * bins, unreachable);
+    auto index = [&](float x, float z, float h, int& out) {
+        int cx = static_cast<int>(std::floor(x + 0.5f)) + w;
+        int cz = static_cast<int>(std::floor(z + 0.5f)) + w;
+        if (cx < 0 || cz < 0 || cx >= side || cz >= side) return false;
+        int hb = static_cast<int>(std::floor((wrapAngle(h) + pi) / (2.f * pi) * bins)) % bins;
+        out = (cz * side + cx) * bins + hb;
+        return true;
+    };
+
+    std::vector<State> heap;
+    auto cmp = [](const State& a, const State& b) { return a.g > b.g; };
+    heap.push_back({0.f, 0.f, 0.f, 0.f});
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        State st = heap.back();
+        heap.pop_back();
+
+        int idx;
+        if (!index(st.x, st.z, st.h, idx) || st.g >= best[idx]) continue;
+        best[idx] = st.g;
+        float& cell = tables->reachCost[idx / bins];
+        cell = std::min(cell, st.g);
+
+        for (const auto& m : tables->primitives) {
+            Vec2 end = toWorld({st.x, st.z}, st.h, m.pos[MotionPrimitive::samples - 1]);
+            float g = st.g + m.length * (m.dir < 0.f ? reversePenalty : 1.f) + std::abs(m.steer) * steerPenalty;
+            int nidx;
+            if (index(end.x, end.z, st.h + m.dHeading[MotionPrimitive::samples - 1], nidx) && g < best[nidx]) {
+                heap.push_back({end.x, end.z, st.h + m.dHeading[MotionPrimitive::samples - 1], g});
+                std::push_heap(heap.begin(), heap.end(), cmp);
+            }
+        }
+    }
+
+    // søkerutenettet dekker plassen slik generateParkingLot lager den
+    ParkingLot lot;
+    generateParkingLot(lot, layout);
+    tables->gridMin = {lot.center.x - lot.width * 0.5f, lot.center.z - lot.depth * 0.5f};
+    tables->cols = std::max(1, static_cast<int>(std::ceil(lot.width)));
+    tables->rows = std::max(1, static_cast<int>(std::ceil(lot.depth)));
+
+    tables->buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    return tables;
+}
+
+}
+
+// ---------------- tabeller ----------------
+
+float PlannerTables::reachCostAt(Vec2 rel) const {
+    int cx = static_cast<int>(std::floor(rel.x + 0.5f)) + window;
+    int cz = static_cast<int>(std::floor(rel.z + 0.5f)) + window;
+    const int side = 2 * window + 1;
+    if (cx < 0 || cz < 0 || cx >= side || cz >= side) return -1.f;
+    return reachCost[static_cast<std::size_t>(cz) * side + cx];
+}
+
+std::shared_ptr<const PlannerTables> plannerTablesFor(const LotLayout& layout, const CarPhysicsParams& car) {
+    using Key = std::tuple<int, int, float, float, float, float, float, float, float, float, float>;
+    static std::mutex mutex;
+    static std::map<Key, std::shared_ptr<const PlannerTables>> cache;
+
+    Key key{layout.rows, layout.cols, layout.slotW, layout.slotD, layout.laneWidth, layout.margin,
+            car.maxSpeed, car.accel, car.brake, car.steerRate, car.friction};
+
+    std::lock_guard lock(mutex);
+    auto it = cache.find(key);
+    if (it != cache.end()) return it->second;
+    auto tables = buildTables(layout, car);
+    cache.emplace(key, tables);
+    return tables;
+}
+
+// ---------------- mål ----------------
+
+bool PlanGoal::contains(Vec2 p) const {
+    if (kind == PlanGoalKind::Key) return lengthSq(p - center) < radius * radius;
+    return std::abs(p.x - center.x) <= half.x && std::abs(p.z - center.z) <= half.z;
+}
+
+bool nextPlanGoal(const Simulation& sim, PlanGoal& out) {
+    if (sim.state() == GameState::Won) return false;
+
+    int target = sim.currentTargetSpot();
+    if (target >= 0) {
+        // strengere enn isCarInsideSpot for alle headinger (kjernen er 0.25 x 0.5 m)
+        const auto& spot = sim.lot().spots[target];
+        out.kind = PlanGoalKind::Spot;
+        out.center = spot.center;
+        out.half = {spot.halfW - 0.5f, spot.halfD - 0.8f};
+        return true;
+    }
+    if (!sim.keyCollected()) {
+        out.kind = PlanGoalKind::Key;
+        out.center = sim.keyPos();
+        out.radius = 0.9f; // spillet tar nøkkelen innenfor sqrt(2)
+        return true;
+    }
+
+    // døråpningen: innenfor dørbredden og nær kanten døra står ved
+    out.kind = PlanGoalKind::Door;
+    out.half = {sim.doorHalfW() - 1.f, 1.2f};
+    out.center = {sim.doorPos().x, sim.doorPos().z + 3.f};
+    return true;
+}
+
+// ---------------- holonomt avstandsfelt ----------------
+
+void GoalField::build(const PlannerTables& tables, const Simulation& sim, const PlanGoal& goal) {
+    tables_ = &tables;
+    const int cols = tables.cols, rows = tables.rows;
+    // én blokkert celle rundt hele rutenettet, så naboene ikke trenger grensesjekk
+    stride_ = cols + 2;
+    const std::size_t cells = static_cast<std::size_t>(stride_) * (rows + 2);
+    auto cell = [&](int x, int z) { return static_cast<std::size_t>(z + 1) * stride_ + (x + 1); };
+
+    // kostnad i tidels meter pluss én; 0 = blokkert, så en blokkert nabo aldri slakkes
+    constexpr std::uint32_t blocked = 0, unvisited = std::numeric_limits<std::uint32_t>::max();
+    cost_.assign(cells, blocked);
+    for (int z = 0; z < rows; ++z) std::fill_n(cost_.begin() + cell(0, z), cols, unvisited);
+
+    // celler bilen ikke kan stå i: kjegler oppblåst med bilens halve bredde
+    const float block = sim.carHalfW() + Simulation::coneRadius;
+    for (Vec2 c : sim.cones()) {
+        int x0 = static_cast<int>(std::floor(c.x - block - tables.gridMin.x));
+        int z0 = static_cast<int>(std::floor(c.z - block - tables.gridMin.z));
+        for (int z = std::max(0, z0); z <= std::min(rows - 1, z0 + 2); ++z) {
+            for (int x = std::max(0, x0); x <= std::min(cols - 1, x0 + 2); ++x) {
+                Vec2 center{tables.gridMin.x + x + 0.5f, tables.gridMin.z + z + 0.5f};
+                if (lengthSq(center - c) < block * block) cost_[cell(x, z)] = blocked;
+            }
+        }
+    }
+
+    // Dijkstra fra alle celler i målområdet, med bøttekø (Dial): kantene koster 10
+    // og 14 tidels meter, så kostnaden er et heltall og neste celle ligger alltid i
+    // en av de neste 15 bøttene; ingen heap. Utdaterte oppføringer hoppes over.
+    for (auto& b : buckets_) b.clear();
+    std::size_t pending = 0;
+    const Vec2 reach = goal.kind == PlanGoalKind::Key ? Vec2{goal.radius, goal.radius} : goal.half;
+    const int gx0 = std::max(0, static_cast<int>(std::floor(goal.center.x - reach.x - tables.gridMin.x)));
+    const int gz0 = std::max(0, static_cast<int>(std::floor(goal.center.z - reach.z - tables.gridMin.z)));
+    const int gx1 = std::min(cols - 1, static_cast<int>(std::floor(goal.center.x + reach.x - tables.gridMin.x)));
+    const int gz1 = std::min(rows - 1, static_cast<int>(std::floor(goal.center.z + reach.z - tables.gridMin.z)));
+    for (int z = gz0; z <= gz1; ++z) {
+        for (int x = gx0; x <= gx1; ++x) {
+            const std::size_t i = cell(x, z);
+            if (cost_[i] != blocked && goal.contains({tables.gridMin.x + x + 0.5f, tables.gridMin.z + z + 0.5f})) {
+                cost_[i] = 1;
+                buckets_[1].push_back(static_cast<std::uint32_t>(i));
+                ++pending;
+            }
+        }
+    }
+
+    const std::ptrdiff_t s = stride_;
+    const std::ptrdiff_t step[8] = {1, -1, s, -s, s + 1, -s + 1, s - 1, -s - 1};
+    static const std::uint32_t nd[8] = {10, 10, 10, 10, 14, 14, 14, 14};
+
+    for (std::uint32_t d = 1; pending > 0; ++d) {
+        auto& bucket = buckets_[d % buckets_.size()];
+        while (!bucket.empty()) {
+            const std::uint32_t i = bucket.back();
+            bucket.pop_back();
+            --pending;
+            if (cost_[i] != d) continue;
+
+            for (int k = 0; k < 8; ++k) {
+                const std::size_t j = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(i) + step[k]);
+                const std::uint32_t c = d + nd[k];
+                if (c >= cost_[j]) continue;
+                cost_[j] = c;
+                buckets_[c % buckets_.size()].push_back(static_cast<std::uint32_t>(j));
+                ++pending;
+            }
+        }
+    }
+}
+
+float GoalField::at(Vec2 p) const {
+    int x = std::clamp(static_cast<int>(std::floor(p.x - tables_->gridMin.x)), 0, tables_->cols - 1);
+    int z = std::clamp(static_cast<int>(std::floor(p.z - tables_->gridMin.z)), 0, tables_->rows - 1);
+    const std::uint32_t c = cost_[static_cast<std::size_t>(z + 1) * stride_ + (x + 1)];
+    if (c == 0 || c == std::numeric_limits<std::uint32_t>::max()) return unreachable;
+    return static_cast<float>(c - 1) * 0.1f;
+}
+
+// ---------------- Hybrid-A* ----------------
+
+ParkingPlanner::ParkingPlanner(std::shared_ptr<const PlannerTables> tables)
+    : tables_(std::move(tables)) {
+    const std::size_t states = static_cast<std::size_t>(tables_->cols) * tables_->rows * PlannerTables::headingBins;
+    seen_.assign(states, Seen{});
+    nearCone_.assign(static_cast<std::size_t>(tables_->cols) * tables_->rows, 0);
+    reserveNodes();
+}
+
+// hver utvidelse legger til høyst én node per primitiv, så plan() allokerer ikke
+void ParkingPlanner::reserveNodes() {
+    const std::size_t most = static_cast<std::size_t>(std::max(0, maxExpansions)) * tables_->primitives.size() + 1;
+    nodes_.reserve(most);
+    open_.reserve(most);
+}
+
+PlanStats ParkingPlanner::plan(const Simulation& sim, const PlanGoal& goal, const GoalField& field,
+                               std::vector<PathPoint>& path) {
+    auto t0 = std::chrono::steady_clock::now();
+    const PlannerTables& T = *tables_;
+    PlanStats stats;
+    path.clear();
+
+    if (++search_ == 0) { // stempelet gikk rundt: nullstill
+        std::fill(seen_.begin(), seen_.end(), Seen{});
+        search_ = 1;
+    }
+    nodes_.clear();
+    open_.clear();
+    reserveNodes(); // no-op med mindre maxExpansions er økt
+
+    const auto& lot = sim.lot();
+    Vec2 lotMin, lotMax;
+    lotBounds(lot, lotMin, lotMax);
+    const float halfW = sim.carHalfW(), halfD = sim.carHalfD();
+
+    // h er allerede i [-pi, pi] (wrapAngle/wrapTurn)
+    auto stateIndex = [&](Vec2 p, float h) -> std::int64_t {
+        int x = static_cast<int>(std::floor(p.x - T.gridMin.x));
+        int z = static_cast<int>(std::floor(p.z - T.gridMin.z));
+        if (x < 0 || z < 0 || x >= T.cols || z >= T.rows) return -1;
+        int hb = static_cast<int>(std::floor((h + pi) / (2.f * pi) * PlannerTables::headingBins)) %
+                 PlannerTables::headingBins;
+        return (static_cast<std::int64_t>(z) * T.cols + x) * PlannerTables::headingBins + hb;
+    };
+
+    // maks av ikke-holon tabell (i bilens ramme) og holonomt felt (med kjegler)
+    auto heuristic = [&](Vec2 p, Vec2 axis) {
+        float hf = field.at(p);
+        if (hf == unreachable) hf = length(goal.center - p) * 3.f;
+        Vec2 d = goal.center - p;
+        float s = axis.x, c = axis.z;
+        float hn = T.reachCostAt({d.x * c - d.z * s, d.x * s + d.z * c});
+        return std::max(hf, hn);
+    };
+
+    // søkecellene (1 m) der en bilboks med sentrum i cellen kan nå en kjegle; utenfor
+    // dem trengs ikke kjegletesten, og det er de aller fleste prøveposene
+    const float reach = length({halfW + clearance, halfD + clearance});
+    const float coneReach = reach + Simulation::coneRadius;
+    nearCone_.assign(static_cast<std::size_t>(T.cols) * T.rows, 0);
+    for (Vec2 c : sim.cones()) {
+        const Vec2 rel = c - T.gridMin;
+        const int x0 = std::max(0, static_cast<int>(std::floor(rel.x - coneReach)));
+        const int z0 = std::max(0, static_cast<int>(std::floor(rel.z - coneReach)));
+        const int x1 = std::min(T.cols - 1, static_cast<int>(std::floor(rel.x + coneReach)));
+        const int z1 = std::min(T.rows - 1, static_cast<int>(std::floor(rel.z + coneReach)));
+        for (int z = z0; z <= z1; ++z) {
+            for (int x = x0; x <= x1; ++x) {
+                const Vec2 d{rel.x - std::clamp(rel.x, static_cast<float>(x), static_cast<float>(x + 1)),
+                             rel.z - std::clamp(rel.z, static_cast<float>(z), static_cast<float>(z + 1))};
+                if (lengthSq(d) <= coneReach * coneReach) nearCone_[static_cast<std::size_t>(z) * T.cols + x] = 1;
+            }
+        }
+    }
+
+    // axis = (sin, cos) av headingen, som i Obb
+    auto collides = [&](Vec2 p, Vec2 axis, float margin) {
+        const Obb box{p, axis, halfW + margin, halfD + margin};
+        // kantene: bare nær dem kan boksen stikke ut
+        if ((p.x - lotMin.x < reach || lotMax.x - p.x < reach || p.z - lotMin.z < reach || lotMax.z - p.z < reach) &&
+            !insideRect(box, lotMin, lotMax)) {
+            return true;
+        }
+        const int x = static_cast<int>(std::floor(p.x - T.gridMin.x));
+        const int z = static_cast<int>(std::floor(p.z - T.gridMin.z));
+        if (x >= 0 && z >= 0 && x < T.cols && z < T.rows && !nearCone_[static_cast<std::size_t>(z) * T.cols + x]) {
+            return false;
+        }
+        return sim.coneGrid().firstOverlapping(box, Simulation::coneRadius) >= 0;
+    };
+
+    auto cmp = [](const OpenEntry& a, const OpenEntry& b) { return a.f > b.f; };
+
+    const Vec2 startPos = sim.car().position();
+    const float startHeading = sim.car().heading();
+    const Vec2 startAxis{std::sin(startHeading), std::cos(startHeading)};
+    // bilen står ofte inntil en kjegle eller kant (simuleringen stopper den der), og
+    // da kommer ingen primitiv fri med klaring; fra en slik start kan rette primitiver
+    // gå uten klaring til bilen er ute av den, så lenge de ikke berører noe
+    const bool startInContact = collides(startPos, startAxis, clearance);
+    nodes_.push_back({startPos, wrapAngle(startHeading), 0.f, heuristicWeight * heuristic(startPos, startAxis), -1, -1,
+                      static_cast<std::uint8_t>(startInContact ? 1 : 0)});
+    open_.push_back({nodes_[0].f, 0});
+
+    int goalNode = -1;
+    std::uint32_t closest = 0; // utvidet node med lavest heuristikk
+    while (!open_.empty() && stats.expansions < maxExpansions) {
+        std::pop_heap(open_.begin(), open_.end(), cmp);
+        const std::uint32_t ni = open_.back().node;
+        open_.pop_back();
+        const Node n = nodes_[ni];
+
+        if (goal.contains(n.pos)) {
+            goalNode = static_cast<int>(ni);
+            break;
+        }
+
+        std::int64_t si = stateIndex(n.pos, n.heading);
+        if (si >= 0) {
+            if (seen_[si].search == search_ && seen_[si].g < n.g) continue; // bedre vei hit funnet
+        }
+        ++stats.expansions;
+        if (n.f - n.g < nodes_[closest].f - nodes_[closest].g) closest = ni;
+
+        const float prevDir = n.prim >= 0 ? T.primitives[n.prim].dir : 0.f;
+        // nodens ramme én gang; primitivenes punkter og akser roteres inn i den
+        const Vec2 fwd{std::sin(n.heading), std::cos(n.heading)}, right{fwd.z, -fwd.x};
+        auto rotate = [&](Vec2 l) { return right * l.x + fwd * l.z; };
+        for (std::size_t k = 0; k < T.primitives.size(); ++k) {
+            const MotionPrimitive& m = T.primitives[k];
+            constexpr int last = MotionPrimitive::samples - 1;
+
+            float g = n.g + m.length * (m.dir < 0.f ? reversePenalty : 1.f) + std::abs(m.steer) * steerPenalty;
+            if (prevDir != 0.f && prevDir != m.dir) g += switchPenalty;
+
+            // sluttilstanden først: er den nådd billigere, spares kollisjonstestene
+            const Vec2 end = n.pos + rotate(m.pos[last]);
+            const float endHeading = wrapTurn(n.heading + m.dHeading[last]);
+            std::int64_t ei = stateIndex(end, endHeading);
+            if (ei < 0) continue;
+            Seen& seen = seen_[ei];
+            if (seen.search == search_ && seen.g <= g) continue;
+
+            const bool escape = n.contact > 0 && m.steer == 0.f;
+            bool blocked = false;
+            for (int s = 0; s < last && !blocked; ++s) {
+                blocked = collides(n.pos + rotate(m.pos[s]), rotate(m.axis[s]), escape ? 0.f : clearance);
+            }
+            if (blocked) continue;
+            std::uint8_t contact = 0;
+            if (collides(end, rotate(m.axis[last]), clearance)) {
+                if (!escape || n.contact >= maxContactSteps || collides(end, rotate(m.axis[last]), 0.f)) continue;
+                contact = static_cast<std::uint8_t>(n.contact + 1);
+            }
+            seen = {search_, g};
+
+            nodes_.push_back({end, endHeading, g, g + heuristicWeight * heuristic(end, rotate(m.axis[last])),
+                              static_cast<std::int32_t>(ni), static_cast<std::int16_t>(k), contact});
+            open_.push_back({nodes_.back().f, static_cast<std::uint32_t>(nodes_.size() - 1)});
+            std::push_heap(open_.begin(), open_.end(), cmp);
+        }
+    }
+
+    stats.limitHit = goalNode < 0 && stats.expansions >= maxExpansions;
+    // budsjettet brukt opp: stien fram til posen nærmest målet, så bilen kommer
+    // videre og planlegger resten derfra
+    if (stats.limitHit && closest > 0) {
+        goalNode = static_cast<int>(closest);
+        stats.partial = true;
+    }
+    if (goalNode >= 0) {
+        stats.found = !stats.partial;
+
+        chain_.clear();
+        for (int i = goalNode; i >= 0; i = nodes_[i].parent) chain_.push_back(i);
+        std::reverse(chain_.begin(), chain_.end());
+
+        path.push_back({startPos, startHeading, chain_.size() > 1 ? T.primitives[nodes_[chain_[1]].prim].dir : 1.f});
+        for (std::size_t c = 1; c < chain_.size(); ++c) {
+            const Node& parent = nodes_[nodes_[chain_[c]].parent];
+            const MotionPrimitive& m = T.primitives[nodes_[chain_[c]].prim];
+            for (int s = 0; s < MotionPrimitive::samples; ++s) {
+                path.push_back({toWorld(parent.pos, parent.heading, m.pos[s]),
+                                wrapAngle(parent.heading + m.dHeading[s]), m.dir});
+            }
+        }
+    }
+
+    stats.micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+    return stats;
+}
+
+// ---------------- sporing ----------------
+
+void Autopilot::replan(const Simulation& sim, ParkingPlanner& planner, const PlanGoal& goal) {
+    lastPlan_ = planner.plan(sim, goal, field_, path_);
+    lastPlan_.fieldMicros = fieldMicros_;
+    fieldMicros_ = 0.0;
+    ++plans_;
+    pathIdx_ = 0;
+    stuckTime_ = 0.f;
+    if (path_.empty()) {
+        ++failed_;
+        retryIn_ = 0.5f;
+        pivotDir_ = -pivotDir_;
+    }
+}
+
+// ingen sti: Car::update snur også i ro, så vri bilen fri av kjeglen
+// (simuleringen stopper vridningen hvis den ville gått inn i en)
+CarInput Autopilot::pivot(const Car& car) const {
+    CarInput in;
+    if (std::abs(car.speed()) > 0.3f) {
+        in.throttle = car.speed() > 0.f ? -1.f : 1.f;
+        return in;
+    }
+    in.steer = pivotDir_;
+    return in;
+}
+
+CarInput Autopilot::drive(const Simulation& sim, ParkingPlanner& planner, float dt) {
+    const Car& car = sim.car();
+    CarInput in;
+
+    PlanGoal goal;
+    if (!nextPlanGoal(sim, goal)) {
+        in.handbrake = car.speed() > 0.f;
+        return in;
+    }
+
+    // før første steg kan bilen stå utenfor plassen; kantene flytter den inn
+    Vec2 lotMin, lotMax;
+    lotBounds(sim.lot(), lotMin, lotMax);
+    const Vec2 p = car.position();
+    if (p.x < lotMin.x || p.z < lotMin.z || p.x > lotMax.x || p.z > lotMax.z) return in;
+
+    // nytt mål eller ny verden: nytt felt og ny sti
+    const int spot = sim.currentTargetSpot();
+    if (!hasGoal_ || world_ != sim.worldId() || goalKind_ != goal.kind || goalSpot_ != spot) {
+        hasGoal_ = true;
+        world_ = sim.worldId();
+        goalKind_ = goal.kind;
+        goalSpot_ = spot;
+        const auto t0 = std::chrono::steady_clock::now();
+        field_.build(planner.tables(), sim, goal);
+        fieldMicros_ = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count();
+        retryIn_ = 0.f;
+        replan(sim, planner, goal);
+    }
+
+    // i målområdet: stå stille (parkering teller mens farten er lav)
+    if (goal.contains(car.position()) && goal.kind != PlanGoalKind::Key) {
+        in.handbrake = car.speed() > 0.f;
+        in.throttle = car.speed() < -0.05f ? 0.5f : 0.f;
+        return in;
+    }
+
+    retryIn_ -= dt;
+    if (path_.empty()) {
+        if (retryIn_ <= 0.f) replan(sim, planner, goal);
+        if (path_.empty()) return pivot(car);
+    }
+
+    // nærmeste punkt framover på stien, innenfor samme kjøreretning
+    std::size_t segEnd = pathIdx_;
+    while (segEnd + 1 < path_.size() && path_[segEnd + 1].dir == path_[pathIdx_].dir) ++segEnd;
+
+    std::size_t nearest = pathIdx_;
+    float nearestD2 = lengthSq(path_[pathIdx_].pos - p);
+    for (std::size_t i = pathIdx_ + 1; i <= segEnd && i < pathIdx_ + 24; ++i) {
+        float d2 = lengthSq(path_[i].pos - p);
+        if (d2 < nearestD2) {
+            nearestD2 = d2;
+            nearest = i;
+        }
+    }
+    pathIdx_ = nearest;
+
+    // vendepunkt: stopp der, fortsett på neste del av stien
+    const float dir = path_[pathIdx_].dir;
+    const float toSegEnd = length(path_[segEnd].pos - p);
+    if (segEnd + 1 < path_.size() && toSegEnd < 0.5f && std::abs(car.speed()) < 0.3f) {
+        pathIdx_ = segEnd + 1;
+        return in;
+    }
+
+    // ute av stien eller fast (kjegle): planlegg på nytt
+    stuckTime_ = std::abs(car.speed()) < 0.05f ? stuckTime_ + dt : 0.f;
+    if ((nearestD2 > 2.f * 2.f || stuckTime_ > 1.f || (pathIdx_ == segEnd && segEnd + 1 == path_.size())) &&
+        retryIn_ <= 0.f) {
+        replan(sim, planner, goal);
+        if (path_.empty()) return pivot(car);
+        return in;
+    }
+
+    // pure pursuit mot et punkt litt lenger fram på samme del
+    const float lookahead = dir > 0.f ? 2.5f : 1.5f;
+    std::size_t target = pathIdx_;
+    while (target < segEnd && length(path_[target].pos - p) < lookahead) ++target;
+    Vec2 d = path_[target].pos - p;
+    if (dir < 0.f) d = d * -1.f; // rygging: baksiden skal peke mot punktet
+
+    float err = wrapAngle(std::atan2(d.x, d.z) - car.heading());
+    // Car::update snur også i ro: fra stillstand ville bilen vridd seg på stedet
+    // i stedet for å følge buen, så rattet venter til bilen ruller
+    const float rolling = std::abs(car.speed()) < 0.3f ? 0.f : std::min(1.f, 0.2f + std::abs(car.speed()));
+    in.steer = std::clamp(err * 2.5f, -1.f, 1.f) * rolling;
+
+    // fart: ned mot null ved vendepunkt og stiens slutt
+    float targetSpeed = std::min(dir > 0.f ? planSpeedFwd : -planSpeedRev, toSegEnd * 1.2f);
+    if (toSegEnd < 0.25f) targetSpeed = 0.f;
+    targetSpeed *= dir;
+
+    in.throttle = std::clamp((targetSpeed - car.speed()) * 0.8f, -1.f, 1.f);
+    in.handbrake = targetSpeed == 0.f && car.speed() > 0.f;
+    return in;
+}
@@ -0,0 +1,341 @@
+// --------------------------------------------------------------------------------------
+// Structure-of-arrays batch version of Car::update.
+// The sin/cos polynomial and range reduction follow the well known Cephes sinf/cosf
+// approach (also used by sse_mathfun); the kernel is written once over a small
+// "ops" wrapper and instantiated for AVX2, SSE2 and plain floats.
+// --------------------------------------------------------------------------------------
+
+#include "sim/CarFleet.h"
+
+#include <cassert>
+#include <cmath>
+
+#if defined(__AVX2__)
+#define CARFLEET_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define CARFLEET_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+// ---------------- ops ----------------
+
+struct ScalarOps {
+    using V = float;
+    using M = bool;
+    static constexpr int width = 1;
+
+    static V load(const float* p) { return *p; }
+    static void store(float* p, V v) { *p = v; }
+    static V set1(float x) { return x; }
+
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V div(V a, V b) { return a / b; }
+    static V min(V a, V b) { return a < b ? a : b; }
+    static V max(V a, V b) { return a > b ? a : b; }
+    static V abs(V a) { return std::fabs(a); }
+    static V neg(V a) { return -a; }
+    static V trunc(V a) { return std::trunc(a); }
+    static V copysign(V mag, V sgn) { return std::copysign(mag, sgn); }
+
+    static M gt(V a, V b) { return a > b; }
+    static M lt(V a, V b) { return a < b; }
+    static M ge(V a, V b) { return a >= b; }
+    static M eq(V a, V b) { return a == b; }
+    static M mand(M a, M b) { return a && b; }
+    static M mor(M a, M b) { return a || b; }
+    static V select(M m, V a, V b) { return m ? a : b; }
+};
+
+#if CARFLEET_AVX2
+struct Avx2Ops {
+    using V = __m256;
+    using M = __m256;
+    static constexpr int width = 8;
+
+    static V load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, V v) { _mm256_storeu_ps(p, v); }
+    static V set1(float x) { return _mm256_set1_ps(x); }
+
+    static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm256_div_ps(a, b); }
+    static V min(V a, V b) { return _mm256_min_ps(a, b); }
+    static V max(V a, V b) { return _mm256_max_ps(a, b); }
+    static V abs(V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+    static V neg(V a) { return _mm256_xor_ps(_mm256_set1_ps(-0.f), a); }
+    static V trunc(V a) { return _mm256_round_ps(a, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC); }
+    static V copysign(V mag, V sgn) {
+        V signBit = _mm256_set1_ps(-0.f);
+        return _mm256_or_ps(_mm256_andnot_ps(signBit, mag), _mm256_and_ps(signBit, sgn));
+    }
+
+    static M gt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static M lt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static M ge(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static M eq(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static M mand(M a, M b) { return _mm256_and_ps(a, b); }
+    static M mor(M a, M b) { return _mm256_or_ps(a, b); }
+    static V select(M m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+};
+#endif
+
+#if CARFLEET_SSE2
+struct Sse2Ops {
+    using V = __m128;
+    using M = __m128;
+    static constexpr int width = 4;
+
+    static V load(const float* p) { return _mm_loadu_ps(p); }
+    static void store(float* p, V v) { _mm_storeu_ps(p, v); }
+    static V set1(float x) { return _mm_set1_ps(x); }
+
+    static V add(V a, V b) { return _mm_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm_div_ps(a, b); }
+    static V min(V a, V b) { return _mm_min_ps(a, b); }
+    static V max(V a, V b) { return _mm_max_ps(a, b); }
+    static V abs(V a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+    static V neg(V a) { return _mm_xor_ps(_mm_set1_ps(-0.f), a); }
+    static V trunc(V a) { return _mm_cvtepi32_ps(_mm_cvttps_epi32(a)); }
+    static V copysign(V mag, V sgn) {
+        V signBit = _mm_set1_ps(-0.f);
+        return _mm_or_ps(_mm_andnot_ps(signBit, mag), _mm_and_ps(signBit, sgn));
+    }
+
+    static M gt(V a, V b) { return _mm_cmpgt_ps(a, b); }
+    static M lt(V a, V b) { return _mm_cmplt_ps(a, b); }
+    static M ge(V a, V b) { return _mm_cmpge_ps(a, b); }
+    static M eq(V a, V b) { return _mm_cmpeq_ps(a, b); }
+    static M mand(M a, M b) { return _mm_and_ps(a, b); }
+    static M mor(M a, M b) { return _mm_or_ps(a, b); }
+    static V select(M m, V a, V b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+};
+#endif
+
+// ---------------- sin/cos ----------------
+
+// Cephes-stil sincos: reduserer til [-pi/4, pi/4] og bruker minimax-polynomer.
+// Nøyaktighet ~1 ulp for vinkler som heading typisk har.
+template <class Ops>
+inline void sincos(typename Ops::V x, typename Ops::V& sOut, typename Ops::V& cOut) {
+    using V = typename Ops::V;
+
+    const V ax = Ops::abs(x);
+
+    // y = kvadrant (gjort partall), j = y mod 8
+    V y = Ops::trunc(Ops::mul(ax, Ops::set1(1.27323954473516f))); // 4/pi
+    V half = Ops::trunc(Ops::mul(y, Ops::set1(0.5f)));
+    y = Ops::add(y, Ops::sub(y, Ops::add(half, half)));
+    V j = Ops::sub(y, Ops::mul(Ops::trunc(Ops::mul(y, Ops::set1(0.125f))), Ops::set1(8.f)));
+
+    // utvidet presisjon: ax - y*pi/4 i tre ledd
+    V r = Ops::sub(ax, Ops::mul(y, Ops::set1(0.78515625f)));
+    r = Ops::sub(r, Ops::mul(y, Ops::set1(2.4187564849853515625e-4f)));
+    r = Ops::sub(r, Ops::mul(y, Ops::set1(3.77489497744594108e-8f)));
+    V z = Ops::mul(r, r);
+
+    V cp = Ops::set1(2.443315711809948e-5f);
+    cp = Ops::add(Ops::mul(cp, z), Ops::set1(-1.388731625493765e-3f));
+    cp = Ops::add(Ops::mul(cp, z), Ops::set1(4.166664568298827e-2f));
+    cp = Ops::mul(Ops::mul(cp, z), z);
+    cp = Ops::add(Ops::sub(cp, Ops::mul(z, Ops::set1(0.5f))), Ops::set1(1.f));
+
+    V sp = Ops::set1(-1.9515295891e-4f);
+    sp = Ops::add(Ops::mul(sp, z), Ops::set1(8.3321608736e-3f));
+    sp = Ops::add(Ops::mul(sp, z), Ops::set1(-1.6666654611e-1f));
+    sp = Ops::add(Ops::mul(Ops::mul(sp, z), r), r);
+
+    auto swap = Ops::mor(Ops::eq(j, Ops::set1(2.f)), Ops::eq(j, Ops::set1(6.f)));
+    auto sneg = Ops::ge(j, Ops::set1(4.f));
+    auto cneg = Ops::mor(Ops::eq(j, Ops::set1(2.f)), Ops::eq(j, Ops::set1(4.f)));
+
+    V s = Ops::select(swap, cp, sp);
+    V c = Ops::select(swap, sp, cp);
+
+    s = Ops::select(sneg, Ops::neg(s), s);
+    s = Ops::select(Ops::lt(x, Ops::set1(0.f)), Ops::neg(s), s);
+    c = Ops::select(cneg, Ops::neg(c), c);
+
+    sOut = s;
+    cOut = c;
+}
+
+// ---------------- kjerne ----------------
+
+struct FleetArrays {
+    float* speed;
+    float* heading;
+    float* x;
+    float* z;
+    const float* maxSpeed;
+    const float* accel;
+    const float* brake;
+    const float* steerRate;
+    const float* friction;
+};
+
+// Grenløs versjon av Car::update for Ops::width biler fra indeks i.
+// in* peker på inputs allerede transponert til arrays.
+template <class Ops>
+inline void integrate(const FleetArrays& f, std::size_t i, float dtf,
+                      const float* inThrottle, const float* inSteer, const float* inHandbrake) {
+    using V = typename Ops::V;
+
+    const V dt   = Ops::set1(dtf);
+    const V zero = Ops::set1(0.f);
+
+    V speed   = Ops::load(f.speed + i);
+    V heading = Ops::load(f.heading + i);
+    V throttle  = Ops::load(inThrottle);
+    V steer     = Ops::load(inSteer);
+    auto handbrake = Ops::gt(Ops::load(inHandbrake), zero);
+
+    // steering (mindre styring ved høy fart)
+    V steerScale = Ops::div(Ops::set1(10.f), Ops::add(Ops::abs(speed), Ops::set1(5.f)));
+    steerScale = Ops::min(Ops::max(steerScale, Ops::set1(0.4f)), Ops::set1(1.2f));
+    heading = Ops::add(heading,
+                       Ops::mul(Ops::mul(Ops::mul(steer, Ops::load(f.steerRate + i)), steerScale), dt));
+
+    V a = Ops::mul(throttle, Ops::load(f.accel + i));
+
+    // handbrekk: bare bremser, ikke revers
+    auto hb = Ops::mand(handbrake, Ops::gt(speed, zero));
+    V braked = Ops::max(zero, Ops::sub(speed, Ops::mul(Ops::load(f.brake + i), dt)));
+    speed = Ops::select(hb, braked, speed);
+    a = Ops::select(hb, Ops::max(a, zero), a);
+
+    // friksjon mot null fra begge sider
+    V mag = Ops::max(zero, Ops::sub(Ops::abs(speed), Ops::mul(Ops::load(f.friction + i), dt)));
+    speed = Ops::copysign(mag, speed);
+
+    // integrer & clamp (litt revers tillatt)
+    V maxSpeed = Ops::load(f.maxSpeed + i);
+    speed = Ops::add(speed, Ops::mul(a, dt));
+    speed = Ops::min(Ops::max(speed, Ops::mul(maxSpeed, Ops::set1(-0.25f))), maxSpeed);
+
+    V s, c;
+    sincos<Ops>(heading, s, c);
+
+    V vdt = Ops::mul(speed, dt);
+    Ops::store(f.x + i, Ops::add(Ops::load(f.x + i), Ops::mul(vdt, s)));
+    Ops::store(f.z + i, Ops::add(Ops::load(f.z + i), Ops::mul(vdt, c)));
+    Ops::store(f.speed + i, speed);
+    Ops::store(f.heading + i, heading);
+}
+
+template <class Ops>
+void integrateRange(const FleetArrays& f, std::size_t n, float dt,
+                    const float* throttle, const float* steer, const float* handbrake) {
+    constexpr int W = Ops::width;
+
+    std::size_t i = 0;
+    for (; i + W <= n; i += W) {
+        integrate<Ops>(f, i, dt, throttle + i, steer + i, handbrake + i);
+    }
+
+    // hale
+    for (; i < n; ++i) {
+        integrate<ScalarOps>(f, i, dt, throttle + i, steer + i, handbrake + i);
+    }
+}
+
+} // namespace
+
+// ---------------- CarFleet ----------------
+
+std::size_t CarFleet::add(const CarPhysicsParams& p, Vec2 pos, float heading) {
+    speed_.push_back(0.f);
+    heading_.push_back(heading);
+    x_.push_back(pos.x);
+    z_.push_back(pos.z);
+
+    maxSpeed_.push_back(p.maxSpeed);
+    accel_.push_back(p.accel);
+    brake_.push_back(p.brake);
+    steerRate_.push_back(p.steerRate);
+    friction_.push_back(p.friction);
+
+    return speed_.size() - 1;
+}
+
+void CarFleet::reserve(std::size_t n) {
+    for (auto* v : {&speed_, &heading_, &x_, &z_,
+                    &maxSpeed_, &accel_, &brake_, &steerRate_, &friction_}) {
+        v->reserve(n);
+    }
+}
+
+void CarFleet::clear() {
+    for (auto* v : {&speed_, &heading_, &x_, &z_,
+                    &maxSpeed_, &accel_, &brake_, &steerRate_, &friction_}) {
+        v->clear();
+    }
+}
+
+void CarFleet::hardReset(std::size_t i, Vec2 pos, float yawRad) {
+    x_[i] = pos.x;
+    z_[i] = pos.z;
+    heading_[i] = yawRad;
+    speed_[i] = 0.f;
+}
+
+void CarFleet::transposeInputs(std::span<const CarInput> inputs) {
+    assert(inputs.size() == size());
+
+    // eget pass: å skrive skalarer og straks lese dem som vektor gir
+    // store-forwarding-stopp, så inputs transponeres for hele flåten først
+    const std::size_t n = size();
+    inThrottle_.resize(n);
+    inSteer_.resize(n);
+    inHandbrake_.resize(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        inThrottle_[i]  = inputs[i].throttle;
+        inSteer_[i]     = inputs[i].steer;
+        inHandbrake_[i] = inputs[i].handbrake ? 1.f : 0.f;
+    }
+}
+
+void CarFleet::update(float dt, std::span<const CarInput> inputs) {
+    transposeInputs(inputs);
+
+    FleetArrays f{speed_.data(), heading_.data(), x_.data(), z_.data(),
+                  maxSpeed_.data(), accel_.data(), brake_.data(),
+                  steerRate_.data(), friction_.data()};
+
+#if CARFLEET_AVX2
+    using Ops = Avx2Ops;
+#elif CARFLEET_SSE2
+    using Ops = Sse2Ops;
+#else
+    using Ops = ScalarOps;
+#endif
+    integrateRange<Ops>(f, size(), dt, inThrottle_.data(), inSteer_.data(), inHandbrake_.data());
+}
+
+void CarFleet::updateScalar(float dt, std::span<const CarInput> inputs) {
+    transposeInputs(inputs);
+
+    FleetArrays f{speed_.data(), heading_.data(), x_.data(), z_.data(),
+                  maxSpeed_.data(), accel_.data(), brake_.data(),
+                  steerRate_.data(), friction_.data()};
+
+    integrateRange<ScalarOps>(f, size(), dt, inThrottle_.data(), inSteer_.data(), inHandbrake_.data());
+}
+
+const char* CarFleet::simdPath() {
+#if CARFLEET_AVX2
+    return "avx2";
+#elif CARFLEET_SSE2
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
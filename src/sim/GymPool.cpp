@@ -0,0 +1,211 @@
+// --------------------------------------------------------------------------------------
+// Batched gym-style environment over EpisodeRunner: structure-of-rows output written
+// straight into caller buffers (zero-copy for numpy / shared memory), auto-reset vector
+// env semantics as in Gymnasium's VectorEnv, and distance-progress reward shaping
+// towards the current objective (spot, key, door).
+// --------------------------------------------------------------------------------------
+
+#include "sim/GymPool.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// grain: ~8 biter per arbeider, som EpisodeRunner::run
+std::size_t grainFor(std::size_t n, unsigned workers) {
+    return std::max<std::size_t>(1, n / (static_cast<std::size_t>(workers) * 8));
+}
+
+unsigned threadCount(unsigned requested) {
+    return requested > 0 ? requested : std::max(1u, std::thread::hardware_concurrency());
+}
+
+}
+
+GymPool::GymPool(const GymConfig& cfg)
+    : cfg_(cfg),
+      runner_(cfg.episodes, cfg.seed, cfg.scenario),
+      pool_(threadCount(cfg.threads)),
+      tracks_(cfg.episodes) {
+    cfg_.frameSkip = std::max(1, cfg_.frameSkip);
+    grain_ = grainFor(runner_.size(), pool_.size());
+    for (std::size_t i = 0; i < runner_.size(); ++i) startTrack(i);
+}
+
+// ---------------- mål og observasjon ----------------
+
+// avstand fra bilen til det den skal mot nå: plassen, nøkkelen eller døråpningen
+float GymPool::goalDistance(const Simulation& sim) const {
+    const Vec2 p = sim.car().position();
+    const int target = sim.currentTargetSpot();
+    if (target >= 0) return length(sim.lot().spots[target].center - p);
+    if (!sim.keyCollected()) return length(sim.keyPos() - p);
+    return length(sim.doorPos() + Vec2{0.f, 2.5f} - p);
+}
+
+void GymPool::startTrack(std::size_t i) {
+    const Simulation& sim = runner_.episode(i);
+    Track& t = tracks_[i];
+    t.steps = 0;
+    t.finished = CAR_GYM_RUNNING;
+    t.completed = sim.completedTargets();
+    t.keyCollected = sim.keyCollected();
+    t.goalDist = goalDistance(sim);
+}
+
+void GymPool::observe(std::size_t i, float* row) const {
+    const Simulation& sim = runner_.episode(i);
+    const Car& car = sim.car();
+    const Vec2 p = car.position();
+    const float s = std::sin(car.heading()), c = std::cos(car.heading());
+
+    // i bilens ramme: x = høyre, z = framover
+    auto local = [&](Vec2 w, int at) {
+        const Vec2 d = w - p;
+        row[at] = d.x * c - d.z * s;
+        row[at + 1] = d.x * s + d.z * c;
+    };
+
+    row[CAR_GYM_OBS_POS_X] = p.x;
+    row[CAR_GYM_OBS_POS_Z] = p.z;
+    row[CAR_GYM_OBS_HEADING_SIN] = s;
+    row[CAR_GYM_OBS_HEADING_COS] = c;
+    row[CAR_GYM_OBS_SPEED] = car.speed();
+
+    const int target = sim.currentTargetSpot();
+    if (target >= 0) {
+        local(sim.lot().spots[target].center, CAR_GYM_OBS_TARGET_DX);
+    } else {
+        row[CAR_GYM_OBS_TARGET_DX] = row[CAR_GYM_OBS_TARGET_DZ] = 0.f;
+    }
+    row[CAR_GYM_OBS_HAS_TARGET] = target >= 0 ? 1.f : 0.f;
+    row[CAR_GYM_OBS_PARKED] = sim.requiredParkTime() > 0.f ? sim.parkedTimer() / sim.requiredParkTime() : 0.f;
+    row[CAR_GYM_OBS_COMPLETED] = sim.requiredTargets() > 0
+                                     ? static_cast<float>(sim.completedTargets()) / static_cast<float>(sim.requiredTargets())
+                                     : 1.f;
+    row[CAR_GYM_OBS_KEY_AVAILABLE] = sim.keyAvailable() ? 1.f : 0.f;
+    row[CAR_GYM_OBS_KEY_COLLECTED] = sim.keyCollected() ? 1.f : 0.f;
+    row[CAR_GYM_OBS_DOOR_OPENED] = sim.doorOpened() ? 1.f : 0.f;
+    local(sim.keyPos(), CAR_GYM_OBS_KEY_DX);
+    local(sim.doorPos(), CAR_GYM_OBS_DOOR_DX);
+
+    // de nærmeste kjeglene innenfor coneRange, sortert (innsetting i en liten tabell)
+    constexpr int k = CAR_GYM_NEAREST_CONES;
+    float bestD2[k];
+    Vec2 best[k];
+    int found = 0;
+    const float range = cfg_.coneRange;
+    sim.coneGrid().forEachInBox(p - Vec2{range, range}, p + Vec2{range, range}, [&](int, Vec2 cp) {
+        const float d2 = lengthSq(cp - p);
+        if (d2 > range * range || (found == k && d2 >= bestD2[k - 1])) return;
+        int at = found < k ? found++ : k - 1;
+        while (at > 0 && bestD2[at - 1] > d2) {
+            bestD2[at] = bestD2[at - 1];
+            best[at] = best[at - 1];
+            --at;
+        }
+        bestD2[at] = d2;
+        best[at] = cp;
+    });
+    for (int j = 0; j < k; ++j) {
+        float* cone = row + CAR_GYM_OBS_CONES + 3 * j;
+        if (j < found) {
+            local(best[j], static_cast<int>(cone - row));
+            cone[2] = 1.f;
+        } else {
+            cone[0] = cone[1] = cone[2] = 0.f;
+        }
+    }
+}
+
+// ---------------- reset / step ----------------
+
+void GymPool::reset(float* observations) {
+    for (std::size_t i = 0; i < runner_.size(); ++i) resetOne(i, observations);
+}
+
+void GymPool::resetOne(std::size_t i, float* observations) {
+    Simulation& sim = runner_.episode(i);
+    sim.reset();
+    startTrack(i);
+    observe(i, observations + i * obsSize);
+}
+
+void GymPool::step(const float* actions, float* observations, float* rewards, std::uint8_t* dones,
+                   float* finalObservations) {
+    actions_ = actions;
+    observations_ = observations;
+    rewards_ = rewards;
+    dones_ = dones;
+    finalObservations_ = finalObservations;
+    // fanger bare this, så std::function ikke trenger å allokere
+    pool_.parallelFor(runner_.size(), grain_, [this](std::size_t begin, std::size_t end) { stepRange(begin, end); });
+}
+
+void GymPool::stepRange(std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+        Simulation& sim = runner_.episode(i);
+        Track& t = tracks_[i];
+
+        const float* a = actions_ + i * actionSize;
+        CarInput in;
+        in.throttle = std::clamp(a[0], -1.f, 1.f);
+        in.steer = std::clamp(a[1], -1.f, 1.f);
+        in.handbrake = a[2] > 0.5f;
+
+        float reward = 0.f;
+        std::uint8_t done = CAR_GYM_RUNNING;
+        if (t.finished) {
+            // uten auto-reset står en ferdig episode til den resettes
+            rewards_[i] = 0.f;
+            dones_[i] = t.finished;
+            observe(i, observations_ + i * obsSize);
+            if (finalObservations_) observe(i, finalObservations_ + i * obsSize);
+            continue;
+        }
+        for (int k = 0; k < cfg_.frameSkip && done == CAR_GYM_RUNNING; ++k) {
+            sim.step(cfg_.dt, in);
+            sim.clearEvents();
+            ++t.steps;
+
+            reward += cfg_.rewardStep;
+            bool newGoal = false;
+            if (sim.completedTargets() != t.completed) {
+                reward += cfg_.rewardTarget * static_cast<float>(sim.completedTargets() - t.completed);
+                t.completed = sim.completedTargets();
+                newGoal = true;
+            }
+            if (sim.keyCollected() && !t.keyCollected) {
+                reward += cfg_.rewardKey;
+                t.keyCollected = true;
+                newGoal = true;
+            }
+            // nytt mål: avstanden regnes fra det, uten straff for hoppet
+            const float dist = goalDistance(sim);
+            if (!newGoal) reward += cfg_.rewardProgress * (t.goalDist - dist);
+            t.goalDist = dist;
+
+            if (sim.state() == GameState::Won) {
+                reward += cfg_.rewardWin;
+                done = CAR_GYM_WON;
+            } else if (cfg_.maxSteps > 0 && t.steps >= cfg_.maxSteps) {
+                done = CAR_GYM_TIME_LIMIT;
+            }
+        }
+
+        rewards_[i] = reward;
+        dones_[i] = done;
+        if (done != CAR_GYM_RUNNING) {
+            // sluttobservasjonen før reset, så en avkuttet episode kan bootstrappes
+            if (finalObservations_) observe(i, finalObservations_ + i * obsSize);
+            if (cfg_.autoReset) {
+                sim.reset();
+                startTrack(i);
+            } else {
+                t.finished = done;
+            }
+        }
+        observe(i, observations_ + i * obsSize);
+    }
+}
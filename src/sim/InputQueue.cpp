@@ -0,0 +1,65 @@
+// --------------------------------------------------------------------------------------
+// Timestamped input events applied inside fixed steps. Each step gets the time-weighted
+// average of the controls over its interval, which for inputs that act linearly on the
+// integrator is equivalent to splitting the step at the event time.
+// --------------------------------------------------------------------------------------
+
+#include "sim/InputQueue.h"
+
+#include <algorithm>
+
+InputQueue::InputQueue(std::size_t capacity, std::uint64_t minHoldNs)
+    : queue_(capacity), minHoldNs_(minHoldNs) {}
+
+bool InputQueue::push(const InputEvent& e) {
+    if (queue_.push(e)) return true;
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+CarInput InputQueue::integrate(std::uint64_t beginNs, std::uint64_t endNs, std::uint64_t nowNs) {
+    double throttle = 0.0, steer = 0.0, handbrake = 0.0;
+    std::uint64_t t = beginNs;
+
+    // kontrollene slik de står, vektet med tiden fram til until
+    auto hold = [&](std::uint64_t until) {
+        const double w = static_cast<double>(until - t);
+        throttle += held_.throttle * w;
+        steer += held_.steer * w;
+        if (held_.handbrake) handbrake += w;
+        t = until;
+    };
+
+    for (;;) {
+        if (!hasPending_) {
+            if (!queue_.pop(pending_)) break;
+            hasPending_ = true;
+        }
+
+        // forrige endring av samme kontroll varer minst minHoldNs
+        const auto c = static_cast<std::size_t>(pending_.control);
+        const std::uint64_t at = std::max({pending_.timeNs, holdUntilNs_[c], t});
+        if (at >= endNs) break; // hører til et senere steg
+
+        hold(at);
+        switch (pending_.control) {
+            case InputControl::Throttle: held_.throttle = pending_.value; break;
+            case InputControl::Steer: held_.steer = pending_.value; break;
+            case InputControl::Handbrake: held_.handbrake = pending_.value != 0.f; break;
+        }
+        holdUntilNs_[c] = at + minHoldNs_;
+        lastAppliedNs_ = pending_.timeNs;
+        if (nowNs >= pending_.timeNs) latency_.add(static_cast<double>(nowNs - pending_.timeNs) * 1e-6);
+        hasPending_ = false;
+    }
+    if (endNs <= beginNs) return held_;
+    hold(endNs);
+
+    const double span = static_cast<double>(endNs - beginNs);
+
+    CarInput in;
+    in.throttle = static_cast<float>(throttle / span);
+    in.steer = static_cast<float>(steer / span);
+    in.handbrake = handbrake * 2.0 >= span;
+    return in;
+}
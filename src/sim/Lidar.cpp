@@ -0,0 +1,167 @@
+// --------------------------------------------------------------------------------------
+// CPU lidar over RayBvh: a static BVH for cones and lot walls, a dynamic one rebuilt
+// each step for the door and other cars, and 8-ray packets per channel. Elevation
+// channels make it a 2.5D scan (extruded footprints plus the ground plane), enough
+// for the flat lot. Parallel scans split work over cars and beam chunks.
+// --------------------------------------------------------------------------------------
+
+#include "sim/Lidar.h"
+
+#include "logic/Simulation.h"
+#include "util/ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+// stråler per oppgave i parallell skanning (delelig med pakkebredden)
+const int beamsPerTask = 256;
+
+}
+
+Lidar::Lidar(const LidarConfig& cfg, const LidarWorldHeights& heights) : cfg_(cfg), heights_(heights) {
+    cfg_.beams = std::max(1, cfg_.beams);
+    cfg_.channels = std::max(1, cfg_.channels);
+
+    // full sirkel: ingen dobbel stråle i ±pi; ellers begge kantene med
+    const bool full = cfg_.fov >= 6.2831f;
+    const float step = cfg_.beams > 1 ? cfg_.fov / static_cast<float>(full ? cfg_.beams : cfg_.beams - 1) : 0.f;
+    const float start = cfg_.beams > 1 ? -0.5f * cfg_.fov : 0.f;
+    beamSin_.resize(cfg_.beams);
+    beamCos_.resize(cfg_.beams);
+    for (int b = 0; b < cfg_.beams; ++b) {
+        const float a = start + step * static_cast<float>(b);
+        beamSin_[b] = std::sin(a);
+        beamCos_[b] = std::cos(a);
+    }
+
+    slope_.resize(cfg_.channels);
+    cosElevation_.resize(cfg_.channels);
+    for (int c = 0; c < cfg_.channels; ++c) {
+        const float e = cfg_.channels == 1 ? 0.f
+                      : cfg_.minElevation + (cfg_.maxElevation - cfg_.minElevation) * static_cast<float>(c) /
+                                                static_cast<float>(cfg_.channels - 1);
+        slope_[c] = std::tan(e);
+        cosElevation_[c] = std::cos(e);
+    }
+}
+
+// ---------------- geometri ----------------
+
+void Lidar::buildStatic(const Simulation& sim) {
+    const auto& cones = sim.cones();
+    static_.clear();
+    static_.reserve(cones.size() + 4);
+    for (std::size_t i = 0; i < cones.size(); ++i) {
+        static_.add(makeCirclePrim(cones[i], Simulation::coneRadius, 0.f, heights_.cone,
+                                   tag(LidarHit::Cone, static_cast<std::uint32_t>(i))));
+    }
+
+    // veggene ligger rett utenfor kanten bilen holdes innenfor
+    const ParkingLot& lot = sim.lot();
+    const float hw = lot.width * 0.5f, hd = lot.depth * 0.5f, t = 0.05f;
+    const Vec2 c = lot.center;
+    const Obb walls[4] = {
+        {{c.x - hw - t, c.z}, {0.f, 1.f}, t, hd + 2.f * t},
+        {{c.x + hw + t, c.z}, {0.f, 1.f}, t, hd + 2.f * t},
+        {{c.x, c.z - hd - t}, {0.f, 1.f}, hw + 2.f * t, t},
+        {{c.x, c.z + hd + t}, {0.f, 1.f}, hw + 2.f * t, t},
+    };
+    for (std::uint32_t k = 0; k < 4; ++k) static_.add(makeBoxPrim(walls[k], 0.f, heights_.wall, tag(LidarHit::Wall, k)));
+    static_.build();
+}
+
+void Lidar::updateDynamic(const Simulation& sim, std::span<const Obb> cars) {
+    dynamic_.clear();
+    dynamic_.reserve(cars.size() + 1);
+    const Obb door{sim.doorPos(), {0.f, 1.f}, sim.doorHalfW(), heights_.doorHalfDepth};
+    dynamic_.add(makeBoxPrim(door, sim.doorHeight() - heights_.doorHalfHeight, sim.doorHeight() + heights_.doorHalfHeight,
+                             tag(LidarHit::Door, 0)));
+    for (std::size_t i = 0; i < cars.size(); ++i) {
+        dynamic_.add(makeBoxPrim(cars[i], 0.f, heights_.car, carTag(static_cast<std::uint32_t>(i))));
+    }
+    dynamic_.build();
+}
+
+// ---------------- skanning ----------------
+
+template <bool Linear>
+void Lidar::scanRange(const LidarPose& pose, int ch, int first, int count, float* ranges, LidarHit* hits) const {
+    const float hs = std::sin(pose.heading), hc = std::cos(pose.heading);
+    const float slope = slope_[ch], cosEl = cosElevation_[ch];
+
+    // horisontal rekkevidde, kortet ned av bakken for stråler nedover
+    const float farT = cfg_.maxRange * cosEl;
+    const float groundT = cfg_.hitGround && slope < 0.f ? -cfg_.mountHeight / slope : farT + 1.f;
+    const float startT = std::min(farT, groundT);
+
+    RayPacket p;
+    p.origin = pose.pos + Vec2{hs, hc} * cfg_.mountForward;
+    p.height = cfg_.mountHeight;
+
+    for (int b0 = first; b0 < first + count; b0 += RayPacket::width) {
+        const int lanes = std::min(RayPacket::width, first + count - b0);
+        for (int l = 0; l < RayPacket::width; ++l) {
+            const int b = b0 + (l < lanes ? l : 0);
+            // retningen (sin(h + a), cos(h + a))
+            const Vec2 dir{hs * beamCos_[b] + hc * beamSin_[b], hc * beamCos_[b] - hs * beamSin_[b]};
+            p.set(l, dir, slope, l < lanes ? startT : 0.f);
+        }
+
+        if constexpr (Linear) {
+            static_.intersectLinear(p, pose.self);
+            dynamic_.intersectLinear(p, pose.self);
+        } else {
+            static_.intersect(p, pose.self);
+            dynamic_.intersect(p, pose.self);
+        }
+
+        const int out = ch * cfg_.beams + b0;
+        for (int l = 0; l < lanes; ++l) {
+            ranges[out + l] = std::min(p.t[l] / cosEl, cfg_.maxRange);
+            if (hits) {
+                hits[out + l] = p.hit[l] != RayPacket::noHit ? static_cast<LidarHit>(p.hit[l] >> 24)
+                              : p.t[l] >= groundT         ? LidarHit::Ground
+                                                          : LidarHit::None;
+            }
+        }
+    }
+}
+
+void Lidar::scan(const LidarPose& pose, float* ranges, LidarHit* hits) const {
+    for (int c = 0; c < cfg_.channels; ++c) scanRange<false>(pose, c, 0, cfg_.beams, ranges, hits);
+}
+
+void Lidar::scanLinear(const LidarPose& pose, float* ranges, LidarHit* hits) const {
+    for (int c = 0; c < cfg_.channels; ++c) scanRange<true>(pose, c, 0, cfg_.beams, ranges, hits);
+}
+
+void Lidar::scan(std::span<const LidarPose> poses, float* ranges, LidarHit* hits, ThreadPool& pool) const {
+    // oppgave = (bil, kanal, bit av strålene)
+    struct Job {
+        const Lidar* lidar;
+        std::span<const LidarPose> poses;
+        float* ranges;
+        LidarHit* hits;
+        int chunks;
+    } job{this, poses, ranges, hits, (cfg_.beams + beamsPerTask - 1) / beamsPerTask};
+
+    const std::size_t tasks = poses.size() * static_cast<std::size_t>(cfg_.channels) * job.chunks;
+    const std::size_t grain = std::max<std::size_t>(1, tasks / (static_cast<std::size_t>(pool.size()) * 8));
+
+    // fanger bare job, så std::function ikke trenger å allokere
+    pool.parallelFor(tasks, grain, [&job](std::size_t begin, std::size_t end) {
+        const Lidar& l = *job.lidar;
+        const std::size_t perPose = static_cast<std::size_t>(l.cfg_.channels) * job.chunks;
+        const std::size_t rays = static_cast<std::size_t>(l.raysPerScan());
+        for (std::size_t task = begin; task < end; ++task) {
+            const std::size_t i = task / perPose;
+            const int ch = static_cast<int>(task % perPose) / job.chunks;
+            const int first = static_cast<int>(task % perPose) % job.chunks * beamsPerTask;
+            const int count = std::min(beamsPerTask, l.cfg_.beams - first);
+            l.scanRange<false>(job.poses[i], ch, first, count, job.ranges + i * rays, job.hits ? job.hits + i * rays : nullptr);
+        }
+    });
+}
@@ -0,0 +1,336 @@
+// --------------------------------------------------------------------------------------
+// Compact replay recording/playback: run-length (delta) encoding of the per-step input
+// with LEB128 varints, and a zero-copy reader that works on memory-mapped archives.
+// --------------------------------------------------------------------------------------
+
+#include "sim/Replay.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+const char magic[4] = {'B', 'S', 'R', 'P'};
+// 2: scenarioet ligger i headeren (versjon 1 kunne ikke spille av --scenario-økter)
+const std::uint16_t version = 2;
+const std::size_t scenarioOffset = 40;
+static_assert(scenarioOffset + sizeof(Scenario::name) + 14 * 4 == ReplayReader::headerSize);
+
+// tag-byte: bit 0-1 throttle, bit 2-3 steer, bit 4 handbrekk, bit 5 reset før run
+enum : std::uint8_t {
+    axisZero = 0,
+    axisPlus = 1,
+    axisMinus = 2,
+    axisRaw = 3,
+
+    tagHandbrake = 1u << 4,
+    tagReset = 1u << 5
+};
+
+std::uint8_t axisKind(float v) {
+    if (v == 0.f) return axisZero;
+    if (v == 1.f) return axisPlus;
+    if (v == -1.f) return axisMinus;
+    return axisRaw;
+}
+
+bool sameInput(const CarInput& a, const CarInput& b) {
+    return a.throttle == b.throttle && a.steer == b.steer && a.handbrake == b.handbrake;
+}
+
+void putU16(std::uint8_t* p, std::uint16_t v) {
+    p[0] = static_cast<std::uint8_t>(v);
+    p[1] = static_cast<std::uint8_t>(v >> 8);
+}
+
+void putU32(std::uint8_t* p, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+}
+
+void putU64(std::uint8_t* p, std::uint64_t v) {
+    for (int i = 0; i < 8; ++i) p[i] = static_cast<std::uint8_t>(v >> (8 * i));
+}
+
+std::uint32_t floatBits(float f) {
+    std::uint32_t u;
+    std::memcpy(&u, &f, sizeof(u));
+    return u;
+}
+
+float bitsToFloat(std::uint32_t u) {
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+std::uint64_t getLE(const std::byte* p, int bytes) {
+    std::uint64_t v = 0;
+    for (int i = 0; i < bytes; ++i) {
+        v |= static_cast<std::uint64_t>(std::to_integer<std::uint8_t>(p[i])) << (8 * i);
+    }
+    return v;
+}
+
+// feltene i headerens rekkefølge; samme liste brukes til å skrive og lese
+template <class S, class Int, class Float>
+void visitScenario(S& s, Int&& i, Float&& f) {
+    i(s.layout.rows);
+    i(s.layout.cols);
+    f(s.layout.slotW);
+    f(s.layout.slotD);
+    f(s.layout.laneWidth);
+    f(s.layout.margin);
+    i(s.requiredTargets);
+    f(s.requiredParkTime);
+    i(s.coneCount);
+    f(s.car.maxSpeed);
+    f(s.car.accel);
+    f(s.car.brake);
+    f(s.car.steerRate);
+    f(s.car.friction);
+}
+
+void putScenario(std::uint8_t* p, const Scenario& s) {
+    std::memcpy(p, s.name, sizeof(s.name));
+    p += sizeof(s.name);
+    visitScenario(s,
+                  [&](int v) { putU32(p, static_cast<std::uint32_t>(v)); p += 4; },
+                  [&](float v) { putU32(p, floatBits(v)); p += 4; });
+}
+
+void getScenario(const std::byte* p, Scenario& s) {
+    std::memcpy(s.name, p, sizeof(s.name));
+    s.name[sizeof(s.name) - 1] = '\0';
+    p += sizeof(s.name);
+    visitScenario(s,
+                  [&](int& v) { v = static_cast<std::int32_t>(getLE(p, 4)); p += 4; },
+                  [&](float& v) { v = bitsToFloat(static_cast<std::uint32_t>(getLE(p, 4))); p += 4; });
+}
+
+}
+
+// ---------------- ReplayWriter ----------------
+
+ReplayWriter::~ReplayWriter() {
+    close();
+}
+
+bool ReplayWriter::open(const std::string& path, std::uint64_t seed, float stepDt, const Scenario& scenario) {
+    close();
+
+    out_.open(path, std::ios::binary | std::ios::trunc);
+    if (!out_) return false;
+
+    seed_ = seed;
+    stepDt_ = stepDt;
+    scenario_ = scenario;
+    steps_ = 0;
+    payloadBytes_ = 0;
+    hasRun_ = false;
+    pendingReset_ = false;
+    buf_.clear();
+    buf_.reserve(64 * 1024);
+
+    writeHeader(); // fylles inn på nytt i close()
+    return true;
+}
+
+void ReplayWriter::recordReset() {
+    if (!isOpen()) return;
+
+    // reset uten steg etter forrige reset blir en run med 0 steg
+    if (pendingReset_ && !hasRun_) {
+        run_ = {};
+        run_.resetBefore = true;
+        hasRun_ = true;
+    }
+    flushRun();
+    pendingReset_ = true;
+}
+
+void ReplayWriter::recordStep(const CarInput& in) {
+    if (!isOpen()) return;
+
+    if (hasRun_ && !pendingReset_ && sameInput(run_.input, in)) {
+        ++run_.steps;
+    } else {
+        flushRun();
+        run_.input = in;
+        run_.steps = 1;
+        run_.resetBefore = pendingReset_;
+        pendingReset_ = false;
+        hasRun_ = true;
+    }
+    ++steps_;
+}
+
+void ReplayWriter::flushRun() {
+    if (!hasRun_) return;
+
+    std::uint8_t tk = axisKind(run_.input.throttle);
+    std::uint8_t sk = axisKind(run_.input.steer);
+    std::uint8_t tag = static_cast<std::uint8_t>(tk | (sk << 2));
+    if (run_.input.handbrake) tag |= tagHandbrake;
+    if (run_.resetBefore) tag |= tagReset;
+    buf_.push_back(tag);
+
+    std::uint8_t raw[4];
+    if (tk == axisRaw) {
+        putU32(raw, floatBits(run_.input.throttle));
+        buf_.insert(buf_.end(), raw, raw + 4);
+    }
+    if (sk == axisRaw) {
+        putU32(raw, floatBits(run_.input.steer));
+        buf_.insert(buf_.end(), raw, raw + 4);
+    }
+
+    // varint (LEB128)
+    std::uint64_t v = run_.steps;
+    do {
+        std::uint8_t b = v & 0x7fu;
+        v >>= 7;
+        buf_.push_back(v ? static_cast<std::uint8_t>(b | 0x80u) : b);
+    } while (v);
+
+    hasRun_ = false;
+    if (buf_.size() >= 60 * 1024) flushBuffer();
+}
+
+void ReplayWriter::flushBuffer() {
+    out_.write(reinterpret_cast<const char*>(buf_.data()), static_cast<std::streamsize>(buf_.size()));
+    payloadBytes_ += buf_.size();
+    buf_.clear();
+}
+
+void ReplayWriter::writeHeader() {
+    std::uint8_t h[ReplayReader::headerSize] = {};
+    std::memcpy(h, magic, 4);
+    putU16(h + 4, version);
+    putU16(h + 6, static_cast<std::uint16_t>(ReplayReader::headerSize));
+    putU64(h + 8, seed_);
+    putU32(h + 16, floatBits(stepDt_));
+    putU32(h + 20, 0u);
+    putU64(h + 24, steps_);
+    putU64(h + 32, payloadBytes_);
+    putScenario(h + scenarioOffset, scenario_);
+
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(h), sizeof(h));
+    out_.seekp(0, std::ios::end);
+}
+
+void ReplayWriter::close() {
+    if (!isOpen()) return;
+
+    if (pendingReset_ && !hasRun_) {
+        run_ = {};
+        run_.resetBefore = true;
+        hasRun_ = true;
+    }
+    flushRun();
+    flushBuffer();
+    writeHeader();
+    out_.close();
+}
+
+// ---------------- ReplayReader ----------------
+
+bool ReplayReader::open(std::span<const std::byte> bytes) {
+    if (bytes.size() < headerSize) return false;
+    if (std::memcmp(bytes.data(), magic, 4) != 0) return false;
+    if (getLE(bytes.data() + 4, 2) != version) return false;
+
+    std::size_t hsize = getLE(bytes.data() + 6, 2);
+    if (hsize != headerSize) return false;
+
+    seed_ = getLE(bytes.data() + 8, 8);
+    stepDt_ = bitsToFloat(static_cast<std::uint32_t>(getLE(bytes.data() + 16, 4)));
+    stepCount_ = getLE(bytes.data() + 24, 8);
+    std::uint64_t payloadBytes = getLE(bytes.data() + 32, 8);
+
+    if (payloadBytes > bytes.size() - headerSize) return false;
+
+    getScenario(bytes.data() + scenarioOffset, scenario_);
+    if (!validateScenario(scenario_)) return false;
+
+    payload_ = bytes.subspan(headerSize, static_cast<std::size_t>(payloadBytes));
+    pos_ = 0;
+    consumed_ = 0;
+    corrupt_ = false;
+    return true;
+}
+
+bool ReplayReader::next(ReplayRun& run) {
+    if (pos_ >= payload_.size() || corrupt_) return false;
+    // runs som til sammen går forbi headerens stepCount er korrupte: ellers kunne
+    // en ødelagt LEB128-lengde gitt opptil 2^64 steg
+    if (!parseRun(run) || run.steps > stepCount_ - consumed_) {
+        corrupt_ = true;
+        return false;
+    }
+    consumed_ += run.steps;
+    return true;
+}
+
+bool ReplayReader::parseRun(ReplayRun& run) {
+    auto byteAt = [&](std::size_t i) { return std::to_integer<std::uint8_t>(payload_[i]); };
+
+    std::uint8_t tag = byteAt(pos_++);
+
+    auto axis = [&](std::uint8_t kind, float& out) {
+        switch (kind) {
+            case axisZero:  out = 0.f;  return true;
+            case axisPlus:  out = 1.f;  return true;
+            case axisMinus: out = -1.f; return true;
+            default:
+                if (pos_ + 4 > payload_.size()) return false;
+                out = bitsToFloat(static_cast<std::uint32_t>(getLE(payload_.data() + pos_, 4)));
+                pos_ += 4;
+                return true;
+        }
+    };
+
+    if (!axis(tag & 3u, run.input.throttle)) return false;
+    if (!axis((tag >> 2) & 3u, run.input.steer)) return false;
+    run.input.handbrake = (tag & tagHandbrake) != 0;
+    run.resetBefore = (tag & tagReset) != 0;
+
+    std::uint64_t steps = 0;
+    for (int shift = 0;; shift += 7) {
+        if (pos_ >= payload_.size() || shift > 63) return false;
+        std::uint8_t b = byteAt(pos_++);
+        steps |= static_cast<std::uint64_t>(b & 0x7fu) << shift;
+        if (!(b & 0x80u)) break;
+    }
+    run.steps = steps;
+    return true;
+}
+
+// ---------------- avspilling ----------------
+
+ReplayResult playReplay(ReplayReader& reader) {
+    auto t0 = std::chrono::steady_clock::now();
+
+    Simulation sim(reader.seed(), reader.scenario());
+    const float dt = reader.stepDt();
+
+    ReplayResult result;
+    ReplayRun run;
+    while (reader.next(run)) {
+        if (run.resetBefore) sim.reset();
+        for (std::uint64_t s = 0; s < run.steps; ++s) {
+            sim.step(dt, run.input);
+        }
+        sim.clearEvents();
+        result.steps += run.steps;
+    }
+    result.valid = !reader.corrupt() && result.steps == reader.stepCount();
+
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    double simulated = static_cast<double>(result.steps) * dt;
+    result.realTimeFactor = result.seconds > 0.0 ? simulated / result.seconds : 0.0;
+    result.state = sim.state();
+    result.completedTargets = sim.completedTargets();
+    result.carPos = sim.car().position();
+    return result;
+}
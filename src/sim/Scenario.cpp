@@ -0,0 +1,172 @@
+// --------------------------------------------------------------------------------------
+// Scenario files: a flat "key = value" format parsed in place with string_view and
+// std::from_chars (no allocation), plus file and directory loading for sweeps.
+// --------------------------------------------------------------------------------------
+
+#include "sim/Scenario.h"
+
+#include "util/MappedFile.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+using IntRef   = int& (*)(Scenario&);
+using FloatRef = float& (*)(Scenario&);
+
+struct Field {
+    std::string_view key;
+    IntRef   intRef;
+    FloatRef floatRef;
+};
+
+const Field fields[] = {
+    {"lot.rows",              [](Scenario& s) -> int& { return s.layout.rows; }, nullptr},
+    {"lot.cols",              [](Scenario& s) -> int& { return s.layout.cols; }, nullptr},
+    {"lot.slotW",             nullptr, [](Scenario& s) -> float& { return s.layout.slotW; }},
+    {"lot.slotD",             nullptr, [](Scenario& s) -> float& { return s.layout.slotD; }},
+    {"lot.laneWidth",         nullptr, [](Scenario& s) -> float& { return s.layout.laneWidth; }},
+    {"lot.margin",            nullptr, [](Scenario& s) -> float& { return s.layout.margin; }},
+    {"rules.requiredTargets", [](Scenario& s) -> int& { return s.requiredTargets; }, nullptr},
+    {"rules.parkTime",        nullptr, [](Scenario& s) -> float& { return s.requiredParkTime; }},
+    {"cones.count",           [](Scenario& s) -> int& { return s.coneCount; }, nullptr},
+    {"car.maxSpeed",          nullptr, [](Scenario& s) -> float& { return s.car.maxSpeed; }},
+    {"car.accel",             nullptr, [](Scenario& s) -> float& { return s.car.accel; }},
+    {"car.brake",             nullptr, [](Scenario& s) -> float& { return s.car.brake; }},
+    {"car.steerRate",         nullptr, [](Scenario& s) -> float& { return s.car.steerRate; }},
+    {"car.friction",          nullptr, [](Scenario& s) -> float& { return s.car.friction; }},
+};
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+template <class T>
+bool parseNumber(std::string_view v, T& out) {
+    T value{};
+    auto [ptr, ec] = std::from_chars(v.data(), v.data() + v.size(), value);
+    if (ec != std::errc() || ptr != v.data() + v.size()) return false;
+    out = value;
+    return true;
+}
+
+bool fail(ScenarioError* err, int line, const char* message) {
+    if (err) *err = {line, message};
+    return false;
+}
+
+// verdier som ville gitt en ubrukelig verden
+const char* validate(const Scenario& s) {
+    const auto& l = s.layout;
+    const auto& c = s.car;
+    // from_chars godtar "nan" og "inf", og NaN slipper gjennom alle < og > under
+    for (float v : {l.slotW, l.slotD, l.laneWidth, l.margin, s.requiredParkTime,
+                    c.maxSpeed, c.accel, c.brake, c.steerRate, c.friction}) {
+        if (!std::isfinite(v)) return "numbers must be finite";
+    }
+    if (l.rows < 1 || l.cols < 1) return "lot.rows and lot.cols must be at least 1";
+    const long long spots = static_cast<long long>(l.rows) * l.cols;
+    if (spots > scenarioMaxSpots) return "lot.rows * lot.cols is too large";
+    if (l.slotW <= 0.f || l.slotD <= 0.f) return "lot.slotW and lot.slotD must be positive";
+    if (l.laneWidth < 0.f || l.margin < 0.f) return "lot.laneWidth and lot.margin must not be negative";
+    const double width = static_cast<double>(l.cols) * l.slotW + 2.0 * l.margin;
+    const double depth = static_cast<double>(l.rows) * l.slotD + (l.rows - 1.0) * l.laneWidth + 2.0 * l.margin;
+    if (width > scenarioMaxExtent || depth > scenarioMaxExtent) return "the lot is too large";
+    if (s.requiredTargets < 1 || s.requiredTargets > spots) {
+        return "rules.requiredTargets must be between 1 and the number of spots";
+    }
+    if (s.requiredParkTime < 0.f) return "rules.parkTime must not be negative";
+    if (s.coneCount < 0 || s.coneCount > scenarioMaxCones) return "cones.count must be between 0 and the maximum";
+    if (c.maxSpeed <= 0.f || c.accel <= 0.f || c.brake <= 0.f || c.steerRate <= 0.f || c.friction < 0.f) {
+        return "car parameters must be positive";
+    }
+    return nullptr;
+}
+
+}
+
+bool parseScenario(std::string_view text, Scenario& out, ScenarioError* err) {
+    Scenario s = out;
+    int lineNo = 0;
+
+    while (!text.empty()) {
+        std::size_t eol = text.find('\n');
+        std::string_view line = text.substr(0, eol);
+        text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+        ++lineNo;
+
+        if (auto hash = line.find('#'); hash != std::string_view::npos) line = line.substr(0, hash);
+        line = trim(line);
+        if (line.empty()) continue;
+
+        std::size_t eq = line.find('=');
+        if (eq == std::string_view::npos) return fail(err, lineNo, "expected 'key = value'");
+        std::string_view key = trim(line.substr(0, eq));
+        std::string_view value = trim(line.substr(eq + 1));
+        if (value.empty()) return fail(err, lineNo, "missing value");
+
+        if (key == "name") {
+            if (value.size() >= sizeof(s.name)) return fail(err, lineNo, "name is too long");
+            std::memcpy(s.name, value.data(), value.size());
+            s.name[value.size()] = '\0';
+            continue;
+        }
+
+        auto field = std::find_if(std::begin(fields), std::end(fields),
+                                  [&](const Field& f) { return f.key == key; });
+        if (field == std::end(fields)) return fail(err, lineNo, "unknown key");
+
+        bool ok = field->intRef ? parseNumber(value, field->intRef(s))
+                                : parseNumber(value, field->floatRef(s));
+        if (!ok) return fail(err, lineNo, "invalid number");
+    }
+
+    if (!validateScenario(s, err)) return false;
+
+    out = s;
+    return true;
+}
+
+bool validateScenario(const Scenario& s, ScenarioError* err) {
+    if (const char* problem = validate(s)) return fail(err, 0, problem);
+    return true;
+}
+
+bool loadScenario(const std::string& path, Scenario& out, ScenarioError* err) {
+    MappedFile file;
+    if (!file.open(path)) return fail(err, 0, "could not open file");
+    std::string_view text(reinterpret_cast<const char*>(file.data()), file.size());
+    return parseScenario(text, out, err);
+}
+
+std::size_t loadScenarioDirectory(const std::string& dir, std::vector<Scenario>& out,
+                                  std::vector<std::string>* errors) {
+    namespace fs = std::filesystem;
+
+    std::vector<fs::path> files;
+    std::error_code ec;
+    for (fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->is_regular_file() && it->path().extension() == ".scn") files.push_back(it->path());
+    }
+    if (ec && errors) errors->push_back(dir + ": " + ec.message());
+    std::sort(files.begin(), files.end());
+
+    std::size_t loaded = 0;
+    for (const auto& path : files) {
+        Scenario s;
+        ScenarioError err;
+        if (!loadScenario(path.string(), s, &err)) {
+            if (errors) errors->push_back(path.string() + ":" + std::to_string(err.line) + ": " + err.message);
+            continue;
+        }
+        out.push_back(s);
+        ++loaded;
+    }
+    return loaded;
+}
@@ -0,0 +1,289 @@
+// --------------------------------------------------------------------------------------
+// Coroutine scenario scripts (C++20 stackless coroutines). Objectives are awaitables:
+// a suspended script is parked in a per-body wait slot or a timer min-heap and is only
+// resumed by the trigger event or deadline it waits on, so idle scripts cost nothing
+// per step. Animations are evaluated from their start time instead of being stepped.
+// Coroutine frames are recycled through per-thread size-class free lists.
+// --------------------------------------------------------------------------------------
+
+#include "sim/ScriptRuntime.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <exception>
+#include <new>
+
+// ---------------- rammer ----------------
+
+namespace {
+
+// frie rammer per størrelsesklasse (64 byte), lenket gjennom rammen selv
+class FrameCache {
+public:
+    static constexpr std::size_t granule = 64;
+    static constexpr std::size_t classes = 16;   // rammer opp til 1 KiB gjenbrukes
+    static constexpr std::size_t maxFree = 256;  // per klasse; resten frigis
+
+    ~FrameCache() {
+        for (FreeFrame* f : free_) {
+            while (f) {
+                FreeFrame* next = f->next;
+                ::operator delete(f);
+                f = next;
+            }
+        }
+    }
+
+    static std::size_t sizeClass(std::size_t size) { return (size + granule - 1) / granule; }
+
+    void* take(std::size_t size) {
+        const std::size_t c = sizeClass(size);
+        if (c < classes && free_[c]) {
+            FreeFrame* f = free_[c];
+            free_[c] = f->next;
+            --count_[c];
+            return f;
+        }
+        return ::operator new(c < classes ? c * granule : size);
+    }
+
+    void give(void* p, std::size_t size) {
+        const std::size_t c = sizeClass(size);
+        if (c >= classes || count_[c] >= maxFree) {
+            ::operator delete(p);
+            return;
+        }
+        free_[c] = new (p) FreeFrame{free_[c]};
+        ++count_[c];
+    }
+
+private:
+    struct FreeFrame {
+        FreeFrame* next;
+    };
+    std::array<FreeFrame*, classes> free_{};
+    std::array<std::size_t, classes> count_{};
+};
+
+FrameCache& frameCache() {
+    thread_local FrameCache cache;
+    return cache;
+}
+
+}
+
+// ---------------- ScriptTask ----------------
+
+void* ScriptTask::promise_type::operator new(std::size_t size) {
+    return frameCache().take(size);
+}
+
+void ScriptTask::promise_type::operator delete(void* p, std::size_t size) noexcept {
+    frameCache().give(p, size);
+}
+
+void ScriptTask::promise_type::unhandled_exception() noexcept {
+    // skriptene kaster ikke; en feil her er en programmeringsfeil
+    std::terminate();
+}
+
+ScriptTask& ScriptTask::operator=(ScriptTask&& o) noexcept {
+    if (this != &o) {
+        if (h_) h_.destroy();
+        h_ = o.h_;
+        o.h_ = nullptr;
+    }
+    return *this;
+}
+
+ScriptTask::~ScriptTask() {
+    if (h_) h_.destroy();
+}
+
+ScriptTask::Handle ScriptTask::release() {
+    Handle h = h_;
+    h_ = nullptr;
+    return h;
+}
+
+// ---------------- animasjon ----------------
+
+float ScriptAnimation::value(double now) const {
+    if (!running) return from;
+    const double t = std::max(0.0, now - start);
+    return static_cast<float>(std::min(static_cast<double>(to), from + rate * t));
+}
+
+double ScriptAnimation::duration() const {
+    return rate > 0.f ? (to - from) / rate : 0.0;
+}
+
+// ---------------- runtime ----------------
+
+namespace {
+
+bool later(double dueA, std::uint64_t seqA, double dueB, std::uint64_t seqB) {
+    return dueA > dueB || (dueA == dueB && seqA > seqB);
+}
+
+}
+
+ScriptRuntime::~ScriptRuntime() {
+    clear();
+}
+
+void ScriptRuntime::reserveBodies(std::size_t bodies) {
+    if (waits_.size() < bodies) waits_.resize(bodies);
+}
+
+void ScriptRuntime::spawn(ScriptTask task) {
+    ScriptTask::Handle h = task.release();
+    if (!h) return;
+    h.promise().slot = scripts_.size();
+    scripts_.push_back(h);
+    ++live_;
+    resume(h);
+}
+
+void ScriptRuntime::resume(ScriptTask::Handle h) {
+    ++resumes_;
+    h.resume();
+    if (!h.done()) return;
+
+    // ferdig: ta den ut av lista (bytt inn den siste) og frigi rammen
+    const std::size_t slot = h.promise().slot;
+    scripts_[slot] = scripts_.back();
+    scripts_[slot].promise().slot = slot;
+    scripts_.pop_back();
+    --live_;
+    h.destroy();
+}
+
+void ScriptRuntime::clear(double now) {
+    for (ScriptTask::Handle h : scripts_) h.destroy();
+    scripts_.clear();
+    for (auto& w : waits_) w = {};
+    timers_.clear();
+    timerSeq_ = 0;
+    now_ = now;
+    live_ = 0;
+}
+
+void ScriptRuntime::step(float dt, std::span<const TriggerEvent> events, const float* speeds) {
+    now_ += dt;
+
+    auto heapCmp = [](const Timer& a, const Timer& b) { return later(a.due, a.seq, b.due, b.seq); };
+    while (!timers_.empty() && timers_.front().due <= now_) {
+        std::pop_heap(timers_.begin(), timers_.end(), heapCmp);
+        const ScriptTask::Handle h = timers_.back().h;
+        timers_.pop_back();
+        resume(h);
+    }
+
+    for (const TriggerEvent& e : events) {
+        if (e.body >= waits_.size()) continue;
+        BodyWait& w = waits_[e.body];
+        if (!w.h || w.trigger != e.trigger) continue;
+
+        float& dwell = w.dwellAt ? *w.dwellAt : w.dwell;
+        if (e.phase == TriggerPhase::Exit) {
+            dwell = 0.f;
+            continue;
+        }
+        if (w.need > 0.f) {
+            // parkert: inne og rolig sammenhengende, ellers fra null igjen
+            if (std::abs(speeds[e.body]) >= w.maxSpeed) {
+                dwell = 0.f;
+                continue;
+            }
+            dwell += dt;
+            if (dwell < w.need) continue;
+        }
+
+        // plassen tømmes før resume, så skriptet kan vente på noe nytt med en gang
+        const ScriptTask::Handle h = w.h;
+        w = {};
+        resume(h);
+    }
+}
+
+// ---------------- awaitables ----------------
+
+ScriptRuntime::TriggerAwait ScriptRuntime::parkedIn(std::uint32_t body, std::uint32_t trigger, float seconds,
+                                                    float maxSpeed, float* dwell) {
+    return {*this, body, trigger, seconds, maxSpeed, dwell};
+}
+
+ScriptRuntime::TriggerAwait ScriptRuntime::reached(std::uint32_t body, std::uint32_t trigger) {
+    return {*this, body, trigger, 0.f, 0.f, nullptr};
+}
+
+ScriptRuntime::TimerAwait ScriptRuntime::delay(double seconds) {
+    return {*this, now_ + seconds};
+}
+
+ScriptRuntime::TimerAwait ScriptRuntime::until(double time) {
+    return {*this, time};
+}
+
+ScriptRuntime::TimerAwait ScriptRuntime::animate(ScriptAnimation& anim, float from, float to, float rate) {
+    anim.start = now_;
+    anim.from = from;
+    anim.to = to;
+    anim.rate = rate;
+    anim.running = true;
+    return {*this, now_ + anim.duration()};
+}
+
+void ScriptRuntime::TriggerAwait::await_suspend(ScriptTask::Handle h) {
+    rt.reserveBodies(static_cast<std::size_t>(body) + 1);
+    BodyWait& w = rt.waits_[body];
+    assert(!w.h && "one waiting script per body");
+    w.h = h;
+    w.trigger = trigger;
+    w.need = seconds;
+    w.maxSpeed = maxSpeed;
+    w.dwell = 0.f;
+    w.dwellAt = dwell; // en ekstern teller beholder verdien sin
+}
+
+void ScriptRuntime::TimerAwait::await_suspend(ScriptTask::Handle h) {
+    rt.timers_.push_back({due, rt.timerSeq_++, h});
+    std::push_heap(rt.timers_.begin(), rt.timers_.end(),
+                   [](const Timer& a, const Timer& b) { return later(a.due, a.seq, b.due, b.seq); });
+}
+
+// ---------------- standardscenariet ----------------
+
+// Hvert steg sjekker objective før det venter, så skriptet kan bygges på nytt fra
+// en lagret ParkingProgress (Simulation::restore) og fortsette midt i banen.
+ScriptTask parkingScript(ScriptRuntime& rt, std::uint32_t body, const ParkingCourse& course,
+                         ParkingProgress& progress) {
+    const int targets = course.targetCount();
+
+    while (progress.objective < targets) {
+        const auto spot = static_cast<std::uint32_t>(course.targets[static_cast<std::size_t>(progress.objective)]);
+        co_await rt.parkedIn(body, spot, course.parkTime, course.maxSpeed, &progress.dwell);
+        progress.dwell = 0.f;
+        ++progress.objective;
+    }
+
+    if (progress.objective == targets) {
+        co_await rt.reached(body, course.keyTrigger);
+        progress.doorStart = rt.now();
+        ++progress.objective;
+    }
+
+    if (progress.objective == targets + 1) {
+        co_await rt.until(progress.doorStart + course.door(progress.doorStart).duration());
+        ++progress.objective;
+    }
+
+    if (progress.objective == targets + 2) {
+        co_await rt.reached(body, course.doorTrigger);
+        progress.wonAt = rt.now();
+        ++progress.objective;
+    }
+}
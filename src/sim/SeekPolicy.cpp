@@ -0,0 +1,40 @@
+// --------------------------------------------------------------------------------------
+// Heuristic "drive towards the goal" controller: proportional steering on the heading
+// error and a speed target that tapers off near the goal.
+// --------------------------------------------------------------------------------------
+
+#include "sim/SeekPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+
+CarInput seekPolicy(const Simulation& sim) {
+    const Car& car = sim.car();
+
+    Vec2 goal;
+    int target = sim.currentTargetSpot();
+    if (target >= 0) {
+        goal = sim.lot().spots[target].center;
+    } else if (!sim.keyCollected()) {
+        goal = sim.keyPos();
+    } else {
+        goal = {sim.doorPos().x, sim.doorPos().z + 2.f};
+    }
+
+    Vec2 d = goal - car.position();
+    float dist = length(d);
+
+    // heading 0 kjører mot +z, så ønsket heading er atan2(dx, dz)
+    float err = std::atan2(d.x, d.z) - car.heading();
+    err = std::remainder(err, 2.f * 3.14159265f);
+
+    CarInput in;
+    in.steer = std::clamp(err * 2.f, -1.f, 1.f);
+
+    float targetSpeed = std::min(8.f, dist * 0.8f);
+    if (dist < 0.5f) targetSpeed = 0.f;
+    in.throttle = std::clamp((targetSpeed - car.speed()) * 0.5f, -1.f, 1.f);
+    in.handbrake = targetSpeed == 0.f && car.speed() > 0.f;
+
+    return in;
+}
@@ -0,0 +1,181 @@
+// --------------------------------------------------------------------------------------
+// Simulation thread: fixed-rate stepping decoupled from rendering, with state handed
+// over through a lock-free triple buffer (latest value wins, neither side blocks).
+// Busy intervals of both threads are tracked to report how much they overlap.
+// --------------------------------------------------------------------------------------
+
+#include "sim/SimThread.h"
+#include "sim/Replay.h"
+#include "util/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+
+SimThread::SimThread(Simulation& sim, float hz, int maxStepsPerFrame)
+    : sim_(sim), stepper_(hz, maxStepsPerFrame) {
+    // startbildet er klart før tråden går, så render har noe å vise fra første frame
+    capture();
+    next_.cones = std::make_shared<const std::vector<Vec2>>(sim_.cones());
+    next_.prevCarPos = next_.carPos;
+    next_.prevCarHeading = next_.carHeading;
+    frames_.publish(next_);
+    frames_.update();
+}
+
+SimThread::~SimThread() {
+    stop();
+}
+
+bool SimThread::setRecorder(ReplayWriter* recorder) {
+    if (running()) return false;
+    recorder_ = recorder;
+    return true;
+}
+
+void SimThread::start() {
+    if (running()) return;
+    stop_.store(false, std::memory_order_relaxed);
+    statsSinceNs_ = Profiler::nowNs();
+    thread_ = std::thread([this] { run(); });
+}
+
+void SimThread::stop() {
+    if (!running()) return;
+    stop_.store(true, std::memory_order_relaxed);
+    thread_.join();
+}
+
+// ---------------- simuleringstråden ----------------
+
+void SimThread::capture() {
+    const Car& car = sim_.car();
+    next_.stepDt = stepper_.stepDt();
+    next_.inputNs = input_.lastAppliedNs();
+    next_.droppedInputs = input_.dropped();
+    next_.carPos = car.position();
+    next_.carHeading = car.heading();
+    next_.carSpeed = car.speed();
+    next_.state = sim_.state();
+    next_.completedTargets = sim_.completedTargets();
+    next_.currentTargetSpot = sim_.currentTargetSpot();
+    next_.insideTarget = sim_.insideTarget();
+    next_.parkedTimer = sim_.parkedTimer();
+    next_.keyAvailable = sim_.keyAvailable();
+    next_.keyCollected = sim_.keyCollected();
+    next_.doorOpened = sim_.doorOpened();
+    next_.doorHeight = sim_.doorHeight();
+    next_.droppedSteps = stepper_.stats().droppedSteps;
+    next_.publishedNs = Profiler::nowNs();
+}
+
+void SimThread::run() {
+    const auto stepNs = static_cast<std::uint64_t>(static_cast<double>(stepper_.stepDt()) * 1e9);
+    std::uint64_t last = Profiler::nowNs();
+    simClockNs_ = last;
+    std::size_t latencySamples = input_.latency().total();
+
+    while (!stop_.load(std::memory_order_relaxed)) {
+        const std::uint64_t now = Profiler::nowNs();
+        simBusySince_.store(now, std::memory_order_release);
+        const double dt = static_cast<double>(now - last) * 1e-9;
+        last = now;
+
+        bool changed = false;
+        const std::uint32_t resets = resets_.load(std::memory_order_relaxed);
+        if (resets != next_.episode) {
+            if (recorder_) recorder_->recordReset();
+            sim_.reset();
+            sim_.clearEvents();
+            // ny kopi: den gamle kan fortsatt leses av render-tråden
+            next_.cones = std::make_shared<const std::vector<Vec2>>(sim_.cones());
+            next_.episode = resets;
+            next_.prevCarPos = sim_.car().position();
+            next_.prevCarHeading = sim_.car().heading();
+            changed = true;
+        }
+
+        // hvert steg dekker [simClockNs_, simClockNs_ + stegtid) i veggtid, og får
+        // input-hendelsene med tidsstempel der
+        int steps = stepper_.advance(dt, [&](float stepDt) {
+            CarInput in = input_.integrate(simClockNs_, simClockNs_ + stepNs, Profiler::nowNs());
+            simClockNs_ += stepNs;
+
+            next_.prevCarPos = sim_.car().position();
+            next_.prevCarHeading = sim_.car().heading();
+            sim_.step(stepDt, in);
+            if (recorder_) recorder_->recordStep(in);
+            ++next_.step;
+        });
+        // kastede steg (og resten i akkumulatoren) flytter klokka uten å steppe
+        simClockNs_ = now - static_cast<std::uint64_t>(static_cast<double>(stepper_.alpha()) * static_cast<double>(stepNs));
+
+        if (steps > 0) {
+            // hendelsene leses ikke her; visningen ser endringene i SimFrame
+            sim_.clearEvents();
+            changed = true;
+        }
+        if (changed) {
+            // latensvinduet sorteres bare når det har kommet nye målinger
+            if (input_.latency().total() != latencySamples) {
+                latencySamples = input_.latency().total();
+                next_.inputToPhysics = input_.latency().summary();
+            }
+            capture();
+            frames_.publish(next_);
+            // stegfasene (SimStep, CarUpdate, ...) havner i sim-vinduet, én frame per publisering
+            Profiler::endFrame(ProfWindow::Sim);
+        }
+
+        endBusy(simBusySince_, renderBusySince_, simBusyNs_);
+
+        // sov til neste steg er modent
+        const double wait = (1.0 - std::clamp(static_cast<double>(stepper_.alpha()), 0.0, 1.0)) * stepper_.stepDt();
+        std::this_thread::sleep_for(std::chrono::duration<double>(wait) -
+                                    std::chrono::nanoseconds(Profiler::nowNs() - now));
+    }
+}
+
+// ---------------- målinger ----------------
+
+void SimThread::endBusy(std::atomic<std::uint64_t>& mine, const std::atomic<std::uint64_t>& other,
+                        std::atomic<std::uint64_t>& total) {
+    const std::uint64_t now = Profiler::nowNs();
+    const std::uint64_t since = mine.exchange(0, std::memory_order_acq_rel);
+    if (since == 0 || since > now) return;
+    total.fetch_add(now - since, std::memory_order_relaxed);
+
+    // overlapp telles av den som slutter først: den andre er fortsatt opptatt nå
+    const std::uint64_t otherSince = other.load(std::memory_order_acquire);
+    if (otherSince != 0 && otherSince < now) {
+        overlapNs_.fetch_add(now - std::max(since, otherSince), std::memory_order_relaxed);
+    }
+}
+
+void SimThread::beginRender() {
+    renderBusySince_.store(Profiler::nowNs(), std::memory_order_release);
+}
+
+void SimThread::endRender(const SimFrame& shown) {
+    endBusy(renderBusySince_, simBusySince_, renderBusyNs_);
+
+    // første frame som viser en ny input: fra tastetrykk til bildet er tegnet
+    if (shown.inputNs != 0 && shown.inputNs != lastShownInputNs_) {
+        lastShownInputNs_ = shown.inputNs;
+        photonLatency_.add(static_cast<double>(Profiler::nowNs() - shown.inputNs) * 1e-6);
+    }
+}
+
+ThreadSplitStats SimThread::takeStats() {
+    ThreadSplitStats s;
+    s.inputToPhoton = photonLatency_.summary();
+
+    const std::uint64_t now = Profiler::nowNs();
+    const double wall = static_cast<double>(now - statsSinceNs_);
+    statsSinceNs_ = now;
+    if (wall > 0.0) {
+        s.simBusy = static_cast<double>(simBusyNs_.exchange(0, std::memory_order_relaxed)) / wall;
+        s.renderBusy = static_cast<double>(renderBusyNs_.exchange(0, std::memory_order_relaxed)) / wall;
+        s.overlap = static_cast<double>(overlapNs_.exchange(0, std::memory_order_relaxed)) / wall;
+    }
+    return s;
+}
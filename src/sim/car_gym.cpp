@@ -0,0 +1,103 @@
+// --------------------------------------------------------------------------------------
+// C ABI over GymPool (see sim/car_gym.h), so Python (ctypes/cffi) or any other FFI can
+// drive batched episodes without a C++ toolchain on the caller's side.
+// --------------------------------------------------------------------------------------
+
+#include "sim/car_gym.h"
+#include "sim/GymPool.h"
+
+struct car_gym {
+    explicit car_gym(const GymConfig& cfg) : pool(cfg) {}
+    GymPool pool;
+};
+
+extern "C" {
+
+void car_gym_default_config(car_gym_config* cfg) {
+    if (!cfg) return;
+    const GymConfig d;
+    cfg->episodes = static_cast<uint32_t>(d.episodes);
+    cfg->seed = d.seed;
+    cfg->threads = d.threads;
+    cfg->dt = d.dt;
+    cfg->frame_skip = static_cast<uint32_t>(d.frameSkip);
+    cfg->max_steps = static_cast<uint32_t>(d.maxSteps);
+    cfg->auto_reset = d.autoReset ? 1 : 0;
+    cfg->cone_range = d.coneRange;
+    cfg->reward_target = d.rewardTarget;
+    cfg->reward_key = d.rewardKey;
+    cfg->reward_win = d.rewardWin;
+    cfg->reward_step = d.rewardStep;
+    cfg->reward_progress = d.rewardProgress;
+    cfg->scenario_path = nullptr;
+}
+
+car_gym* car_gym_create(const car_gym_config* cfg) {
+    if (!cfg || cfg->episodes == 0 || !(cfg->dt > 0.f) || cfg->frame_skip == 0) return nullptr;
+
+    GymConfig g;
+    g.episodes = cfg->episodes;
+    g.seed = cfg->seed;
+    g.threads = cfg->threads;
+    g.dt = cfg->dt;
+    g.frameSkip = static_cast<int>(cfg->frame_skip);
+    g.maxSteps = static_cast<int>(cfg->max_steps);
+    g.autoReset = cfg->auto_reset != 0;
+    g.coneRange = cfg->cone_range;
+    g.rewardTarget = cfg->reward_target;
+    g.rewardKey = cfg->reward_key;
+    g.rewardWin = cfg->reward_win;
+    g.rewardStep = cfg->reward_step;
+    g.rewardProgress = cfg->reward_progress;
+    if (cfg->scenario_path && !loadScenario(cfg->scenario_path, g.scenario)) return nullptr;
+
+    // ingen unntak over C-grensen (bad_alloc fra episodene, trådstart)
+    try {
+        return new car_gym(g);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void car_gym_destroy(car_gym* gym) {
+    delete gym;
+}
+
+uint32_t car_gym_size(const car_gym* gym) {
+    return gym ? static_cast<uint32_t>(gym->pool.size()) : 0;
+}
+
+// som i car_gym_create: ingen unntak over C-grensen (parallelFor kaster videre
+// fra arbeiderne, f.eks. bad_alloc fra første korutineramme i en tråd)
+int car_gym_reset(car_gym* gym, float* observations) {
+    if (!gym || !observations) return CAR_GYM_EINVAL;
+    try {
+        gym->pool.reset(observations);
+    } catch (...) {
+        return CAR_GYM_EFAIL;
+    }
+    return CAR_GYM_OK;
+}
+
+int car_gym_reset_one(car_gym* gym, uint32_t episode, float* observations) {
+    if (!gym || !observations || episode >= gym->pool.size()) return CAR_GYM_EINVAL;
+    try {
+        gym->pool.resetOne(episode, observations);
+    } catch (...) {
+        return CAR_GYM_EFAIL;
+    }
+    return CAR_GYM_OK;
+}
+
+int car_gym_step(car_gym* gym, const float* actions, float* observations, float* rewards, uint8_t* dones,
+                 float* final_observations) {
+    if (!gym || !actions || !observations || !rewards || !dones) return CAR_GYM_EINVAL;
+    try {
+        gym->pool.step(actions, observations, rewards, dones, final_observations);
+    } catch (...) {
+        return CAR_GYM_EFAIL;
+    }
+    return CAR_GYM_OK;
+}
+
+}
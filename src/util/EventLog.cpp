@@ -0,0 +1,203 @@
+// --------------------------------------------------------------------------------------
+// Async event log: bounded single-producer/single-consumer ring of fixed-size binary
+// records, formatted and written by a background thread. The producer never blocks.
+// --------------------------------------------------------------------------------------
+
+#include "util/EventLog.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+std::uint64_t nowNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            clock_type::now().time_since_epoch()).count());
+}
+
+std::size_t roundUpPow2(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+}
+
+// delt med drain-tråden, så den kan leve videre hvis den må slippes ved avslutning
+struct EventLog::State {
+    std::FILE* out = nullptr;
+    std::vector<LogRecord> ring;
+    std::size_t mask = 0;
+
+    alignas(64) std::atomic<std::uint64_t> head{0};     // skrevet av produsent
+    alignas(64) std::atomic<std::uint64_t> tail{0};     // lest av konsument
+    alignas(64) std::atomic<std::uint64_t> flushed{0};  // poster formatert og flushet
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<bool> running{true};
+
+    void drainLoop();
+    std::size_t drainOnce();
+};
+
+std::size_t EventLog::State::drainOnce() {
+    std::uint64_t t = tail.load(std::memory_order_relaxed);
+    std::uint64_t h = head.load(std::memory_order_acquire);
+    if (t == h) return 0;
+
+    char buf[8192];
+    std::size_t used = 0;
+    std::uint64_t n = 0;
+
+    for (; t != h; ++t, ++n) {
+        const LogRecord& rec = ring[t & mask];
+        if (sizeof(buf) - used < 1024) {
+            std::fwrite(buf, 1, used, out);
+            used = 0;
+        }
+        used += formatLogRecord(rec, buf + used, sizeof(buf) - used);
+        // frigjør plassen straks posten er formatert
+        tail.store(t + 1, std::memory_order_release);
+    }
+    std::fwrite(buf, 1, used, out);
+    std::fflush(out);
+
+    flushed.store(t, std::memory_order_release);
+    return static_cast<std::size_t>(n);
+}
+
+void EventLog::State::drainLoop() {
+    while (running.load(std::memory_order_acquire)) {
+        if (drainOnce() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    drainOnce();
+}
+
+EventLog::EventLog(std::FILE* out, std::size_t capacity)
+    : state_(std::make_shared<State>()) {
+    state_->out = out;
+    state_->ring.resize(roundUpPow2(std::max<std::size_t>(capacity, 2)));
+    state_->mask = state_->ring.size() - 1;
+
+    drain_ = std::thread([s = state_] { s->drainLoop(); });
+}
+
+EventLog::~EventLog() {
+    bool done = flush(exitFlushTimeout);
+    state_->running.store(false, std::memory_order_release);
+    if (done) {
+        drain_.join();
+    } else {
+        // skriveren henger (f.eks. full pipe); ikke hold igjen avslutningen
+        drain_.detach();
+    }
+}
+
+bool EventLog::push(LogRecord rec) {
+    auto& s = *state_;
+    std::uint64_t h = s.head.load(std::memory_order_relaxed);
+    if (h - s.tail.load(std::memory_order_acquire) >= s.ring.size()) {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    rec.timeNs = nowNs();
+    s.ring[h & s.mask] = rec;
+    s.head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+bool EventLog::flush(std::chrono::milliseconds timeout) {
+    auto& s = *state_;
+    std::uint64_t target = s.head.load(std::memory_order_acquire);
+    auto deadline = clock_type::now() + timeout;
+    while (s.flushed.load(std::memory_order_acquire) < target) {
+        if (clock_type::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return true;
+}
+
+std::uint64_t EventLog::dropped() const {
+    return state_->dropped.load(std::memory_order_relaxed);
+}
+
+std::uint64_t EventLog::written() const {
+    return state_->flushed.load(std::memory_order_acquire);
+}
+
+// ---------------- formatering (drain-tråden) ----------------
+
+std::size_t formatLogRecord(const LogRecord& rec, char* buf, std::size_t cap) {
+    const double* a = rec.args;
+    int n = 0;
+
+    switch (rec.kind) {
+        case LogKind::Text:
+            n = std::snprintf(buf, cap, "%s\n", rec.text ? rec.text : "");
+            break;
+        case LogKind::Intro:
+            n = std::snprintf(buf, cap,
+                              "PARKING QUEST (Game class):\n"
+                              "- Park in %d random spots (yellow pole).\n"
+                              "- Stay inside for %g seconds for it to count.\n"
+                              "- Then collect key and drive through the door.\n"
+                              "Controls: W/S/A/D, SPACE = handbrake, R = reset, P = dump profiler trace.\n\n",
+                              static_cast<int>(a[0]), a[1]);
+            break;
+        case LogKind::Reset:
+            n = std::snprintf(buf, cap, "Resetting game (R pressed).\n");
+            break;
+        case LogKind::TargetCompleted:
+            n = std::snprintf(buf, cap, "Target parking #%d completed (spot %d).\n",
+                              static_cast<int>(a[0]), static_cast<int>(a[1]));
+            break;
+        case LogKind::KeySpawned:
+            n = std::snprintf(buf, cap, "All target spots done! Yellow key spawned.\n");
+            break;
+        case LogKind::KeyCollected:
+            n = std::snprintf(buf, cap, "Key collected! Door will open.\n");
+            break;
+        case LogKind::DoorOpened:
+            n = std::snprintf(buf, cap, "Door is open! Drive through to win.\n");
+            break;
+        case LogKind::Won:
+            n = std::snprintf(buf, cap,
+                              "\n************************\n"
+                              "         YOU WIN!       \n"
+                              "************************\n\n");
+            break;
+        case LogKind::Hud:
+            if (a[3] >= 0.0) {
+                n = std::snprintf(buf, cap, "[HUD] Speed: %g m/s | Targets: %d/%d | Park hold: %g / %g s\n",
+                                  a[0], static_cast<int>(a[1]), static_cast<int>(a[2]), a[3], a[4]);
+            } else {
+                n = std::snprintf(buf, cap, "[HUD] Speed: %g m/s | Targets: %d/%d\n",
+                                  a[0], static_cast<int>(a[1]), static_cast<int>(a[2]));
+            }
+            break;
+        case LogKind::HudDrops:
+            n = std::snprintf(buf, cap, "[HUD] Dropped steps: %llu | Dropped log records: %llu | Dropped inputs: %llu\n",
+                              static_cast<unsigned long long>(a[0]),
+                              static_cast<unsigned long long>(a[1]),
+                              static_cast<unsigned long long>(a[2]));
+            break;
+        case LogKind::PhaseStats:
+            n = std::snprintf(buf, cap, "  %-12s p50 %7.3f  p99 %7.3f  max %7.3f ms\n",
+                              rec.text ? rec.text : "?", a[0], a[1], a[2]);
+            break;
+        case LogKind::HudLatency:
+            n = std::snprintf(buf, cap, "[HUD] %s: p50 %.1f  p99 %.1f  max %.1f ms (%d samples)\n",
+                              rec.text ? rec.text : "Latency", a[0], a[1], a[2], static_cast<int>(a[3]));
+            break;
+        case LogKind::HudThreads:
+            n = std::snprintf(buf, cap, "[HUD] Busy: sim %.0f%% | render %.0f%% | both %.0f%%\n",
+                              a[0], a[1], a[2]);
+            break;
+    }
+
+    if (n < 0) return 0;
+    return std::min(static_cast<std::size_t>(n), cap > 0 ? cap - 1 : 0);
+}
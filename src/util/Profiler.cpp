@@ -0,0 +1,204 @@
+// --------------------------------------------------------------------------------------
+// Phase profiler: per-thread single-writer event rings, per-frame phase totals with
+// rolling windows (render thread, sim thread) for percentiles, and Chrome trace-event
+// JSON export.
+// --------------------------------------------------------------------------------------
+
+#include "util/Profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+std::atomic<bool> Profiler::enabled_{false};
+
+namespace {
+
+constexpr std::size_t phaseCount = static_cast<std::size_t>(ProfPhase::Count);
+constexpr std::size_t windowCount = static_cast<std::size_t>(ProfWindow::Count);
+
+const char* const phaseNames[phaseCount] = {
+    "Frame", "SimStep", "CarUpdate", "Cones", "Triggers", "Script",
+    "Events", "SyncScene", "CameraChase", "Streaming", "Hud", "Render",
+};
+
+// Ett event i ringen. Feltene er atomiske (relaxed) så en samtidig snapshot()
+// ikke er et datakappløp; på x86/ARM er det vanlige load/store.
+struct Slot {
+    std::atomic<std::uint64_t> startNs{0};
+    std::atomic<std::uint64_t> durNs{0};
+    std::atomic<std::uint8_t> phase{0};
+};
+
+struct ThreadRing {
+    std::uint32_t tid = 0;
+    std::atomic<std::uint64_t> head{0}; // antall skrevne events totalt
+    std::unique_ptr<Slot[]> slots{new Slot[Profiler::ringCapacity]};
+
+    // tid per fase i inneværende frame; bare eiertråden rører disse
+    std::array<std::uint64_t, phaseCount> frameNs{};
+};
+
+// rullerende vindu, fylles av endFrame() fra én tråd
+struct Window {
+    std::array<std::array<double, Profiler::windowFrames>, phaseCount> ms{};
+    std::size_t count = 0;
+    std::size_t pos = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    std::array<Window, windowCount> windows;
+};
+
+Registry& registry() {
+    static Registry r;
+    return r;
+}
+
+// registreres én gang per tråd; ringen lever videre i registeret etter at tråden avslutter
+ThreadRing& localRing() {
+    thread_local std::shared_ptr<ThreadRing> ring = [] {
+        auto r = std::make_shared<ThreadRing>();
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        r->tid = static_cast<std::uint32_t>(reg.rings.size());
+        reg.rings.push_back(r);
+        return r;
+    }();
+    return *ring;
+}
+
+}
+
+const char* profPhaseName(ProfPhase phase) {
+    auto i = static_cast<std::size_t>(phase);
+    return i < phaseCount ? phaseNames[i] : "?";
+}
+
+void Profiler::record(ProfPhase phase, std::uint64_t startNs, std::uint64_t endNs) {
+    auto& ring = localRing();
+    std::uint64_t dur = endNs - startNs;
+
+    std::uint64_t h = ring.head.load(std::memory_order_relaxed);
+    Slot& s = ring.slots[h & (ringCapacity - 1)];
+    s.startNs.store(startNs, std::memory_order_relaxed);
+    s.durNs.store(dur, std::memory_order_relaxed);
+    s.phase.store(static_cast<std::uint8_t>(phase), std::memory_order_relaxed);
+    ring.head.store(h + 1, std::memory_order_release);
+
+    ring.frameNs[static_cast<std::size_t>(phase)] += dur;
+}
+
+void Profiler::endFrame(ProfWindow window) {
+    auto& ring = localRing();
+    auto& reg = registry();
+    {
+        std::lock_guard lock(reg.mutex);
+        Window& w = reg.windows[static_cast<std::size_t>(window)];
+        for (std::size_t p = 0; p < phaseCount; ++p) {
+            w.ms[p][w.pos] = static_cast<double>(ring.frameNs[p]) * 1e-6;
+        }
+        w.pos = (w.pos + 1) % windowFrames;
+        w.count = std::min(w.count + 1, windowFrames);
+    }
+    ring.frameNs.fill(0);
+}
+
+PhaseSummary Profiler::summary(ProfPhase phase, ProfWindow window) {
+    auto& reg = registry();
+    std::array<double, windowFrames> values;
+    std::size_t n;
+    {
+        std::lock_guard lock(reg.mutex);
+        const Window& w = reg.windows[static_cast<std::size_t>(window)];
+        n = w.count;
+        const auto& ms = w.ms[static_cast<std::size_t>(phase)];
+        std::copy(ms.begin(), ms.begin() + static_cast<std::ptrdiff_t>(n), values.begin());
+    }
+
+    PhaseSummary s;
+    s.frames = n;
+    if (n == 0) return s;
+
+    std::sort(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(n));
+    s.p50Ms = values[(n - 1) / 2];
+    s.p99Ms = values[(n - 1) * 99 / 100];
+    s.maxMs = values[n - 1];
+    return s;
+}
+
+std::vector<ProfEvent> Profiler::snapshot() {
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        rings = reg.rings;
+    }
+
+    std::vector<ProfEvent> events;
+    for (const auto& ring : rings) {
+        std::uint64_t end = ring->head.load(std::memory_order_acquire);
+        std::uint64_t begin = end > ringCapacity ? end - ringCapacity : 0;
+        std::size_t base = events.size();
+
+        for (std::uint64_t i = begin; i < end; ++i) {
+            const Slot& s = ring->slots[i & (ringCapacity - 1)];
+            ProfEvent e;
+            e.phase = static_cast<ProfPhase>(s.phase.load(std::memory_order_relaxed));
+            e.tid = ring->tid;
+            e.startNs = s.startNs.load(std::memory_order_relaxed);
+            e.durNs = s.durNs.load(std::memory_order_relaxed);
+            events.push_back(e);
+        }
+
+        // skriveren kan ha gått rundt mens vi kopierte: dropp de som kan være overskrevet
+        std::uint64_t after = ring->head.load(std::memory_order_acquire);
+        std::uint64_t overwritten = after > begin + ringCapacity ? after - (begin + ringCapacity) : 0;
+        overwritten = std::min<std::uint64_t>(overwritten, end - begin);
+        events.erase(events.begin() + static_cast<std::ptrdiff_t>(base),
+                     events.begin() + static_cast<std::ptrdiff_t>(base + overwritten));
+    }
+
+    std::sort(events.begin(), events.end(), [](const ProfEvent& a, const ProfEvent& b) {
+        return a.startNs < b.startNs;
+    });
+    return events;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) {
+    auto events = snapshot();
+
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    if (!f) return false;
+
+    std::uint64_t origin = events.empty() ? 0 : events.front().startNs;
+    std::fputs("{\"traceEvents\":[\n", f);
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        const auto& e = events[i];
+        // Chrome trace bruker mikrosekunder
+        std::fprintf(f, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+                     profPhaseName(e.phase), e.tid,
+                     static_cast<double>(e.startNs - origin) * 1e-3,
+                     static_cast<double>(e.durNs) * 1e-3,
+                     i + 1 < events.size() ? "," : "");
+    }
+    std::fputs("],\"displayTimeUnit\":\"ms\"}\n", f);
+    return std::fclose(f) == 0;
+}
+
+void Profiler::clear() {
+    localRing().frameNs.fill(0); // registrerer tråden før vi tar låsen
+
+    auto& reg = registry();
+    std::lock_guard lock(reg.mutex);
+    for (auto& ring : reg.rings) {
+        ring->head.store(0, std::memory_order_release);
+    }
+    for (auto& w : reg.windows) {
+        w.count = 0;
+        w.pos = 0;
+    }
+}
@@ -0,0 +1,130 @@
+// --------------------------------------------------------------------------------------
+// Work-stealing thread pool (per-worker queues, owner pops LIFO, thieves steal FIFO),
+// following the usual Cilk/TBB-style scheduling scheme with plain mutexes per queue.
+// --------------------------------------------------------------------------------------
+
+#include "util/ThreadPool.h"
+
+#include <algorithm>
+#include <utility>
+
+ThreadPool::ThreadPool(unsigned threads) {
+    threads = std::max(1u, threads);
+
+    queues_.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+
+    // arbeider 0 er tråden som kaller parallelFor
+    workers_.reserve(threads - 1);
+    for (unsigned i = 1; i < threads; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : workers_) t.join();
+}
+
+void ThreadPool::parallelFor(std::size_t n, std::size_t grain,
+                             const std::function<void(std::size_t, std::size_t)>& fn) {
+    if (n == 0) return;
+    grain = std::max<std::size_t>(1, grain);
+
+    if (queues_.size() == 1) {
+        for (std::size_t b = 0; b < n; b += grain) fn(b, std::min(n, b + grain));
+        return;
+    }
+
+    // fordel bitene round-robin på køene
+    std::size_t chunks = (n + grain - 1) / grain;
+    remaining_.store(chunks, std::memory_order_relaxed);
+    failed_.store(false, std::memory_order_relaxed);
+    job_ = &fn;
+
+    for (std::size_t c = 0; c < chunks; ++c) {
+        WorkQueue& q = *queues_[c % queues_.size()];
+        std::lock_guard<std::mutex> lock(q.m);
+        q.ranges.push_back({c * grain, std::min(n, (c + 1) * grain)});
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    while (runOne(0)) {}
+
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    done_.wait(lock, [this] { return remaining_.load(std::memory_order_acquire) == 0; });
+    job_ = nullptr;
+    if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    std::uint64_t seen = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+
+        while (runOne(index)) {}
+    }
+}
+
+bool ThreadPool::runOne(unsigned index) {
+    Range r{};
+    if (!popLocal(index, r) && !steal(index, r)) return false;
+
+    // et unntak må ikke hoppe over nedtellingen, ellers venter parallelFor for alltid
+    if (!failed_.load(std::memory_order_relaxed)) {
+        try {
+            (*job_)(r.begin, r.end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            if (!error_) error_ = std::current_exception();
+            failed_.store(true, std::memory_order_relaxed);
+        }
+    }
+
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        done_.notify_all();
+    }
+    return true;
+}
+
+bool ThreadPool::popLocal(unsigned index, Range& out) {
+    WorkQueue& q = *queues_[index];
+    std::lock_guard<std::mutex> lock(q.m);
+    if (q.empty()) return false;
+    out = q.ranges.back();
+    q.ranges.pop_back();
+    q.trim();
+    return true;
+}
+
+bool ThreadPool::steal(unsigned index, Range& out) {
+    const unsigned n = size();
+    for (unsigned k = 1; k < n; ++k) {
+        WorkQueue& q = *queues_[(index + k) % n];
+        std::lock_guard<std::mutex> lock(q.m);
+        if (q.empty()) continue;
+        out = q.ranges[q.head++];
+        q.trim();
+        steals_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
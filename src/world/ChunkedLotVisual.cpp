@@ -0,0 +1,251 @@
+// --------------------------------------------------------------------------------------
+// Streamed parking lot visuals: per-chunk asphalt, line markings and cones with two
+// levels of detail, built with the standard threepp API. Which chunks exist is
+// decided by ChunkStreamer in LotChunks.cpp.
+// --------------------------------------------------------------------------------------
+
+#include "world/ChunkedLotVisual.h"
+#include "world/WorldCache.h"
+
+using namespace threepp;
+
+namespace {
+
+constexpr float lineH = 0.01f;
+constexpr float lineT = 0.05f;
+
+}
+
+// delt mellom alle chunks: ingen geometri eller materiale lages per chunk unntatt
+// de sammenslåtte strekene for fjerne chunks
+struct ChunkedLotVisual::Assets {
+    std::shared_ptr<PlaneGeometry> asphaltGeo = PlaneGeometry::create(1.f, 1.f);
+    std::shared_ptr<MeshPhongMaterial> asphaltMat = MeshPhongMaterial::create();
+    std::shared_ptr<BoxGeometry> lineGeo = BoxGeometry::create(1.f, 1.f, 1.f);
+    std::shared_ptr<MeshBasicMaterial> lineMat = MeshBasicMaterial::create();
+    std::shared_ptr<LineBasicMaterial> farLineMat = LineBasicMaterial::create();
+    std::shared_ptr<ConeGeometry> coneNear = ConeGeometry::create(0.4f, 1.0f, 12);
+    std::shared_ptr<ConeGeometry> coneFar = ConeGeometry::create(0.4f, 1.0f, 5);
+    std::shared_ptr<MeshPhongMaterial> coneMat = MeshPhongMaterial::create();
+
+    Assets() {
+        asphaltGeo->rotateX(-math::PI / 2);
+        asphaltMat->color = Color(0x303030);
+        lineMat->color = Color(0xffffff);
+        farLineMat->color = Color(0xffffff);
+        coneMat->color = Color(0xff8800);
+    }
+};
+
+struct ChunkedLotVisual::Chunk {
+    std::shared_ptr<Group> group = Group::create();
+    std::shared_ptr<Mesh> asphalt;
+    std::shared_ptr<Object3D> lines;
+    std::shared_ptr<InstancedMesh> cones;
+    std::size_t coneCapacity = 0;
+    ChunkLod coneLod = ChunkLod::None;
+    ChunkLod lod = ChunkLod::None;
+    Box3 bounds;
+};
+
+ChunkedLotVisual::ChunkedLotVisual(Scene& scene, const ParkingLot& lot,
+                                   float chunkSize, StreamingParams params)
+    : scene_(scene),
+      lot_(lot),
+      streamer_(params),
+      assets_(std::make_unique<Assets>()) {
+    chunks_.configure(lot, chunkSize);
+    streamer_.reset(chunks_);
+    slots_.resize(static_cast<std::size_t>(chunks_.count()));
+}
+
+ChunkedLotVisual::ChunkedLotVisual(Scene& scene, const ParkingLot& lot,
+                                   const BakedWorld& baked, StreamingParams params)
+    : scene_(scene),
+      lot_(lot),
+      streamer_(params),
+      assets_(std::make_unique<Assets>()) {
+    chunks_.configure(lot, baked.key.chunkSize, baked.chunkStart, baked.chunkSpots);
+    if (baked.chunkStart.size() == static_cast<std::size_t>(chunks_.count()) + 1 &&
+        baked.lineVertices.size() == lot.spots.size() * 18) {
+        bakedLines_ = baked.lineVertices;
+    }
+    streamer_.reset(chunks_);
+    slots_.resize(static_cast<std::size_t>(chunks_.count()));
+}
+
+ChunkedLotVisual::~ChunkedLotVisual() {
+    for (int c : streamer_.resident()) {
+        scene_.remove(*slots_[static_cast<std::size_t>(c)]->group);
+    }
+}
+
+void ChunkedLotVisual::setCones(std::shared_ptr<const std::vector<Vec2>> cones) {
+    cones_ = std::move(cones);
+    chunks_.setCones(*cones_);
+    for (int c : streamer_.resident()) {
+        auto& chunk = *slots_[static_cast<std::size_t>(c)];
+        buildCones(chunk, c, chunk.lod);
+    }
+}
+
+void ChunkedLotVisual::prime(Vec2 focus) {
+    streamer_.loadAll(chunks_, focus);
+    applyChanges();
+}
+
+void ChunkedLotVisual::update(Vec2 focus, const Frustum& frustum) {
+    streamer_.update(chunks_, focus);
+    applyChanges();
+
+    // culling per chunk; renderer-en slipper å teste hvert objekt i chunken
+    visible_ = 0;
+    for (int c : streamer_.resident()) {
+        auto& chunk = *slots_[static_cast<std::size_t>(c)];
+        chunk.group->visible = frustum.intersectsBox(chunk.bounds);
+        visible_ += chunk.group->visible;
+    }
+}
+
+void ChunkedLotVisual::applyChanges() {
+    for (const auto& change : streamer_.changes()) {
+        if (change.to == ChunkLod::None) {
+            evict(change.chunk);
+        } else if (change.from == ChunkLod::None) {
+            build(change.chunk, change.to);
+        } else {
+            auto& chunk = *slots_[static_cast<std::size_t>(change.chunk)];
+            chunk.lod = change.to;
+            buildLines(chunk, change.chunk, change.to);
+            buildCones(chunk, change.chunk, change.to);
+        }
+    }
+}
+
+void ChunkedLotVisual::build(int index, ChunkLod lod) {
+    std::unique_ptr<Chunk> chunk;
+    if (!free_.empty()) {
+        chunk = std::move(free_.back());
+        free_.pop_back();
+    } else {
+        chunk = std::make_unique<Chunk>();
+        chunk->asphalt = Mesh::create(assets_->asphaltGeo, assets_->asphaltMat);
+        chunk->group->add(chunk->asphalt);
+    }
+
+    Vec2 mn = chunks_.chunkMin(index);
+    Vec2 mx = chunks_.chunkMax(index);
+    chunk->asphalt->position.set((mn.x + mx.x) * 0.5f, 0.f, (mn.z + mx.z) * 0.5f);
+    chunk->asphalt->scale.set(mx.x - mn.x, 1.f, mx.z - mn.z);
+    chunk->bounds.set(Vector3(mn.x, 0.f, mn.z), Vector3(mx.x, 1.f, mx.z));
+    chunk->lod = lod;
+
+    buildLines(*chunk, index, lod);
+    buildCones(*chunk, index, lod);
+
+    scene_.add(chunk->group);
+    slots_[static_cast<std::size_t>(index)] = std::move(chunk);
+}
+
+void ChunkedLotVisual::evict(int index) {
+    auto& chunk = slots_[static_cast<std::size_t>(index)];
+    scene_.remove(*chunk->group);
+
+    // strekene og kjeglene er LOD-avhengige; asfalt og gruppe gjenbrukes
+    if (chunk->lines) chunk->group->remove(*chunk->lines);
+    if (chunk->cones) chunk->group->remove(*chunk->cones);
+    chunk->lines.reset();
+    chunk->cones.reset();
+    chunk->coneCapacity = 0;
+    chunk->coneLod = ChunkLod::None;
+    chunk->lod = ChunkLod::None;
+    free_.push_back(std::move(chunk));
+}
+
+void ChunkedLotVisual::buildLines(Chunk& c, int index, ChunkLod lod) {
+    if (c.lines) c.group->remove(*c.lines);
+
+    auto spots = chunks_.spotsIn(index);
+    if (spots.empty()) {
+        c.lines.reset();
+        return;
+    }
+
+    if (lod == ChunkLod::Near) {
+        // som addParkingLot: tre skalerte enhetsbokser per plass i én InstancedMesh
+        auto lines = InstancedMesh::create(assets_->lineGeo, assets_->lineMat, spots.size() * 3);
+        lines->frustumCulled = false;
+
+        Matrix4 m;
+        Quaternion noRotation;
+        std::size_t instance = 0;
+        auto addLine = [&](float x, float z, float sizeX, float sizeZ) {
+            m.compose(Vector3(x, lineH * 0.5f, z), noRotation, Vector3(sizeX, lineH, sizeZ));
+            lines->setMatrixAt(instance++, m);
+        };
+
+        for (auto i : spots) {
+            const auto& s = lot_.spots[i];
+            addLine(s.center.x - s.halfW, s.center.z, lineT, s.halfD * 2.f);
+            addLine(s.center.x + s.halfW, s.center.z, lineT, s.halfD * 2.f);
+            addLine(s.center.x, s.center.z + s.halfD, s.halfW * 2.f, lineT);
+        }
+        lines->instanceMatrix()->needsUpdate();
+        c.lines = lines;
+    } else {
+        // fjernt: alle strekene i chunken som ett linjesett (tre segmenter per plass)
+        std::vector<float> pos;
+        if (!bakedLines_.empty()) {
+            // fra en bakt verden ligger verteksene ferdige og samlet per chunk
+            auto slice = bakedLines_.subspan(chunks_.spotOffset(index) * 18, spots.size() * 18);
+            pos.assign(slice.begin(), slice.end());
+        } else {
+            pos.reserve(spots.size() * 18);
+            auto seg = [&](float x0, float z0, float x1, float z1) {
+                pos.insert(pos.end(), {x0, lineH, z0, x1, lineH, z1});
+            };
+
+            for (auto i : spots) {
+                const auto& s = lot_.spots[i];
+                float l = s.center.x - s.halfW, r = s.center.x + s.halfW;
+                float b = s.center.z - s.halfD, f = s.center.z + s.halfD;
+                seg(l, b, l, f);
+                seg(r, b, r, f);
+                seg(l, f, r, f);
+            }
+        }
+
+        auto geo = BufferGeometry::create();
+        geo->setAttribute("position", FloatBufferAttribute::create(pos, 3));
+        c.lines = LineSegments::create(geo, assets_->farLineMat);
+    }
+    c.group->add(c.lines);
+}
+
+void ChunkedLotVisual::buildCones(Chunk& c, int index, ChunkLod lod) {
+    auto ids = cones_ ? chunks_.conesIn(index) : std::span<const std::uint32_t>{};
+    const auto& geo = lod == ChunkLod::Near ? assets_->coneNear : assets_->coneFar;
+
+    // ny InstancedMesh bare når kapasiteten ikke rekker eller LOD-geometrien byttes
+    bool rebuild = !c.cones || ids.size() > c.coneCapacity || c.coneLod != lod;
+    if (rebuild) {
+        if (c.cones) c.group->remove(*c.cones);
+        c.coneCapacity = std::max<std::size_t>(ids.size(), 4);
+        c.cones = InstancedMesh::create(geo, assets_->coneMat, c.coneCapacity);
+        c.cones->frustumCulled = false;
+        c.coneLod = lod;
+        c.group->add(c.cones);
+    }
+
+    Matrix4 m;
+    for (std::size_t i = 0; i < c.coneCapacity; ++i) {
+        if (i < ids.size()) {
+            Vec2 p = (*cones_)[ids[i]];
+            m.makeTranslation(p.x, 0.5f, p.z);
+        } else {
+            m.makeScale(0.f, 0.f, 0.f); // ubrukte instanser skjules
+        }
+        c.cones->setMatrixAt(i, m);
+    }
+    c.cones->instanceMatrix()->needsUpdate();
+}
@@ -0,0 +1,122 @@
+// --------------------------------------------------------------------------------------
+// Uniform grid broadphase for traffic cones, built with a counting sort so each
+// cell's cones are contiguous in memory (standard "compact grid" technique).
+// --------------------------------------------------------------------------------------
+
+#include "world/ConeGrid.h"
+#include "world/Sweep.h"
+
+#include <algorithm>
+
+void ConeGrid::configure(Vec2 minCorner, float width, float depth, float cellSize) {
+    origin_   = minCorner;
+    cellSize_ = cellSize;
+    invCell_  = 1.f / cellSize;
+    cols_ = std::max(1, static_cast<int>(std::ceil(width * invCell_)));
+    rows_ = std::max(1, static_cast<int>(std::ceil(depth * invCell_)));
+
+    cellStart_.assign(static_cast<std::size_t>(cols_) * rows_ + 1, 0u);
+    cellPos_.clear();
+    cellIds_.clear();
+}
+
+void ConeGrid::rebuild(const std::vector<Vec2>& positions) {
+    const std::size_t n = positions.size();
+    const std::size_t cells = static_cast<std::size_t>(cols_) * rows_;
+
+    coneCell_.resize(n);
+    cellPos_.resize(n);
+    cellIds_.resize(n);
+    std::fill(cellStart_.begin(), cellStart_.end(), 0u);
+
+    // tell kjegler per celle (forskjøvet én, så prefikssummen blir start)
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint32_t cell = static_cast<std::uint32_t>(
+            cellZ(positions[i].z) * cols_ + cellX(positions[i].x));
+        coneCell_[i] = cell;
+        ++cellStart_[cell + 1];
+    }
+
+    for (std::size_t c = 0; c < cells; ++c) {
+        cellStart_[c + 1] += cellStart_[c];
+    }
+
+    // spre ut; bruker coneCell_ som skrivepeker per celle i et andre pass
+    for (std::size_t i = 0; i < n; ++i) {
+        std::uint32_t cell = coneCell_[i];
+        coneCell_[i] = cellStart_[cell]++;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        cellPos_[coneCell_[i]] = positions[i];
+        cellIds_[coneCell_[i]] = static_cast<std::uint32_t>(i);
+    }
+
+    // cellStart_ ble forskjøvet av skrivepekerne; flytt tilbake én plass
+    for (std::size_t c = cells; c > 0; --c) {
+        cellStart_[c] = cellStart_[c - 1];
+    }
+    cellStart_[0] = 0;
+}
+
+int ConeGrid::firstWithin(Vec2 p, float radius) const {
+    const float r2 = radius * radius;
+    int hit = -1;
+
+    forEachInBox({p.x - radius, p.z - radius}, {p.x + radius, p.z + radius},
+                 [&](int index, Vec2 cp) {
+        float dx = p.x - cp.x;
+        float dz = p.z - cp.z;
+        if (hit < 0 && dx * dx + dz * dz < r2) hit = index;
+    });
+
+    return hit;
+}
+
+int ConeGrid::firstOverlapping(const Obb& box, float radius) const {
+    int hit = -1;
+    Vec2 e = obbExtents(box) + Vec2{radius, radius};
+    forEachInBox(box.center - e, box.center + e, [&](int index, Vec2 cp) {
+        if (hit < 0 && overlapsCircle(box, cp, radius)) hit = index;
+    });
+    return hit;
+}
+
+int ConeGrid::sweepFirst(Vec2 from, Vec2 to, float radius, float& toi) const {
+    const Vec2 d = to - from;
+    int hit = -1;
+    float best = 2.f;
+
+    Vec2 lo{std::min(from.x, to.x) - radius, std::min(from.z, to.z) - radius};
+    Vec2 hi{std::max(from.x, to.x) + radius, std::max(from.z, to.z) + radius};
+    forEachInBox(lo, hi, [&](int index, Vec2 cp) {
+        float t;
+        if (sweepCircle(from, d, cp, radius, t) && t < best) {
+            best = t;
+            hit = index;
+        }
+    });
+
+    if (hit >= 0) toi = best;
+    return hit;
+}
+
+int ConeGrid::sweepFirstBox(const Obb& box, Vec2 d, float radius, float& toi) const {
+    int hit = -1;
+    float best = 2.f;
+
+    // AABB rundt boksen i start- og sluttposisjon, pluss radius
+    Vec2 e = obbExtents(box) + Vec2{radius, radius};
+    Vec2 end = box.center + d;
+    Vec2 lo{std::min(box.center.x, end.x) - e.x, std::min(box.center.z, end.z) - e.z};
+    Vec2 hi{std::max(box.center.x, end.x) + e.x, std::max(box.center.z, end.z) + e.z};
+    forEachInBox(lo, hi, [&](int index, Vec2 cp) {
+        float t;
+        if (sweepObbCircle(box, d, cp, radius, t) && t < best) {
+            best = t;
+            hit = index;
+        }
+    });
+
+    if (hit >= 0) toi = best;
+    return hit;
+}
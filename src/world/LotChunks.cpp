@@ -0,0 +1,182 @@
+// --------------------------------------------------------------------------------------
+// Chunk partition of the parking lot and the streaming policy deciding which chunks
+// are resident and at which level of detail. Headless; the threepp side is in
+// ChunkedLotVisual.
+// --------------------------------------------------------------------------------------
+
+#include "world/LotChunks.h"
+
+#include <algorithm>
+#include <cmath>
+
+// ---------------- LotChunks ----------------
+
+void LotChunks::configureGrid(const ParkingLot& lot, float chunkSize) {
+    origin_ = {lot.center.x - lot.width * 0.5f, lot.center.z - lot.depth * 0.5f};
+    extent_ = {lot.width, lot.depth};
+    chunkSize_ = chunkSize;
+    invChunk_ = 1.f / chunkSize;
+    cols_ = std::max(1, static_cast<int>(std::ceil(lot.width * invChunk_)));
+    rows_ = std::max(1, static_cast<int>(std::ceil(lot.depth * invChunk_)));
+
+    coneStart_.assign(static_cast<std::size_t>(count()) + 1, 0u);
+    coneIds_.clear();
+}
+
+void LotChunks::configure(const ParkingLot& lot, float chunkSize) {
+    configureGrid(lot, chunkSize);
+
+    scratch_.clear();
+    scratch_.reserve(lot.spots.size());
+    for (const auto& s : lot.spots) scratch_.push_back(s.center);
+    bucket(scratch_, spotStart_, spotIds_);
+}
+
+void LotChunks::configure(const ParkingLot& lot, float chunkSize,
+                          std::span<const std::uint32_t> chunkStart,
+                          std::span<const std::uint32_t> chunkSpots) {
+    configureGrid(lot, chunkSize);
+    if (chunkStart.size() != static_cast<std::size_t>(count()) + 1 ||
+        chunkSpots.size() != lot.spots.size()) {
+        configure(lot, chunkSize);
+        return;
+    }
+    spotStart_.assign(chunkStart.begin(), chunkStart.end());
+    spotIds_.assign(chunkSpots.begin(), chunkSpots.end());
+}
+
+void LotChunks::setCones(const std::vector<Vec2>& cones) {
+    bucket(cones, coneStart_, coneIds_);
+}
+
+void LotChunks::bucket(std::span<const Vec2> points, std::vector<std::uint32_t>& start,
+                       std::vector<std::uint32_t>& ids) const {
+    const std::size_t chunks = static_cast<std::size_t>(count());
+    start.assign(chunks + 1, 0u);
+    ids.resize(points.size());
+
+    for (const auto& p : points) ++start[static_cast<std::size_t>(chunkAt(p)) + 1];
+    for (std::size_t c = 0; c < chunks; ++c) start[c + 1] += start[c];
+
+    // skriv ut med start[c] som skrivepeker, og flytt tilbake etterpå (som ConeGrid)
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        ids[start[static_cast<std::size_t>(chunkAt(points[i]))]++] = static_cast<std::uint32_t>(i);
+    }
+    for (std::size_t c = chunks; c > 0; --c) start[c] = start[c - 1];
+    start[0] = 0;
+}
+
+int LotChunks::chunkAt(Vec2 p) const {
+    // klemmes i flyttall før konvertering, som ConeGrid::cellX (NaN gir 0)
+    const float fx = std::floor((p.x - origin_.x) * invChunk_);
+    const float fz = std::floor((p.z - origin_.z) * invChunk_);
+    const int x = fx >= static_cast<float>(cols_) ? cols_ - 1 : (fx >= 0.f ? static_cast<int>(fx) : 0);
+    const int z = fz >= static_cast<float>(rows_) ? rows_ - 1 : (fz >= 0.f ? static_cast<int>(fz) : 0);
+    return z * cols_ + x;
+}
+
+Vec2 LotChunks::chunkMin(int chunk) const {
+    return {origin_.x + static_cast<float>(chunkX(chunk)) * chunkSize_,
+            origin_.z + static_cast<float>(chunkZ(chunk)) * chunkSize_};
+}
+
+Vec2 LotChunks::chunkMax(int chunk) const {
+    Vec2 mn = chunkMin(chunk);
+    return {std::min(mn.x + chunkSize_, origin_.x + extent_.x),
+            std::min(mn.z + chunkSize_, origin_.z + extent_.z)};
+}
+
+float LotChunks::distanceTo(int chunk, Vec2 p) const {
+    Vec2 mn = chunkMin(chunk);
+    Vec2 mx = chunkMax(chunk);
+    float dx = std::max({mn.x - p.x, 0.f, p.x - mx.x});
+    float dz = std::max({mn.z - p.z, 0.f, p.z - mx.z});
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+std::span<const std::uint32_t> LotChunks::spotsIn(int chunk) const {
+    auto c = static_cast<std::size_t>(chunk);
+    return {spotIds_.data() + spotStart_[c], spotStart_[c + 1] - spotStart_[c]};
+}
+
+std::span<const std::uint32_t> LotChunks::conesIn(int chunk) const {
+    auto c = static_cast<std::size_t>(chunk);
+    return {coneIds_.data() + coneStart_[c], coneStart_[c + 1] - coneStart_[c]};
+}
+
+// ---------------- ChunkStreamer ----------------
+
+void ChunkStreamer::reset(const LotChunks& chunks) {
+    lod_.assign(static_cast<std::size_t>(chunks.count()), ChunkLod::None);
+    resident_.clear();
+    changes_.clear();
+    pending_ = 0;
+}
+
+void ChunkStreamer::update(const LotChunks& chunks, Vec2 focus) {
+    step(chunks, focus, static_cast<std::size_t>(std::max(params_.maxLoadsPerUpdate, 0)));
+}
+
+void ChunkStreamer::loadAll(const LotChunks& chunks, Vec2 focus) {
+    step(chunks, focus, static_cast<std::size_t>(-1));
+}
+
+ChunkLod ChunkStreamer::lodFor(float distance) const {
+    return distance > params_.lodDistance ? ChunkLod::Far : ChunkLod::Near;
+}
+
+void ChunkStreamer::step(const LotChunks& chunks, Vec2 focus, std::size_t maxLoads) {
+    if (lod_.size() != static_cast<std::size_t>(chunks.count())) reset(chunks);
+    changes_.clear();
+
+    // residente: fjern de som er for langt unna, bytt LOD på resten
+    std::size_t kept = 0;
+    for (int c : resident_) {
+        float d = chunks.distanceTo(c, focus);
+        ChunkLod& cur = lod_[static_cast<std::size_t>(c)];
+        if (d > params_.evictRadius) {
+            changes_.push_back({c, cur, ChunkLod::None});
+            cur = ChunkLod::None;
+            continue;
+        }
+        ChunkLod want = lodFor(d);
+        if (want != cur) {
+            changes_.push_back({c, cur, want});
+            cur = want;
+        }
+        resident_[kept++] = c;
+    }
+    resident_.resize(kept);
+
+    // nye innenfor loadRadius; bare chunkene i boksen rundt fokus ses på
+    const float r = params_.loadRadius;
+    int x0 = chunks.chunkX(chunks.chunkAt({focus.x - r, focus.z}));
+    int x1 = chunks.chunkX(chunks.chunkAt({focus.x + r, focus.z}));
+    int z0 = chunks.chunkZ(chunks.chunkAt({focus.x, focus.z - r}));
+    int z1 = chunks.chunkZ(chunks.chunkAt({focus.x, focus.z + r}));
+
+    candidates_.clear();
+    for (int z = z0; z <= z1; ++z) {
+        for (int x = x0; x <= x1; ++x) {
+            int c = z * chunks.cols() + x;
+            if (lod_[static_cast<std::size_t>(c)] != ChunkLod::None) continue;
+            float d = chunks.distanceTo(c, focus);
+            if (d <= r) candidates_.push_back({d, c});
+        }
+    }
+
+    // nærmeste først når budsjettet ikke rekker til alle
+    std::size_t n = std::min(maxLoads, candidates_.size());
+    if (n < candidates_.size()) {
+        std::partial_sort(candidates_.begin(), candidates_.begin() + static_cast<std::ptrdiff_t>(n),
+                          candidates_.end());
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        auto [d, c] = candidates_[i];
+        ChunkLod want = lodFor(d);
+        lod_[static_cast<std::size_t>(c)] = want;
+        resident_.push_back(c);
+        changes_.push_back({c, ChunkLod::None, want});
+    }
+    pending_ = candidates_.size() - n;
+}
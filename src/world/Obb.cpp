@@ -0,0 +1,147 @@
+// --------------------------------------------------------------------------------------
+// Oriented boxes in the ground plane: 2D separating-axis tests, box vs circle, and a
+// swept box vs circle time of impact (the box grown by the radius is two slabs plus
+// four corner circles, as in Ericson's "Real-Time Collision Detection").
+// --------------------------------------------------------------------------------------
+
+#include "world/Obb.h"
+#include "world/Sweep.h"
+
+#include <algorithm>
+
+namespace {
+
+// punktet p inn i boksens lokale ramme (x = høyre, z = framover)
+Vec2 toLocal(const Obb& b, Vec2 p) {
+    Vec2 q = p - b.center;
+    return {dot(q, b.right()), dot(q, b.axis)};
+}
+
+// stråle p + v*t mot boksen |x| <= hx, |z| <= hz; første t i [0, 1]
+bool sweepPointBox(Vec2 p, Vec2 v, float hx, float hz, float& toi) {
+    float t0 = 0.f, t1 = 1.f;
+    const float pa[2] = {p.x, p.z}, va[2] = {v.x, v.z}, ha[2] = {hx, hz};
+    for (int i = 0; i < 2; ++i) {
+        if (va[i] == 0.f) {
+            if (std::abs(pa[i]) > ha[i]) return false;
+            continue;
+        }
+        float inv = 1.f / va[i];
+        float ta = (-ha[i] - pa[i]) * inv;
+        float tb = (ha[i] - pa[i]) * inv;
+        if (ta > tb) std::swap(ta, tb);
+        t0 = std::max(t0, ta);
+        t1 = std::min(t1, tb);
+        if (t0 > t1) return false;
+    }
+    toi = t0;
+    return true;
+}
+
+}
+
+bool overlaps(const Obb& a, const Obb& b) {
+    // i 2D er cos/sin mellom aksene alt SAT trenger
+    const float c = std::abs(dot(a.axis, b.axis));
+    const float s = std::abs(dot(a.right(), b.axis));
+    const Vec2 d = b.center - a.center;
+
+    if (std::abs(dot(d, a.right())) > a.halfW + b.halfW * c + b.halfD * s) return false;
+    if (std::abs(dot(d, a.axis))    > a.halfD + b.halfW * s + b.halfD * c) return false;
+    if (std::abs(dot(d, b.right())) > b.halfW + a.halfW * c + a.halfD * s) return false;
+    if (std::abs(dot(d, b.axis))    > b.halfD + a.halfW * s + a.halfD * c) return false;
+    return true;
+}
+
+bool overlapsCircle(const Obb& b, Vec2 c, float r) {
+    Vec2 q = toLocal(b, c);
+    Vec2 closest{std::clamp(q.x, -b.halfW, b.halfW), std::clamp(q.z, -b.halfD, b.halfD)};
+    return lengthSq(q - closest) < r * r;
+}
+
+bool insideRect(const Obb& b, Vec2 min, Vec2 max) {
+    Vec2 e = obbExtents(b);
+    return b.center.x - e.x >= min.x && b.center.x + e.x <= max.x &&
+           b.center.z - e.z >= min.z && b.center.z + e.z <= max.z;
+}
+
+bool sweepObbCircle(const Obb& b, Vec2 d, Vec2 c, float r, float& toi) {
+    // i boksens ramme står boksen stille og sirkelsenteret beveger seg med -d
+    const Vec2 q = toLocal(b, c);
+    const Vec2 v{-dot(d, b.right()), -dot(d, b.axis)};
+    const float hw = b.halfW, hd = b.halfD;
+
+    Vec2 closest{std::clamp(q.x, -hw, hw), std::clamp(q.z, -hd, hd)};
+    Vec2 delta = q - closest;
+    float dist2 = lengthSq(delta);
+    if (dist2 < r * r) {
+        // allerede i kontakt: treff bare når sirkelen går videre innover
+        Vec2 out = dist2 > 0.f ? delta : q;
+        if (dot(v, out) >= 0.f) return false;
+        toi = 0.f;
+        return true;
+    }
+
+    // boksen utvidet med r = to plater + fire hjørnesirkler
+    float best = 2.f, t;
+    if (sweepPointBox(q, v, hw + r, hd, t)) best = std::min(best, t);
+    if (sweepPointBox(q, v, hw, hd + r, t)) best = std::min(best, t);
+    for (Vec2 corner : {Vec2{-hw, -hd}, Vec2{hw, -hd}, Vec2{-hw, hd}, Vec2{hw, hd}}) {
+        if (sweepCircle(q, v, corner, r, t)) best = std::min(best, t);
+    }
+
+    if (best > 1.f) return false;
+    toi = best;
+    return true;
+}
+
+void overlapsBatch(std::span<const Obb> bodies, std::span<const BodyPair> pairs,
+                   std::vector<BodyPair>& hits) {
+    constexpr std::size_t block = 16;
+
+    // SoA-blokk: differanse mellom sentrene, akser og halvmål for begge boksene
+    alignas(32) float dx[block], dz[block];
+    alignas(32) float aax[block], aaz[block], bax[block], baz[block];
+    alignas(32) float ahw[block], ahd[block], bhw[block], bhd[block];
+    alignas(32) int   hit[block];
+
+    for (std::size_t base = 0; base < pairs.size(); base += block) {
+        const std::size_t n = std::min(block, pairs.size() - base);
+
+        for (std::size_t k = 0; k < n; ++k) {
+            const Obb& a = bodies[pairs[base + k].a];
+            const Obb& b = bodies[pairs[base + k].b];
+            dx[k] = b.center.x - a.center.x;
+            dz[k] = b.center.z - a.center.z;
+            aax[k] = a.axis.x; aaz[k] = a.axis.z;
+            bax[k] = b.axis.x; baz[k] = b.axis.z;
+            ahw[k] = a.halfW;  ahd[k] = a.halfD;
+            bhw[k] = b.halfW;  bhd[k] = b.halfD;
+        }
+        // resten av siste blokk nullstilles; bare de n første leses ut
+        for (std::size_t k = n; k < block; ++k) {
+            dx[k] = dz[k] = 0.f;
+            aax[k] = aaz[k] = bax[k] = baz[k] = 0.f;
+            ahw[k] = ahd[k] = bhw[k] = bhd[k] = 0.f;
+        }
+
+        // samme akser som overlaps(); right = (axis.z, -axis.x)
+        for (std::size_t k = 0; k < block; ++k) {
+            float c = std::abs(aax[k] * bax[k] + aaz[k] * baz[k]);
+            float s = std::abs(aaz[k] * bax[k] - aax[k] * baz[k]);
+            float da0 = std::abs(dx[k] * aaz[k] - dz[k] * aax[k]);
+            float da1 = std::abs(dx[k] * aax[k] + dz[k] * aaz[k]);
+            float db0 = std::abs(dx[k] * baz[k] - dz[k] * bax[k]);
+            float db1 = std::abs(dx[k] * bax[k] + dz[k] * baz[k]);
+            bool sep = (da0 > ahw[k] + bhw[k] * c + bhd[k] * s) |
+                       (da1 > ahd[k] + bhw[k] * s + bhd[k] * c) |
+                       (db0 > bhw[k] + ahw[k] * c + ahd[k] * s) |
+                       (db1 > bhd[k] + ahw[k] * s + ahd[k] * c);
+            hit[k] = !sep;
+        }
+
+        for (std::size_t k = 0; k < n; ++k) {
+            if (hit[k]) hits.push_back(pairs[base + k]);
+        }
+    }
+}
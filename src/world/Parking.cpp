@@ -1,107 +1,57 @@
 // --------------------------------------------------------------------------------------
-// Parking spot geometry and “inside parking spot” detection based on custom logic.
+// Parking spot layout and “inside parking spot” detection based on custom logic.
 // Axis-aligned bounding box check method inspired by standard collision tutorials.
 // --------------------------------------------------------------------------------------
 
 #include "world/Parking.h"
+#include "world/Obb.h"
 #include <random>
 #include <algorithm>
 #include <cmath>
 
-using namespace threepp;
+void generateParkingLot(ParkingLot& lot, const LotLayout& layout) {
 
-static std::shared_ptr<Group> makeParkingSpotVisual(
-        Scene& scene,
-        const Vector3& center,
-        float width,
-        float depth) {
-
-    auto lineMat = MeshBasicMaterial::create();
-    lineMat->color = Color(0xffffff);
-
-    const float h = 0.01f;
-    const float t = 0.05f;
-
-    auto sideGeo  = BoxGeometry::create(t, h, depth);
-    auto frontGeo = BoxGeometry::create(width, h, t);
-
-    auto group = Group::create();
-
-    auto left = Mesh::create(sideGeo, lineMat);
-    left->position.set(center.x - width * 0.5f, h * 0.5f, center.z);
-    group->add(left);
-
-    auto right = Mesh::create(sideGeo, lineMat);
-    right->position.set(center.x + width * 0.5f, h * 0.5f, center.z);
-    group->add(right);
-
-    auto front = Mesh::create(frontGeo, lineMat);
-    front->position.set(center.x, h * 0.5f, center.z + depth * 0.5f);
-    group->add(front);
-
-    scene.add(group);
-    return group;
-}
-
-void addParkingLot(Scene& scene,
-                   std::vector<ParkingSpot>& spots,
-                   Vector3& lotCenterOut,
-                   float& lotWidthOut,
-                   float& lotDepthOut) {
-
-    const int   rows      = 12;
-    const int   cols      = 24;
-    const float slotW     = 2.6f;
-    const float slotD     = 5.2f;
-    const float laneWidth = 3.0f;
-    const float margin    = 1.0f;
+    const int   rows      = layout.rows;
+    const int   cols      = layout.cols;
+    const float slotW     = layout.slotW;
+    const float slotD     = layout.slotD;
+    const float laneWidth = layout.laneWidth;
+    const float margin    = layout.margin;
 
     const float totalW = cols * slotW + 2 * margin;
     const float totalD = rows * slotD + (rows - 1) * laneWidth + 2 * margin;
 
-    Vector3 center{0.f, 0.f, 0.f};
-    lotCenterOut = center;
-    lotWidthOut  = totalW;
-    lotDepthOut  = totalD;
-
-    auto asphaltMat = MeshPhongMaterial::create();
-    asphaltMat->color = Color(0x303030);
-    auto asphaltGeo = PlaneGeometry::create(totalW, totalD);
-    asphaltGeo->rotateX(-math::PI / 2);
-    auto asphalt = Mesh::create(asphaltGeo, asphaltMat);
-    asphalt->position.set(center.x, 0.0f, center.z);
-    scene.add(asphalt);
+    Vec2 center{0.f, 0.f};
+    lot.layout = layout;
+    lot.center = center;
+    lot.width  = totalW;
+    lot.depth  = totalD;
 
     float baseX = center.x - totalW * 0.5f + margin + slotW * 0.5f;
     float baseZ = center.z - totalD * 0.5f + margin + slotD * 0.5f;
 
-    spots.clear();
-    spots.reserve(rows * cols);
+    lot.spots.clear();
+    lot.spots.reserve(static_cast<std::size_t>(std::max(rows, 0)) * static_cast<std::size_t>(std::max(cols, 0)));
 
     for (int r = 0; r < rows; ++r) {
         float rowZ = baseZ + r * (slotD + laneWidth);
 
         for (int c = 0; c < cols; ++c) {
             float x = baseX + c * slotW;
-            Vector3 spotCenter{x, 0.f, rowZ};
-
-            auto visual = makeParkingSpotVisual(scene, spotCenter, slotW, slotD);
 
             ParkingSpot s;
-            s.center = spotCenter;
+            s.center = {x, rowZ};
             s.halfW  = slotW * 0.5f;
             s.halfD  = slotD * 0.5f;
-            s.visual = visual;
             s.completed = false;
-            s.completeMarker.reset();
 
-            spots.push_back(s);
+            lot.spots.push_back(s);
         }
     }
 }
 
 bool isCarInsideSpot(const ParkingSpot& s,
-                     const Vector3& carPos,
+                     Vec2 carPos,
                      float carHalfW,
                      float carHalfD) {
 
@@ -109,26 +59,39 @@ bool isCarInsideSpot(const ParkingSpot& s,
            std::abs(carPos.z - s.center.z) <= (s.halfD - carHalfD * 0.25f);
 }
 
-std::vector<int> makeRandomTargetSequence(int totalSpots, int count) {
-    std::vector<int> indices(totalSpots);
+bool isCarInsideSpot(const ParkingSpot& s,
+                     Vec2 carPos,
+                     float carHeading,
+                     float carHalfW,
+                     float carHalfD) {
+
+    Obb core = makeCarObb(carPos, carHeading, carHalfW * 0.25f, carHalfD * 0.25f);
+    Vec2 half{s.halfW, s.halfD};
+    return insideRect(core, s.center - half, s.center + half);
+}
+
+std::vector<int> makeRandomTargetSequence(int totalSpots, int count, Rng& rng) {
+    std::vector<int> indices;
+    makeRandomTargetSequence(totalSpots, count, rng, indices);
+    return indices;
+}
+
+void makeRandomTargetSequence(int totalSpots, int count, Rng& rng, std::vector<int>& indices) {
+    indices.resize(static_cast<std::size_t>(std::max(totalSpots, 0)));
     for (int i = 0; i < totalSpots; ++i) indices[i] = i;
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::shuffle(indices.begin(), indices.end(), gen);
+    // Fisher-Yates med Rng::below (std::shuffle sin fordeling er ikke lik på alle plattformer)
+    for (int i = totalSpots - 1; i > 0; --i) {
+        int j = static_cast<int>(rng.below(static_cast<std::uint32_t>(i) + 1u));
+        std::swap(indices[i], indices[j]);
+    }
 
     if (count < totalSpots) {
         indices.resize(count);
     }
-    return indices;
 }
 
-void updateTargetMarkerPosition(const std::shared_ptr<Mesh>& marker,
-                                const ParkingSpot& spot) {
-    if (!marker) return;
-    marker->position.set(
-        spot.center.x,
-        0.9f,
-        spot.center.z - spot.halfD * 0.6f
-    );
+std::vector<int> makeRandomTargetSequence(int totalSpots, int count) {
+    Rng rng(std::random_device{}());
+    return makeRandomTargetSequence(totalSpots, count, rng);
 }
@@ -0,0 +1,170 @@
+// --------------------------------------------------------------------------------------
+// Parking spot lookup: arithmetic indexing for the regular grids that
+// generateParkingLot produces, and a small median-split AABB BVH for anything else.
+// --------------------------------------------------------------------------------------
+
+#include "world/ParkingLotIndex.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace {
+    const std::uint32_t leafSize = 4;
+}
+
+void ParkingLotIndex::build(const ParkingLot& lot) {
+    const std::size_t n = lot.spots.size();
+    cx_.resize(n);
+    cz_.resize(n);
+    hw_.resize(n);
+    hd_.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        cx_[i] = lot.spots[i].center.x;
+        cz_[i] = lot.spots[i].center.z;
+        hw_[i] = lot.spots[i].halfW;
+        hd_[i] = lot.spots[i].halfD;
+    }
+
+    const LotLayout& L = lot.layout;
+    regular_ = n > 0 && static_cast<std::size_t>(L.rows) * L.cols == n;
+
+    if (regular_) {
+        rows_ = L.rows;
+        cols_ = L.cols;
+        originX_ = cx_[0] - hw_[0];
+        originZ_ = cz_[0] - hd_[0];
+        invSlotW_ = 1.f / L.slotW;
+        slotD_ = L.slotD;
+        rowPitch_ = L.slotD + L.laneWidth;
+        invRowPitch_ = 1.f / rowPitch_;
+
+        // plassene må faktisk ligge der layouten sier (radvis, slik generateParkingLot lager dem)
+        const float eps = 1e-3f;
+        for (std::size_t i = 0; i < n && regular_; ++i) {
+            int r = static_cast<int>(i) / cols_;
+            int c = static_cast<int>(i) % cols_;
+            regular_ = std::abs(cx_[i] - (originX_ + (c + 0.5f) * L.slotW)) < eps &&
+                       std::abs(cz_[i] - (originZ_ + r * rowPitch_ + 0.5f * L.slotD)) < eps &&
+                       std::abs(hw_[i] - 0.5f * L.slotW) < eps &&
+                       std::abs(hd_[i] - 0.5f * L.slotD) < eps;
+        }
+    }
+
+    bvh_.clear();
+    bvhSpots_.clear();
+    if (!regular_ && n > 0) {
+        bvhSpots_.resize(n);
+        for (std::uint32_t i = 0; i < n; ++i) bvhSpots_[i] = i;
+        bvh_.reserve(2 * n / leafSize + 1);
+        buildBvhNode(0, static_cast<std::uint32_t>(n));
+    }
+}
+
+std::uint32_t ParkingLotIndex::buildBvhNode(std::uint32_t first, std::uint32_t count) {
+    std::uint32_t nodeIndex = static_cast<std::uint32_t>(bvh_.size());
+    bvh_.push_back({});
+
+    BvhNode node{1e30f, 1e30f, -1e30f, -1e30f, first, count};
+    for (std::uint32_t k = first; k < first + count; ++k) {
+        std::uint32_t s = bvhSpots_[k];
+        node.minX = std::min(node.minX, cx_[s] - hw_[s]);
+        node.minZ = std::min(node.minZ, cz_[s] - hd_[s]);
+        node.maxX = std::max(node.maxX, cx_[s] + hw_[s]);
+        node.maxZ = std::max(node.maxZ, cz_[s] + hd_[s]);
+    }
+
+    if (count > leafSize) {
+        // del på medianen langs lengste akse
+        bool splitX = (node.maxX - node.minX) >= (node.maxZ - node.minZ);
+        auto begin = bvhSpots_.begin() + first;
+        auto mid = begin + count / 2;
+        std::nth_element(begin, mid, begin + count, [&](std::uint32_t a, std::uint32_t b) {
+            return splitX ? cx_[a] < cx_[b] : cz_[a] < cz_[b];
+        });
+
+        // venstre barn havner rett etter denne noden; lagre bare høyre
+        buildBvhNode(first, count / 2);
+        node.first = buildBvhNode(first + count / 2, count - count / 2);
+        node.count = 0;
+    }
+
+    bvh_[nodeIndex] = node;
+    return nodeIndex;
+}
+
+bool ParkingLotIndex::contains(std::uint32_t s, Vec2 p) const {
+    float dx = p.x - (cx_[s] - hw_[s]);
+    float dz = p.z - (cz_[s] - hd_[s]);
+    return dx >= 0.f && dx < 2.f * hw_[s] && dz >= 0.f && dz < 2.f * hd_[s];
+}
+
+int ParkingLotIndex::locateRegular(float x, float z) const {
+    float fx = (x - originX_) * invSlotW_;
+    float fz = z - originZ_;
+    const float fc = std::floor(fx);
+    const float fr = std::floor(fz * invRowPitch_);
+    // sjekkes i flyttall før konvertering: NaN og verdier utenfor int er UB i static_cast
+    const bool inGrid = (fc >= 0.f) & (fc < static_cast<float>(cols_)) & (fr >= 0.f) & (fr < static_cast<float>(rows_));
+    const int c = inGrid ? static_cast<int>(fc) : 0;
+    const int r = inGrid ? static_cast<int>(fr) : 0;
+    float inRow = fz - fr * rowPitch_;
+
+    bool valid = inGrid & (inRow < slotD_);
+    return valid ? r * cols_ + c : -1;
+}
+
+int ParkingLotIndex::locateBvh(Vec2 p) const {
+    if (bvh_.empty()) return -1;
+
+    std::uint32_t stack[64];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0) {
+        const std::uint32_t index = stack[--top];
+        const BvhNode& node = bvh_[index];
+        if (p.x < node.minX || p.x >= node.maxX || p.z < node.minZ || p.z >= node.maxZ) continue;
+
+        if (node.count > 0) {
+            for (std::uint32_t k = node.first; k < node.first + node.count; ++k) {
+                if (contains(bvhSpots_[k], p)) return static_cast<int>(bvhSpots_[k]);
+            }
+        } else {
+            stack[top++] = node.first;  // høyre
+            stack[top++] = index + 1;   // venstre
+        }
+    }
+    return -1;
+}
+
+int ParkingLotIndex::locate(Vec2 p) const {
+    return regular_ ? locateRegular(p.x, p.z) : locateBvh(p);
+}
+
+void ParkingLotIndex::locate(std::span<const Vec2> positions, std::span<int> out) const {
+    assert(out.size() >= positions.size());
+
+    if (regular_) {
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            out[i] = locateRegular(positions[i].x, positions[i].z);
+        }
+    } else {
+        for (std::size_t i = 0; i < positions.size(); ++i) {
+            out[i] = locateBvh(positions[i]);
+        }
+    }
+}
+
+void ParkingLotIndex::locate(const float* xs, const float* zs, int* out, std::size_t n) const {
+    if (regular_) {
+        // grenløs aritmetikk, vektoriseres av kompilatoren
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = locateRegular(xs[i], zs[i]);
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = locateBvh({xs[i], zs[i]});
+        }
+    }
+}
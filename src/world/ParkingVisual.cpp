@@ -0,0 +1,75 @@
+// --------------------------------------------------------------------------------------
+// Parking lot visuals (asphalt and line markings) built with the standard threepp API.
+// Layout comes from generateParkingLot in Parking.cpp. All line markings share one
+// unit box geometry and one material and are drawn as a single InstancedMesh.
+// --------------------------------------------------------------------------------------
+
+#include "world/ParkingVisual.h"
+
+using namespace threepp;
+
+void addParkingLot(Scene& scene, const ParkingLot& lot) {
+
+    auto asphaltMat = MeshPhongMaterial::create();
+    asphaltMat->color = Color(0x303030);
+    auto asphaltGeo = PlaneGeometry::create(lot.width, lot.depth);
+    asphaltGeo->rotateX(-math::PI / 2);
+    auto asphalt = Mesh::create(asphaltGeo, asphaltMat);
+    asphalt->position.set(lot.center.x, 0.0f, lot.center.z);
+    scene.add(asphalt);
+
+    // oppmerking: venstre, høyre og front-strek per plass, ett draw call totalt
+    const float h = 0.01f;
+    const float t = 0.05f;
+
+    auto lineMat = MeshBasicMaterial::create();
+    lineMat->color = Color(0xffffff);
+    auto lineGeo = BoxGeometry::create(1.f, 1.f, 1.f);
+
+    auto lines = InstancedMesh::create(lineGeo, lineMat, lot.spots.size() * 3);
+    // bounding-volumet til en instans sier ingenting om hele plassen
+    lines->frustumCulled = false;
+
+    Matrix4 m;
+    Quaternion noRotation;
+    std::size_t instance = 0;
+
+    auto addLine = [&](float x, float z, float sizeX, float sizeZ) {
+        m.compose(Vector3(x, h * 0.5f, z), noRotation, Vector3(sizeX, h, sizeZ));
+        lines->setMatrixAt(instance++, m);
+    };
+
+    for (const auto& s : lot.spots) {
+        const float width = s.halfW * 2.f;
+        const float depth = s.halfD * 2.f;
+
+        addLine(s.center.x - s.halfW, s.center.z, t, depth);
+        addLine(s.center.x + s.halfW, s.center.z, t, depth);
+        addLine(s.center.x, s.center.z + s.halfD, width, t);
+    }
+
+    lines->instanceMatrix()->needsUpdate();
+    scene.add(lines);
+}
+
+CompletionMarkerAssets makeCompletionMarkerAssets() {
+    CompletionMarkerAssets assets;
+    assets.material = MeshPhongMaterial::create();
+    assets.material->color = Color(0x00ff00);
+    assets.geometry = BoxGeometry::create(0.3f, 1.2f, 0.3f);
+    return assets;
+}
+
+void placeCompletionMarker(Mesh& marker, const ParkingSpot& spot) {
+    marker.position.set(spot.center.x, 0.6f, spot.center.z - spot.halfD * 0.5f);
+}
+
+void updateTargetMarkerPosition(const std::shared_ptr<Mesh>& marker,
+                                const ParkingSpot& spot) {
+    if (!marker) return;
+    marker->position.set(
+        spot.center.x,
+        0.9f,
+        spot.center.z - spot.halfD * 0.6f
+    );
+}
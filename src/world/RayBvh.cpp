@@ -0,0 +1,362 @@
+// --------------------------------------------------------------------------------------
+// Packet ray casting against extruded 2D primitives. Coherent rays share one origin and
+// traverse the BVH together (Wald et al., "Interactive Rendering with Coherent Ray
+// Tracing"): a node is entered if any lane's slab interval is live, children are
+// visited in the order given by the packet's direction along the split axis, and the
+// leaf tests run across the lanes with the same small SIMD "ops" wrapper as CarFleet.
+// --------------------------------------------------------------------------------------
+
+#include "world/RayBvh.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+
+#if defined(__AVX2__)
+#define RAYBVH_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#define RAYBVH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const std::uint32_t leafSize = 4;
+
+// ---------------- ops ----------------
+
+struct ScalarOps {
+    using V = float;
+    using M = bool;
+    static constexpr int width = 1;
+
+    static V load(const float* p) { return *p; }
+    static void store(float* p, V v) { *p = v; }
+    static V set1(float x) { return x; }
+
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V div(V a, V b) { return a / b; }
+    static V min(V a, V b) { return a < b ? a : b; }
+    static V max(V a, V b) { return a > b ? a : b; }
+    static V sqrt(V a) { return std::sqrt(a); }
+
+    static M lt(V a, V b) { return a < b; }
+    static M le(V a, V b) { return a <= b; }
+    static M ge(V a, V b) { return a >= b; }
+    static M mand(M a, M b) { return a && b; }
+    static V select(M m, V a, V b) { return m ? a : b; }
+    static bool any(M m) { return m; }
+};
+
+#if RAYBVH_AVX2
+struct Avx2Ops {
+    using V = __m256;
+    using M = __m256;
+    static constexpr int width = 8;
+
+    static V load(const float* p) { return _mm256_load_ps(p); }
+    static void store(float* p, V v) { _mm256_store_ps(p, v); }
+    static V set1(float x) { return _mm256_set1_ps(x); }
+
+    static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm256_div_ps(a, b); }
+    static V min(V a, V b) { return _mm256_min_ps(a, b); }
+    static V max(V a, V b) { return _mm256_max_ps(a, b); }
+    static V sqrt(V a) { return _mm256_sqrt_ps(a); }
+
+    static M lt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static M le(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static M ge(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static M mand(M a, M b) { return _mm256_and_ps(a, b); }
+    static V select(M m, V a, V b) { return _mm256_blendv_ps(b, a, m); }
+    static bool any(M m) { return _mm256_movemask_ps(m) != 0; }
+};
+#elif RAYBVH_SSE2
+struct Sse2Ops {
+    using V = __m128;
+    using M = __m128;
+    static constexpr int width = 4;
+
+    static V load(const float* p) { return _mm_load_ps(p); }
+    static void store(float* p, V v) { _mm_store_ps(p, v); }
+    static V set1(float x) { return _mm_set1_ps(x); }
+
+    static V add(V a, V b) { return _mm_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm_div_ps(a, b); }
+    static V min(V a, V b) { return _mm_min_ps(a, b); }
+    static V max(V a, V b) { return _mm_max_ps(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_ps(a); }
+
+    static M lt(V a, V b) { return _mm_cmplt_ps(a, b); }
+    static M le(V a, V b) { return _mm_cmple_ps(a, b); }
+    static M ge(V a, V b) { return _mm_cmpge_ps(a, b); }
+    static M mand(M a, M b) { return _mm_and_ps(a, b); }
+    static V select(M m, V a, V b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+    static bool any(M m) { return _mm_movemask_ps(m) != 0; }
+};
+#endif
+
+#if RAYBVH_AVX2
+using PacketOps = Avx2Ops;
+#elif RAYBVH_SSE2
+using PacketOps = Sse2Ops;
+#else
+using PacketOps = ScalarOps;
+#endif
+
+// retninger nær null gir uendelige inverser; holdes endelige så 0 * inv ikke blir NaN
+float safeInverse(float v) {
+    const float tiny = 1e-12f;
+    return 1.f / (std::abs(v) < tiny ? (v < 0.f ? -tiny : tiny) : v);
+}
+
+}
+
+// ---------------- pakke ----------------
+
+void RayPacket::set(int i, Vec2 dir, float slope, float tmax) {
+    assert(i >= 0 && i < width);
+    dx[i] = dir.x;
+    dz[i] = dir.z;
+    invDx[i] = safeInverse(dir.x);
+    invDz[i] = safeInverse(dir.z);
+    // vannrett stråle: (y - height) * invSlope blir ±stor, ikke NaN
+    invSlope[i] = safeInverse(std::abs(slope) < 1e-7f ? 1e-7f : slope);
+    t[i] = tmax;
+    hit[i] = noHit;
+}
+
+// ---------------- bygging ----------------
+
+void RayBvh::clear() {
+    pending_.clear();
+    nodes_.clear();
+    for (auto* v : {&cx_, &cz_, &ax_, &az_, &hw_, &hd_, &y0_, &y1_}) v->clear();
+    tag_.clear();
+    circle_.clear();
+}
+
+void RayBvh::reserve(std::size_t prims) {
+    pending_.reserve(prims);
+    order_.reserve(prims);
+    nodes_.reserve(2 * prims / leafSize + 1);
+    for (auto* v : {&cx_, &cz_, &ax_, &az_, &hw_, &hd_, &y0_, &y1_}) v->reserve(prims);
+    tag_.reserve(prims);
+    circle_.reserve(prims);
+}
+
+void RayBvh::build() {
+    const std::size_t n = pending_.size();
+    order_.resize(n);
+    for (std::uint32_t i = 0; i < n; ++i) order_[i] = i;
+
+    nodes_.clear();
+    if (n > 0) buildNode(0, static_cast<std::uint32_t>(n));
+
+    // prismene i løvrekkefølge
+    for (auto* v : {&cx_, &cz_, &ax_, &az_, &hw_, &hd_, &y0_, &y1_}) v->resize(n);
+    tag_.resize(n);
+    circle_.resize(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        const RayPrim& p = pending_[order_[k]];
+        cx_[k] = p.box.center.x;
+        cz_[k] = p.box.center.z;
+        ax_[k] = p.circle ? 0.f : p.box.axis.x;
+        az_[k] = p.circle ? 0.f : p.box.axis.z;
+        hw_[k] = p.box.halfW;
+        hd_[k] = p.box.halfD;
+        y0_[k] = p.y0;
+        y1_[k] = p.y1;
+        tag_[k] = p.tag;
+        circle_[k] = p.circle ? 1 : 0;
+    }
+    pending_.clear();
+}
+
+std::uint32_t RayBvh::buildNode(std::uint32_t first, std::uint32_t count) {
+    const std::uint32_t nodeIndex = static_cast<std::uint32_t>(nodes_.size());
+    nodes_.push_back({});
+
+    Node node{1e30f, 1e30f, -1e30f, -1e30f, 1e30f, -1e30f, first, static_cast<std::uint16_t>(count), 0};
+    for (std::uint32_t k = first; k < first + count; ++k) {
+        const RayPrim& p = pending_[order_[k]];
+        const Vec2 e = p.circle ? Vec2{p.box.halfW, p.box.halfW} : obbExtents(p.box);
+        node.minX = std::min(node.minX, p.box.center.x - e.x);
+        node.minZ = std::min(node.minZ, p.box.center.z - e.z);
+        node.maxX = std::max(node.maxX, p.box.center.x + e.x);
+        node.maxZ = std::max(node.maxZ, p.box.center.z + e.z);
+        node.minY = std::min(node.minY, p.y0);
+        node.maxY = std::max(node.maxY, p.y1);
+    }
+
+    if (count > leafSize) {
+        // del på medianen langs lengste akse
+        const bool splitX = (node.maxX - node.minX) >= (node.maxZ - node.minZ);
+        auto begin = order_.begin() + first;
+        auto mid = begin + count / 2;
+        std::nth_element(begin, mid, begin + count, [&](std::uint32_t a, std::uint32_t b) {
+            return splitX ? pending_[a].box.center.x < pending_[b].box.center.x
+                          : pending_[a].box.center.z < pending_[b].box.center.z;
+        });
+
+        buildNode(first, count / 2);
+        node.first = buildNode(first + count / 2, count - count / 2);
+        node.count = 0;
+        node.axis = splitX ? 0 : 1;
+    }
+
+    nodes_[nodeIndex] = node;
+    return nodeIndex;
+}
+
+// ---------------- traversering ----------------
+
+template <class Ops>
+struct PacketTraversal {
+    using V = typename Ops::V;
+    static constexpr int chunks = RayPacket::width / Ops::width;
+
+    const RayBvh& bvh;
+    RayPacket& p;
+
+    V dx[chunks], dz[chunks], invDx[chunks], invDz[chunks], invSlope[chunks], t[chunks], hit[chunks];
+
+    PacketTraversal(const RayBvh& b, RayPacket& packet) : bvh(b), p(packet) {
+        for (int c = 0; c < chunks; ++c) {
+            const int o = c * Ops::width;
+            dx[c] = Ops::load(p.dx + o);
+            dz[c] = Ops::load(p.dz + o);
+            invDx[c] = Ops::load(p.invDx + o);
+            invDz[c] = Ops::load(p.invDz + o);
+            invSlope[c] = Ops::load(p.invSlope + o);
+            t[c] = Ops::load(p.t + o);
+            hit[c] = Ops::load(reinterpret_cast<const float*>(p.hit) + o); // tag-bitene, ikke tall
+        }
+    }
+
+    void finish() {
+        for (int c = 0; c < chunks; ++c) {
+            Ops::store(p.t + c * Ops::width, t[c]);
+            Ops::store(reinterpret_cast<float*>(p.hit) + c * Ops::width, hit[c]);
+        }
+    }
+
+    // strålene som treffer nodens 3D-boks nærmere enn nåværende treff
+    bool enters(const RayBvh::Node& n) const {
+        const V x0 = Ops::set1(n.minX - p.origin.x), x1 = Ops::set1(n.maxX - p.origin.x);
+        const V z0 = Ops::set1(n.minZ - p.origin.z), z1 = Ops::set1(n.maxZ - p.origin.z);
+        const V y0 = Ops::set1(n.minY - p.height), y1 = Ops::set1(n.maxY - p.height);
+        bool any = false;
+        for (int c = 0; c < chunks; ++c) {
+            const V tx0 = Ops::mul(x0, invDx[c]), tx1 = Ops::mul(x1, invDx[c]);
+            const V tz0 = Ops::mul(z0, invDz[c]), tz1 = Ops::mul(z1, invDz[c]);
+            const V ty0 = Ops::mul(y0, invSlope[c]), ty1 = Ops::mul(y1, invSlope[c]);
+            const V tn = Ops::max(Ops::max(Ops::max(Ops::min(tx0, tx1), Ops::min(tz0, tz1)), Ops::min(ty0, ty1)),
+                                  Ops::set1(0.f));
+            const V tf = Ops::min(Ops::min(Ops::min(Ops::max(tx0, tx1), Ops::max(tz0, tz1)), Ops::max(ty0, ty1)), t[c]);
+            any |= Ops::any(Ops::le(tn, tf));
+        }
+        return any;
+    }
+
+    // ett prisme mot alle strålene: [tin, tout] fra fotavtrykket, klippet av høyden
+    void primitive(std::uint32_t k) {
+        const float ox = p.origin.x - bvh.cx_[k], oz = p.origin.z - bvh.cz_[k];
+        const V hy0 = Ops::set1(bvh.y0_[k] - p.height), hy1 = Ops::set1(bvh.y1_[k] - p.height);
+        const V tag = Ops::set1(std::bit_cast<float>(bvh.tag_[k]));
+        const V zero = Ops::set1(0.f);
+
+        for (int c = 0; c < chunks; ++c) {
+            V tin, tout;
+            typename Ops::M valid;
+            if (bvh.circle_[k]) {
+                // |o + t d - c|^2 = r^2 med |d| = 1
+                const V b = Ops::add(Ops::mul(Ops::set1(ox), dx[c]), Ops::mul(Ops::set1(oz), dz[c]));
+                const V disc = Ops::sub(Ops::mul(b, b), Ops::set1(ox * ox + oz * oz - bvh.hw_[k] * bvh.hw_[k]));
+                valid = Ops::ge(disc, zero);
+                const V s = Ops::sqrt(Ops::max(disc, zero));
+                tin = Ops::sub(Ops::sub(zero, b), s);
+                tout = Ops::sub(s, b);
+            } else {
+                // slabs i boksens ramme (x = høyre, z = framover)
+                const float axx = bvh.ax_[k], axz = bvh.az_[k];
+                const float lr = ox * axz - oz * axx, lf = ox * axx + oz * axz;
+                const V dr = Ops::sub(Ops::mul(dx[c], Ops::set1(axz)), Ops::mul(dz[c], Ops::set1(axx)));
+                const V df = Ops::add(Ops::mul(dx[c], Ops::set1(axx)), Ops::mul(dz[c], Ops::set1(axz)));
+                const V ir = Ops::div(Ops::set1(1.f), dr), iff = Ops::div(Ops::set1(1.f), df);
+                const V ta = Ops::mul(Ops::set1(-bvh.hw_[k] - lr), ir), tb = Ops::mul(Ops::set1(bvh.hw_[k] - lr), ir);
+                const V tc = Ops::mul(Ops::set1(-bvh.hd_[k] - lf), iff), td = Ops::mul(Ops::set1(bvh.hd_[k] - lf), iff);
+                tin = Ops::max(Ops::min(ta, tb), Ops::min(tc, td));
+                tout = Ops::min(Ops::max(ta, tb), Ops::max(tc, td));
+                valid = Ops::le(tin, tout);
+            }
+
+            // høyden height + slope * t innenfor [y0, y1]
+            const V ya = Ops::mul(hy0, invSlope[c]), yb = Ops::mul(hy1, invSlope[c]);
+            tin = Ops::max(Ops::max(tin, Ops::min(ya, yb)), zero);
+            tout = Ops::min(tout, Ops::max(ya, yb));
+
+            const auto hitMask = Ops::mand(Ops::mand(valid, Ops::le(tin, tout)), Ops::lt(tin, t[c]));
+            t[c] = Ops::select(hitMask, tin, t[c]);
+            hit[c] = Ops::select(hitMask, tag, hit[c]);
+        }
+    }
+
+    void run(std::uint32_t skipTag) {
+        if (bvh.nodes_.empty()) return;
+        const bool posX = p.dx[0] >= 0.f, posZ = p.dz[0] >= 0.f;
+
+        std::uint32_t stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const std::uint32_t index = stack[--top];
+            const RayBvh::Node& n = bvh.nodes_[index];
+            if (!enters(n)) continue;
+
+            if (n.count > 0) {
+                for (std::uint32_t k = n.first; k < n.first + n.count; ++k) {
+                    if (bvh.tag_[k] != skipTag) primitive(k);
+                }
+            } else if (n.axis == 0 ? posX : posZ) {
+                stack[top++] = n.first;  // høyre sist
+                stack[top++] = index + 1;
+            } else {
+                stack[top++] = index + 1;
+                stack[top++] = n.first;
+            }
+        }
+    }
+};
+
+void RayBvh::intersect(RayPacket& p, std::uint32_t skipTag) const {
+    PacketTraversal<PacketOps> trav(*this, p);
+    trav.run(skipTag);
+    trav.finish();
+}
+
+void RayBvh::intersectLinear(RayPacket& p, std::uint32_t skipTag) const {
+    PacketTraversal<ScalarOps> trav(*this, p);
+    for (std::uint32_t k = 0; k < tag_.size(); ++k) {
+        if (tag_[k] != skipTag) trav.primitive(k);
+    }
+    trav.finish();
+}
+
+const char* RayBvh::simdPath() {
+#if RAYBVH_AVX2
+    return "avx2";
+#elif RAYBVH_SSE2
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,104 @@
+// --------------------------------------------------------------------------------------
+// Sweep-and-prune broadphase on one axis with a persistent, insertion-sorted order
+// (the frame-to-frame coherence trick from Baraff's and Cohen et al.'s SAP papers),
+// swept per z band like a segmented/multi-SAP so large square worlds stay cheap.
+// --------------------------------------------------------------------------------------
+
+#include "world/SweepAndPrune.h"
+
+#include <algorithm>
+#include <numeric>
+
+void SweepAndPrune::update(std::span<const Aabb> boxes) {
+    const std::size_t n = boxes.size();
+    swaps_ = 0;
+
+    if (order_.size() != n) {
+        order_.resize(n);
+        std::iota(order_.begin(), order_.end(), 0u);
+        std::sort(order_.begin(), order_.end(), [&](std::uint32_t a, std::uint32_t b) {
+            return boxes[a].min.x < boxes[b].min.x;
+        });
+        minX_.resize(n);
+        maxX_.resize(n);
+        minZ_.resize(n);
+        maxZ_.resize(n);
+    }
+
+    for (std::size_t k = 0; k < n; ++k) {
+        minX_[k] = boxes[order_[k]].min.x;
+    }
+
+    // innsettingssortering fra forrige rekkefølge
+    for (std::size_t i = 1; i < n; ++i) {
+        const float key = minX_[i];
+        const std::uint32_t id = order_[i];
+        std::size_t j = i;
+        while (j > 0 && minX_[j - 1] > key) {
+            minX_[j] = minX_[j - 1];
+            order_[j] = order_[j - 1];
+            --j;
+        }
+        minX_[j] = key;
+        order_[j] = id;
+        swaps_ += i - j;
+    }
+
+    for (std::size_t k = 0; k < n; ++k) {
+        const Aabb& b = boxes[order_[k]];
+        maxX_[k] = b.max.x;
+        minZ_[k] = b.min.z;
+        maxZ_[k] = b.max.z;
+    }
+
+    pairs_.clear();
+    if (n == 0) return;
+
+    // z-bånd på fire midlere kroppshøyder (maks 4096 bånd)
+    float zLo = minZ_[0], zHi = maxZ_[0], heightSum = 0.f;
+    for (std::size_t k = 0; k < n; ++k) {
+        zLo = std::min(zLo, minZ_[k]);
+        zHi = std::max(zHi, maxZ_[k]);
+        heightSum += maxZ_[k] - minZ_[k];
+    }
+    const float span = std::max(zHi - zLo, 1e-6f);
+    const float bandH = std::max(4.f * heightSum / static_cast<float>(n), span / 4096.f);
+    const float invBand = 1.f / bandH;
+    const int bands = static_cast<int>(span * invBand) + 1;
+    auto bandOf = [&](float z) {
+        return std::min(bands - 1, static_cast<int>((z - zLo) * invBand));
+    };
+
+    // tellesortering inn i båndene; i stigende k, så hvert bånd beholder x-rekkefølgen
+    bandStart_.assign(static_cast<std::size_t>(bands) + 1, 0u);
+    for (std::size_t k = 0; k < n; ++k) {
+        for (int b = bandOf(minZ_[k]); b <= bandOf(maxZ_[k]); ++b) ++bandStart_[b + 1];
+    }
+    for (int b = 0; b < bands; ++b) bandStart_[b + 1] += bandStart_[b];
+    bandEntries_.resize(bandStart_[bands]);
+    for (std::size_t k = 0; k < n; ++k) {
+        for (int b = bandOf(minZ_[k]); b <= bandOf(maxZ_[k]); ++b) {
+            bandEntries_[bandStart_[b]++] = static_cast<std::uint32_t>(k);
+        }
+    }
+    for (int b = bands; b > 0; --b) bandStart_[b] = bandStart_[b - 1];
+    bandStart_[0] = 0;
+
+    // sveip per bånd: kandidatene til i er de som starter før i slutter. Et par som
+    // deler flere bånd rapporteres bare i båndet der den høyeste min.z ligger.
+    for (int band = 0; band < bands; ++band) {
+        const std::uint32_t begin = bandStart_[band], end = bandStart_[band + 1];
+        for (std::uint32_t e = begin; e < end; ++e) {
+            const std::uint32_t i = bandEntries_[e];
+            const float maxX = maxX_[i], minZ = minZ_[i], maxZ = maxZ_[i];
+            for (std::uint32_t f = e + 1; f < end; ++f) {
+                const std::uint32_t j = bandEntries_[f];
+                if (minX_[j] > maxX) break;
+                if (minZ_[j] <= maxZ && maxZ_[j] >= minZ && bandOf(std::max(minZ, minZ_[j])) == band) {
+                    std::uint32_t a = order_[i], b = order_[j];
+                    pairs_.push_back(a < b ? BodyPair{a, b} : BodyPair{b, a});
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,33 @@
+// --------------------------------------------------------------------------------------
+// Cone meshes for positions produced by scatterTrafficCones.
+// Object creation and rendering follow standard threepp API usage.
+// --------------------------------------------------------------------------------------
+
+#include "world/TrafficConesVisual.h"
+
+using namespace threepp;
+
+ConeAssets makeConeAssets() {
+    ConeAssets assets;
+    assets.material = MeshPhongMaterial::create();
+    assets.material->color = Color(0xff8800);
+    assets.geometry = ConeGeometry::create(0.4f, 1.0f, 12);
+    return assets;
+}
+
+void addTrafficCones(Scene& scene,
+                     const std::vector<Vec2>& cones,
+                     std::vector<std::shared_ptr<Mesh>>& outCones) {
+
+    auto assets = makeConeAssets();
+
+    outCones.clear();
+    outCones.reserve(cones.size());
+
+    for (const auto& p : cones) {
+        auto cone = Mesh::create(assets.geometry, assets.material);
+        cone->position.set(p.x, 0.5f, p.z);
+        scene.add(cone);
+        outCones.push_back(cone);
+    }
+}
@@ -0,0 +1,242 @@
+// --------------------------------------------------------------------------------------
+// Trigger volumes for gameplay events, indexed in a uniform grid (each volume binned
+// into every cell its reach-expanded bounds cover, counting-sorted into contiguous
+// per-cell lists as in ConeGrid). Enter/stay/exit comes from diffing each body's
+// sorted contact list against the previous one.
+// --------------------------------------------------------------------------------------
+
+#include "world/TriggerRegistry.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+Vec2 toLocal(const Obb& b, Vec2 p) {
+    Vec2 q = p - b.center;
+    return {dot(q, b.right()), dot(q, b.axis)};
+}
+
+// halve utstrekninger av boksen b langs aksene til v
+Vec2 extentsIn(const Obb& b, const Obb& v) {
+    return {std::abs(dot(b.right(), v.right())) * b.halfW + std::abs(dot(b.axis, v.right())) * b.halfD,
+            std::abs(dot(b.right(), v.axis)) * b.halfW + std::abs(dot(b.axis, v.axis)) * b.halfD};
+}
+
+// volumets AABB (halve utstrekninger)
+Vec2 boundsOf(const TriggerVolume& v) {
+    if (v.shape == TriggerShape::Circle) return {v.box.halfW, v.box.halfW};
+    return obbExtents(v.box);
+}
+
+bool centerInside(const TriggerVolume& v, Vec2 p) {
+    if (v.shape == TriggerShape::Circle) return lengthSq(p - v.box.center) < v.box.halfW * v.box.halfW;
+    Vec2 q = toLocal(v.box, p);
+    return std::abs(q.x) <= v.box.halfW && std::abs(q.z) <= v.box.halfD;
+}
+
+bool containsBox(const TriggerVolume& v, const Obb& body) {
+    const Obb core{body.center, body.axis, body.halfW * v.fit, body.halfD * v.fit};
+    switch (v.shape) {
+        case TriggerShape::Aabb: {
+            const Vec2 half{v.box.halfW, v.box.halfD};
+            return insideRect(core, v.box.center - half, v.box.center + half);
+        }
+        case TriggerShape::Obb: {
+            const Vec2 q = toLocal(v.box, core.center);
+            const Vec2 e = extentsIn(core, v.box);
+            return std::abs(q.x) + e.x <= v.box.halfW && std::abs(q.z) + e.z <= v.box.halfD;
+        }
+        case TriggerShape::Circle: {
+            // det fjerneste hjørnet avgjør
+            const float r2 = v.box.halfW * v.box.halfW;
+            const Vec2 w = core.right() * core.halfW, d = core.axis * core.halfD;
+            for (Vec2 corner : {w + d, w - d, d - w, Vec2{} - w - d}) {
+                if (lengthSq(core.center + corner - v.box.center) >= r2) return false;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+TriggerVolume makeAabbTrigger(TriggerKind kind, TriggerTest test, Vec2 center, Vec2 half, int ref) {
+    TriggerVolume v;
+    v.shape = TriggerShape::Aabb;
+    v.test = test;
+    v.kind = kind;
+    v.box = {center, {0.f, 1.f}, half.x, half.z};
+    v.ref = ref;
+    return v;
+}
+
+TriggerVolume makeCircleTrigger(TriggerKind kind, TriggerTest test, Vec2 center, float radius, int ref) {
+    TriggerVolume v;
+    v.shape = TriggerShape::Circle;
+    v.test = test;
+    v.kind = kind;
+    v.box = {center, {0.f, 1.f}, radius, radius};
+    v.ref = ref;
+    return v;
+}
+
+TriggerVolume makeObbTrigger(TriggerKind kind, TriggerTest test, const Obb& box, int ref) {
+    TriggerVolume v;
+    v.shape = TriggerShape::Obb;
+    v.test = test;
+    v.kind = kind;
+    v.box = box;
+    v.ref = ref;
+    return v;
+}
+
+bool TriggerContacts::contains(std::uint32_t id) const {
+    for (int i = 0; i < count; ++i) {
+        if (ids[i] == id) return true;
+    }
+    return false;
+}
+
+// ---------------- bygging ----------------
+
+std::uint32_t TriggerRegistry::add(const TriggerVolume& v) {
+    volumes_.push_back(v);
+    return static_cast<std::uint32_t>(volumes_.size() - 1);
+}
+
+void TriggerRegistry::clear() {
+    volumes_.clear();
+    cellStart_.clear();
+    cellIds_.clear();
+    cols_ = rows_ = 0;
+}
+
+void TriggerRegistry::build(float bodyReach, float cellSize) {
+    if (configureGrid(bodyReach, cellSize)) fillCells(bodyReach);
+}
+
+void TriggerRegistry::build(float bodyReach, float cellSize,
+                            std::span<const std::uint32_t> cellStart,
+                            std::span<const std::uint32_t> cellIds) {
+    if (!configureGrid(bodyReach, cellSize)) return;
+
+    // cellene må passe til rutenettet og volumene, ellers fordeler vi selv
+    bool fits = cellStart.size() == cellStart_.size() && cellStart.front() == 0 &&
+                cellStart.back() == cellIds.size();
+    for (std::size_t c = 1; fits && c < cellStart.size(); ++c) fits = cellStart[c - 1] <= cellStart[c];
+    for (std::size_t i = 0; fits && i < cellIds.size(); ++i) fits = cellIds[i] < volumes_.size();
+    if (!fits) {
+        fillCells(bodyReach);
+        return;
+    }
+    cellStart_.assign(cellStart.begin(), cellStart.end());
+    cellIds_.assign(cellIds.begin(), cellIds.end());
+}
+
+bool TriggerRegistry::configureGrid(float bodyReach, float cellSize) {
+    cellStart_.clear();
+    cellIds_.clear();
+    cols_ = rows_ = 0;
+    if (volumes_.empty()) return false;
+
+    // rutenettet dekker alle volumene, utvidet med rekkevidden
+    Vec2 lo{1e30f, 1e30f}, hi{-1e30f, -1e30f};
+    for (const auto& v : volumes_) {
+        const Vec2 e = boundsOf(v) + Vec2{bodyReach, bodyReach};
+        lo = {std::min(lo.x, v.box.center.x - e.x), std::min(lo.z, v.box.center.z - e.z)};
+        hi = {std::max(hi.x, v.box.center.x + e.x), std::max(hi.z, v.box.center.z + e.z)};
+    }
+    origin_ = lo;
+    cellSize_ = cellSize;
+    bodyReach_ = bodyReach;
+    invCell_ = 1.f / cellSize;
+    cols_ = std::max(1, static_cast<int>(std::ceil((hi.x - lo.x) * invCell_)));
+    rows_ = std::max(1, static_cast<int>(std::ceil((hi.z - lo.z) * invCell_)));
+    cellStart_.assign(static_cast<std::size_t>(cols_) * rows_ + 1, 0u);
+    return true;
+}
+
+void TriggerRegistry::fillCells(float bodyReach) {
+    auto cellRange = [&](const TriggerVolume& v, int& c0, int& c1, int& r0, int& r1) {
+        const Vec2 e = boundsOf(v) + Vec2{bodyReach, bodyReach};
+        auto clampCell = [](float t, int n) { return std::clamp(static_cast<int>(std::floor(t)), 0, n - 1); };
+        c0 = clampCell((v.box.center.x - e.x - origin_.x) * invCell_, cols_);
+        c1 = clampCell((v.box.center.x + e.x - origin_.x) * invCell_, cols_);
+        r0 = clampCell((v.box.center.z - e.z - origin_.z) * invCell_, rows_);
+        r1 = clampCell((v.box.center.z + e.z - origin_.z) * invCell_, rows_);
+    };
+
+    // tell (forskjøvet én), prefikssum, spre ut i id-rekkefølge så hver celle er sortert
+    int c0, c1, r0, r1;
+    for (const auto& v : volumes_) {
+        cellRange(v, c0, c1, r0, r1);
+        for (int r = r0; r <= r1; ++r)
+            for (int c = c0; c <= c1; ++c) ++cellStart_[static_cast<std::size_t>(r) * cols_ + c + 1];
+    }
+    for (std::size_t c = 1; c < cellStart_.size(); ++c) cellStart_[c] += cellStart_[c - 1];
+
+    cellIds_.resize(cellStart_.back());
+    std::vector<std::uint32_t> write(cellStart_.begin(), cellStart_.end() - 1);
+    for (std::uint32_t id = 0; id < volumes_.size(); ++id) {
+        cellRange(volumes_[id], c0, c1, r0, r1);
+        for (int r = r0; r <= r1; ++r)
+            for (int c = c0; c <= c1; ++c) cellIds_[write[static_cast<std::size_t>(r) * cols_ + c]++] = id;
+    }
+}
+
+// ---------------- oppslag ----------------
+
+std::span<const std::uint32_t> TriggerRegistry::candidates(Vec2 p) const {
+    if (cellStart_.empty()) return {};
+    const float fx = std::floor((p.x - origin_.x) * invCell_);
+    const float fz = std::floor((p.z - origin_.z) * invCell_);
+    // utenfor rutenettet er ingen volumer innen rekkevidde
+    if (!(fx >= 0.f && fz >= 0.f && fx < static_cast<float>(cols_) && fz < static_cast<float>(rows_))) return {};
+
+    const std::size_t cell = static_cast<std::size_t>(fz) * cols_ + static_cast<std::size_t>(fx);
+    return {cellIds_.data() + cellStart_[cell], cellStart_[cell + 1] - cellStart_[cell]};
+}
+
+bool TriggerRegistry::touches(std::uint32_t id, const Obb& body) const {
+    const TriggerVolume& v = volumes_[id];
+    switch (v.test) {
+        case TriggerTest::Center: return centerInside(v, body.center);
+        case TriggerTest::Overlap:
+            return v.shape == TriggerShape::Circle ? overlapsCircle(body, v.box.center, v.box.halfW)
+                                                   : overlaps(body, v.box);
+        case TriggerTest::Contain: return containsBox(v, body);
+    }
+    return false;
+}
+
+void TriggerRegistry::update(std::uint32_t body, const Obb& box, TriggerContacts& contacts,
+                             std::vector<TriggerEvent>& out) const {
+    // nye kontakter; kandidatene er sortert på id, så lista blir det også
+    TriggerContacts now;
+    for (std::uint32_t id : candidates(box.center)) {
+        if (now.count < TriggerContacts::capacity && touches(id, box)) now.ids[now.count++] = id;
+    }
+
+    // fletting av to sorterte lister
+    int i = 0, j = 0;
+    while (i < contacts.count || j < now.count) {
+        if (j == now.count || (i < contacts.count && contacts.ids[i] < now.ids[j])) {
+            out.push_back({body, contacts.ids[i++], TriggerPhase::Exit});
+        } else if (i == contacts.count || now.ids[j] < contacts.ids[i]) {
+            out.push_back({body, now.ids[j++], TriggerPhase::Enter});
+        } else {
+            out.push_back({body, now.ids[j++], TriggerPhase::Stay});
+            ++i;
+        }
+    }
+    contacts = now;
+}
+
+void TriggerRegistry::update(std::uint32_t firstBody, std::span<const Obb> boxes,
+                             std::span<TriggerContacts> contacts, std::vector<TriggerEvent>& out) const {
+    for (std::size_t k = 0; k < boxes.size(); ++k) {
+        update(firstBody + static_cast<std::uint32_t>(k), boxes[k], contacts[k], out);
+    }
+}
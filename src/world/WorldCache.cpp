@@ -0,0 +1,302 @@
+// --------------------------------------------------------------------------------------
+// Baked world cache: one flat, versioned file with everything generated or binned at
+// startup (spots, cones, target sequence, trigger cells, chunk buckets, far-LOD line
+// vertices, poses and the RNG state), memory-mapped on the next launch. The simulation
+// copies the arrays into its own buffers; only the line vertices are used in place.
+// --------------------------------------------------------------------------------------
+
+#include "world/WorldCache.h"
+
+#include "logic/Simulation.h"
+#include "world/LotChunks.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+const char magic[4] = {'B', 'S', 'W', 'C'};
+const std::uint16_t version = 3;
+
+enum Section : int {
+    SecSpots,
+    SecCones,
+    SecTargets,
+    SecTriggerStart,
+    SecTriggerIds,
+    SecChunkStart,
+    SecChunkSpots,
+    SecLines,
+    SecCount
+};
+
+// fast layout, skrives og leses med memcpy (vi antar little-endian som i replay-formatet)
+struct Header {
+    char          magic[4];
+    std::uint16_t version;
+    std::uint16_t headerSize;
+
+    std::int32_t  rows, cols;
+    float         slotW, slotD, laneWidth, margin;
+    std::uint64_t seed;
+    std::int32_t  coneCount;
+    float         chunkSize;
+    std::int32_t  requiredTargets;
+    float         triggerReach, triggerCellSize;
+    std::int32_t  reserved;
+
+    float lotCenterX, lotCenterZ, lotWidth, lotDepth;
+    float doorX, doorZ, doorHalfW;
+    float keyX, keyZ;
+    float startX, startZ, startYaw;
+
+    std::uint8_t rng[16];
+
+    std::uint64_t offset[SecCount];
+    std::uint64_t count[SecCount];
+};
+
+static_assert(std::is_trivially_copyable_v<Header>);
+static_assert(sizeof(Header) == 256, "header layout changed; bump the version");
+static_assert(std::is_trivially_copyable_v<Rng> && sizeof(Rng) == 16);
+static_assert(sizeof(Vec2) == 8 && sizeof(BakedSpot) == 16);
+
+bool sameKey(const Header& h, const WorldKey& k) {
+    return h.rows == k.layout.rows && h.cols == k.layout.cols &&
+           h.slotW == k.layout.slotW && h.slotD == k.layout.slotD &&
+           h.laneWidth == k.layout.laneWidth && h.margin == k.layout.margin &&
+           h.seed == k.seed && h.coneCount == k.coneCount && h.chunkSize == k.chunkSize &&
+           h.requiredTargets == k.requiredTargets;
+}
+
+const std::size_t elemSize[SecCount] = {sizeof(BakedSpot), sizeof(Vec2), sizeof(std::int32_t),
+                                        sizeof(std::uint32_t), sizeof(std::uint32_t),
+                                        sizeof(std::uint32_t), sizeof(std::uint32_t), sizeof(float)};
+
+std::uint64_t align16(std::uint64_t v) {
+    return (v + 15u) & ~std::uint64_t{15u};
+}
+
+// mappet minne er 4 KB-justert og seksjonene 16-byte-justert, så elementene kan
+// leses der de ligger
+template <class T>
+std::span<const T> sectionView(const std::byte* base, const Header& h, Section s) {
+    return {reinterpret_cast<const T*>(base + h.offset[s]), static_cast<std::size_t>(h.count[s])};
+}
+
+}
+
+std::uint64_t worldKeyHash(const WorldKey& key) {
+    // FNV-1a over feltene (ikke over struct-bytes, som kan ha padding)
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    auto mix = [&](const void* p, std::size_t n) {
+        const auto* b = static_cast<const unsigned char*>(p);
+        for (std::size_t i = 0; i < n; ++i) {
+            h ^= b[i];
+            h *= 0x100000001b3ull;
+        }
+    };
+    mix(&version, sizeof(version));
+    mix(&key.layout.rows, sizeof(int));
+    mix(&key.layout.cols, sizeof(int));
+    mix(&key.layout.slotW, sizeof(float));
+    mix(&key.layout.slotD, sizeof(float));
+    mix(&key.layout.laneWidth, sizeof(float));
+    mix(&key.layout.margin, sizeof(float));
+    mix(&key.seed, sizeof(key.seed));
+    mix(&key.coneCount, sizeof(int));
+    mix(&key.chunkSize, sizeof(float));
+    mix(&key.requiredTargets, sizeof(int));
+    return h;
+}
+
+std::string worldCachePath(const std::string& dir, const WorldKey& key) {
+    char name[40];
+    std::snprintf(name, sizeof(name), "world_%016llx.bswc",
+                  static_cast<unsigned long long>(worldKeyHash(key)));
+    if (dir.empty()) return name;
+    char last = dir.back();
+    return (last == '/' || last == '\\') ? dir + name : dir + "/" + name;
+}
+
+bool bakeWorld(const std::string& path, const Simulation& sim, float chunkSize) {
+    const auto& lot = sim.lot();
+
+    LotChunks chunks;
+    chunks.configure(lot, chunkSize);
+
+    std::vector<BakedSpot> spots;
+    spots.reserve(lot.spots.size());
+    for (const auto& s : lot.spots) spots.push_back({s.center.x, s.center.z, s.halfW, s.halfD});
+
+    std::vector<std::int32_t> targets(sim.targetSequence().begin(), sim.targetSequence().end());
+    const auto& triggers = sim.triggers();
+
+    std::vector<std::uint32_t> chunkStart, chunkSpots;
+    chunkStart.reserve(static_cast<std::size_t>(chunks.count()) + 1);
+    chunkStart.push_back(0);
+    for (int c = 0; c < chunks.count(); ++c) {
+        auto ids = chunks.spotsIn(c);
+        chunkSpots.insert(chunkSpots.end(), ids.begin(), ids.end());
+        chunkStart.push_back(static_cast<std::uint32_t>(chunkSpots.size()));
+    }
+
+    // samme tre streker per plass som ChunkedLotVisual bygger for fjerne chunks
+    const float h = 0.01f;
+    std::vector<float> lines;
+    lines.reserve(chunkSpots.size() * 18);
+    for (auto i : chunkSpots) {
+        const auto& s = lot.spots[i];
+        float l = s.center.x - s.halfW, r = s.center.x + s.halfW;
+        float b = s.center.z - s.halfD, f = s.center.z + s.halfD;
+        lines.insert(lines.end(), {l, h, b, l, h, f,
+                                   r, h, b, r, h, f,
+                                   l, h, f, r, h, f});
+    }
+
+    Header hd{};
+    std::memcpy(hd.magic, magic, 4);
+    hd.version = version;
+    hd.headerSize = sizeof(Header);
+    hd.rows = lot.layout.rows;
+    hd.cols = lot.layout.cols;
+    hd.slotW = lot.layout.slotW;
+    hd.slotD = lot.layout.slotD;
+    hd.laneWidth = lot.layout.laneWidth;
+    hd.margin = lot.layout.margin;
+    hd.seed = sim.seed();
+    hd.coneCount = sim.coneCount();
+    hd.chunkSize = chunkSize;
+    hd.requiredTargets = sim.requiredTargets();
+    hd.triggerReach = triggers.bodyReach();
+    hd.triggerCellSize = triggers.cellSize();
+    hd.lotCenterX = lot.center.x;
+    hd.lotCenterZ = lot.center.z;
+    hd.lotWidth = lot.width;
+    hd.lotDepth = lot.depth;
+    hd.doorX = sim.doorPos().x;
+    hd.doorZ = sim.doorPos().z;
+    hd.doorHalfW = sim.doorHalfW();
+    hd.keyX = sim.keyPos().x;
+    hd.keyZ = sim.keyPos().z;
+    hd.startX = sim.startPos().x;
+    hd.startZ = sim.startPos().z;
+    hd.startYaw = sim.startYaw();
+    std::memcpy(hd.rng, &sim.rng(), sizeof(hd.rng));
+
+    const void* data[SecCount] = {spots.data(), sim.cones().data(), targets.data(),
+                                  triggers.cellStarts().data(), triggers.cellIds().data(),
+                                  chunkStart.data(), chunkSpots.data(), lines.data()};
+    const std::size_t counts[SecCount] = {spots.size(), sim.cones().size(), targets.size(),
+                                          triggers.cellStarts().size(), triggers.cellIds().size(),
+                                          chunkStart.size(), chunkSpots.size(), lines.size()};
+
+    std::uint64_t offset = align16(sizeof(Header));
+    for (int s = 0; s < SecCount; ++s) {
+        hd.offset[s] = offset;
+        hd.count[s] = counts[s];
+        offset = align16(offset + counts[s] * elemSize[s]);
+    }
+
+    // skriv til en midlertidig fil og gi den riktig navn til slutt, så en
+    // avbrutt baking aldri etterlater en halv fil som ser gyldig ut
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+
+        const char zeros[16] = {};
+        out.write(reinterpret_cast<const char*>(&hd), sizeof(hd));
+        std::uint64_t pos = sizeof(hd);
+        for (int s = 0; s < SecCount; ++s) {
+            out.write(zeros, static_cast<std::streamsize>(hd.offset[s] - pos));
+            std::size_t bytes = counts[s] * elemSize[s];
+            out.write(static_cast<const char*>(data[s]), static_cast<std::streamsize>(bytes));
+            pos = hd.offset[s] + bytes;
+        }
+        out.write(zeros, static_cast<std::streamsize>(offset - pos));
+        if (!out) return false;
+    }
+
+    std::remove(path.c_str());
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool WorldCache::open(const std::string& path, const WorldKey& key) {
+    world_ = BakedWorld();
+    if (!file_.open(path)) return false;
+
+    auto fail = [this] {
+        file_.close();
+        world_ = BakedWorld();
+        return false;
+    };
+
+    if (file_.size() < sizeof(Header)) return fail();
+    Header h;
+    std::memcpy(&h, file_.data(), sizeof(h));
+    if (std::memcmp(h.magic, magic, 4) != 0 || h.version != version || h.headerSize != sizeof(Header)) {
+        return fail();
+    }
+    if (!sameKey(h, key)) return fail();
+
+    for (int s = 0; s < SecCount; ++s) {
+        if (h.offset[s] % 16 != 0 || h.offset[s] > file_.size() ||
+            h.count[s] > (file_.size() - h.offset[s]) / elemSize[s]) {
+            return fail();
+        }
+    }
+
+    const std::byte* base = file_.data();
+    world_.key = key;
+    world_.lotCenter = {h.lotCenterX, h.lotCenterZ};
+    world_.lotWidth = h.lotWidth;
+    world_.lotDepth = h.lotDepth;
+    world_.doorPos = {h.doorX, h.doorZ};
+    world_.doorHalfW = h.doorHalfW;
+    world_.keyPos = {h.keyX, h.keyZ};
+    world_.startPos = {h.startX, h.startZ};
+    world_.startYaw = h.startYaw;
+    std::memcpy(&world_.rng, h.rng, sizeof(h.rng));
+
+    world_.spots = sectionView<BakedSpot>(base, h, SecSpots);
+    world_.cones = sectionView<Vec2>(base, h, SecCones);
+    world_.targets = sectionView<std::int32_t>(base, h, SecTargets);
+    world_.triggerReach = h.triggerReach;
+    world_.triggerCellSize = h.triggerCellSize;
+    world_.triggerStart = sectionView<std::uint32_t>(base, h, SecTriggerStart);
+    world_.triggerIds = sectionView<std::uint32_t>(base, h, SecTriggerIds);
+    world_.chunkStart = sectionView<std::uint32_t>(base, h, SecChunkStart);
+    world_.chunkSpots = sectionView<std::uint32_t>(base, h, SecChunkSpots);
+    world_.lineVertices = sectionView<float>(base, h, SecLines);
+
+    // like mange plasser og kjegler som generering gir for nøkkelen
+    const std::size_t rows = static_cast<std::size_t>(std::max(key.layout.rows, 0));
+    const std::size_t cols = static_cast<std::size_t>(std::max(key.layout.cols, 0));
+    if (world_.spots.size() != rows * cols ||
+        world_.cones.size() != static_cast<std::size_t>(std::max(key.coneCount, 0))) {
+        return fail();
+    }
+
+    // sammenheng mellom seksjonene, så en ødelagt fil ikke gir lesing utenfor
+    // (triggercellene sjekker TriggerRegistry::build selv)
+    if (world_.chunkStart.empty() || world_.chunkStart.back() != world_.chunkSpots.size() ||
+        world_.chunkSpots.size() != world_.spots.size() ||
+        world_.lineVertices.size() != world_.chunkSpots.size() * 18) {
+        return fail();
+    }
+    for (std::size_t c = 0; c + 1 < world_.chunkStart.size(); ++c) {
+        if (world_.chunkStart[c] > world_.chunkStart[c + 1]) return fail();
+    }
+    for (auto i : world_.chunkSpots) {
+        if (i >= world_.spots.size()) return fail();
+    }
+    for (auto t : world_.targets) {
+        if (t < 0 || static_cast<std::size_t>(t) >= world_.spots.size()) return fail();
+    }
+    return true;
+}
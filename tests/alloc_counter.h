@@ -0,0 +1,8 @@
+// tests/alloc_counter.h
+#pragma once
+
+#include <cstddef>
+
+// Antall heap-allokeringer i hele testprogrammet så langt (alloc_counter.cpp
+// erstatter global operator new). Testene ser bare på differansen.
+std::size_t allocationCount();
@@ -0,0 +1,175 @@
+// tests/test_autopilot.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "sim/Autopilot.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+TEST_CASE("Motion primitives follow the car kinematics") {
+    auto tables = plannerTablesFor(LotLayout{}, CarPhysicsParams{});
+
+    for (const auto& m : tables->primitives) {
+        // kjør bilen med samme ratt i planleggingsfarten og sammenlign sluttposen
+        Car car;
+        car.hardReset({0.f, 0.f}, 0.f);
+        float v = m.dir > 0.f ? 6.f : -2.f;
+        float dt = 1.f / 240.f;
+        float travelled = 0.f;
+        while (travelled < m.length) {
+            float steerScale = std::clamp(10.f / (std::abs(v) + 5.f), 0.4f, 1.2f);
+            float h = car.heading() + m.steer * CarPhysicsParams{}.steerRate * steerScale * dt;
+            car.setHeading(h);
+            car.setPosition(car.position() + Vec2{std::sin(h), std::cos(h)} * (v * dt));
+            travelled += std::abs(v) * dt;
+        }
+
+        const Vec2 end = m.pos[MotionPrimitive::samples - 1];
+        REQUIRE(std::abs(end.x - car.position().x) < 0.05f);
+        REQUIRE(std::abs(end.z - car.position().z) < 0.05f);
+        REQUIRE(std::abs(m.dHeading[MotionPrimitive::samples - 1] - car.heading()) < 0.02f);
+        REQUIRE((end.z > 0.f) == (m.dir > 0.f));
+    }
+}
+
+TEST_CASE("Planner tables are built once per layout and car") {
+    auto a = plannerTablesFor(LotLayout{}, CarPhysicsParams{});
+    auto b = plannerTablesFor(LotLayout{}, CarPhysicsParams{});
+    REQUIRE(a.get() == b.get());
+
+    CarPhysicsParams other;
+    other.steerRate = 2.f;
+    REQUIRE(plannerTablesFor(LotLayout{}, other).get() != a.get());
+
+    // rett fram er billigere enn sidelengs, og origo koster ingenting
+    REQUIRE(a->reachCostAt({0.f, 0.f}) == 0.f);
+    REQUIRE(a->reachCostAt({0.f, 8.f}) < a->reachCostAt({8.f, 0.f}));
+    REQUIRE(a->reachCostAt({100.f, 0.f}) < 0.f);
+}
+
+TEST_CASE("GoalField holds grid distances to the goal and can be rebuilt") {
+    Scenario sc;
+    sc.coneCount = 0;
+    Simulation empty(5, sc);
+    auto tables = plannerTablesFor(empty.lot().layout, CarPhysicsParams{});
+
+    PlanGoal goal;
+    goal.center = empty.lot().center;
+    goal.half = {1.f, 1.f};
+    GoalField field;
+    field.build(*tables, empty, goal);
+
+    // 1 m rett fram, 1.4 m på skrå; avrundes til cellene (1 m)
+    REQUIRE(field.at(goal.center) == 0.f);
+    REQUIRE(std::abs(field.at(goal.center + Vec2{0.f, -12.f}) - 11.f) < 1.5f);
+    REQUIRE(std::abs(field.at(goal.center + Vec2{-9.f, -9.f}) - 8.f * 1.4f) < 1.5f);
+
+    // samme felt om det bygges på nytt over et gammelt, med kjegler og annet mål
+    Simulation sim(1000);
+    PlanGoal spot;
+    REQUIRE(nextPlanGoal(sim, spot));
+    field.build(*tables, sim, spot);
+    GoalField fresh;
+    fresh.build(*tables, sim, spot);
+    for (float z = -40.f; z <= 40.f; z += 0.7f) {
+        for (float x = -30.f; x <= 30.f; x += 0.7f) {
+            const Vec2 p = sim.lot().center + Vec2{x, z};
+            REQUIRE(field.at(p) == fresh.at(p));
+        }
+    }
+}
+
+TEST_CASE("Planned path is collision free and ends in the goal") {
+    Simulation sim(1000);
+    sim.step(1.f / 60.f, {}); // kantene flytter bilen inn på plassen
+
+    PlanGoal goal;
+    REQUIRE(nextPlanGoal(sim, goal));
+    REQUIRE(goal.kind == PlanGoalKind::Spot);
+
+    auto tables = plannerTablesFor(sim.lot().layout, CarPhysicsParams{});
+    ParkingPlanner planner(tables);
+    GoalField field;
+    field.build(*tables, sim, goal);
+
+    std::vector<PathPoint> path;
+    PlanStats stats = planner.plan(sim, goal, field, path);
+    REQUIRE(stats.found);
+    REQUIRE(path.size() > 1);
+    REQUIRE(goal.contains(path.back().pos));
+
+    for (const auto& p : path) {
+        Obb box = makeCarObb(p.pos, p.heading, sim.carHalfW(), sim.carHalfD());
+        REQUIRE(sim.coneGrid().firstOverlapping(box, Simulation::coneRadius) < 0);
+    }
+}
+
+TEST_CASE("Planner leaves a start pose inside the cone clearance") {
+    Simulation sim(1000);
+    sim.step(1.f / 60.f, {});
+
+    PlanGoal goal;
+    REQUIRE(nextPlanGoal(sim, goal));
+    auto tables = plannerTablesFor(sim.lot().layout, CarPhysicsParams{});
+    ParkingPlanner planner(tables);
+
+    // én kjegle 5 cm fra siden av bilen, slik bilen blir stående etter en pivot: ingen
+    // kollisjon, men innenfor klaringen langs hele første primitiv uansett retning.
+    // Snapshotet får en egen verden, så restore tar med de nye kjeglene
+    SimSnapshot snap;
+    sim.snapshot(snap);
+    const Vec2 pos{sim.lot().center.x + 3.f, sim.lot().center.z - sim.lot().depth * 0.5f + 8.f};
+    snap.episode.car.hardReset(pos, 0.f);
+    snap.cones = {pos + Vec2{sim.carHalfW() + Simulation::coneRadius + 0.05f, 0.f}};
+    snap.world = std::numeric_limits<std::uint64_t>::max();
+    REQUIRE(sim.restore(snap));
+    REQUIRE(sim.coneGrid().firstOverlapping(sim.carBox(), Simulation::coneRadius) < 0);
+
+    GoalField field;
+    field.build(*tables, sim, goal);
+    std::vector<PathPoint> path;
+    PlanStats stats = planner.plan(sim, goal, field, path);
+    REQUIRE(stats.found);
+    REQUIRE(goal.contains(path.back().pos));
+    for (const auto& p : path) {
+        Obb box = makeCarObb(p.pos, p.heading, sim.carHalfW(), sim.carHalfD());
+        REQUIRE(sim.coneGrid().firstOverlapping(box, Simulation::coneRadius) < 0);
+    }
+}
+
+TEST_CASE("Planner out of budget returns the path towards the goal so far") {
+    Simulation sim(1000);
+    sim.step(1.f / 60.f, {});
+
+    PlanGoal goal;
+    REQUIRE(nextPlanGoal(sim, goal));
+    auto tables = plannerTablesFor(sim.lot().layout, CarPhysicsParams{});
+    ParkingPlanner planner(tables);
+    GoalField field;
+    field.build(*tables, sim, goal);
+
+    planner.maxExpansions = 5;
+    std::vector<PathPoint> path;
+    PlanStats stats = planner.plan(sim, goal, field, path);
+    REQUIRE_FALSE(stats.found);
+    REQUIRE(stats.limitHit);
+    REQUIRE(stats.partial);
+    REQUIRE(path.size() > 1);
+    REQUIRE(field.at(path.back().pos) < field.at(path.front().pos));
+}
+
+TEST_CASE("Autopilot wins whole episodes") {
+    auto tables = plannerTablesFor(LotLayout{}, CarPhysicsParams{});
+    ParkingPlanner planner(tables);
+
+    for (std::uint64_t seed : {1000u, 1001u, 1003u}) {
+        Simulation sim(seed);
+        Autopilot pilot;
+        const float dt = 1.f / 60.f;
+        for (int i = 0; i < 150 * 60 && sim.state() != GameState::Won; ++i) {
+            sim.step(dt, pilot.drive(sim, planner, dt));
+        }
+        REQUIRE(sim.state() == GameState::Won);
+        REQUIRE(pilot.plans() >= 5); // tre plasser, nøkkel og dør
+    }
+}
@@ -2,11 +2,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include "models/Car.h"
 
-using namespace threepp;
-
 TEST_CASE("Car accelerates forward when throttle is positive") {
-    auto node = Object3D::create();
-    Car car(node, CarPhysicsParams{
+    Car car(CarPhysicsParams{
         20.f,  // maxSpeed
         10.f,  // accel
         40.f,  // brake
@@ -27,8 +24,7 @@ TEST_CASE("Car accelerates forward when throttle is positive") {
 }
 
 TEST_CASE("Car slows down due to friction when no throttle") {
-    auto node = Object3D::create();
-    Car car(node);
+    Car car;
 
     CarInput in;
     in.throttle = 1.f;
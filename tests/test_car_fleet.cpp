@@ -0,0 +1,81 @@
+// tests/test_car_fleet.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "sim/CarFleet.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<CarInput> randomInputs(std::mt19937& gen, std::size_t n) {
+    std::uniform_int_distribution<int> pick(-1, 1);
+    std::uniform_int_distribution<int> coin(0, 3);
+
+    std::vector<CarInput> inputs(n);
+    for (auto& in : inputs) {
+        in.throttle = static_cast<float>(pick(gen));
+        in.steer = static_cast<float>(pick(gen));
+        in.handbrake = coin(gen) == 0;
+    }
+    return inputs;
+}
+
+}
+
+TEST_CASE("CarFleet matches per-object Car::update") {
+    const std::size_t n = 37; // ikke delelig med SIMD-bredden, så halen testes også
+    const float dt = 1.f / 60.f;
+
+    CarPhysicsParams fast;
+    fast.maxSpeed = 30.f;
+    fast.steerRate = 1.8f;
+
+    std::vector<Car> cars;
+    CarFleet fleet;
+    for (std::size_t i = 0; i < n; ++i) {
+        CarPhysicsParams p = (i % 2) ? fast : CarPhysicsParams{};
+        Vec2 pos{static_cast<float>(i), -static_cast<float>(i)};
+        float yaw = 0.1f * static_cast<float>(i);
+
+        cars.emplace_back(p);
+        cars.back().hardReset(pos, yaw);
+        fleet.add(p, pos, yaw);
+    }
+
+    std::mt19937 gen(1234);
+    for (int step = 0; step < 600; ++step) {
+        auto inputs = randomInputs(gen, n);
+        for (std::size_t i = 0; i < n; ++i) cars[i].update(dt, inputs[i]);
+        fleet.update(dt, inputs);
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        REQUIRE(std::abs(fleet.speed(i) - cars[i].speed()) < 1e-3f);
+        REQUIRE(std::abs(fleet.heading(i) - cars[i].heading()) < 1e-3f);
+        REQUIRE(std::abs(fleet.position(i).x - cars[i].position().x) < 1e-2f);
+        REQUIRE(std::abs(fleet.position(i).z - cars[i].position().z) < 1e-2f);
+    }
+}
+
+TEST_CASE("CarFleet SIMD and scalar paths agree") {
+    const std::size_t n = 64;
+    CarFleet simd, scalar;
+    for (std::size_t i = 0; i < n; ++i) {
+        simd.add({}, {}, 0.05f * static_cast<float>(i));
+        scalar.add({}, {}, 0.05f * static_cast<float>(i));
+    }
+
+    std::mt19937 gen(99);
+    for (int step = 0; step < 300; ++step) {
+        auto inputs = randomInputs(gen, n);
+        simd.update(0.02f, inputs);
+        scalar.updateScalar(0.02f, inputs);
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        REQUIRE(std::abs(simd.position(i).x - scalar.position(i).x) < 1e-4f);
+        REQUIRE(std::abs(simd.position(i).z - scalar.position(i).z) < 1e-4f);
+        REQUIRE(std::abs(simd.speed(i) - scalar.speed(i)) < 1e-5f);
+    }
+}
@@ -0,0 +1,182 @@
+// tests/test_car_gym.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "sim/GymPool.h"
+#include "sim/car_gym.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+car_gym_config smallConfig(uint32_t episodes, uint32_t threads) {
+    car_gym_config cfg;
+    car_gym_default_config(&cfg);
+    cfg.episodes = episodes;
+    cfg.threads = threads;
+    cfg.seed = 99;
+    return cfg;
+}
+
+// litt ulik handling per episode og steg
+void fillActions(std::vector<float>& a, int step) {
+    for (std::size_t i = 0; i < a.size() / CAR_GYM_ACTION_SIZE; ++i) {
+        a[i * 3 + 0] = (i + step / 40) % 3 == 0 ? -0.5f : 1.f;
+        a[i * 3 + 1] = std::sin(0.05f * static_cast<float>(step) + static_cast<float>(i));
+        a[i * 3 + 2] = 0.f;
+    }
+}
+
+}
+
+TEST_CASE("car_gym writes one observation row per episode") {
+    car_gym_config cfg = smallConfig(6, 1);
+    car_gym* gym = car_gym_create(&cfg);
+    REQUIRE(gym != nullptr);
+    REQUIRE(car_gym_size(gym) == 6);
+
+    std::vector<float> obs(6 * CAR_GYM_OBS_SIZE, -7.f), actions(6 * CAR_GYM_ACTION_SIZE, 0.f), rewards(6);
+    std::vector<uint8_t> dones(6, 9);
+    REQUIRE(car_gym_reset(gym, obs.data()) == CAR_GYM_OK);
+    REQUIRE(car_gym_step(gym, actions.data(), obs.data(), rewards.data(), dones.data(), nullptr) == CAR_GYM_OK);
+
+    for (int i = 0; i < 6; ++i) {
+        const float* row = obs.data() + i * CAR_GYM_OBS_SIZE;
+        REQUIRE(dones[i] == CAR_GYM_RUNNING);
+        REQUIRE(row[CAR_GYM_OBS_HAS_TARGET] == 1.f);
+        REQUIRE(std::abs(row[CAR_GYM_OBS_HEADING_SIN] * row[CAR_GYM_OBS_HEADING_SIN] +
+                         row[CAR_GYM_OBS_HEADING_COS] * row[CAR_GYM_OBS_HEADING_COS] - 1.f) < 1e-5f);
+
+        // kjeglene: nærmeste først, innenfor rekkevidden
+        float prev = 0.f;
+        for (int k = 0; k < CAR_GYM_NEAREST_CONES; ++k) {
+            const float* c = row + CAR_GYM_OBS_CONES + 3 * k;
+            if (c[2] == 0.f) break;
+            const float d = std::sqrt(c[0] * c[0] + c[1] * c[1]);
+            REQUIRE(d >= prev - 1e-4f);
+            REQUIRE(d <= cfg.cone_range + 1e-3f);
+            prev = d;
+        }
+    }
+    car_gym_destroy(gym);
+}
+
+TEST_CASE("car_gym steps the same regardless of thread count") {
+    std::vector<float> results[2];
+    const uint32_t n = 40;
+    for (int run = 0; run < 2; ++run) {
+        car_gym_config cfg = smallConfig(n, run == 0 ? 1 : 3);
+        cfg.max_steps = 100; // noen episoder resettes underveis
+        cfg.frame_skip = 2;
+        car_gym* gym = car_gym_create(&cfg);
+        std::vector<float> obs(n * CAR_GYM_OBS_SIZE), actions(n * CAR_GYM_ACTION_SIZE), rewards(n);
+        std::vector<uint8_t> dones(n);
+        car_gym_reset(gym, obs.data());
+        for (int s = 0; s < 150; ++s) {
+            fillActions(actions, s);
+            car_gym_step(gym, actions.data(), obs.data(), rewards.data(), dones.data(), nullptr);
+            results[run].insert(results[run].end(), rewards.begin(), rewards.end());
+        }
+        results[run].insert(results[run].end(), obs.begin(), obs.end());
+        car_gym_destroy(gym);
+    }
+    REQUIRE(results[0].size() == results[1].size());
+    REQUIRE(std::memcmp(results[0].data(), results[1].data(), results[0].size() * sizeof(float)) == 0);
+}
+
+TEST_CASE("car_gym time limit with and without auto reset") {
+    GymConfig cfg;
+    cfg.episodes = 2;
+    cfg.threads = 1;
+    cfg.maxSteps = 6;
+    cfg.frameSkip = 4;
+    GymPool pool(cfg);
+
+    std::vector<float> obs(2 * GymPool::obsSize), actions(2 * GymPool::actionSize, 0.f), rewards(2);
+    std::vector<std::uint8_t> dones(2);
+    actions[0] = 1.f;
+    pool.reset(obs.data());
+
+    pool.step(actions.data(), obs.data(), rewards.data(), dones.data());
+    REQUIRE(dones[0] == CAR_GYM_RUNNING);
+    pool.step(actions.data(), obs.data(), rewards.data(), dones.data());
+    REQUIRE(dones[0] == CAR_GYM_TIME_LIMIT); // 6 av 8 fysikksteg
+    // ny episode i raden: bilen står på start
+    REQUIRE(obs[CAR_GYM_OBS_POS_Z] == pool.episode(0).startPos().z);
+    REQUIRE(obs[CAR_GYM_OBS_SPEED] == 0.f);
+
+    cfg.autoReset = false;
+    GymPool held(cfg);
+    held.reset(obs.data());
+    held.step(actions.data(), obs.data(), rewards.data(), dones.data());
+    held.step(actions.data(), obs.data(), rewards.data(), dones.data());
+    const float z = obs[CAR_GYM_OBS_POS_Z];
+    held.step(actions.data(), obs.data(), rewards.data(), dones.data());
+    REQUIRE(dones[0] == CAR_GYM_TIME_LIMIT);
+    REQUIRE(rewards[0] == 0.f);
+    REQUIRE(obs[CAR_GYM_OBS_POS_Z] == z); // står til den resettes
+    held.resetOne(0, obs.data());
+    held.step(actions.data(), obs.data(), rewards.data(), dones.data());
+    REQUIRE(dones[0] == CAR_GYM_RUNNING);
+}
+
+TEST_CASE("car_gym final observations hold the row from before the auto reset") {
+    const uint32_t n = 3;
+    car_gym_config cfg = smallConfig(n, 1);
+    cfg.max_steps = 6;
+    cfg.frame_skip = 4;
+    car_gym* gym = car_gym_create(&cfg);
+    cfg.auto_reset = 0;
+    car_gym* held = car_gym_create(&cfg); // samme episoder, står der de sluttet
+
+    std::vector<float> obs(n * CAR_GYM_OBS_SIZE), heldObs(obs.size()), final(obs.size(), -7.f);
+    std::vector<float> actions(n * CAR_GYM_ACTION_SIZE), rewards(n);
+    std::vector<uint8_t> dones(n);
+    fillActions(actions, 0);
+    for (uint32_t i = 0; i < n; ++i) actions[i * CAR_GYM_ACTION_SIZE] = 1.f; // alle kjører
+    car_gym_reset(gym, obs.data());
+    car_gym_reset(held, heldObs.data());
+
+    REQUIRE(car_gym_step(gym, actions.data(), obs.data(), rewards.data(), dones.data(), final.data()) == CAR_GYM_OK);
+    REQUIRE(dones[0] == CAR_GYM_RUNNING);
+    for (float v : final) REQUIRE(v == -7.f); // ingen ferdige: urørt
+    car_gym_step(held, actions.data(), heldObs.data(), rewards.data(), dones.data(), nullptr);
+
+    car_gym_step(gym, actions.data(), obs.data(), rewards.data(), dones.data(), final.data());
+    for (uint32_t i = 0; i < n; ++i) REQUIRE(dones[i] == CAR_GYM_TIME_LIMIT);
+    car_gym_step(held, actions.data(), heldObs.data(), rewards.data(), dones.data(), nullptr);
+
+    REQUIRE(std::memcmp(final.data(), heldObs.data(), final.size() * sizeof(float)) == 0);
+    for (uint32_t i = 0; i < n; ++i) {
+        REQUIRE(obs[i * CAR_GYM_OBS_SIZE + CAR_GYM_OBS_SPEED] == 0.f); // ny episode
+        const float* row = obs.data() + i * CAR_GYM_OBS_SIZE;
+        REQUIRE(std::memcmp(row, final.data() + i * CAR_GYM_OBS_SIZE, CAR_GYM_OBS_SIZE * sizeof(float)) != 0);
+    }
+
+    // uten auto-reset er sluttraden den samme som observasjonen
+    std::fill(final.begin(), final.end(), -7.f);
+    car_gym_step(held, actions.data(), heldObs.data(), rewards.data(), dones.data(), final.data());
+    REQUIRE(std::memcmp(final.data(), heldObs.data(), final.size() * sizeof(float)) == 0);
+
+    car_gym_destroy(held);
+    car_gym_destroy(gym);
+}
+
+TEST_CASE("car_gym rejects bad arguments") {
+    car_gym_config cfg = smallConfig(0, 1);
+    REQUIRE(car_gym_create(&cfg) == nullptr);
+    REQUIRE(car_gym_create(nullptr) == nullptr);
+    cfg = smallConfig(2, 1);
+    cfg.scenario_path = "/no/such/file.scn";
+    REQUIRE(car_gym_create(&cfg) == nullptr);
+
+    cfg.scenario_path = nullptr;
+    car_gym* gym = car_gym_create(&cfg);
+    std::vector<float> obs(2 * CAR_GYM_OBS_SIZE);
+    REQUIRE(car_gym_reset(gym, nullptr) == CAR_GYM_EINVAL);
+    REQUIRE(car_gym_reset_one(gym, 2, obs.data()) == CAR_GYM_EINVAL);
+    REQUIRE(car_gym_step(gym, nullptr, obs.data(), nullptr, nullptr, nullptr) == CAR_GYM_EINVAL);
+    REQUIRE(car_gym_size(nullptr) == 0);
+    car_gym_destroy(gym);
+}
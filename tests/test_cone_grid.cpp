@@ -0,0 +1,135 @@
+// tests/test_cone_grid.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "world/ConeGrid.h"
+#include "world/TrafficCones.h"
+
+#include <cmath>
+#include <random>
+
+namespace {
+
+bool bruteForceHit(const std::vector<Vec2>& cones, Vec2 p, float r) {
+    for (const auto& c : cones) {
+        float dx = p.x - c.x, dz = p.z - c.z;
+        if (dx * dx + dz * dz < r * r) return true;
+    }
+    return false;
+}
+
+}
+
+TEST_CASE("ConeGrid finds the same hits as a linear scan") {
+    const float lotW = 66.4f, lotD = 97.4f;
+    std::vector<Vec2> cones;
+    scatterTrafficCones({0.f, 0.f}, lotW, lotD, 2000, cones);
+
+    ConeGrid grid;
+    grid.configure({-lotW * 0.5f, -lotD * 0.5f}, lotW, lotD, 2.5f);
+    grid.rebuild(cones);
+    REQUIRE(grid.size() == cones.size());
+
+    std::mt19937 gen(7);
+    // litt utenfor plassen også, for å teste klemming til kantcellene
+    std::uniform_real_distribution<float> dx(-lotW * 0.6f, lotW * 0.6f);
+    std::uniform_real_distribution<float> dz(-lotD * 0.6f, lotD * 0.6f);
+
+    for (int i = 0; i < 5000; ++i) {
+        Vec2 p{dx(gen), dz(gen)};
+        int hit = grid.firstWithin(p, 1.25f);
+        REQUIRE((hit >= 0) == bruteForceHit(cones, p, 1.25f));
+        if (hit >= 0) {
+            REQUIRE(length(p - cones[hit]) < 1.25f);
+        }
+    }
+}
+
+TEST_CASE("ConeGrid rebuild replaces the previous cones") {
+    ConeGrid grid;
+    grid.configure({0.f, 0.f}, 10.f, 10.f, 2.f);
+
+    grid.rebuild({{1.f, 1.f}});
+    REQUIRE(grid.firstWithin({1.f, 1.f}, 0.5f) == 0);
+
+    grid.rebuild({{8.f, 8.f}, {5.f, 5.f}});
+    REQUIRE(grid.firstWithin({1.f, 1.f}, 0.5f) == -1);
+    REQUIRE(grid.firstWithin({5.f, 5.f}, 0.5f) == 1);
+}
+
+TEST_CASE("ConeGrid clamps far-away and NaN positions without UB") {
+    ConeGrid grid;
+    grid.configure({0.f, 0.f}, 10.f, 10.f, 2.f);
+    grid.rebuild({{0.5f, 0.5f}, {9.5f, 9.5f}});
+
+    // langt utenfor int-området: kantcellene, ingen treff så langt unna
+    REQUIRE(grid.firstWithin({1e20f, 1e20f}, 0.5f) == -1);
+    REQUIRE(grid.firstWithin({-1e20f, 0.5f}, 0.5f) == -1);
+    const float nan = std::nanf("");
+    REQUIRE(grid.firstWithin({nan, nan}, 0.5f) == -1);
+
+    int seen = 0;
+    grid.forEachInBox({-1e30f, -1e30f}, {1e30f, 1e30f}, [&](int, Vec2) { ++seen; });
+    REQUIRE(seen == 2);
+}
+
+TEST_CASE("ConeGrid sweep catches cones a test at the end position skips") {
+    ConeGrid grid;
+    grid.configure({0.f, 0.f}, 20.f, 20.f, 2.5f);
+    grid.rebuild({{10.f, 10.f}, {14.f, 10.f}});
+
+    // 2 m per steg rett gjennom kjeglen: hverken start eller slutt er innenfor 1.25 m
+    Vec2 from{8.5f, 10.f}, to{11.5f, 10.f};
+    REQUIRE(grid.firstWithin(from, 1.25f) == -1);
+    REQUIRE(grid.firstWithin(to, 1.25f) == -1);
+
+    float toi = -1.f;
+    REQUIRE(grid.sweepFirst(from, to, 1.25f, toi) == 0);
+    REQUIRE(toi >= 0.f);
+    REQUIRE(toi < 1.f);
+    Vec2 contact = from + (to - from) * toi;
+    REQUIRE(std::abs(length(contact - Vec2{10.f, 10.f}) - 1.25f) < 1e-4f);
+
+    // første treff langs strekningen, ikke laveste indeks
+    REQUIRE(grid.sweepFirst({18.f, 10.f}, {6.f, 10.f}, 1.25f, toi) == 1);
+
+    // på vei bort fra en kjegle man står inntil er ikke et treff
+    REQUIRE(grid.sweepFirst({11.f, 10.f}, {12.f, 11.f}, 1.25f, toi) == -1);
+    REQUIRE(grid.sweepFirst({11.f, 10.f}, {10.5f, 10.f}, 1.25f, toi) == 0);
+    REQUIRE(toi == 0.f);
+}
+
+TEST_CASE("ConeGrid sweep agrees with finely sampled discrete tests") {
+    const float lotW = 66.4f, lotD = 97.4f;
+    std::vector<Vec2> cones;
+    scatterTrafficCones({0.f, 0.f}, lotW, lotD, 500, cones);
+
+    ConeGrid grid;
+    grid.configure({-lotW * 0.5f, -lotD * 0.5f}, lotW, lotD, 2.5f);
+    grid.rebuild(cones);
+
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> px(-lotW * 0.5f, lotW * 0.5f);
+    std::uniform_real_distribution<float> pz(-lotD * 0.5f, lotD * 0.5f);
+    std::uniform_real_distribution<float> step(-3.f, 3.f);
+
+    for (int i = 0; i < 2000; ++i) {
+        Vec2 a{px(gen), pz(gen)};
+        if (bruteForceHit(cones, a, 1.25f)) continue; // starter fritt, som bilen
+        Vec2 b = a + Vec2{step(gen), step(gen)};
+
+        float toi = 2.f;
+        int hit = grid.sweepFirst(a, b, 1.25f, toi);
+
+        // sjekk med 200 delsteg; små marginer rundt kontaktavstanden
+        int firstSample = -1;
+        for (int s = 1; s <= 200 && firstSample < 0; ++s) {
+            if (bruteForceHit(cones, a + (b - a) * (s / 200.f), 1.25f - 1e-3f)) firstSample = s;
+        }
+        if (firstSample >= 0) {
+            REQUIRE(hit >= 0);
+            REQUIRE(toi <= firstSample / 200.f);
+        }
+        if (hit >= 0) {
+            REQUIRE(std::abs(length(a + (b - a) * toi - cones[hit]) - 1.25f) < 1e-3f);
+        }
+    }
+}
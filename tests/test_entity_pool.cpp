@@ -0,0 +1,50 @@
+// tests/test_entity_pool.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "alloc_counter.h"
+#include "logic/Simulation.h"
+#include "util/EntityPool.h"
+
+#include <memory>
+
+TEST_CASE("EntityPool recycles elements without allocating") {
+    EntityPool<std::unique_ptr<int>> pool;
+    int made = 0;
+    auto make = [&](std::size_t i) { ++made; return std::make_unique<int>(static_cast<int>(i)); };
+    pool.preallocate(30, make);
+    REQUIRE(made == 30);
+
+    std::size_t before = allocationCount();
+    for (int round = 0; round < 100; ++round) {
+        int hidden = 0;
+        pool.releaseAll([&](const std::unique_ptr<int>&) { ++hidden; });
+        for (int i = 0; i < 30; ++i) pool.acquire(make);
+        REQUIRE(pool.activeCount() == 30);
+    }
+    REQUIRE(allocationCount() == before);
+    REQUIRE(made == 30);
+    REQUIRE(pool.grown() == 0);
+
+    // går poolen tom vokser den, og det telles
+    pool.acquire(make);
+    REQUIRE(pool.grown() == 1);
+    REQUIRE(pool.capacity() == 31);
+}
+
+TEST_CASE("Simulation steps and resets do not allocate in steady state") {
+    Simulation sim(5);
+    CarInput in{1.f, 0.3f, false};
+
+    // første runde fyller kapasiteten til events, kjegler og target-sekvens
+    for (int i = 0; i < 600; ++i) sim.step(1.f / 120.f, in);
+    sim.reset();
+
+    std::size_t before = allocationCount();
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 600; ++i) {
+            sim.step(1.f / 120.f, in);
+            sim.clearEvents();
+        }
+        sim.reset();
+    }
+    REQUIRE(allocationCount() == before);
+}
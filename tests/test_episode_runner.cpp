@@ -0,0 +1,58 @@
+// tests/test_episode_runner.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "sim/EpisodeRunner.h"
+#include "sim/SeekPolicy.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("ThreadPool parallelFor visits every index exactly once") {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(10007);
+
+    pool.parallelFor(hits.size(), 13, [&](std::size_t b, std::size_t e) {
+        for (std::size_t i = b; i < e; ++i) hits[i].fetch_add(1);
+    });
+
+    for (auto& h : hits) REQUIRE(h.load() == 1);
+}
+
+TEST_CASE("ThreadPool parallelFor rethrows a worker's exception and stays usable") {
+    ThreadPool pool(3);
+    std::atomic<int> calls{0};
+    REQUIRE_THROWS_AS(pool.parallelFor(1000, 10, [&](std::size_t b, std::size_t) {
+        calls.fetch_add(1);
+        if (b == 500) throw std::runtime_error("bit 50");
+    }), std::runtime_error);
+    REQUIRE(calls.load() <= 100);
+
+    // neste jobb kjører som vanlig
+    std::atomic<int> sum{0};
+    pool.parallelFor(100, 7, [&](std::size_t b, std::size_t e) { sum.fetch_add(static_cast<int>(e - b)); });
+    REQUIRE(sum.load() == 100);
+}
+
+TEST_CASE("Episodes are deterministic regardless of thread count") {
+    const std::size_t episodes = 24;
+    EpisodePolicy policy = [](std::size_t, const Simulation& sim) { return seekPolicy(sim); };
+
+    EpisodeRunner single(episodes, 2024), multi(episodes, 2024);
+    ThreadPool one(1), four(4);
+
+    single.run(one, 600, 1.f / 120.f, policy);
+    multi.run(four, 300, 1.f / 120.f, policy);
+    multi.run(four, 300, 1.f / 120.f, policy);
+
+    for (std::size_t i = 0; i < episodes; ++i) {
+        const auto& a = single.episode(i);
+        const auto& b = multi.episode(i);
+        REQUIRE(a.car().position().x == b.car().position().x);
+        REQUIRE(a.car().position().z == b.car().position().z);
+        REQUIRE(a.completedTargets() == b.completedTargets());
+        REQUIRE(a.currentTargetSpot() == b.currentTargetSpot());
+    }
+
+    // ulike episoder får ulike baner
+    REQUIRE(single.episode(0).currentTargetSpot() != single.episode(1).currentTargetSpot());
+}
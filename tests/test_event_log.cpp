@@ -0,0 +1,81 @@
+// tests/test_event_log.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "util/EventLog.h"
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+std::string readAll(std::FILE* f) {
+    std::string s;
+    std::rewind(f);
+    char buf[512];
+    std::size_t n;
+    while ((n = std::fread(buf, 1, sizeof(buf), f)) > 0) s.append(buf, n);
+    return s;
+}
+
+}
+
+TEST_CASE("EventLog formats records on the drain thread in order") {
+    std::FILE* f = std::tmpfile();
+    REQUIRE(f != nullptr);
+    {
+        EventLog log(f, 64);
+        REQUIRE(log.write(LogKind::TargetCompleted, 1, 17));
+        REQUIRE(log.write(LogKind::KeySpawned));
+        REQUIRE(log.text("hello"));
+        REQUIRE(log.flush(std::chrono::milliseconds(2000)));
+        REQUIRE(log.written() == 3);
+    }
+
+    std::string out = readAll(f);
+    REQUIRE(out == "Target parking #1 completed (spot 17).\n"
+                   "All target spots done! Yellow key spawned.\n"
+                   "hello\n");
+    std::fclose(f);
+}
+
+TEST_CASE("EventLog never blocks the producer and counts drops") {
+    std::FILE* f = std::tmpfile();
+    REQUIRE(f != nullptr);
+
+    const int total = 100000;
+    int accepted = 0;
+    std::uint64_t dropped = 0;
+    {
+        EventLog log(f, 4);
+        for (int i = 0; i < total; ++i) {
+            if (log.write(LogKind::Hud, 1.5, i, 3, -1.0, 1.5)) ++accepted;
+        }
+        REQUIRE(log.flush(std::chrono::milliseconds(2000)));
+        dropped = log.dropped();
+        REQUIRE(log.written() == static_cast<std::uint64_t>(accepted));
+    }
+    REQUIRE(accepted + dropped == static_cast<std::uint64_t>(total));
+
+    // hver akseptert post ble én linje
+    std::string out = readAll(f);
+    std::size_t lines = 0;
+    for (char c : out) lines += c == '\n';
+    REQUIRE(lines == static_cast<std::size_t>(accepted));
+    std::fclose(f);
+}
+
+TEST_CASE("formatLogRecord writes the HUD line with and without park hold") {
+    char buf[128];
+    LogRecord rec;
+    rec.kind = LogKind::Hud;
+    rec.args[0] = 2.5;
+    rec.args[1] = 1;
+    rec.args[2] = 3;
+    rec.args[3] = -1.0;
+    rec.args[4] = 1.5;
+    formatLogRecord(rec, buf, sizeof(buf));
+    REQUIRE(std::string(buf) == "[HUD] Speed: 2.5 m/s | Targets: 1/3\n");
+
+    rec.args[3] = 0.75;
+    formatLogRecord(rec, buf, sizeof(buf));
+    REQUIRE(std::string(buf) == "[HUD] Speed: 2.5 m/s | Targets: 1/3 | Park hold: 0.75 / 1.5 s\n");
+}
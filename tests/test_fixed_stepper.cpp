@@ -0,0 +1,33 @@
+// tests/test_fixed_stepper.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "sim/FixedStepper.h"
+
+TEST_CASE("FixedStepper runs whole steps independent of frame rate") {
+    FixedStepper a(120.f), b(120.f);
+    int stepsA = 0, stepsB = 0;
+
+    // samme 2 sekunder, men 30 fps vs 144 fps
+    for (int i = 0; i < 60; ++i) a.advance(1.0 / 30.0, [&](float dt) { ++stepsA; REQUIRE(dt == a.stepDt()); });
+    for (int i = 0; i < 288; ++i) b.advance(1.0 / 144.0, [&](float) { ++stepsB; });
+
+    REQUIRE(stepsA >= 239);
+    REQUIRE(stepsA <= 240);
+    REQUIRE(stepsB >= 239);
+    REQUIRE(stepsB <= 240);
+    REQUIRE(a.alpha() >= 0.f);
+    REQUIRE(a.alpha() < 1.f);
+    REQUIRE(a.stats().catchUpSteps > 0);
+}
+
+TEST_CASE("FixedStepper caps catch-up and counts dropped steps") {
+    FixedStepper stepper(100.f, 4);
+    int steps = 0;
+
+    // en frame på 0.5 s (f.eks. vinduet ble dratt) = 50 steg
+    int ran = stepper.advance(0.5, [&](float) { ++steps; });
+
+    REQUIRE(ran == 4);
+    REQUIRE(steps == 4);
+    REQUIRE(stepper.stats().droppedSteps >= 45);
+    REQUIRE(stepper.alpha() <= 1.f);
+}
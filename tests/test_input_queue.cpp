@@ -0,0 +1,71 @@
+// tests/test_input_queue.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "sim/InputQueue.h"
+
+#include <cmath>
+
+namespace {
+
+constexpr std::uint64_t ms = 1000000;
+
+}
+
+TEST_CASE("InputQueue weights events by where they fall in the step") {
+    InputQueue q;
+    REQUIRE(q.push({25 * ms, InputControl::Throttle, 1.f}));
+    REQUIRE(q.push({30 * ms, InputControl::Steer, -1.f}));
+
+    // steg [20, 30): throttle på de siste 5 ms
+    CarInput a = q.integrate(20 * ms, 30 * ms, 31 * ms);
+    REQUIRE(std::abs(a.throttle - 0.5f) < 1e-6f);
+    REQUIRE(a.steer == 0.f); // hendelsen ved 30 hører til neste steg
+
+    CarInput b = q.integrate(30 * ms, 40 * ms, 41 * ms);
+    REQUIRE(b.throttle == 1.f);
+    REQUIRE(b.steer == -1.f);
+    REQUIRE(q.held().throttle == 1.f);
+    REQUIRE(q.lastAppliedNs() == 30 * ms);
+
+    // latens: fra tidsstempel til steget ble kjørt
+    LatencySummary l = q.latency().summary();
+    REQUIRE(l.samples == 2);
+    REQUIRE(std::abs(l.maxMs - 11.0) < 1e-9);
+}
+
+TEST_CASE("InputQueue keeps taps shorter than a step") {
+    InputQueue q;
+    q.push({12 * ms, InputControl::Throttle, 1.f});
+    q.push({14 * ms, InputControl::Throttle, 0.f});
+    q.push({15 * ms, InputControl::Handbrake, 1.f});
+
+    CarInput in = q.integrate(10 * ms, 20 * ms, 20 * ms);
+    REQUIRE(std::abs(in.throttle - 0.2f) < 1e-6f); // 2 av 10 ms
+    REQUIRE(in.handbrake);                         // holdt halve steget
+    REQUIRE(q.held().throttle == 0.f);
+}
+
+TEST_CASE("InputQueue holds each change for at least minHold") {
+    // trykk og slipp i samme event-poll: nesten samme tidsstempel
+    InputQueue q(64, 10 * ms);
+    q.push({5 * ms, InputControl::Steer, 1.f});
+    q.push({5 * ms + 1000, InputControl::Steer, 0.f});
+
+    CarInput a = q.integrate(0, 10 * ms, 10 * ms);
+    REQUIRE(std::abs(a.steer - 0.5f) < 1e-6f);
+    CarInput b = q.integrate(10 * ms, 20 * ms, 20 * ms);
+    REQUIRE(std::abs(b.steer - 0.5f) < 1e-6f); // slippet flyttet til 15 ms
+    REQUIRE(q.held().steer == 0.f);
+}
+
+TEST_CASE("InputQueue applies late events at the start of the step") {
+    InputQueue q;
+    q.push({5 * ms, InputControl::Throttle, -1.f});
+    CarInput in = q.integrate(10 * ms, 20 * ms, 20 * ms);
+    REQUIRE(in.throttle == -1.f);
+}
+
+TEST_CASE("InputQueue counts events dropped on a full queue") {
+    InputQueue q(4);
+    for (int i = 0; i < 6; ++i) q.push({static_cast<std::uint64_t>(i), InputControl::Steer, 1.f});
+    REQUIRE(q.dropped() == 2);
+}
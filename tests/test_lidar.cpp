@@ -0,0 +1,179 @@
+// tests/test_lidar.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "logic/Simulation.h"
+#include "sim/Lidar.h"
+#include "util/ThreadPool.h"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+TEST_CASE("RayBvh packets find the same hits as testing every primitive") {
+    RayBvh bvh;
+    std::mt19937 gen(4);
+    std::uniform_real_distribution<float> pos(-40.f, 40.f), size(0.2f, 2.f), angle(-3.14f, 3.14f), h(0.f, 2.f);
+    for (std::uint32_t i = 0; i < 500; ++i) {
+        const Vec2 c{pos(gen), pos(gen)};
+        const float y0 = h(gen), y1 = y0 + size(gen);
+        if (i % 3 == 0) {
+            bvh.add(makeBoxPrim(makeCarObb(c, angle(gen), size(gen), size(gen)), y0, y1, i));
+        } else {
+            bvh.add(makeCirclePrim(c, size(gen), y0, y1, i));
+        }
+    }
+    bvh.build();
+    REQUIRE(bvh.size() == 500);
+
+    std::uniform_real_distribution<float> slope(-0.3f, 0.3f);
+    int hits = 0;
+    for (int n = 0; n < 200; ++n) {
+        RayPacket a, b;
+        a.origin = b.origin = {pos(gen), pos(gen)};
+        a.height = b.height = h(gen);
+        const float base = angle(gen);
+        for (int l = 0; l < RayPacket::width; ++l) {
+            const float yaw = base + 0.02f * static_cast<float>(l);
+            const float s = n % 4 == 0 ? 0.f : slope(gen);
+            a.set(l, {std::sin(yaw), std::cos(yaw)}, s, 60.f);
+            b.set(l, {std::sin(yaw), std::cos(yaw)}, s, 60.f);
+        }
+        bvh.intersect(a);
+        bvh.intersectLinear(b);
+        for (int l = 0; l < RayPacket::width; ++l) {
+            REQUIRE(std::abs(a.t[l] - b.t[l]) < 1e-4f);
+            REQUIRE((a.hit[l] == b.hit[l] || std::abs(a.t[l] - b.t[l]) < 1e-6f));
+            hits += a.hit[l] != RayPacket::noHit ? 1 : 0;
+        }
+    }
+    REQUIRE(hits > 400);
+}
+
+TEST_CASE("RayBvh clips hits by the primitive's height") {
+    RayBvh bvh;
+    bvh.add(makeCirclePrim({0.f, 10.f}, 0.5f, 0.f, 1.f, 7));
+    bvh.add(makeCirclePrim({10.f, 0.f}, 0.5f, 0.6f, 2.f, 8)); // hever seg fra 0.6 m
+    bvh.build();
+
+    RayPacket p;
+    p.origin = {0.f, 0.f};
+    p.height = 0.5f;
+    p.set(0, {0.f, 1.f}, 0.f, 50.f);      // rett fram: treffer siden
+    p.set(1, {0.f, 1.f}, 0.1f, 50.f);     // 1.45 m høy ved kjeglen: over
+    p.set(2, {1.f, 0.f}, 0.0105f, 50.f);  // under ved siden, inn gjennom bunnen
+    p.set(3, {-1.f, 0.f}, 0.f, 50.f);     // feil vei
+    for (int l = 4; l < RayPacket::width; ++l) p.set(l, {0.f, 1.f}, 0.f, 0.f); // avslått
+    bvh.intersect(p);
+
+    REQUIRE(p.hit[0] == 7);
+    REQUIRE(std::abs(p.t[0] - 9.5f) < 1e-4f);
+    REQUIRE(p.hit[1] == RayPacket::noHit);
+    REQUIRE(p.hit[2] == 8);
+    REQUIRE(std::abs(p.t[2] - 0.1f / 0.0105f) < 1e-3f);
+    REQUIRE(p.hit[3] == RayPacket::noHit);
+    for (int l = 4; l < RayPacket::width; ++l) REQUIRE(p.hit[l] == RayPacket::noHit);
+}
+
+TEST_CASE("Lidar measures walls and ground around the car") {
+    Scenario sc;
+    sc.coneCount = 0;
+    Simulation sim(2, sc);
+
+    LidarConfig cfg;
+    cfg.beams = 4;            // -pi, -pi/2, 0, pi/2 fra heading
+    cfg.channels = 2;
+    cfg.minElevation = -0.3f;
+    cfg.maxElevation = 0.f;
+    cfg.maxRange = 200.f;
+    Lidar lidar(cfg);
+    lidar.buildStatic(sim);
+    lidar.updateDynamic(sim);
+
+    const ParkingLot& lot = sim.lot();
+    LidarPose pose;
+    pose.pos = lot.center;
+    std::vector<float> ranges(lidar.raysPerScan());
+    std::vector<LidarHit> hits(lidar.raysPerScan());
+    lidar.scan(pose, ranges.data(), hits.data());
+
+    // kanal 1 er vannrett: veggene rett foran og til siden
+    const float* flat = ranges.data() + cfg.beams;
+    REQUIRE(hits[cfg.beams + 2] == LidarHit::Wall);
+    REQUIRE(std::abs(flat[2] - lot.depth * 0.5f) < 1e-3f);
+    REQUIRE(hits[cfg.beams + 3] == LidarHit::Wall);
+    REQUIRE(std::abs(flat[3] - lot.width * 0.5f) < 1e-3f);
+
+    // kanal 0 peker nedover: bakken
+    for (int b = 0; b < cfg.beams; ++b) {
+        REQUIRE(hits[b] == LidarHit::Ground);
+        REQUIRE(std::abs(ranges[b] - cfg.mountHeight / std::sin(0.3f)) < 1e-3f);
+    }
+
+    // uten treff: maxRange
+    cfg.maxRange = 5.f;
+    Lidar shortRange(cfg);
+    shortRange.buildStatic(sim);
+    shortRange.scan(pose, ranges.data(), hits.data());
+    REQUIRE(flat[2] == 5.f);
+    REQUIRE(hits[cfg.beams + 2] == LidarHit::None);
+}
+
+TEST_CASE("Lidar sees other cars but not the one it sits on") {
+    Scenario sc;
+    sc.coneCount = 0;
+    Simulation sim(2, sc);
+    LidarConfig cfg;
+    cfg.beams = 4;
+    Lidar lidar(cfg);
+    lidar.buildStatic(sim);
+
+    const Vec2 c = sim.lot().center;
+    const Obb cars[2] = {makeCarObb(c, 0.f, 0.5f, 1.f), makeCarObb(c + Vec2{0.f, 6.f}, 0.f, 0.5f, 1.f)};
+    lidar.updateDynamic(sim, cars);
+
+    std::vector<float> ranges(4);
+    std::vector<LidarHit> hits(4);
+    LidarPose pose{c, 0.f, Lidar::carTag(0)};
+    lidar.scan(pose, ranges.data(), hits.data());
+    REQUIRE(hits[2] == LidarHit::Car);
+    REQUIRE(std::abs(ranges[2] - 5.f) < 1e-3f);
+
+    pose.self = RayPacket::noHit; // står inne i sin egen boks
+    lidar.scan(pose, ranges.data(), hits.data());
+    REQUIRE(ranges[2] == 0.f);
+}
+
+TEST_CASE("Lidar parallel scan matches scanning each car alone") {
+    Scenario sc;
+    sc.coneCount = 400;
+    Simulation sim(9, sc);
+    LidarConfig cfg;
+    cfg.beams = 600; // ikke delelig med pakkebredden eller oppgavestørrelsen
+    cfg.channels = 3;
+    Lidar lidar(cfg);
+    lidar.buildStatic(sim);
+
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> u(-0.4f, 0.4f), yaw(-3.14f, 3.14f);
+    std::vector<LidarPose> poses(13);
+    std::vector<Obb> boxes(poses.size());
+    for (std::size_t i = 0; i < poses.size(); ++i) {
+        poses[i].pos = sim.lot().center + Vec2{u(gen) * sim.lot().width, u(gen) * sim.lot().depth};
+        poses[i].heading = yaw(gen);
+        poses[i].self = Lidar::carTag(static_cast<std::uint32_t>(i));
+        boxes[i] = makeCarObb(poses[i].pos, poses[i].heading, 0.5f, 1.f);
+    }
+    lidar.updateDynamic(sim, boxes);
+
+    const std::size_t rays = static_cast<std::size_t>(lidar.raysPerScan());
+    std::vector<float> batch(poses.size() * rays), one(rays);
+    std::vector<LidarHit> batchHits(batch.size()), oneHits(rays);
+    ThreadPool pool(3);
+    lidar.scan(poses, batch.data(), batchHits.data(), pool);
+
+    for (std::size_t i = 0; i < poses.size(); ++i) {
+        lidar.scan(poses[i], one.data(), oneHits.data());
+        REQUIRE(std::memcmp(one.data(), batch.data() + i * rays, rays * sizeof(float)) == 0);
+        REQUIRE(std::memcmp(oneHits.data(), batchHits.data() + i * rays, rays) == 0);
+    }
+}
@@ -0,0 +1,116 @@
+// tests/test_lot_chunks.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "world/LotChunks.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+
+namespace {
+
+ParkingLot makeLot(int rows, int cols) {
+    ParkingLot lot;
+    LotLayout layout;
+    layout.rows = rows;
+    layout.cols = cols;
+    generateParkingLot(lot, layout);
+    return lot;
+}
+
+}
+
+TEST_CASE("LotChunks buckets every spot and cone into the chunk containing it") {
+    auto lot = makeLot(40, 60);
+    LotChunks chunks;
+    chunks.configure(lot, 32.f);
+
+    std::vector<Vec2> cones = {lot.center, {lot.center.x + 50.f, lot.center.z - 20.f}};
+    chunks.setCones(cones);
+
+    std::size_t spots = 0, coneCount = 0;
+    for (int c = 0; c < chunks.count(); ++c) {
+        Vec2 mn = chunks.chunkMin(c);
+        Vec2 mx = chunks.chunkMax(c);
+        for (auto i : chunks.spotsIn(c)) {
+            Vec2 p = lot.spots[i].center;
+            REQUIRE(p.x >= mn.x);
+            REQUIRE(p.x <= mx.x);
+            REQUIRE(p.z >= mn.z);
+            REQUIRE(p.z <= mx.z);
+            ++spots;
+        }
+        for (auto i : chunks.conesIn(c)) {
+            REQUIRE(chunks.chunkAt(cones[i]) == c);
+            ++coneCount;
+        }
+    }
+    REQUIRE(spots == lot.spots.size());
+    REQUIRE(coneCount == cones.size());
+
+    // utenfor int-området og NaN klemmes til kantene (ikke UB i konverteringen)
+    REQUIRE(chunks.chunkAt({-1e20f, -1e20f}) == 0);
+    REQUIRE(chunks.chunkAt({1e20f, 1e20f}) == chunks.count() - 1);
+    REQUIRE(chunks.chunkAt({std::nanf(""), std::nanf("")}) == 0);
+}
+
+TEST_CASE("ChunkStreamer keeps the resident set bounded regardless of lot size") {
+    StreamingParams params;
+    params.loadRadius = 80.f;
+    params.evictRadius = 110.f;
+    params.lodDistance = 40.f;
+
+    std::size_t smallMax = 0, hugeMax = 0;
+    for (auto [rows, cols, maxResident] : {std::tuple{40, 60, &smallMax}, std::tuple{300, 400, &hugeMax}}) {
+        auto lot = makeLot(rows, cols);
+        LotChunks chunks;
+        chunks.configure(lot, 32.f);
+        ChunkStreamer streamer(params);
+        streamer.reset(chunks);
+
+        // kjør diagonalt over hele plassen
+        Vec2 a{lot.center.x - lot.width * 0.5f, lot.center.z - lot.depth * 0.5f};
+        Vec2 b{lot.center.x + lot.width * 0.5f, lot.center.z + lot.depth * 0.5f};
+        streamer.loadAll(chunks, a);
+        for (int i = 0; i <= 2000; ++i) {
+            Vec2 p = a + (b - a) * (static_cast<float>(i) / 2000.f);
+            streamer.update(chunks, p);
+            *maxResident = std::max(*maxResident, streamer.resident().size());
+
+            for (int c : streamer.resident()) {
+                float d = chunks.distanceTo(c, p);
+                REQUIRE(d <= params.evictRadius);
+                REQUIRE(streamer.lod(c) == (d > params.lodDistance ? ChunkLod::Far : ChunkLod::Near));
+            }
+        }
+    }
+
+    // (2 * 110 / 32 + 2)^2 chunks er en øvre grense for begge
+    REQUIRE(hugeMax <= 81);
+    REQUIRE(hugeMax <= smallMax * 2);
+}
+
+TEST_CASE("ChunkStreamer loads nearest chunks first within the per-update budget") {
+    auto lot = makeLot(100, 100);
+    LotChunks chunks;
+    chunks.configure(lot, 16.f);
+
+    StreamingParams params;
+    params.maxLoadsPerUpdate = 3;
+    ChunkStreamer streamer(params);
+    streamer.reset(chunks);
+
+    streamer.update(chunks, lot.center);
+    REQUIRE(streamer.changes().size() == 3);
+    REQUIRE(streamer.pending() > 0);
+    // chunken bilen står i kommer først
+    REQUIRE(streamer.lod(chunks.chunkAt(lot.center)) == ChunkLod::Near);
+
+    // flere oppdateringer på samme sted fyller opp til alt innenfor loadRadius er lastet
+    int updates = 1;
+    while (streamer.pending() > 0 && updates < 1000) {
+        streamer.update(chunks, lot.center);
+        ++updates;
+    }
+    REQUIRE(streamer.pending() == 0);
+    REQUIRE(updates > 1);
+}
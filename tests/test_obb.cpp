@@ -0,0 +1,132 @@
+// tests/test_obb.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "world/Obb.h"
+#include "world/Parking.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace {
+
+// punkter i et tett rutenett over boksen; brukes som fasit for SAT
+bool sampledOverlap(const Obb& a, const Obb& b) {
+    for (int i = 0; i <= 40; ++i) {
+        for (int j = 0; j <= 40; ++j) {
+            float u = -1.f + i / 20.f, v = -1.f + j / 20.f;
+            Vec2 p = a.center + a.right() * (u * a.halfW) + a.axis * (v * a.halfD);
+            Vec2 q = p - b.center;
+            if (std::abs(dot(q, b.right())) <= b.halfW && std::abs(dot(q, b.axis)) <= b.halfD) return true;
+        }
+    }
+    return false;
+}
+
+}
+
+TEST_CASE("OBB SAT agrees with sampling and is symmetric") {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> pos(-3.f, 3.f), ang(-3.2f, 3.2f), half(0.2f, 1.5f);
+
+    int hits = 0;
+    for (int i = 0; i < 3000; ++i) {
+        Obb a = makeCarObb({pos(gen), pos(gen)}, ang(gen), half(gen), half(gen));
+        Obb b = makeCarObb({pos(gen), pos(gen)}, ang(gen), half(gen), half(gen));
+        bool sat = overlaps(a, b);
+        REQUIRE(sat == overlaps(b, a));
+        // sampling finner ikke berøringer på kanten; bare sjekk tydelige tilfeller
+        if (sampledOverlap(a, b) || sampledOverlap(b, a)) REQUIRE(sat);
+        Obb grownA = a, grownB = b;
+        grownA.halfW *= 0.97f; grownA.halfD *= 0.97f;
+        grownB.halfW *= 0.97f; grownB.halfD *= 0.97f;
+        if (sat && !overlaps(grownA, grownB)) continue;
+        if (sat) REQUIRE((sampledOverlap(a, b) || sampledOverlap(b, a)));
+        hits += sat;
+    }
+    REQUIRE(hits > 100);
+}
+
+TEST_CASE("A rotated car box touches what an axis-aligned one misses") {
+    Obb car = makeCarObb({0.f, 0.f}, 0.f, 0.5f, 1.0f);
+    REQUIRE_FALSE(overlapsCircle(car, {1.0f, 0.f}, 0.35f));
+    REQUIRE(overlapsCircle(car, {0.f, 1.2f}, 0.35f));
+
+    // 90 grader: nå er bilen lang langs x
+    Obb turned = makeCarObb({0.f, 0.f}, 1.5707964f, 0.5f, 1.0f);
+    REQUIRE(overlapsCircle(turned, {1.0f, 0.f}, 0.35f));
+    REQUIRE_FALSE(overlapsCircle(turned, {0.f, 1.2f}, 0.35f));
+
+    REQUIRE(insideRect(car, {-0.5f, -1.f}, {0.5f, 1.f}));
+    REQUIRE_FALSE(insideRect(turned, {-0.5f, -1.f}, {0.5f, 1.f}));
+}
+
+TEST_CASE("Swept box vs circle finds the first contact") {
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> pos(-4.f, 4.f), ang(-3.2f, 3.2f), step(-4.f, 4.f);
+
+    for (int i = 0; i < 3000; ++i) {
+        Obb box = makeCarObb({pos(gen), pos(gen)}, ang(gen), 0.5f, 1.0f);
+        Vec2 c{pos(gen), pos(gen)};
+        if (overlapsCircle(box, c, 0.35f)) continue;
+        Vec2 d{step(gen), step(gen)};
+
+        float toi = 2.f;
+        bool hit = sweepObbCircle(box, d, c, 0.35f, toi);
+
+        int first = -1;
+        for (int s = 1; s <= 400 && first < 0; ++s) {
+            Obb moved = box;
+            moved.center = box.center + d * (s / 400.f);
+            if (overlapsCircle(moved, c, 0.35f - 1e-3f)) first = s;
+        }
+        if (first >= 0) {
+            REQUIRE(hit);
+            REQUIRE(toi <= first / 400.f);
+        }
+        if (hit) {
+            Obb at = box;
+            at.center = box.center + d * toi;
+            REQUIRE(overlapsCircle(at, c, 0.35f + 1e-3f));
+            REQUIRE_FALSE(overlapsCircle(at, c, 0.35f - 1e-3f));
+        }
+    }
+}
+
+TEST_CASE("Batch SAT finds the same pairs as the scalar test") {
+    std::mt19937 gen(9);
+    std::uniform_real_distribution<float> pos(-20.f, 20.f), ang(-3.2f, 3.2f);
+
+    std::vector<Obb> bodies;
+    for (int i = 0; i < 200; ++i) bodies.push_back(makeCarObb({pos(gen), pos(gen)}, ang(gen), 0.9f, 2.2f));
+
+    std::vector<BodyPair> pairs, expected, hits;
+    for (std::uint32_t a = 0; a < bodies.size(); ++a) {
+        for (std::uint32_t b = a + 1; b < bodies.size(); ++b) {
+            pairs.push_back({a, b});
+            if (overlaps(bodies[a], bodies[b])) expected.push_back({a, b});
+        }
+    }
+    overlapsBatch(bodies, pairs, hits);
+
+    REQUIRE(hits.size() == expected.size());
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+        REQUIRE(hits[i].a == expected[i].a);
+        REQUIRE(hits[i].b == expected[i].b);
+    }
+}
+
+TEST_CASE("Parking check follows the car's heading") {
+    ParkingSpot spot{{0.f, 0.f}, 1.3f, 2.6f, false};
+
+    // heading 0: samme svar som den aksejusterte testen
+    for (float x : {0.f, 1.1f, 1.2f}) {
+        for (float z : {0.f, 2.3f, 2.4f}) {
+            REQUIRE(isCarInsideSpot(spot, {x, z}, 0.f, 0.5f, 1.0f) ==
+                    isCarInsideSpot(spot, {x, z}, 0.5f, 1.0f));
+        }
+    }
+
+    // på tvers nær kortsiden: den aksejusterte sier ja, den roterte nei
+    REQUIRE(isCarInsideSpot(spot, {1.15f, 0.f}, 0.5f, 1.0f));
+    REQUIRE_FALSE(isCarInsideSpot(spot, {1.15f, 0.f}, 1.5707964f, 0.5f, 1.0f));
+}
@@ -3,15 +3,13 @@
 #include <catch2/catch_test_macros.hpp>
 #include "world/Parking.h"
 
-using namespace threepp;
-
 TEST_CASE("Car inside spot is detected correctly") {
     ParkingSpot spot;
-    spot.center = {0.f, 0.f, 0.f};
+    spot.center = {0.f, 0.f};
     spot.halfW = 1.5f;
     spot.halfD = 3.0f;
 
-    Vector3 carPos{0.f, 0.f, 0.f};
+    Vec2 carPos{0.f, 0.f};
     float carHalfW = 0.5f;
     float carHalfD = 1.0f;
 
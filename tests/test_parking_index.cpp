@@ -0,0 +1,76 @@
+// tests/test_parking_index.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "world/ParkingLotIndex.h"
+
+#include <cmath>
+#include <random>
+
+namespace {
+
+// -1 hvis ingen plass, -2 hvis punktet er så nær en kant at svaret er tvetydig
+int bruteForceLocate(const ParkingLot& lot, Vec2 p) {
+    const float eps = 1e-3f;
+    for (std::size_t i = 0; i < lot.spots.size(); ++i) {
+        const auto& s = lot.spots[i];
+        float dx = std::abs(p.x - s.center.x) - s.halfW;
+        float dz = std::abs(p.z - s.center.z) - s.halfD;
+        if (std::abs(dx) < eps || std::abs(dz) < eps) return -2;
+        if (dx < 0.f && dz < 0.f) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void checkAgainstBruteForce(const ParkingLot& lot, const ParkingLotIndex& index) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> dx(lot.center.x - lot.width * 0.6f, lot.center.x + lot.width * 0.6f);
+    std::uniform_real_distribution<float> dz(lot.center.z - lot.depth * 0.6f, lot.center.z + lot.depth * 0.6f);
+
+    std::vector<Vec2> points(3000);
+    for (auto& p : points) p = {dx(gen), dz(gen)};
+
+    std::vector<int> batch(points.size());
+    index.locate(points, batch);
+
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        int expected = bruteForceLocate(lot, points[i]);
+        if (expected == -2) continue;
+        REQUIRE(index.locate(points[i]) == expected);
+        REQUIRE(batch[i] == expected);
+    }
+}
+
+}
+
+TEST_CASE("ParkingLotIndex locates spots arithmetically on a regular lot") {
+    ParkingLot lot;
+    generateParkingLot(lot);
+
+    ParkingLotIndex index;
+    index.build(lot);
+
+    REQUIRE(index.isRegular());
+    REQUIRE(index.size() == lot.spots.size());
+    REQUIRE(index.locate(lot.spots[37].center) == 37);
+    checkAgainstBruteForce(lot, index);
+
+    // langt utenfor int-området og NaN: ingen plass (ikke UB i konverteringen)
+    REQUIRE(index.locate(Vec2{1e20f, 0.f}) == -1);
+    REQUIRE(index.locate(Vec2{-1e20f, -1e20f}) == -1);
+    REQUIRE(index.locate(Vec2{std::nanf(""), 0.f}) == -1);
+}
+
+TEST_CASE("ParkingLotIndex falls back to a BVH for irregular lots") {
+    ParkingLot lot;
+    generateParkingLot(lot);
+
+    // fjern noen plasser og flytt én, så rutenettet ikke lenger stemmer
+    lot.spots.erase(lot.spots.begin() + 10, lot.spots.begin() + 20);
+    lot.spots[5].center.x += 100.f;
+
+    ParkingLotIndex index;
+    index.build(lot);
+
+    REQUIRE_FALSE(index.isRegular());
+    REQUIRE(index.locate(lot.spots[5].center) == 5);
+    checkAgainstBruteForce(lot, index);
+}
@@ -0,0 +1,114 @@
+// tests/test_profiler.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "util/Profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+TEST_CASE("Profiler records nested scopes and sums them per frame") {
+    Profiler::clear();
+    Profiler::setEnabled(true);
+
+    for (int frame = 0; frame < 10; ++frame) {
+        {
+            PROFILE_SCOPE(Frame);
+            PROFILE_SCOPE(SimStep);
+        }
+        Profiler::endFrame();
+    }
+
+    auto events = Profiler::snapshot();
+    REQUIRE(events.size() == 20);
+
+    auto frame = Profiler::summary(ProfPhase::Frame);
+    auto step = Profiler::summary(ProfPhase::SimStep);
+    REQUIRE(frame.frames == 10);
+    REQUIRE(frame.p50Ms <= frame.p99Ms);
+    REQUIRE(frame.p99Ms <= frame.maxMs);
+    REQUIRE(step.maxMs <= frame.maxMs);
+    REQUIRE(Profiler::summary(ProfPhase::Render).maxMs == 0.0);
+
+    Profiler::setEnabled(false);
+}
+
+TEST_CASE("Profiler is off until enabled and keeps only the newest events") {
+    Profiler::clear();
+    Profiler::setEnabled(false);
+    { PROFILE_SCOPE(Render); }
+    REQUIRE(Profiler::snapshot().empty());
+
+    Profiler::setEnabled(true);
+    for (std::size_t i = 0; i < Profiler::ringCapacity + 100; ++i) {
+        PROFILE_SCOPE(Cones);
+    }
+    REQUIRE(Profiler::snapshot().size() == Profiler::ringCapacity);
+    Profiler::setEnabled(false);
+}
+
+TEST_CASE("Profiler writes a Chrome trace with events from several threads") {
+    Profiler::clear();
+    Profiler::setEnabled(true);
+
+    { PROFILE_SCOPE(Frame); }
+    std::thread worker([] { PROFILE_SCOPE(SimStep); });
+    worker.join();
+
+    auto events = Profiler::snapshot();
+    REQUIRE(events.size() == 2);
+    REQUIRE(events[0].tid != events[1].tid);
+
+    const char* path = "test_profiler_trace.json";
+    REQUIRE(Profiler::writeChromeTrace(path));
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    std::string json = ss.str();
+    REQUIRE(json.find("\"traceEvents\"") != std::string::npos);
+    REQUIRE(json.find("\"name\":\"Frame\"") != std::string::npos);
+    REQUIRE(json.find("\"name\":\"SimStep\"") != std::string::npos);
+    in.close();
+    std::remove(path);
+
+    Profiler::setEnabled(false);
+}
+
+TEST_CASE("Profiler keeps a separate window for phases recorded on the sim thread") {
+    Profiler::clear();
+    Profiler::setEnabled(true);
+
+    std::thread sim([] {
+        for (int step = 0; step < 5; ++step) {
+            {
+                PROFILE_SCOPE(SimStep);
+                PROFILE_SCOPE(CarUpdate);
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            Profiler::endFrame(ProfWindow::Sim);
+        }
+    });
+    sim.join();
+    {
+        PROFILE_SCOPE(Render);
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    Profiler::endFrame();
+
+    auto step = Profiler::summary(ProfPhase::SimStep, ProfWindow::Sim);
+    auto car = Profiler::summary(ProfPhase::CarUpdate, ProfWindow::Sim);
+    REQUIRE(step.frames == 5);
+    REQUIRE(step.p50Ms >= 0.2);
+    REQUIRE(car.maxMs > 0.0);
+    REQUIRE(car.maxMs <= step.maxMs);
+
+    // hvert vindu ser bare sin egen tråds faser
+    REQUIRE(Profiler::summary(ProfPhase::SimStep).frames == 1);
+    REQUIRE(Profiler::summary(ProfPhase::SimStep).maxMs == 0.0);
+    REQUIRE(Profiler::summary(ProfPhase::Render).maxMs >= 0.2);
+    REQUIRE(Profiler::summary(ProfPhase::Render, ProfWindow::Sim).maxMs == 0.0);
+
+    Profiler::setEnabled(false);
+}
@@ -0,0 +1,190 @@
+// tests/test_replay.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "sim/Replay.h"
+#include "sim/SeekPolicy.h"
+#include "util/MappedFile.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace {
+
+// kjører en økt og tar den opp; returnerer sluttilstanden
+Simulation recordSession(const std::string& path, std::uint64_t seed, const Scenario& scenario = {}) {
+    const float dt = 1.f / 120.f;
+    Simulation sim(seed, scenario);
+    ReplayWriter writer;
+    REQUIRE(writer.open(path, seed, dt, scenario));
+
+    for (int i = 0; i < 3000; ++i) {
+        if (i == 1200) {
+            writer.recordReset();
+            sim.reset();
+        }
+        CarInput in = (i % 500 < 250) ? seekPolicy(sim) : CarInput{1.f, -1.f, false};
+        sim.step(dt, in);
+        writer.recordStep(in);
+    }
+    writer.close();
+    return sim;
+}
+
+}
+
+TEST_CASE("Replay reproduces a recorded session") {
+    auto path = (std::filesystem::temp_directory_path() / "bilsim_test_replay.bsrp").string();
+    Simulation original = recordSession(path, 77);
+
+    MappedFile file;
+    REQUIRE(file.open(path));
+
+    ReplayReader reader;
+    REQUIRE(reader.open(file.bytes()));
+    REQUIRE(reader.seed() == 77u);
+    REQUIRE(reader.stepCount() == 3000u);
+
+    ReplayResult r = playReplay(reader);
+    REQUIRE(r.valid);
+    REQUIRE(r.steps == 3000u);
+    REQUIRE(r.carPos.x == original.car().position().x);
+    REQUIRE(r.carPos.z == original.car().position().z);
+    REQUIRE(r.completedTargets == original.completedTargets());
+
+    file.close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Replay stores the scenario and replays in it") {
+    auto path = (std::filesystem::temp_directory_path() / "bilsim_test_replay_scenario.bsrp").string();
+
+    // som scenarios/tight_lot.scn, pluss annen fysikk
+    Scenario scenario;
+    REQUIRE(parseScenario("name = tight_lot\nlot.rows = 6\nlot.cols = 10\nlot.slotW = 2.3\n"
+                          "lot.laneWidth = 2.5\nrules.requiredTargets = 4\nrules.parkTime = 2.0\n"
+                          "cones.count = 60\ncar.maxSpeed = 12\ncar.friction = 0.8\n", scenario));
+    Simulation original = recordSession(path, 1234, scenario);
+
+    MappedFile file;
+    REQUIRE(file.open(path));
+    ReplayReader reader;
+    REQUIRE(reader.open(file.bytes()));
+    REQUIRE(std::string(reader.scenario().name) == "tight_lot");
+    REQUIRE(reader.scenario().layout.rows == 6);
+    REQUIRE(reader.scenario().layout.slotW == 2.3f);
+    REQUIRE(reader.scenario().requiredTargets == 4);
+    REQUIRE(reader.scenario().requiredParkTime == 2.f);
+    REQUIRE(reader.scenario().coneCount == 60);
+    REQUIRE(reader.scenario().car.friction == 0.8f);
+
+    ReplayResult r = playReplay(reader);
+    REQUIRE(r.valid);
+    REQUIRE(r.steps == 3000u);
+    REQUIRE(r.carPos.x == original.car().position().x);
+    REQUIRE(r.carPos.z == original.car().position().z);
+    REQUIRE(r.completedTargets == original.completedTargets());
+
+    // samme seed og policy i standardscenarioet ender et annet sted
+    Simulation other = recordSession(path, 1234);
+    REQUIRE((other.car().position().x != original.car().position().x ||
+             other.car().position().z != original.car().position().z));
+
+    file.close();
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Replay reader rejects version 1 headers and invalid scenarios") {
+    auto path = (std::filesystem::temp_directory_path() / "bilsim_test_replay_bad.bsrp").string();
+    recordSession(path, 5);
+
+    std::vector<std::byte> bytes;
+    {
+        MappedFile file;
+        REQUIRE(file.open(path));
+        bytes.assign(file.bytes().begin(), file.bytes().end());
+    }
+    std::filesystem::remove(path);
+
+    ReplayReader reader;
+    REQUIRE(reader.open(bytes));
+
+    auto oldVersion = bytes;
+    oldVersion[4] = std::byte{1};
+    REQUIRE_FALSE(reader.open(oldVersion));
+
+    // lot.rows (første felt etter navnet) = 0
+    auto badScenario = bytes;
+    for (int i = 0; i < 4; ++i) badScenario[40 + 48 + i] = std::byte{0};
+    REQUIRE_FALSE(reader.open(badScenario));
+}
+
+TEST_CASE("Replay playback stops at the header's step count on corrupt runs") {
+    auto path = (std::filesystem::temp_directory_path() / "bilsim_test_replay_corrupt.bsrp").string();
+    recordSession(path, 9);
+    std::vector<std::byte> bytes;
+    {
+        MappedFile file;
+        REQUIRE(file.open(path));
+        bytes.assign(file.bytes().begin(), file.bytes().end());
+    }
+    std::filesystem::remove(path);
+
+    // én run med 2^63 steg (LEB128): ville aldri blitt ferdig
+    std::vector<std::byte> huge(bytes.begin(), bytes.begin() + ReplayReader::headerSize);
+    huge.push_back(std::byte{0});
+    for (int i = 0; i < 9; ++i) huge.push_back(std::byte{0x80});
+    huge.push_back(std::byte{0x01});
+    const std::uint64_t payload = huge.size() - ReplayReader::headerSize;
+    for (int i = 0; i < 8; ++i) huge[32 + i] = static_cast<std::byte>(payload >> (8 * i));
+
+    ReplayReader reader;
+    REQUIRE(reader.open(huge));
+    ReplayResult r = playReplay(reader);
+    REQUIRE_FALSE(r.valid);
+    REQUIRE(r.steps == 0u);
+    REQUIRE(reader.corrupt());
+
+    // avkortet payload: færre steg enn headeren sier
+    auto truncated = bytes;
+    const std::uint64_t half = (bytes.size() - ReplayReader::headerSize) / 2;
+    for (int i = 0; i < 8; ++i) truncated[32 + i] = static_cast<std::byte>(half >> (8 * i));
+    REQUIRE(reader.open(truncated));
+    r = playReplay(reader);
+    REQUIRE_FALSE(r.valid);
+    REQUIRE(r.steps < reader.stepCount());
+}
+
+TEST_CASE("Replay archives can hold several concatenated replays") {
+    auto dir = std::filesystem::temp_directory_path();
+    auto a = (dir / "bilsim_test_a.bsrp").string();
+    auto b = (dir / "bilsim_test_b.bsrp").string();
+    auto archive = (dir / "bilsim_test_archive.bsrp").string();
+
+    recordSession(a, 1);
+    recordSession(b, 2);
+
+    {
+        std::ofstream out(archive, std::ios::binary);
+        for (const auto& part : {a, b}) {
+            std::ifstream in(part, std::ios::binary);
+            out << in.rdbuf();
+        }
+    }
+
+    MappedFile file;
+    REQUIRE(file.open(archive));
+
+    std::vector<std::uint64_t> seeds;
+    std::size_t count = forEachReplay(file.bytes(), [&](ReplayReader& reader) {
+        seeds.push_back(reader.seed());
+    });
+
+    REQUIRE(count == 2u);
+    REQUIRE(seeds[0] == 1u);
+    REQUIRE(seeds[1] == 2u);
+
+    file.close();
+    for (const auto& p : {a, b, archive}) std::filesystem::remove(p);
+}
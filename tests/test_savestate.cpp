@@ -0,0 +1,149 @@
+// tests/test_savestate.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "alloc_counter.h"
+#include "logic/Simulation.h"
+#include "sim/Autopilot.h"
+#include "sim/SeekPolicy.h"
+
+#include <cstring>
+#include <optional>
+
+namespace {
+
+// felt for felt; memcmp ville også sammenlignet utfyllingsbytes
+bool sameState(const EpisodeState& a, const EpisodeState& b) {
+    return a.car.position().x == b.car.position().x && a.car.position().z == b.car.position().z &&
+           a.car.speed() == b.car.speed() && a.car.heading() == b.car.heading() &&
+           std::memcmp(&a.rng, &b.rng, sizeof(Rng)) == 0 && a.time == b.time &&
+           a.progress.objective == b.progress.objective && a.progress.dwell == b.progress.dwell &&
+           a.progress.doorStart == b.progress.doorStart && a.progress.wonAt == b.progress.wonAt;
+}
+
+bool sameEpisode(const Simulation& a, const Simulation& b) {
+    if (!sameState(a.episode(), b.episode())) return false;
+    if (a.cones().size() != b.cones().size() || a.targetSequence() != b.targetSequence()) return false;
+    for (std::size_t i = 0; i < a.cones().size(); ++i) {
+        if (a.cones()[i].x != b.cones()[i].x || a.cones()[i].z != b.cones()[i].z) return false;
+    }
+    for (std::size_t i = 0; i < a.lot().spots.size(); ++i) {
+        if (a.lot().spots[i].completed != b.lot().spots[i].completed) return false;
+    }
+    return true;
+}
+
+void run(Simulation& sim, int steps) {
+    for (int i = 0; i < steps; ++i) sim.step(1.f / 120.f, seekPolicy(sim));
+}
+
+}
+
+TEST_CASE("Restoring a snapshot replays the same future") {
+    Simulation sim(77), reference(77);
+    run(sim, 4000);
+    run(reference, 4000);
+    REQUIRE(sim.completedTargets() > 0); // midt i episoden, med fullførte plasser
+
+    SimSnapshot snap;
+    sim.snapshot(snap);
+
+    run(sim, 3000);
+    sim.reset();
+    run(sim, 500);
+
+    REQUIRE(sim.restore(snap));
+    REQUIRE(sim.events().empty());
+    REQUIRE(sameEpisode(sim, reference));
+
+    run(sim, 6000);
+    run(reference, 6000);
+    REQUIRE(sameEpisode(sim, reference));
+}
+
+TEST_CASE("A snapshot moves between simulations of the same lot") {
+    Simulation source(5), target(9);
+    run(source, 2500);
+
+    SimSnapshot snap;
+    source.snapshot(snap);
+    REQUIRE(target.restore(snap));
+    REQUIRE(target.worldId() == source.worldId());
+    REQUIRE(sameEpisode(target, source));
+
+    run(source, 2000);
+    run(target, 2000);
+    REQUIRE(sameEpisode(target, source));
+
+    // reset fortsetter fra den restaurerte RNG-strømmen
+    source.reset();
+    target.reset();
+    REQUIRE(sameEpisode(target, source));
+
+    // annen plass: avvises og lar simuleringen være
+    Scenario small;
+    small.layout.rows = 3;
+    small.layout.cols = 4;
+    Simulation other(5, small);
+    SimSnapshot before;
+    other.snapshot(before);
+    REQUIRE_FALSE(other.restore(snap));
+    REQUIRE(sameState(other.episode(), before.episode));
+
+    SimSnapshot empty;
+    REQUIRE_FALSE(other.restore(empty));
+}
+
+TEST_CASE("Restore and copies rebuild the parking script where it was") {
+    auto tables = plannerTablesFor(LotLayout{}, CarPhysicsParams{});
+    ParkingPlanner planner(tables);
+    Autopilot pilot;
+    Simulation sim(1000);
+    const float dt = 1.f / 120.f;
+
+    // lagre mens døra går opp
+    SimSnapshot opening;
+    std::optional<Simulation> copy;
+    for (int i = 0; i < 150 * 120 && sim.state() != GameState::Won; ++i) {
+        sim.step(dt, pilot.drive(sim, planner, dt));
+        if (!copy && sim.keyCollected() && sim.episode().time > sim.episode().progress.doorStart + 0.25) {
+            sim.snapshot(opening);
+            copy.emplace(sim);
+        }
+    }
+    REQUIRE(sim.state() == GameState::Won);
+    REQUIRE(copy.has_value());
+    REQUIRE_FALSE(copy->doorOpened());
+    const float height = copy->doorHeight();
+    REQUIRE(height > 1.f);
+
+    REQUIRE(sim.restore(opening));
+    REQUIRE(sim.state() == GameState::Playing);
+    REQUIRE(sim.doorHeight() == height);
+    REQUIRE(sameEpisode(sim, *copy));
+
+    // døra fortsetter fra starttiden sin, ikke fra null, og begge er åpne på samme steg
+    int steps = 0;
+    while (!sim.doorOpened() && steps < 1000) {
+        sim.step(dt, CarInput{});
+        copy->step(dt, CarInput{});
+        REQUIRE(copy->doorOpened() == sim.doorOpened());
+        REQUIRE(copy->doorHeight() == sim.doorHeight());
+        ++steps;
+    }
+    REQUIRE(sim.doorOpened());
+    REQUIRE(steps < 0.8 / dt);
+    REQUIRE(sim.events().back().type == SimEventType::DoorOpened);
+}
+
+TEST_CASE("Snapshot and restore within an episode do not allocate") {
+    Simulation sim(3);
+    SimSnapshot snap;
+    sim.snapshot(snap); // første gang: kopierer kjegler og målsekvens
+
+    std::size_t before = allocationCount();
+    for (int i = 0; i < 1000; ++i) {
+        sim.snapshot(snap);
+        for (int s = 0; s < 8; ++s) sim.step(1.f / 120.f, CarInput{1.f, 0.3f, false});
+        REQUIRE(sim.restore(snap));
+    }
+    REQUIRE(allocationCount() == before);
+}
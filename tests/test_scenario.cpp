@@ -0,0 +1,150 @@
+// tests/test_scenario.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "alloc_counter.h"
+#include "logic/Simulation.h"
+#include "sim/Scenario.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("Scenario text sets the listed keys and keeps the rest") {
+    const char* text =
+        "# kommentar\n"
+        "name = tight\r\n"
+        "\n"
+        "lot.rows = 6   # etter verdi\n"
+        "  lot.cols=10\n"
+        "lot.slotW = 2.25\n"
+        "rules.requiredTargets = 4\n"
+        "rules.parkTime = 2\n"
+        "cones.count = 0\n"
+        "car.friction = 0.5";
+
+    Scenario s;
+    ScenarioError err;
+    REQUIRE(parseScenario(text, s, &err));
+    REQUIRE(std::strcmp(s.name, "tight") == 0);
+    REQUIRE(s.layout.rows == 6);
+    REQUIRE(s.layout.cols == 10);
+    REQUIRE(s.layout.slotW == 2.25f);
+    REQUIRE(s.layout.slotD == LotLayout{}.slotD);
+    REQUIRE(s.requiredTargets == 4);
+    REQUIRE(s.requiredParkTime == 2.f);
+    REQUIRE(s.coneCount == 0);
+    REQUIRE(s.car.friction == 0.5f);
+    REQUIRE(s.car.maxSpeed == CarPhysicsParams{}.maxSpeed);
+}
+
+TEST_CASE("Scenario errors name the line and leave the scenario untouched") {
+    Scenario s;
+    s.coneCount = 7;
+    ScenarioError err;
+
+    REQUIRE_FALSE(parseScenario("cones.count = 12\nlot.colour = 3\n", s, &err));
+    REQUIRE(err.line == 2);
+    REQUIRE(s.coneCount == 7);
+
+    REQUIRE_FALSE(parseScenario("lot.rows = 4x\n", s, &err));
+    REQUIRE(err.line == 1);
+    REQUIRE_FALSE(parseScenario("lot.rows 4\n", s, &err));
+    REQUIRE_FALSE(parseScenario("lot.rows =\n", s, &err));
+    REQUIRE_FALSE(parseScenario("name = aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\n", s, &err));
+
+    // gyldig syntaks, men umulig verden
+    REQUIRE_FALSE(parseScenario("lot.rows = 1\nlot.cols = 2\nrules.requiredTargets = 3\n", s, &err));
+    REQUIRE(err.line == 0);
+    REQUIRE_FALSE(parseScenario("car.maxSpeed = -1\n", s, &err));
+    REQUIRE(s.coneCount == 7);
+}
+
+TEST_CASE("Scenario rejects nan, inf and lots beyond the documented maximum") {
+    Scenario s;
+    ScenarioError err;
+
+    // from_chars leser disse, men validate skal avvise dem
+    REQUIRE_FALSE(parseScenario("lot.slotW = nan\n", s, &err));
+    REQUIRE(err.line == 0);
+    REQUIRE_FALSE(parseScenario("lot.margin = inf\n", s, &err));
+    REQUIRE_FALSE(parseScenario("lot.laneWidth = -nan\n", s, &err));
+    REQUIRE_FALSE(parseScenario("rules.parkTime = infinity\n", s, &err));
+    REQUIRE_FALSE(parseScenario("car.friction = nan\n", s, &err));
+    REQUIRE_FALSE(parseScenario("car.maxSpeed = inf\n", s, &err));
+
+    // rows * cols ville flyte over int
+    REQUIRE_FALSE(parseScenario("lot.rows = 100000\nlot.cols = 100000\n", s, &err));
+    REQUIRE_FALSE(parseScenario("lot.rows = 2000000000\nlot.cols = 2\n", s, &err));
+    // endelige, men for store mål
+    REQUIRE_FALSE(parseScenario("lot.slotW = 1e30\n", s, &err));
+    REQUIRE_FALSE(parseScenario("lot.rows = 1\nlot.margin = 3000\n", s, &err));
+    REQUIRE_FALSE(parseScenario("cones.count = 2000000\n", s, &err));
+    REQUIRE(s.layout.rows == LotLayout{}.rows);
+    REQUIRE(s.coneCount == Scenario{}.coneCount);
+
+    // akkurat på grensene går bra
+    REQUIRE(parseScenario("lot.rows = 1024\nlot.cols = 1024\nlot.slotW = 1\nlot.slotD = 1\n"
+                          "lot.laneWidth = 2\nlot.margin = 0\n", s, &err));
+    REQUIRE(static_cast<long long>(s.layout.rows) * s.layout.cols == scenarioMaxSpots);
+    REQUIRE(parseScenario("cones.count = 1048576\n", s, &err));
+    REQUIRE(s.coneCount == scenarioMaxCones);
+}
+
+TEST_CASE("Simulation uses the scenario's lot, rules, cones and car") {
+    Scenario s;
+    REQUIRE(parseScenario("lot.rows = 4\nlot.cols = 5\nrules.requiredTargets = 6\n"
+                          "rules.parkTime = 0.5\ncones.count = 12\ncar.maxSpeed = 9\n", s));
+
+    Simulation sim(99, s);
+    REQUIRE(sim.lot().spots.size() == 20);
+    REQUIRE(sim.requiredTargets() == 6);
+    REQUIRE(sim.targetSequence().size() == 6);
+    REQUIRE(sim.requiredParkTime() == 0.5f);
+    REQUIRE(sim.cones().size() == 12);
+    REQUIRE(sim.car().params().maxSpeed == 9.f);
+
+    // standardscenarioet er det vanlige spillet
+    Simulation a(99), b(99, Scenario{});
+    REQUIRE(a.lot().spots.size() == b.lot().spots.size());
+    REQUIRE(a.cones()[0].x == b.cones()[0].x);
+    REQUIRE(a.currentTargetSpot() == b.currentTargetSpot());
+}
+
+TEST_CASE("A scenario directory loads every .scn in name order and reports bad files") {
+    namespace fs = std::filesystem;
+    const fs::path dir = "test_scenarios";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    std::ofstream(dir / "b.scn") << "name = b\ncones.count = 5\n";
+    std::ofstream(dir / "a.scn") << "name = a\n";
+    std::ofstream(dir / "c.scn") << "name = c\nbogus = 1\n";
+    std::ofstream(dir / "notes.txt") << "ikke et scenario\n";
+
+    std::vector<Scenario> out;
+    std::vector<std::string> errors;
+    REQUIRE(loadScenarioDirectory(dir.string(), out, &errors) == 2);
+    REQUIRE(out.size() == 2);
+    REQUIRE(std::strcmp(out[0].name, "a") == 0);
+    REQUIRE(std::strcmp(out[1].name, "b") == 0);
+    REQUIRE(out[1].coneCount == 5);
+    REQUIRE(errors.size() == 1);
+    REQUIRE(errors[0].find("c.scn:2") != std::string::npos);
+
+    fs::remove_all(dir);
+}
+
+TEST_CASE("Parsing a scenario does not allocate") {
+    const char* text =
+        "name = sweep_a\n"
+        "lot.rows = 20\nlot.cols = 30\nlot.slotW = 2.4\n"
+        "rules.requiredTargets = 5\nrules.parkTime = 2\n"
+        "cones.count = 100\ncar.maxSpeed = 15\n";
+
+    Scenario s;
+    std::size_t before = allocationCount();
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(parseScenario(text, s));
+    }
+    REQUIRE(allocationCount() == before);
+}
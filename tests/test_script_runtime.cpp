@@ -0,0 +1,185 @@
+// tests/test_script_runtime.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "sim/Autopilot.h"
+#include "sim/ScriptRuntime.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <span>
+#include <vector>
+
+namespace {
+
+ScriptTask waitThenCount(ScriptRuntime& rt, double seconds, int& counter) {
+    co_await rt.delay(seconds);
+    ++counter;
+}
+
+ScriptTask parkThenCount(ScriptRuntime& rt, std::uint32_t body, std::uint32_t trigger, int& counter) {
+    co_await rt.parkedIn(body, trigger, 0.5f, 0.4f);
+    ++counter;
+    co_await rt.reached(body, trigger + 1);
+    ++counter;
+}
+
+}
+
+TEST_CASE("ScriptRuntime resumes timers when they are due") {
+    ScriptRuntime rt;
+    int a = 0, b = 0;
+    rt.spawn(waitThenCount(rt, 0.25, a));
+    rt.spawn(waitThenCount(rt, 0.5, b));
+    REQUIRE(rt.live() == 2);
+
+    for (int i = 0; i < 14; ++i) rt.step(0.02f, {}, nullptr); // 0.28 s
+    REQUIRE(a == 1);
+    REQUIRE(b == 0);
+    for (int i = 0; i < 12; ++i) rt.step(0.02f, {}, nullptr);
+    REQUIRE(b == 1);
+    REQUIRE(rt.live() == 0); // ferdige skript er frigitt
+
+    ScriptAnimation door;
+    door.from = 1.f;
+    REQUIRE(door.value(5.0) == 1.f); // ikke startet
+    door = {2.0, 1.f, 4.f, 3.f, true};
+    REQUIRE(std::abs(door.value(2.5) - 2.5f) < 1e-6f);
+    REQUIRE(door.value(9.0) == 4.f);
+}
+
+TEST_CASE("parkedIn needs the body inside and slow without a break") {
+    ScriptRuntime rt;
+    int counter = 0;
+    rt.spawn(parkThenCount(rt, 2, 7, counter));
+
+    float speeds[3] = {0.f, 0.f, 0.f};
+    const TriggerEvent stay{2, 7, TriggerPhase::Stay};
+    const TriggerEvent other{1, 7, TriggerPhase::Stay}; // en annen kropp
+    const TriggerEvent exit{2, 7, TriggerPhase::Exit};
+
+    for (int i = 0; i < 4; ++i) rt.step(0.1f, std::span(&stay, 1), speeds);
+    rt.step(0.1f, std::span(&exit, 1), speeds); // ut igjen: teller fra null
+    for (int i = 0; i < 4; ++i) rt.step(0.1f, std::span(&other, 1), speeds);
+    REQUIRE(counter == 0);
+
+    speeds[2] = 1.f; // for fort
+    for (int i = 0; i < 6; ++i) rt.step(0.1f, std::span(&stay, 1), speeds);
+    REQUIRE(counter == 0);
+
+    speeds[2] = 0.f;
+    for (int i = 0; i < 4; ++i) rt.step(0.1f, std::span(&stay, 1), speeds);
+    REQUIRE(counter == 0);
+    rt.step(0.1f, std::span(&stay, 1), speeds);
+    REQUIRE(counter == 1);
+
+    const TriggerEvent next{2, 8, TriggerPhase::Enter};
+    const std::uint64_t before = rt.resumes();
+    for (int i = 0; i < 100; ++i) rt.step(0.1f, {}, speeds);
+    REQUIRE(rt.resumes() == before); // ventende skript vekkes ikke uten hendelser
+    rt.step(0.1f, std::span(&next, 1), speeds);
+    REQUIRE(counter == 2);
+    REQUIRE(rt.live() == 0);
+}
+
+TEST_CASE("Simulation's rules are parkingScript on its trigger events") {
+    auto tables = plannerTablesFor(LotLayout{}, CarPhysicsParams{});
+    ParkingPlanner planner(tables);
+    Simulation sim(1000);
+    Autopilot pilot;
+
+    // et eget skript på de samme hendelsene kommer like langt på samme steg
+    ParkingCourse course = sim.course();
+    const std::vector<int> targets(course.targets.begin(), course.targets.end());
+    course.targets = targets;
+    REQUIRE(course.targetCount() == sim.requiredTargets());
+
+    ScriptRuntime rt;
+    ParkingProgress progress;
+    rt.spawn(parkingScript(rt, 0, course, progress));
+
+    const float dt = 1.f / 60.f;
+    bool sawDoorMoving = false;
+    int i = 0;
+    for (; i < 150 * 60 && sim.state() != GameState::Won; ++i) {
+        sim.step(dt, pilot.drive(sim, planner, dt));
+        const float speed = sim.car().speed();
+        rt.step(dt, sim.triggerEvents(), &speed);
+
+        REQUIRE(progress.objective == sim.episode().progress.objective);
+        REQUIRE(progress.completedTargets(course) == sim.completedTargets());
+        REQUIRE(progress.keyCollected(course) == sim.keyCollected());
+        REQUIRE(progress.doorHeight(course, rt.now()) == sim.doorHeight());
+        if (sim.keyCollected() && !sim.doorOpened()) {
+            sawDoorMoving = true;
+            REQUIRE(sim.doorHeight() >= course.doorFrom);
+            REQUIRE(sim.doorHeight() <= course.doorTo);
+        }
+    }
+    REQUIRE(sim.state() == GameState::Won);
+    REQUIRE(progress.won(course));
+    REQUIRE(sawDoorMoving);
+    REQUIRE(sim.doorHeight() == course.doorTo);
+}
+
+TEST_CASE("parkingScript resumes from saved progress") {
+    const std::vector<int> targets{4, 9};
+    ParkingCourse course;
+    course.targets = targets;
+    course.parkTime = 0.5f;
+    course.keyTrigger = 100;
+    course.doorTrigger = 101;
+
+    const float speed = 0.f;
+    const TriggerEvent inSpot9{0, 9, TriggerPhase::Stay};
+    const TriggerEvent atDoor{0, 101, TriggerPhase::Enter};
+
+    // midt i andre plass: dwell fortsetter fra lagret verdi
+    ScriptRuntime rt;
+    ParkingProgress p;
+    p.objective = 1;
+    p.dwell = 0.45f;
+    rt.spawn(parkingScript(rt, 0, course, p));
+    rt.step(0.1f, std::span(&inSpot9, 1), &speed);
+    REQUIRE(p.objective == 2);
+    REQUIRE(p.dwell == 0.f);
+
+    // døra har gått i 0.5 av 1 s: åpen etter 0.5 s til, på klokka den ble lagret med
+    rt.clear(10.0);
+    p = {};
+    p.objective = 3;
+    p.doorStart = 9.5;
+    rt.spawn(parkingScript(rt, 0, course, p));
+    REQUIRE(std::abs(p.doorHeight(course, rt.now()) - 2.5f) < 1e-5f);
+    for (int i = 0; i < 4; ++i) rt.step(0.1f, {}, &speed);
+    REQUIRE_FALSE(p.doorOpened(course));
+    rt.step(0.11f, {}, &speed);
+    REQUIRE(p.doorOpened(course));
+    REQUIRE(p.doorHeight(course, rt.now()) == 4.f);
+
+    rt.step(0.1f, std::span(&atDoor, 1), &speed);
+    REQUIRE(p.won(course));
+    REQUIRE(rt.live() == 0);
+
+    // allerede forbi tidspunktet: åpnes med en gang skriptet bygges
+    rt.clear(20.0);
+    p = {};
+    p.objective = 3;
+    p.doorStart = 1.0;
+    rt.spawn(parkingScript(rt, 0, course, p));
+    REQUIRE(p.objective == 4);
+}
+
+TEST_CASE("Thousands of waiting scripts cost nothing per step") {
+    ScriptRuntime rt;
+    std::vector<int> counters(5000, 0);
+    for (std::uint32_t b = 0; b < counters.size(); ++b) {
+        rt.spawn(parkThenCount(rt, b, b % 288, counters[b]));
+    }
+    REQUIRE(rt.live() == 5000);
+    const std::uint64_t spawned = rt.resumes();
+
+    for (int i = 0; i < 1000; ++i) rt.step(1.f / 120.f, {}, nullptr);
+    REQUIRE(rt.resumes() == spawned);
+
+    rt.clear();
+    REQUIRE(rt.live() == 0);
+}
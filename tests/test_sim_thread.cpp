@@ -0,0 +1,171 @@
+// tests/test_sim_thread.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "sim/SimThread.h"
+#include "util/Profiler.h"
+#include "util/TripleBuffer.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// venter på en frame som oppfyller pred, maks 2 s
+template <class Pred>
+bool waitForFrame(SimThread& t, Pred pred) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (t.poll() && pred(t.frame())) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+bool sameCones(const std::vector<Vec2>& a, const std::vector<Vec2>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (a[i].x != b[i].x || a[i].z != b[i].z) return false;
+    }
+    return true;
+}
+
+struct Pair {
+    int a = 0;
+    int b = 0;
+};
+
+}
+
+TEST_CASE("TripleBuffer hands over the latest value") {
+    TripleBuffer<int> buf(-1);
+    REQUIRE_FALSE(buf.update());
+    REQUIRE(buf.front() == -1);
+
+    buf.publish(1);
+    buf.publish(2);
+    REQUIRE(buf.update());
+    REQUIRE(buf.front() == 2); // 1 ble hoppet over
+    REQUIRE_FALSE(buf.update());
+    REQUIRE(buf.front() == 2);
+
+    buf.publish(3);
+    REQUIRE(buf.update());
+    REQUIRE(buf.front() == 3);
+}
+
+TEST_CASE("TripleBuffer reader never sees a torn value") {
+    TripleBuffer<Pair> buf;
+    constexpr int count = 200000;
+
+    std::thread writer([&] {
+        for (int i = 1; i <= count; ++i) {
+            buf.back() = {i, -i};
+            buf.publish();
+        }
+    });
+
+    int last = 0;
+    bool ok = true;
+    while (last < count) {
+        if (!buf.update()) continue;
+        const Pair& p = buf.front();
+        ok = ok && p.a == -p.b && p.a >= last;
+        last = p.a;
+    }
+    writer.join();
+    REQUIRE(ok);
+}
+
+TEST_CASE("SimThread steps on its own thread and applies input") {
+    Simulation sim(5);
+    SimThread thread(sim, 240.f);
+
+    // startbildet finnes før tråden går
+    REQUIRE(thread.frame().step == 0);
+    REQUIRE(thread.frame().carPos.z == sim.startPos().z);
+
+    thread.start();
+    const std::uint64_t pressed = Profiler::nowNs();
+    REQUIRE(thread.push({pressed, InputControl::Throttle, 1.f}));
+
+    REQUIRE(waitForFrame(thread, [&](const SimFrame& f) { return f.carSpeed > 1.f; }));
+    const SimFrame& f = thread.frame();
+    REQUIRE(f.step > 0);
+    REQUIRE(f.inputNs == pressed);
+    REQUIRE(f.stepDt == thread.stepDt());
+    REQUIRE(f.inputToPhysics.samples == 1);
+    REQUIRE(f.inputToPhysics.maxMs < 1000.0);
+
+    // render-siden melder tegnet frame: én måling per ny input
+    thread.beginRender();
+    thread.endRender(f);
+    thread.endRender(f);
+    ThreadSplitStats stats = thread.takeStats();
+    REQUIRE(stats.inputToPhoton.samples == 1);
+    REQUIRE(stats.inputToPhoton.p50Ms >= 0.0);
+    REQUIRE(stats.simBusy > 0.0);
+    REQUIRE(stats.overlap <= stats.simBusy);
+
+    thread.stop();
+    REQUIRE_FALSE(thread.running());
+}
+
+TEST_CASE("SimThread puts its step phases in the profiler's sim window") {
+    Profiler::clear();
+    Profiler::setEnabled(true);
+    Simulation sim(5);
+    SimThread thread(sim, 240.f);
+    thread.start();
+    REQUIRE(waitForFrame(thread, [](const SimFrame& f) { return f.step >= 20; }));
+    thread.stop();
+    Profiler::setEnabled(false);
+
+    auto step = Profiler::summary(ProfPhase::SimStep, ProfWindow::Sim);
+    REQUIRE(step.frames > 0);
+    REQUIRE(step.maxMs > 0.0);
+    REQUIRE(Profiler::summary(ProfPhase::CarUpdate, ProfWindow::Sim).maxMs > 0.0);
+    REQUIRE(Profiler::summary(ProfPhase::SimStep).frames == 0); // render-vinduet er urørt
+}
+
+TEST_CASE("SimThread performs every requested reset once") {
+    Simulation sim(6);
+    SimThread thread(sim, 240.f);
+    thread.start();
+
+    thread.push({Profiler::nowNs(), InputControl::Throttle, 1.f});
+    REQUIRE(waitForFrame(thread, [](const SimFrame& f) { return f.carSpeed > 1.f; }));
+
+    thread.push({Profiler::nowNs(), InputControl::Throttle, 0.f});
+    thread.requestReset();
+    REQUIRE(thread.resetsRequested() == 1);
+    REQUIRE(waitForFrame(thread, [](const SimFrame& f) { return f.episode == 1; }));
+    REQUIRE(thread.frame().carSpeed == 0.f);
+
+    // ny input etter reseten gir ingen ny reset
+    thread.push({Profiler::nowNs(), InputControl::Throttle, 1.f});
+    REQUIRE(waitForFrame(thread, [](const SimFrame& f) { return f.carSpeed > 1.f; }));
+    REQUIRE(thread.frame().episode == 1);
+
+    thread.stop();
+}
+
+TEST_CASE("SimThread publishes each episode's cones as its own copy") {
+    Simulation sim(6);
+    SimThread thread(sim, 240.f);
+    auto first = thread.frame().cones;
+    REQUIRE(first);
+    REQUIRE(sameCones(*first, sim.cones()));
+    const std::vector<Vec2> before = *first;
+
+    thread.start();
+    thread.requestReset();
+    REQUIRE(waitForFrame(thread, [](const SimFrame& f) { return f.episode == 1; }));
+    auto second = thread.frame().cones;
+    thread.stop();
+
+    // visningen kan holde den gamle mens simuleringstråden resetter: den er urørt
+    REQUIRE(second != first);
+    REQUIRE(sameCones(*second, sim.cones()));
+    REQUIRE(sameCones(*first, before));
+    REQUIRE_FALSE(sameCones(*first, *second));
+}
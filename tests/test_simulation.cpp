@@ -0,0 +1,84 @@
+// tests/test_simulation.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "logic/Simulation.h"
+
+#include <cmath>
+
+TEST_CASE("Simulation starts a fresh episode without any scene") {
+    Simulation sim;
+
+    REQUIRE(sim.state() == GameState::Playing);
+    REQUIRE(sim.lot().spots.size() == 12u * 24u);
+    REQUIRE(sim.cones().size() == 30u);
+    REQUIRE(sim.currentTargetSpot() >= 0);
+    REQUIRE(sim.car().position().z == sim.startPos().z);
+}
+
+TEST_CASE("Simulation keeps the car inside the lot") {
+    Simulation sim;
+
+    CarInput in;
+    in.throttle = -1.f; // rygg mot døra/kanten
+
+    for (int i = 0; i < 2000; ++i) {
+        sim.step(1.f / 60.f, in);
+    }
+
+    const auto& lot = sim.lot();
+    Vec2 p = sim.car().position();
+    REQUIRE(p.z >= lot.center.z - lot.depth * 0.5f + 1.0f);
+    REQUIRE(p.x >= lot.center.x - lot.width * 0.5f + 1.0f);
+    REQUIRE(p.x <= lot.center.x + lot.width * 0.5f - 1.0f);
+}
+
+TEST_CASE("Simulation reset puts the car back at the start") {
+    Simulation sim;
+
+    CarInput in;
+    in.throttle = 1.f;
+    in.steer = 0.5f;
+    for (int i = 0; i < 120; ++i) {
+        sim.step(1.f / 60.f, in);
+    }
+
+    sim.reset();
+
+    REQUIRE(sim.car().speed() == 0.f);
+    REQUIRE(sim.car().position().x == sim.startPos().x);
+    REQUIRE(sim.car().position().z == sim.startPos().z);
+    REQUIRE(sim.completedTargets() == 0);
+    REQUIRE(sim.events().empty());
+}
+
+TEST_CASE("Simulation stops at cones even with large steps") {
+    Scenario scenario;
+    scenario.coneCount = 300;
+
+    // 0.1 s per steg: opptil 2 m per steg, mer enn bilen er bred
+    const float dt = 0.1f;
+    int stops = 0;
+    for (std::uint64_t seed = 1; seed <= 8; ++seed) {
+        Simulation sim(seed, scenario);
+        for (int i = 0; i < 3000; ++i) {
+            CarInput in;
+            in.throttle = 1.f;
+            in.steer = std::sin(0.6f * i * dt + static_cast<float>(seed));
+
+            Vec2 a = sim.car().position();
+            float speed = sim.car().speed();
+            sim.step(dt, in);
+            Vec2 b = sim.car().position();
+            if (speed > 1.f && sim.car().speed() == 0.f) ++stops;
+
+            // bilboksen langs strekningen den faktisk kjørte går aldri gjennom en kjegle
+            for (int k = 0; k <= 20; ++k) {
+                Obb box = makeCarObb(a + (b - a) * (k / 20.f), sim.car().heading(),
+                                     sim.carHalfW(), sim.carHalfD());
+                for (const auto& c : sim.cones()) {
+                    REQUIRE_FALSE(overlapsCircle(box, c, 0.35f - 0.01f));
+                }
+            }
+        }
+    }
+    REQUIRE(stops > 0);
+}
@@ -0,0 +1,135 @@
+// tests/test_triggers.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "logic/Simulation.h"
+#include "world/TriggerRegistry.h"
+
+#include <algorithm>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+Obb carAt(Vec2 p, float heading = 0.f) {
+    return makeCarObb(p, heading, 0.5f, 1.0f);
+}
+
+}
+
+TEST_CASE("TriggerRegistry reports enter, stay and exit per body") {
+    TriggerRegistry reg;
+    const auto zone = reg.add(makeCircleTrigger(TriggerKind::Key, TriggerTest::Center, {10.f, 0.f}, 1.5f));
+    reg.build(1.2f);
+
+    TriggerContacts c;
+    std::vector<TriggerEvent> ev;
+
+    reg.update(3, carAt({0.f, 0.f}), c, ev);
+    REQUIRE(ev.empty());
+
+    reg.update(3, carAt({9.f, 0.f}), c, ev);
+    REQUIRE(ev.size() == 1);
+    REQUIRE(ev[0].body == 3);
+    REQUIRE(ev[0].trigger == zone);
+    REQUIRE(ev[0].phase == TriggerPhase::Enter);
+
+    ev.clear();
+    reg.update(3, carAt({10.5f, 0.f}), c, ev);
+    REQUIRE(ev.size() == 1);
+    REQUIRE(ev[0].phase == TriggerPhase::Stay);
+    REQUIRE(c.contains(zone));
+
+    ev.clear();
+    reg.update(3, carAt({40.f, 0.f}), c, ev); // langt utenfor rutenettet
+    REQUIRE(ev.size() == 1);
+    REQUIRE(ev[0].phase == TriggerPhase::Exit);
+    REQUIRE(c.count == 0);
+}
+
+TEST_CASE("TriggerRegistry grid finds the same contacts as testing every volume") {
+    TriggerRegistry reg;
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> pos(-30.f, 30.f), size(0.5f, 4.f), angle(-3.14f, 3.14f);
+    for (int i = 0; i < 300; ++i) {
+        const Vec2 c{pos(gen), pos(gen)};
+        const auto test = static_cast<TriggerTest>(i % 3);
+        switch (i % 3) {
+            case 0: reg.add(makeAabbTrigger(TriggerKind::Spot, test, c, {size(gen), size(gen)})); break;
+            case 1: reg.add(makeCircleTrigger(TriggerKind::Key, test, c, size(gen))); break;
+            default: reg.add(makeObbTrigger(TriggerKind::Door, test, makeCarObb(c, angle(gen), size(gen), size(gen)))); break;
+        }
+    }
+    reg.build(length({0.5f, 1.f}), 3.f);
+
+    std::uniform_real_distribution<float> wide(-40.f, 40.f);
+    for (int k = 0; k < 3000; ++k) {
+        const Obb body = carAt({wide(gen), wide(gen)}, angle(gen));
+        TriggerContacts c;
+        std::vector<TriggerEvent> ev;
+        reg.update(0, body, c, ev);
+
+        int expected = 0;
+        for (std::uint32_t id = 0; id < reg.size(); ++id) {
+            if (reg.touches(id, body)) {
+                ++expected;
+                if (c.count < TriggerContacts::capacity) REQUIRE(c.contains(id));
+            }
+        }
+        REQUIRE(c.count == std::min(expected, TriggerContacts::capacity));
+    }
+}
+
+TEST_CASE("TriggerRegistry takes prebuilt cells and refills ones that don't fit") {
+    auto fill = [](TriggerRegistry& reg) {
+        for (int i = 0; i < 40; ++i) {
+            reg.add(makeAabbTrigger(TriggerKind::Spot, TriggerTest::Contain,
+                                    {static_cast<float>(i % 8) * 3.f, static_cast<float>(i / 8) * 6.f}, {1.2f, 2.5f}, i));
+        }
+    };
+    TriggerRegistry built;
+    fill(built);
+    built.build(1.2f);
+    std::vector<std::uint32_t> start(built.cellStarts().begin(), built.cellStarts().end());
+    std::vector<std::uint32_t> ids(built.cellIds().begin(), built.cellIds().end());
+
+    auto sameCells = [&](const TriggerRegistry& reg) {
+        return std::equal(reg.cellStarts().begin(), reg.cellStarts().end(), start.begin(), start.end()) &&
+               std::equal(reg.cellIds().begin(), reg.cellIds().end(), ids.begin(), ids.end());
+    };
+
+    TriggerRegistry prebuilt;
+    fill(prebuilt);
+    prebuilt.build(1.2f, 4.f, start, ids);
+    REQUIRE(sameCells(prebuilt));
+
+    // feil antall celler, id utenfor og synkende start gir samme celler som build()
+    std::vector<std::uint32_t> badId = ids;
+    badId[0] = 40;
+    std::vector<std::uint32_t> badStart = start;
+    badStart[1] = badStart[2] + 1;
+    TriggerRegistry a, b, c;
+    fill(a);
+    fill(b);
+    fill(c);
+    a.build(1.2f, 4.f, std::span(start).first(start.size() - 1), ids);
+    b.build(1.2f, 4.f, start, badId);
+    c.build(1.2f, 4.f, badStart, ids);
+    REQUIRE(sameCells(a));
+    REQUIRE(sameCells(b));
+    REQUIRE(sameCells(c));
+}
+
+TEST_CASE("Spot triggers follow the isCarInsideSpot rule") {
+    Simulation sim(5);
+    const auto& spot = sim.lot().spots[17];
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> off(-3.f, 3.f), angle(-3.14f, 3.14f);
+    for (int k = 0; k < 2000; ++k) {
+        const Vec2 p = spot.center + Vec2{off(gen), off(gen)};
+        const float h = angle(gen);
+        const Obb body = makeCarObb(p, h, sim.carHalfW(), sim.carHalfD());
+        REQUIRE(sim.triggers().touches(17, body) == isCarInsideSpot(spot, p, h, sim.carHalfW(), sim.carHalfD()));
+    }
+    REQUIRE(sim.triggers().volume(sim.keyTrigger()).kind == TriggerKind::Key);
+    REQUIRE(sim.triggers().volume(sim.doorTrigger()).kind == TriggerKind::Door);
+}
@@ -0,0 +1,142 @@
+// tests/test_world_cache.cpp
+#include <catch2/catch_test_macros.hpp>
+#include "logic/Simulation.h"
+#include "sim/SeekPolicy.h"
+#include "world/LotChunks.h"
+#include "world/WorldCache.h"
+
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace {
+
+WorldKey keyFor(const Simulation& sim, float chunkSize) {
+    WorldKey key;
+    key.layout = sim.lot().layout;
+    key.seed = sim.seed();
+    key.coneCount = sim.coneCount();
+    key.requiredTargets = sim.requiredTargets();
+    key.chunkSize = chunkSize;
+    return key;
+}
+
+void requireSameState(const Simulation& a, const Simulation& b) {
+    REQUIRE(a.car().position().x == b.car().position().x);
+    REQUIRE(a.car().position().z == b.car().position().z);
+    REQUIRE(a.car().heading() == b.car().heading());
+    REQUIRE(a.completedTargets() == b.completedTargets());
+    REQUIRE(a.currentTargetSpot() == b.currentTargetSpot());
+    REQUIRE(a.cones().size() == b.cones().size());
+    for (std::size_t i = 0; i < a.cones().size(); ++i) {
+        REQUIRE(a.cones()[i].x == b.cones()[i].x);
+        REQUIRE(a.cones()[i].z == b.cones()[i].z);
+    }
+}
+
+}
+
+TEST_CASE("A baked world loads into the same simulation as generating it") {
+    const std::string path = "test_world_cache.bswc";
+    Simulation generated(1234);
+    REQUIRE(bakeWorld(path, generated, 32.f));
+
+    WorldCache cache;
+    REQUIRE(cache.open(path, keyFor(generated, 32.f)));
+    const auto& w = cache.world();
+    REQUIRE(w.spots.size() == generated.lot().spots.size());
+    REQUIRE(w.lineVertices.size() == w.spots.size() * 18);
+
+    Simulation loaded(w);
+    REQUIRE(loaded.seed() == generated.seed());
+    REQUIRE(loaded.lot().spots.size() == generated.lot().spots.size());
+    REQUIRE(loaded.lot().spots[17].center.x == generated.lot().spots[17].center.x);
+    requireSameState(loaded, generated);
+
+    // samme episode videre, også etter reset (RNG-strømmen fortsetter likt)
+    for (int i = 0; i < 3000; ++i) {
+        loaded.step(1.f / 120.f, seekPolicy(loaded));
+        generated.step(1.f / 120.f, seekPolicy(generated));
+    }
+    requireSameState(loaded, generated);
+    loaded.reset();
+    generated.reset();
+    requireSameState(loaded, generated);
+
+    // chunk-bøttene fra filen er de samme som LotChunks lager selv
+    LotChunks fresh, baked;
+    fresh.configure(generated.lot(), 32.f);
+    baked.configure(loaded.lot(), 32.f, w.chunkStart, w.chunkSpots);
+    REQUIRE(baked.count() == fresh.count());
+    for (int c = 0; c < fresh.count(); ++c) {
+        auto a = fresh.spotsIn(c);
+        auto b = baked.spotsIn(c);
+        REQUIRE(std::equal(a.begin(), a.end(), b.begin(), b.end()));
+    }
+
+    // triggercellene fra filen gir samme rutenett som å bygge det
+    auto tg = generated.triggers().cellIds();
+    auto tl = loaded.triggers().cellIds();
+    REQUIRE(w.triggerIds.size() == tg.size());
+    REQUIRE(std::equal(tl.begin(), tl.end(), tg.begin(), tg.end()));
+    REQUIRE(loaded.triggers().cols() == generated.triggers().cols());
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("WorldCache misses on another key or a damaged file") {
+    const std::string path = "test_world_cache_miss.bswc";
+    Simulation sim(99);
+    REQUIRE(bakeWorld(path, sim, 32.f));
+
+    WorldCache cache;
+    auto key = keyFor(sim, 32.f);
+    REQUIRE(cache.open(path, key));
+
+    auto otherSeed = key;
+    otherSeed.seed = 100;
+    REQUIRE_FALSE(cache.open(path, otherSeed));
+    auto otherChunk = key;
+    otherChunk.chunkSize = 64.f;
+    REQUIRE_FALSE(cache.open(path, otherChunk));
+    REQUIRE(worldCachePath("cache", key) != worldCachePath("cache", otherSeed));
+
+    // avkuttet fil
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() / 2));
+    }
+    REQUIRE_FALSE(cache.open(path, key));
+    REQUIRE_FALSE(cache.open("does_not_exist.bswc", key));
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("WorldCache rejects spot and cone counts that don't match the key") {
+    const std::string path = "test_world_cache_counts.bswc";
+    Simulation sim(7);
+    const auto key = keyFor(sim, 32.f);
+
+    // count[] i headeren (versjon 3) starter på byte 192; seksjon 0 = plasser, 1 = kjegler
+    auto patchCount = [&](int section, std::uint64_t count) {
+        REQUIRE(bakeWorld(path, sim, 32.f));
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(192 + 8 * section);
+        f.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    };
+
+    WorldCache cache;
+    patchCount(1, sim.cones().size() - 1);
+    REQUIRE_FALSE(cache.open(path, key));
+    patchCount(0, sim.lot().spots.size() - 1);
+    REQUIRE_FALSE(cache.open(path, key));
+    patchCount(1, sim.cones().size());
+    REQUIRE(cache.open(path, key));
+
+    std::remove(path.c_str());
+}
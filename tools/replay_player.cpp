@@ -0,0 +1,63 @@
+// --------------------------------------------------------------------------------------
+// Headless replay player: memory-maps a replay file or an archive of concatenated
+// replays and re-simulates each one as fast as possible, in the scenario it was
+// recorded with.
+// Usage: replay_player <file.bsrp>
+// --------------------------------------------------------------------------------------
+
+#include "sim/Replay.h"
+#include "util/MappedFile.h"
+
+#include <cstdio>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <replay file or archive>\n", argv[0]);
+        return 2;
+    }
+
+    MappedFile file;
+    if (!file.open(argv[1])) {
+        std::fprintf(stderr, "could not open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::uint64_t totalSteps = 0;
+    std::size_t rejected = 0;
+    double totalSeconds = 0.0;
+    double totalSimulated = 0.0;
+
+    std::size_t count = forEachReplay(file.bytes(), [&](ReplayReader& reader) {
+        ReplayResult r = playReplay(reader);
+        if (!r.valid) {
+            std::fprintf(stderr, "%-16s seed %016llx  rejected: corrupt after %llu of %llu steps\n",
+                         reader.scenario().name, static_cast<unsigned long long>(reader.seed()),
+                         static_cast<unsigned long long>(r.steps),
+                         static_cast<unsigned long long>(reader.stepCount()));
+            ++rejected;
+            return;
+        }
+
+        std::printf("%-16s seed %016llx  steps %8llu  %-7s targets %d  car (%.2f, %.2f)  %.0fx real time\n",
+                    reader.scenario().name, static_cast<unsigned long long>(reader.seed()),
+                    static_cast<unsigned long long>(r.steps),
+                    r.state == GameState::Won ? "won" : "playing",
+                    r.completedTargets, r.carPos.x, r.carPos.z, r.realTimeFactor);
+
+        totalSteps += r.steps;
+        totalSeconds += r.seconds;
+        totalSimulated += static_cast<double>(r.steps) * reader.stepDt();
+    });
+
+    if (count == rejected) {
+        std::fprintf(stderr, "no valid replays in %s\n", argv[1]);
+        return 1;
+    }
+
+    std::printf("%zu replay(s), %llu steps in %.3f s (%.0fx real time)",
+                count - rejected, static_cast<unsigned long long>(totalSteps), totalSeconds,
+                totalSeconds > 0.0 ? totalSimulated / totalSeconds : 0.0);
+    if (rejected > 0) std::printf(", %zu rejected", rejected);
+    std::printf("\n");
+    return rejected > 0 ? 1 : 0;
+}
@@ -0,0 +1,63 @@
+// --------------------------------------------------------------------------------------
+// Scenario sweep: loads every *.scn in a directory and runs a batch of headless
+// episodes per scenario with seekPolicy, reporting win rate and throughput.
+// Usage: scenario_sweep <dir> [episodes] [steps]
+// --------------------------------------------------------------------------------------
+
+#include "sim/EpisodeRunner.h"
+#include "sim/Scenario.h"
+#include "sim/SeekPolicy.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <scenario dir> [episodes] [steps]\n", argv[0]);
+        return 2;
+    }
+    const std::size_t episodes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 256;
+    const int steps = argc > 3 ? std::atoi(argv[3]) : 120 * 60;
+
+    using clock = std::chrono::steady_clock;
+
+    std::vector<Scenario> scenarios;
+    std::vector<std::string> errors;
+    auto t0 = clock::now();
+    loadScenarioDirectory(argv[1], scenarios, &errors);
+    double loadMs = std::chrono::duration<double, std::milli>(clock::now() - t0).count();
+
+    for (const auto& e : errors) std::fprintf(stderr, "%s\n", e.c_str());
+    if (scenarios.empty()) {
+        std::fprintf(stderr, "no scenarios in %s\n", argv[1]);
+        return 1;
+    }
+    std::printf("%zu scenario(s) loaded in %.3f ms; %zu episodes x %d steps each\n",
+                scenarios.size(), loadMs, episodes, steps);
+    std::printf("%-24s %8s %10s %10s %14s\n", "scenario", "won", "targets", "build ms", "steps/sec");
+
+    ThreadPool pool;
+    EpisodePolicy policy = [](std::size_t, const Simulation& sim) { return seekPolicy(sim); };
+
+    for (const auto& scenario : scenarios) {
+        auto b0 = clock::now();
+        EpisodeRunner runner(episodes, 12345, scenario);
+        double buildMs = std::chrono::duration<double, std::milli>(clock::now() - b0).count();
+
+        EpisodeRunStats stats = runner.run(pool, steps, 1.f / 120.f, policy);
+
+        std::size_t won = 0;
+        double targets = 0.0;
+        for (std::size_t i = 0; i < runner.size(); ++i) {
+            const auto& sim = runner.episode(i);
+            if (sim.state() == GameState::Won) ++won;
+            targets += sim.completedTargets();
+        }
+
+        std::printf("%-24s %7.1f%% %10.2f %10.2f %14.3e\n", scenario.name,
+                    100.0 * static_cast<double>(won) / static_cast<double>(runner.size()),
+                    targets / static_cast<double>(runner.size()), buildMs, stats.stepsPerSec);
+    }
+    return 0;
+}